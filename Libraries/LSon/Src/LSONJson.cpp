@@ -2,6 +2,7 @@
 #include "LSONJsonContainer.h"
 #include "LSONJsonLexer.h"
 #include "Gen/LSONJsonParser.h"	// Must come after container/lexer.
+#include <memory>
 #include <sstream>
 
 
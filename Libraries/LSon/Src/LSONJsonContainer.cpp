@@ -1,11 +1,15 @@
 // TMP.
+#ifdef _WIN32
 #include <Windows.h>
+#endif
 
 #include "LSONJsonContainer.h"
 #include "LSONJsonLexer.h"
 
 
+#ifdef _WIN32
 #include <format>
+#endif
 
 
 namespace lson {
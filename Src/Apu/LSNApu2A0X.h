@@ -12,6 +12,7 @@
 #include "../LSNLSpiroNes.h"
 #include "LSNPulse.h"
 #include "../Bus/LSNBus.h"
+#include "../System/LSNEventQueue.h"
 #include "../System/LSNTickable.h"
 #include "../Utilities/LSNDelayedValue.h"
 
@@ -69,10 +70,13 @@ namespace lsn {
 		unsigned _tM1S0, unsigned _tM1S1, unsigned _tM1S2, unsigned _tM1S3, unsigned _tM1S4_0, unsigned _tM1S4_1>
 	class CApu2A0X : public CTickable {
 	public :
-		CApu2A0X( CCpuBus * _pbBus ) :
+		CApu2A0X( CCpuBus * _pbBus, CEventQueue * _peqEvents, uint64_t _ui64ApuDiv ) :
 			m_pbBus( _pbBus ),
+			m_peqEvents( _peqEvents ),
+			m_ui64ApuDiv( _ui64ApuDiv ),
 			m_ui64Cycles( 0 ),
-			m_ui64StepCycles( 0 ),
+			m_ui64StepStart( 0 ),
+			m_ui8FrameStep( 0 ),
 			m_dvRegisters3_4017( Set4017, this ) {
 
 		}
@@ -88,7 +92,7 @@ namespace lsn {
 		/**
 		 * Performs a single cycle update.
 		 */
-		virtual void									Tick() {
+		virtual void									Tick() final {
 			m_dvRegisters3_4017.Tick();
 			(this->*m_pftTick)();
 
@@ -101,11 +105,17 @@ namespace lsn {
 		 */
 		void											ResetAnalog() {
 			m_ui64Cycles = 0;
-			m_ui64StepCycles = 0;
-			m_pftTick = &CApu2A0X::Tick_Mode0_Step0<false>;
+			m_ui64StepStart = 0;
+			m_ui8FrameStep = 0;
+			m_pftTick = &CApu2A0X::Tick_Cycle<false>;
 			m_bModeSwitch = false;
 			m_pPulse1.SetSeq( GetDuty( 0 ) );
 			m_pPulse2.SetSeq( GetDuty( 0 ) );
+
+			// The system resets the event queue first, so this cannot fail.
+			m_peqEvents->Cancel( FrameStep, this );
+			[[maybe_unused]] const bool bScheduled = ScheduleFrameStep();
+			assert( bScheduled );
 		}
 
 		/**
@@ -128,14 +138,8 @@ namespace lsn {
 					m_pbBus->SetReadFunc( uint16_t( I ), CCpuBus::NoRead, this, uint16_t( I ) );
 				}
 			}
-			// I/O registers normally disabled except in debug mode.
-			for ( uint32_t I = LSN_APU_IO_START; I < (LSN_APU_IO_START + LSN_APU_IO); ++I ) {
-				m_pbBus->SetReadFunc( uint16_t( I ), CCpuBus::NoRead, this, uint16_t( I ) );
-			}
-			// Unallocated space from 0x4020 to 0x40FF.
-			for ( uint32_t I = (LSN_APU_IO_START + LSN_APU_IO); I <= (LSN_APU_START + 0xFF); ++I ) {
-				m_pbBus->SetReadFunc( uint16_t( I ), CCpuBus::NoRead, this, uint16_t( I ) );
-			}
+			// I/O registers normally disabled except in debug mode, then unallocated space from 0x4020 to 0x40FF.
+			m_pbBus->SetReadRange( LSN_APU_IO_START, LSN_APU_START + 0x100, CCpuBus::NoRead, this, LSN_APU_IO_START );
 
 			m_pbBus->SetWriteFunc( 0x4000, Write4000, this, 0 );
 			m_pbBus->SetWriteFunc( 0x4002, Write4002, this, 0 );
@@ -156,6 +160,47 @@ namespace lsn {
 		 **/
 		bool											IsEvenCycle() const { return (m_ui64Cycles & 1) == 1; }
 
+		/**
+		 * Writes the APU state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 **/
+		bool											SaveState( CStream &_sStream ) const {
+			if ( !_sStream.WriteUi64( m_ui64Cycles ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64StepStart ) ) { return false; }
+			if ( !m_pPulse1.SaveState( _sStream ) ) { return false; }
+			if ( !m_pPulse2.SaveState( _sStream ) ) { return false; }
+			if ( !m_dvRegisters3_4017.SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteBytes( m_ui8Registers, sizeof( m_ui8Registers ) ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8FrameStep ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bModeSwitch ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the APU state from a stream previously written by SaveState().  The frame-counter step is rescheduled on the event queue, so
+		 *	the event queue must already be synchronized with the restored master counter.
+		 * 
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 **/
+		bool											LoadState( CStream &_sStream ) {
+			if ( !_sStream.ReadUi64( m_ui64Cycles ) ) { return false; }
+			if ( !_sStream.ReadUi64( m_ui64StepStart ) ) { return false; }
+			if ( !m_pPulse1.LoadState( _sStream ) ) { return false; }
+			if ( !m_pPulse2.LoadState( _sStream ) ) { return false; }
+			if ( !m_dvRegisters3_4017.LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_ui8Registers, sizeof( m_ui8Registers ) ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8FrameStep ) || m_ui8FrameStep >= 4 ) { return false; }
+			if ( !_sStream.ReadBool( m_bModeSwitch ) ) { return false; }
+			// The tick function alternates every cycle starting from Tick_Cycle<false> on cycle 0.
+			m_pftTick = (m_ui64Cycles & 1) ? &CApu2A0X::Tick_Cycle<true> : &CApu2A0X::Tick_Cycle<false>;
+
+			m_peqEvents->Cancel( FrameStep, this );
+			return ScheduleFrameStep();
+		}
+
 
 
 
@@ -168,10 +213,14 @@ namespace lsn {
 		// == Members.
 		/** The cycle counter. */
 		uint64_t										m_ui64Cycles;
-		/** The step cycle counter. */
-		uint64_t										m_ui64StepCycles;
+		/** The APU cycle on which the current frame-counter sequence started. */
+		uint64_t										m_ui64StepStart;
+		/** The master-clock divider for the APU. */
+		uint64_t										m_ui64ApuDiv;
 		/** The main bus. */
 		CCpuBus *										m_pbBus;
+		/** The system event queue, on which the frame-counter steps are scheduled. */
+		CEventQueue *									m_peqEvents;
 		/** The current cycle function. */
 		PfTicks											m_pftTick;
 		/** Pulse 1. */
@@ -182,129 +231,61 @@ namespace lsn {
 		DelayedVal										m_dvRegisters3_4017;
 		/** Non-delayed registers. */
 		uint8_t											m_ui8Registers[0x15+1];
+		/** The current frame-counter step. */
+		uint8_t											m_ui8FrameStep;
 		/** Set to true upon a write to $4017. */
 		bool											m_bModeSwitch;
 
 
 		// == Functions.
-		/** Mode-0 step-0 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode0_Step0() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM0S0 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step1<!_bEven>;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step0<!_bEven>;
-			}
-		}
-
-		/** Mode-0 step-1 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode0_Step1() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM0S1 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step2<!_bEven>;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step1<!_bEven>;
-			}
-		}
-
-		/** Mode-0 step-2 tick function. */
+		/** The per-cycle tick function.  The pulse timers tick every other cycle. */
 		template <bool _bEven>
-		void											Tick_Mode0_Step2() {
+		void											Tick_Cycle() {
 			LSN_APU_UPDATE;
 
-			if ( ++m_ui64StepCycles == _tM0S2 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step3<!_bEven>;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step2<!_bEven>;
-			}
+			m_pftTick = &CApu2A0X::Tick_Cycle<!_bEven>;
 		}
 
-		/** Mode-0 step-3 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode0_Step3() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM0S3_2 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step0<!_bEven>;
-				m_ui64StepCycles = 0;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode0_Step3<!_bEven>;
-			}
-		}
-
-
-		/** Mode-1 step-0 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode1_Step0() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM1S0 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step1<!_bEven>;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step0<!_bEven>;
-			}
-		}
-
-		/** Mode-1 step-1 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode1_Step1() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM1S1 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step2<!_bEven>;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step1<!_bEven>;
-			}
-		}
-
-		/** Mode-1 step-2 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode1_Step2() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM1S2 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step3<!_bEven>;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step2<!_bEven>;
+		/**
+		 * Gets the number of APU cycles from the start of the sequence to the end of the current frame-counter step.
+		 * 
+		 * \return Returns the cycle within the sequence on which the current step ends.
+		 **/
+		inline uint64_t									FrameStepEnd() const {
+			// Only the 4-step sequence is run until $4017 writes are acted upon.
+			switch ( m_ui8FrameStep ) {
+				case 0 : { return _tM0S0; }
+				case 1 : { return _tM0S1; }
+				case 2 : { return _tM0S2; }
+				default : { return _tM0S3_2; }
 			}
 		}
 
-		/** Mode-1 step-3 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode1_Step3() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM1S3 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step4<!_bEven>;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step3<!_bEven>;
-			}
+		/**
+		 * Schedules the end of the current frame-counter step on the event queue.  The event lands on the master cycle right after the APU
+		 *	tick that ends the step, so the frame counter costs nothing on the cycles in between.
+		 * 
+		 * \return Returns false if the event queue is full.
+		 **/
+		inline bool										ScheduleFrameStep() {
+			return m_peqEvents->Schedule( (m_ui64StepStart + FrameStepEnd()) * m_ui64ApuDiv + 1, FrameStep, this );
 		}
 
-		/** Mode-1 step-4 tick function. */
-		template <bool _bEven>
-		void											Tick_Mode1_Step4() {
-			LSN_APU_UPDATE;
-
-			if ( ++m_ui64StepCycles == _tM1S4_1 ) {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step0<!_bEven>;
-				m_ui64StepCycles = 0;
-			}
-			else {
-				m_pftTick = &CApu2A0X::Tick_Mode1_Step4<!_bEven>;
+		/**
+		 * The event callback for the end of a frame-counter step.
+		 * 
+		 * \param _pvParm A pointer to this APU object.
+		 * \param _ui64Time The master cycle on which the event was scheduled.
+		 **/
+		static void LSN_FASTCALL						FrameStep( void * _pvParm, uint64_t /*_ui64Time*/ ) {
+			CApu2A0X * paApu = reinterpret_cast<CApu2A0X *>(_pvParm);
+			if ( ++paApu->m_ui8FrameStep == 4 ) {
+				paApu->m_ui64StepStart += _tM0S3_2;
+				paApu->m_ui8FrameStep = 0;
 			}
+			// The queue removed this event before calling, so there is room for the next one.
+			[[maybe_unused]] const bool bScheduled = paApu->ScheduleFrameStep();
+			assert( bScheduled );
 		}
 
 		/**
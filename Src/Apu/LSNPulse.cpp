@@ -17,4 +17,27 @@ namespace lsn {
 	CPulse::~CPulse() {
 	}
 
+	// == Functions.
+	/**
+	 * Writes the pulse state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write.
+	 * \return Returns true if the state was written.
+	 **/
+	bool CPulse::SaveState( CStream &_sStream ) const {
+		if ( !CSequencer::SaveState( _sStream ) ) { return false; }
+		return _sStream.WriteUi64( m_ui64SeqOff );
+	}
+
+	/**
+	 * Reads the pulse state from a stream previously written by SaveState().
+	 * 
+	 * \param _sStream The stream from which to read.
+	 * \return Returns true if the state was read.
+	 **/
+	bool CPulse::LoadState( CStream &_sStream ) {
+		if ( !CSequencer::LoadState( _sStream ) ) { return false; }
+		return _sStream.ReadUi64( m_ui64SeqOff );
+	}
+
 }	// namespace lsn
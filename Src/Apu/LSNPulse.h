@@ -28,6 +28,24 @@ namespace lsn {
 		virtual ~CPulse();
 
 
+		// == Functions.
+		/**
+		 * Writes the pulse state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 **/
+		virtual bool							SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the pulse state from a stream previously written by SaveState().
+		 * 
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 **/
+		virtual bool							LoadState( CStream &_sStream );
+
+
 	protected :
 		// == Members.
 		/** The sequence offset. */
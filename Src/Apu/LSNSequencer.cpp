@@ -17,4 +17,33 @@ namespace lsn {
 	CSequencer::~CSequencer() {
 	}
 
+	// == Functions.
+	/**
+	 * Writes the sequencer state to a stream.
+	 * 
+	 * \param _sStream The stream to which to write.
+	 * \return Returns true if the state was written.
+	 **/
+	bool CSequencer::SaveState( CStream &_sStream ) const {
+		if ( !_sStream.WriteUi32( m_ui32Sequence ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16Timer ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16Reload ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8Out ) ) { return false; }
+		return true;
+	}
+
+	/**
+	 * Reads the sequencer state from a stream previously written by SaveState().
+	 * 
+	 * \param _sStream The stream from which to read.
+	 * \return Returns true if the state was read.
+	 **/
+	bool CSequencer::LoadState( CStream &_sStream ) {
+		if ( !_sStream.ReadUi32( m_ui32Sequence ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16Timer ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16Reload ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8Out ) ) { return false; }
+		return true;
+	}
+
 }	// namespace lsn
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
 
 
 namespace lsn {
@@ -58,6 +59,22 @@ namespace lsn {
 		 **/
 		inline uint16_t							SetTimerHigh( uint8_t _ui8Val );
 
+		/**
+		 * Writes the sequencer state to a stream.
+		 * 
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 **/
+		virtual bool							SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the sequencer state from a stream previously written by SaveState().
+		 * 
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 **/
+		virtual bool							LoadState( CStream &_sStream );
+
 
 	protected :
 		// == Members.
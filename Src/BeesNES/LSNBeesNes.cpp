@@ -23,6 +23,7 @@ namespace lsn {
 		m_pipPoller( _pipPoller ) {
 
 		std::memset( m_ui8RapidFires, 0, sizeof( m_ui8RapidFires ) );
+		m_imMovie.SetSource( m_pipPoller );
 		
 		//m_pfbFilterTable
 		CFilterBase * pfbTmp[CFilterBase::LSN_F_TOTAL][LSN_PM_CONSOLE_TOTAL] = {
@@ -165,8 +166,10 @@ namespace lsn {
 		m_cfartCurFilterAndTargets.ui32Width = m_cfartCurFilterAndTargets.pfbCurFilter->OutputWidth();
 		m_cfartCurFilterAndTargets.ui32Height = m_cfartCurFilterAndTargets.pfbCurFilter->OutputHeight();
 		m_cfartCurFilterAndTargets.ui32Stride = uint32_t( m_cfartCurFilterAndTargets.pfbCurFilter->OutputStride() );
-		m_cfartCurFilterAndTargets.ui64Frame = GetDisplayClient()->FrameCount();
-		m_cfartCurFilterAndTargets.ui64RenderStartCycle = GetDisplayClient()->GetRenderStartCycle();
+		// When running ahead, the frame may have been presented by a second system.
+		const CDisplayClient * pdcPresenter = m_raRunAhead.Presenter() ? m_raRunAhead.Presenter() : GetDisplayClient();
+		m_cfartCurFilterAndTargets.ui64Frame = pdcPresenter->FrameCount();
+		m_cfartCurFilterAndTargets.ui64RenderStartCycle = pdcPresenter->GetRenderStartCycle();
 		m_cfartCurFilterAndTargets.bDirty = true;
 		m_cfartCurFilterAndTargets.bMirrored = m_cfartCurFilterAndTargets.pfbCurFilter->FlipInput();
 
@@ -198,20 +201,73 @@ namespace lsn {
 			}
 			m_pnsSystem = m_psbSystems[m_pmSystem];
 			UpdateCurrentSystem();
+			m_rbRewind.Reset();
+			m_raRunAhead.Reset();
+			m_imMovie.Stop();
 			if ( m_pnsSystem->LoadRom( rTmp ) ) {
 				m_pnsSystem->ResetState( false );
+				SetRunAhead( m_oOptions.ui32RunAheadFrames, m_oOptions.bRunAheadSecondInstance );
 				return true;
 			}
 		}
 		return false;
 	}
 
+	/**
+	 * Steps the current system back 1 frame using the rewind buffer and runs it for 1 frame so that the restored frame is displayed.
+	 *	The real-time clock is resynchronized so that Tick() carries on from there.
+	 *
+	 * \return Returns false if there was nothing left to rewind.
+	 */
+	bool CBeesNes::RewindFrame() {
+		if ( !m_pnsSystem || !m_pnsSystem->IsRomLoaded() ) { return false; }
+		if ( !m_rbRewind.StepBack( (*m_pnsSystem), 1 ) ) { return false; }
+		m_pnsSystem->RunFrames( 1 );
+		m_pnsSystem->SyncRealTime();
+		return true;
+	}
+
+	/**
+	 * Sets the number of frames to run ahead and whether they run on a second system, and stores them in the options.  Call only
+	 *	while the emulation thread is stopped.
+	 *
+	 * \param _ui32Frames The number of frames to run ahead.  0 disables run-ahead.
+	 * \param _bSecondInstance If true, the extra frames are run on a second system instead of rolling the current system back.
+	 */
+	void CBeesNes::SetRunAhead( uint32_t _ui32Frames, bool _bSecondInstance ) {
+		m_oOptions.ui32RunAheadFrames = _ui32Frames;
+		m_oOptions.bRunAheadSecondInstance = _bSecondInstance;
+		m_raRunAhead.SetFrames( _ui32Frames );
+		if ( _ui32Frames && _bSecondInstance && m_pnsSystem->IsRomLoaded() ) {
+			if ( !m_raRunAhead.HasSecondInstance() ) {
+				m_raRunAhead.CreateSecondInstance( (*m_pnsSystem), m_pmSystem, m_pipPoller );
+			}
+		}
+		else {
+			m_raRunAhead.DestroySecondInstance();
+		}
+		// While running ahead, only the run-ahead frames are presented.
+		if ( GetDisplayClient() ) {
+			GetDisplayClient()->SetDisplayHost( _ui32Frames ? nullptr : m_pdhDisplayHost );
+		}
+	}
+
+	/**
+	 * Runs ahead of the current system and presents the last frame run.  Call once each time the current system finishes a frame.
+	 *
+	 * \return Returns true if a frame was presented.
+	 */
+	bool CBeesNes::RunAheadFrame() {
+		if ( !m_pnsSystem ) { return false; }
+		return m_raRunAhead.Run( (*m_pnsSystem), m_pdhDisplayHost );
+	}
+
 	/**
 	 * Updates the current system with render information, display hosts, etc.
 	 */
 	void CBeesNes::UpdateCurrentSystem() {
 		if ( !GetDisplayClient() ) { return; }
-		GetDisplayClient()->SetDisplayHost( m_pdhDisplayHost );
+		GetDisplayClient()->SetDisplayHost( m_raRunAhead.Frames() ? nullptr : m_pdhDisplayHost );
 
 		// Set ratios.
 		m_dRatioActual = GetDisplayClient()->DisplayRatio();
@@ -237,7 +293,7 @@ namespace lsn {
 		GetDisplayClient()->SetRenderTarget( m_cfartCurFilterAndTargets.pfbCurFilter->CurTarget(), m_cfartCurFilterAndTargets.pfbCurFilter->OutputStride(), m_cfartCurFilterAndTargets.pfbCurFilter->InputFormat(), m_cfartCurFilterAndTargets.pfbCurFilter->FlipInput() );
 
 		// Set up input.
-		m_pnsSystem->SetInputPoller( m_pipPoller );
+		m_pnsSystem->SetInputPoller( &m_imMovie );
 	}
 
 	/**
@@ -252,6 +308,10 @@ namespace lsn {
 		if ( !_sFile.ReadUi32( ui32Version ) ) { return false; }
 
 		if ( !LoadInputSettings( ui32Version, _sFile, m_oOptions.ioGlobalInputOptions ) ) { return false; }
+		if ( ui32Version >= 1 ) {
+			if ( !_sFile.ReadUi32( m_oOptions.ui32RunAheadFrames ) ) { return false; }
+			if ( !_sFile.ReadBool( m_oOptions.bRunAheadSecondInstance ) ) { return false; }
+		}
 		return true;
 	}
 
@@ -264,6 +324,8 @@ namespace lsn {
 	bool CBeesNes::SaveSettings( CStream &_sFile ) {
 		if ( !_sFile.WriteUi32( LSN_BEESNES_SETTINGS_VERSION ) ) { return false; }
 		if ( !SaveInputSettings( _sFile, m_oOptions.ioGlobalInputOptions ) ) { return false; }
+		if ( !_sFile.WriteUi32( m_oOptions.ui32RunAheadFrames ) ) { return false; }
+		if ( !_sFile.WriteBool( m_oOptions.bRunAheadSecondInstance ) ) { return false; }
 		return true;
 	}
 
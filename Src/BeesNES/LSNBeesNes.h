@@ -19,11 +19,14 @@
 #include "../Filters/LSNPalCrtFullFilter.h"
 #include "../Filters/LSNRgb24Filter.h"
 #include "../Filters/LSNSrgbPostProcess.h"
+#include "../Input/LSNInputMovie.h"
 #include "../Options/LSNOptions.h"
+#include "../System/LSNRewindBuffer.h"
+#include "../System/LSNRunAhead.h"
 #include "../System/LSNSystem.h"
 #include "../Utilities/LSNStream.h"
 
-#define LSN_BEESNES_SETTINGS_VERSION			0
+#define LSN_BEESNES_SETTINGS_VERSION			1
 
 namespace lsn {
 
@@ -193,6 +196,52 @@ namespace lsn {
 		 */
 		const CSystemBase *						GetSystem() const { return m_pnsSystem; }
 
+		/**
+		 * Gets the rewind buffer.
+		 *
+		 * \return Returns a reference to the rewind buffer.
+		 */
+		CRewindBuffer &							Rewind() { return m_rbRewind; }
+
+		/**
+		 * Steps the current system back 1 frame using the rewind buffer and runs it for 1 frame so that the restored frame is displayed.
+		 *	The real-time clock is resynchronized so that Tick() carries on from there.
+		 *
+		 * \return Returns false if there was nothing left to rewind.
+		 */
+		bool									RewindFrame();
+
+		/**
+		 * Gets the run-ahead state.
+		 *
+		 * \return Returns a reference to the run-ahead state.
+		 */
+		const CRunAhead &						RunAhead() const { return m_raRunAhead; }
+
+		/**
+		 * Sets the number of frames to run ahead and whether they run on a second system, and stores them in the options.  Call only
+		 *	while the emulation thread is stopped.
+		 *
+		 * \param _ui32Frames The number of frames to run ahead.  0 disables run-ahead.
+		 * \param _bSecondInstance If true, the extra frames are run on a second system instead of rolling the current system back.
+		 */
+		void									SetRunAhead( uint32_t _ui32Frames, bool _bSecondInstance );
+
+		/**
+		 * Runs ahead of the current system and presents the last frame run.  Call once each time the current system finishes a frame.
+		 *
+		 * \return Returns true if a frame was presented.
+		 */
+		bool									RunAheadFrame();
+
+		/**
+		 * Gets the input movie.  It sits between the input poller and the current system and passes input through when it is neither
+		 *	recording nor playing back.
+		 *
+		 * \return Returns a reference to the input movie.
+		 */
+		CInputMovie &							Movie() { return m_imMovie; }
+
 		/**
 		 * Gets the current render information.
 		 *
@@ -311,6 +360,12 @@ namespace lsn {
 		uint8_t									m_ui8RapidFires[8];
 		/** The emulation options. */
 		LSN_OPTIONS								m_oOptions;
+		/** The rewind buffer. */
+		CRewindBuffer							m_rbRewind;
+		/** Run-ahead. */
+		CRunAhead								m_raRunAhead;
+		/** The input movie. */
+		CInputMovie								m_imMovie;
 
 
 		// == Functions.
@@ -28,6 +28,14 @@
  *	would have been served by virtual functions.  Ultiately, memory access can be made into an
  *	entirely branchless system.
  *
+ * The per-address table is large (one LSN_ADDR_ACCESSOR per address), so a 256-entry page table sits
+ *	in front of it.  Pages that are plain memory (every address uses StdRead()/StdWrite() on consecutive
+ *	bytes of bus memory, or a page mapped directly with SetDirectReadPage()) hold a data pointer and
+ *	are accessed inline.  Only I/O and other special pages fall back to the per-address functions.
+ *
+ * Defining LSN_BUS_HISTOGRAM builds the bus with per-page access counters (see PageCounts()), which
+ *	split every read and write into page-table, StdRead()/StdWrite(), and other-handler accesses.
+ *
  * An outward-facing design decision is to have the entire block of system RAM contiguous in memory
  *	here to make it easier to parse by external readers (IE an external debugger).
  *
@@ -39,6 +47,8 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "../Utilities/LSNStream.h"
+#include <bit>
 
 #ifdef LSN_CPU_VERIFY
 #include <vector>
@@ -75,6 +85,11 @@ namespace lsn {
 	 *	would have been served by virtual functions.  Ultiately, memory access can be made into an
 	 *	entirely branchless system.
 	 *
+	 * The per-address table is large (one LSN_ADDR_ACCESSOR per address), so a 256-entry page table sits
+	 *	in front of it.  Pages that are plain memory (every address uses StdRead()/StdWrite() on consecutive
+	 *	bytes of bus memory, or a page mapped directly with SetDirectReadPage()) hold a data pointer and
+	 *	are accessed inline.  Only I/O and other special pages fall back to the per-address functions.
+	 *
 	 * An outward-facing design decision is to have the entire block of system RAM contiguous in memory
 	 *	here to make it easier to parse by external readers (IE an external debugger).
 	 *
@@ -86,13 +101,34 @@ namespace lsn {
 	public :
 		// == Various constructors.
 		CBus() :
-			m_ui8LastRead( 0 ) {
+			m_ui8LastRead( 0 ),
+#ifdef LSN_CPU_FAST_PATH_CHECK
+			m_ui64HandlerAccesses( 0 ),
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+			m_bFastPages( true ) {
+			MarkAllDirty();
+			std::memset( m_pPages, 0, sizeof( m_pPages ) );
+			std::memset( m_pui8DirectRead, 0, sizeof( m_pui8DirectRead ) );
+			std::memset( m_ui64PendingPages, 0, sizeof( m_ui64PendingPages ) );
+#ifdef LSN_BUS_HISTOGRAM
+			ResetPageCounts();
+#endif	// #ifdef LSN_BUS_HISTOGRAM
 		}
 		~CBus() {
 			ResetToKnown();
 		}
 
 
+		// == Enumerations.
+		/** Dirty-page tracking. */
+		enum LSN_BUS_PAGES : size_t {
+			LSN_BP_PAGE_SHIFT				= 8,												/**< Pages are 256 bytes. */
+			LSN_BP_PAGE_SIZE				= size_t( 1 ) << LSN_BP_PAGE_SHIFT,					/**< The size of a page in bytes. */
+			LSN_BP_PAGES					= _uSize / LSN_BP_PAGE_SIZE,						/**< The number of pages on the bus. */
+			LSN_BP_WORDS					= (LSN_BP_PAGES + 63) / 64,							/**< The number of 64-bit words in the dirty-page bitmap. */
+		};
+
+
 		// == Types.
 		/** An address-reading function. */
 		typedef void (LSN_FASTCALL *		PfReadFunc)( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t &_ui8Ret );
@@ -110,6 +146,34 @@ namespace lsn {
 			uint16_t						ui16WriterParm1;				/**< The writer's second parameter. */
 		};
 
+		/** A page-table entry.  A nullptr means the page goes through the per-address functions. */
+		struct LSN_PAGE {
+			const uint8_t *					pui8Read;						/**< Reads from the page are direct loads from pui8Read[_ui16Addr&0xFF]. */
+			uint8_t *						pui8Write;						/**< Writes to the page are direct stores to pui8Write[_ui16Addr&0xFF], which always points into bus memory. */
+		};
+
+		/** The memory followed by its dirty-page bitmap.  Access functions are given a pointer to ui8Ram, through which MarkDirty() finds the bitmap. */
+		struct LSN_MEMORY {
+			uint8_t							ui8Ram[_uSize];					/**< Memory of _uSize bytes. */
+			uint64_t						ui64Dirty[LSN_BP_WORDS];		/**< 1 bit per page, set when the page is written. */
+		};
+
+		/** Access counters for 1 page.  Only counted if LSN_BUS_HISTOGRAM is defined. */
+		struct LSN_PAGE_COUNTS {
+			uint64_t						ui64Reads;						/**< All reads. */
+			uint64_t						ui64Writes;						/**< All writes. */
+			uint64_t						ui64DirectReads;				/**< Reads through the page table. */
+			uint64_t						ui64DirectWrites;				/**< Writes through the page table. */
+			uint64_t						ui64StdReads;					/**< Reads through StdRead().  The rest went through other handlers. */
+			uint64_t						ui64StdWrites;					/**< Writes through StdWrite().  The rest went through other handlers. */
+		};
+
+		/** A copy of the access functions of every address, taken by SaveMap() and put back by RestoreMap(). */
+		struct LSN_MAP {
+			LSN_ADDR_ACCESSOR				aaAccessors[_uSize];			/**< The access functions. */
+			const uint8_t *					pui8DirectRead[LSN_BP_PAGES];	/**< The pages mapped by SetDirectReadPage(). */
+		};
+
 		/** A trampoline is a read/write function that has been inserted to perform its own operation at a given address and then optionally call the original read/write function for that address. */
 		struct LSN_TRAMPOLINE {
 			void *							pvReaderParm0;					/**< The trampoline reader's first parameter. */
@@ -124,8 +188,9 @@ namespace lsn {
 		 */
 		void								ResetToKnown() {
 			ResetAnalog();
-			std::memset( m_ui8Ram, 0, sizeof( m_ui8Ram ) );
+			std::memset( m_mMemory.ui8Ram, 0, sizeof( m_mMemory.ui8Ram ) );
 			m_ui8LastRead = 0;
+			MarkAllDirty();
 		}
 
 		/**
@@ -138,10 +203,8 @@ namespace lsn {
 		 * Applies the default map to the memory.
 		 */
 		void								ApplyMap() {
-			for ( auto I = Size(); I--; ) {
-				SetReadFunc( uint16_t( I ), StdRead, nullptr, uint16_t( I ) );
-				SetWriteFunc( uint16_t( I ), StdWrite, nullptr, uint16_t( I ) );
-			}
+			SetReadRange( 0, Size(), StdRead, nullptr, 0 );
+			SetWriteRange( 0, Size(), StdWrite, nullptr, 0 );
 #ifdef LSN_CPU_VERIFY
 			m_vReadWriteLog.clear();
 #endif	// #ifdef LSN_CPU_VERIFY
@@ -154,17 +217,29 @@ namespace lsn {
 		 * \return Returns the requested value.
 		 */
 		inline uint8_t						Read( uint16_t _ui16Addr ) {
-			if constexpr ( _uSize == 0x10000 ) {
-				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr];
-				aaAcc.pfReader( aaAcc.pvReaderParm0,
-					aaAcc.ui16ReaderParm1,
-					m_ui8Ram, m_ui8LastRead );
+			const uint16_t ui16Addr = (_uSize == 0x10000) ? _ui16Addr : uint16_t( _ui16Addr & (_uSize - 1) );
+			const LSN_PAGE & pPage = m_pPages[ui16Addr>>LSN_BP_PAGE_SHIFT];
+#ifdef LSN_BUS_HISTOGRAM
+			LSN_PAGE_COUNTS & pcCounts = m_pcCounts[ui16Addr>>LSN_BP_PAGE_SHIFT];
+			++pcCounts.ui64Reads;
+#endif	// #ifdef LSN_BUS_HISTOGRAM
+			if ( pPage.pui8Read ) {
+				m_ui8LastRead = pPage.pui8Read[ui16Addr&(LSN_BP_PAGE_SIZE-1)];
+#ifdef LSN_BUS_HISTOGRAM
+				++pcCounts.ui64DirectReads;
+#endif	// #ifdef LSN_BUS_HISTOGRAM
 			}
 			else {
-				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr&(_uSize-1)];
+				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[ui16Addr];
+#ifdef LSN_BUS_HISTOGRAM
+				pcCounts.ui64StdReads += aaAcc.pfReader == StdRead;
+#endif	// #ifdef LSN_BUS_HISTOGRAM
+#ifdef LSN_CPU_FAST_PATH_CHECK
+				++m_ui64HandlerAccesses;
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
 				aaAcc.pfReader( aaAcc.pvReaderParm0,
 					aaAcc.ui16ReaderParm1,
-					m_ui8Ram, m_ui8LastRead );
+					m_mMemory.ui8Ram, m_ui8LastRead );
 			}
 #ifdef LSN_CPU_VERIFY
 			m_vReadWriteLog.push_back( { .ui16Address = _ui16Addr, .ui8Value = m_ui8LastRead, .bRead = true } );
@@ -179,17 +254,32 @@ namespace lsn {
 		 * \param _ui8Val The value to write.
 		 */
 		inline void							Write( uint16_t _ui16Addr, uint8_t _ui8Val ) {
-			if constexpr ( _uSize == 0x10000 ) {
-				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr];
-				aaAcc.pfWriter( aaAcc.pvWriterParm0,
-					aaAcc.ui16WriterParm1,
-					m_ui8Ram, _ui8Val );
+			const uint16_t ui16Addr = (_uSize == 0x10000) ? _ui16Addr : uint16_t( _ui16Addr & (_uSize - 1) );
+			const LSN_PAGE & pPage = m_pPages[ui16Addr>>LSN_BP_PAGE_SHIFT];
+#ifdef LSN_BUS_HISTOGRAM
+			LSN_PAGE_COUNTS & pcCounts = m_pcCounts[ui16Addr>>LSN_BP_PAGE_SHIFT];
+			++pcCounts.ui64Writes;
+#endif	// #ifdef LSN_BUS_HISTOGRAM
+			if ( pPage.pui8Write ) {
+				uint8_t * pui8Dst = pPage.pui8Write + (ui16Addr & (LSN_BP_PAGE_SIZE - 1));
+				(*pui8Dst) = _ui8Val;
+				const size_t stPage = size_t( pui8Dst - m_mMemory.ui8Ram ) >> LSN_BP_PAGE_SHIFT;
+				m_mMemory.ui64Dirty[stPage>>6] |= 1ULL << (stPage & 63);
+#ifdef LSN_BUS_HISTOGRAM
+				++pcCounts.ui64DirectWrites;
+#endif	// #ifdef LSN_BUS_HISTOGRAM
 			}
 			else {
-				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[_ui16Addr&(_uSize-1)];
+				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[ui16Addr];
+#ifdef LSN_BUS_HISTOGRAM
+				pcCounts.ui64StdWrites += aaAcc.pfWriter == StdWrite;
+#endif	// #ifdef LSN_BUS_HISTOGRAM
+#ifdef LSN_CPU_FAST_PATH_CHECK
+				++m_ui64HandlerAccesses;
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
 				aaAcc.pfWriter( aaAcc.pvWriterParm0,
 					aaAcc.ui16WriterParm1,
-					m_ui8Ram, _ui8Val );
+					m_mMemory.ui8Ram, _ui8Val );
 			}
 #ifdef LSN_CPU_VERIFY
 			m_vReadWriteLog.push_back( { .ui16Address = _ui16Addr, .ui8Value = _ui8Val, .bRead = false } );
@@ -233,6 +323,8 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfReader = _pfReadFunc;
 				m_aaAccessors[_ui16Address].pvReaderParm0 = _pvParm0;
 				m_aaAccessors[_ui16Address].ui16ReaderParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
+				m_pui8DirectRead[_ui16Address>>LSN_BP_PAGE_SHIFT] = nullptr;
 			}
 		}
 
@@ -249,9 +341,97 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfWriter = _pfWriteFunc;
 				m_aaAccessors[_ui16Address].pvWriterParm0 = _pvParm0;
 				m_aaAccessors[_ui16Address].ui16WriterParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
+			}
+		}
+
+		/**
+		 * Sets the read function for a range of addresses.  Address _ui32Start + N * _ui32Step is given the parameter
+		 *	_ui16Parm1 + (_ui32Mirror ? N % _ui32Mirror : N) * _ui16Parm1Step.  Each page in the range is invalidated once rather than once
+		 *	per address.
+		 *
+		 * \param _ui32Start The first address to assign the read function.
+		 * \param _ui32End The address after the last address to assign the read function.
+		 * \param _pfReadFunc The function to assign to the addresses.
+		 * \param _pvParm0 A data value assigned to the addresses.
+		 * \param _ui16Parm1 The 16-bit parameter assigned to the first address.
+		 * \param _ui16Parm1Step The amount added to the 16-bit parameter for each following address.  0 gives every address the same parameter.
+		 * \param _ui32Mirror If not 0, the 16-bit parameter wraps back to _ui16Parm1 every this many addresses.
+		 * \param _ui32Step The distance between addresses.
+		 */
+		void								SetReadRange( uint32_t _ui32Start, uint32_t _ui32End, PfReadFunc _pfReadFunc, void * _pvParm0, uint16_t _ui16Parm1,
+			uint16_t _ui16Parm1Step = 1, uint32_t _ui32Mirror = 0, uint32_t _ui32Step = 1 ) {
+			if ( _ui32End > Size() ) { _ui32End = Size(); }
+			if ( _ui32Start >= _ui32End ) { return; }
+			uint32_t ui32Index = 0;
+			for ( uint32_t I = _ui32Start; I < _ui32End; I += _ui32Step, ++ui32Index ) {
+				if ( ui32Index == _ui32Mirror ) { ui32Index = 0; }
+				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[I];
+				aaAcc.pfReader = _pfReadFunc;
+				aaAcc.pvReaderParm0 = _pvParm0;
+				aaAcc.ui16ReaderParm1 = uint16_t( _ui16Parm1 + ui32Index * _ui16Parm1Step );
+			}
+			InvalidatePages( _ui32Start, _ui32End );
+			for ( uint32_t I = _ui32Start >> LSN_BP_PAGE_SHIFT; I <= ((_ui32End - 1) >> LSN_BP_PAGE_SHIFT); ++I ) {
+				m_pui8DirectRead[I] = nullptr;
 			}
 		}
 
+		/**
+		 * Sets the write function for a range of addresses.  Address _ui32Start + N * _ui32Step is given the parameter
+		 *	_ui16Parm1 + (_ui32Mirror ? N % _ui32Mirror : N) * _ui16Parm1Step.  Each page in the range is invalidated once rather than once
+		 *	per address.
+		 *
+		 * \param _ui32Start The first address to assign the write function.
+		 * \param _ui32End The address after the last address to assign the write function.
+		 * \param _pfWriteFunc The function to assign to the addresses.
+		 * \param _pvParm0 A data value assigned to the addresses.
+		 * \param _ui16Parm1 The 16-bit parameter assigned to the first address.
+		 * \param _ui16Parm1Step The amount added to the 16-bit parameter for each following address.  0 gives every address the same parameter.
+		 * \param _ui32Mirror If not 0, the 16-bit parameter wraps back to _ui16Parm1 every this many addresses.
+		 * \param _ui32Step The distance between addresses.
+		 */
+		void								SetWriteRange( uint32_t _ui32Start, uint32_t _ui32End, PfWriteFunc _pfWriteFunc, void * _pvParm0, uint16_t _ui16Parm1,
+			uint16_t _ui16Parm1Step = 1, uint32_t _ui32Mirror = 0, uint32_t _ui32Step = 1 ) {
+			if ( _ui32End > Size() ) { _ui32End = Size(); }
+			if ( _ui32Start >= _ui32End ) { return; }
+			uint32_t ui32Index = 0;
+			for ( uint32_t I = _ui32Start; I < _ui32End; I += _ui32Step, ++ui32Index ) {
+				if ( ui32Index == _ui32Mirror ) { ui32Index = 0; }
+				LSN_ADDR_ACCESSOR & aaAcc = m_aaAccessors[I];
+				aaAcc.pfWriter = _pfWriteFunc;
+				aaAcc.pvWriterParm0 = _pvParm0;
+				aaAcc.ui16WriterParm1 = uint16_t( _ui16Parm1 + ui32Index * _ui16Parm1Step );
+			}
+			InvalidatePages( _ui32Start, _ui32End );
+		}
+
+		/**
+		 * Copies the access functions of every address and the direct-read pages.
+		 *
+		 * \param _mMap Holds the returned copy.
+		 */
+		void								SaveMap( LSN_MAP &_mMap ) const {
+			std::memcpy( _mMap.aaAccessors, m_aaAccessors, sizeof( m_aaAccessors ) );
+			std::memcpy( _mMap.pui8DirectRead, m_pui8DirectRead, sizeof( m_pui8DirectRead ) );
+		}
+
+		/**
+		 * Puts back the access functions and direct-read pages previously copied by SaveMap().  Every page is rebuilt by the next
+		 *	UpdatePageTable().
+		 *
+		 * \param _mMap The copy to put back.
+		 */
+		void								RestoreMap( const LSN_MAP &_mMap ) {
+			std::memcpy( m_aaAccessors, _mMap.aaAccessors, sizeof( m_aaAccessors ) );
+			std::memcpy( m_pui8DirectRead, _mMap.pui8DirectRead, sizeof( m_pui8DirectRead ) );
+			std::memset( m_pPages, 0, sizeof( m_pPages ) );
+			MarkAllPagesPending();
+#ifdef LSN_CPU_VERIFY
+			m_vReadWriteLog.clear();
+#endif	// #ifdef LSN_CPU_VERIFY
+		}
+
 		/**
 		 * Inserts a read trampoline function for a given address.  The read function's _pvParm0 value will be a pointer to the trampoline.  reinterpret_cast<LSN_TRAMPOLINE *>(_pvParm0)->pvReaderParm0 holds the "_pvParm0" value passed here.
 		 *
@@ -270,6 +450,8 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfReader = _pfReadFunc;
 				m_aaAccessors[_ui16Address].pvReaderParm0 = _ptTrampoline;
 				m_aaAccessors[_ui16Address].ui16ReaderParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
+				m_pui8DirectRead[_ui16Address>>LSN_BP_PAGE_SHIFT] = nullptr;
 			}
 		}
 
@@ -291,9 +473,196 @@ namespace lsn {
 				m_aaAccessors[_ui16Address].pfWriter = _pfWriteFunc;
 				m_aaAccessors[_ui16Address].pvWriterParm0 = _ptTrampoline;
 				m_aaAccessors[_ui16Address].ui16WriterParm1 = _ui16Parm1;
+				InvalidatePage( _ui16Address );
+			}
+		}
+
+		/**
+		 * Maps a page directly to 256 bytes that can be read without side effects, such as a bank of PRG ROM.  Reads from the page then
+		 *	bypass the per-address read functions.  Those functions must already be set, since a later SetReadFunc() or
+		 *	SetTrampolineReadFunc() on any address in the page removes the direct mapping again.  Takes effect immediately.
+		 *
+		 * \param _ui16Page The page index (the address >> 8).
+		 * \param _pui8Data The 256 bytes to which to map the page, or nullptr to go back to the per-address read functions.
+		 */
+		void								SetDirectReadPage( uint16_t _ui16Page, const uint8_t * _pui8Data ) {
+			if ( _ui16Page < LSN_BP_PAGES ) {
+				m_pui8DirectRead[_ui16Page] = _pui8Data;
+				if ( m_bFastPages ) {
+					m_pPages[_ui16Page].pui8Read = _pui8Data;
+				}
+				if ( !_pui8Data ) {
+					m_ui64PendingPages[_ui16Page>>6] |= 1ULL << (_ui16Page & 63);
+				}
 			}
 		}
 
+		/**
+		 * Gets the 256 bytes to which a page was mapped by SetDirectReadPage().
+		 *
+		 * \param _ui16Page The page index (the address >> 8).
+		 * \return Returns the page's direct-read memory, or nullptr if the page goes through the per-address read functions.
+		 */
+		inline const uint8_t *				DirectReadPage( uint16_t _ui16Page ) const { return _ui16Page < LSN_BP_PAGES ? m_pui8DirectRead[_ui16Page] : nullptr; }
+
+		/**
+		 * Determines whether reads from an address go through the page table.  Such reads have no side effects, so no other component
+		 *	needs to be caught up before them.
+		 *
+		 * \param _ui16Addr The address to check.
+		 * \return Returns true if reads from the address are direct loads.
+		 */
+		inline bool							IsDirectRead( uint16_t _ui16Addr ) const {
+			const uint16_t ui16Addr = (_uSize == 0x10000) ? _ui16Addr : uint16_t( _ui16Addr & (_uSize - 1) );
+			return m_pPages[ui16Addr>>LSN_BP_PAGE_SHIFT].pui8Read != nullptr;
+		}
+
+		/**
+		 * Determines whether writes to an address go through the page table.  Such writes only store to bus memory.
+		 *
+		 * \param _ui16Addr The address to check.
+		 * \return Returns true if writes to the address are direct stores.
+		 */
+		inline bool							IsDirectWrite( uint16_t _ui16Addr ) const {
+			const uint16_t ui16Addr = (_uSize == 0x10000) ? _ui16Addr : uint16_t( _ui16Addr & (_uSize - 1) );
+			return m_pPages[ui16Addr>>LSN_BP_PAGE_SHIFT].pui8Write != nullptr;
+		}
+
+		/**
+		 * Reads an address through the page table without updating the floating value or any counters.  The address must be
+		 *	IsDirectRead().
+		 *
+		 * \param _ui16Addr The address to read.
+		 * \return Returns the value at the address.
+		 */
+		inline uint8_t						PeekDirect( uint16_t _ui16Addr ) const {
+			const uint16_t ui16Addr = (_uSize == 0x10000) ? _ui16Addr : uint16_t( _ui16Addr & (_uSize - 1) );
+			return m_pPages[ui16Addr>>LSN_BP_PAGE_SHIFT].pui8Read[ui16Addr&(LSN_BP_PAGE_SIZE-1)];
+		}
+
+		/**
+		 * Gets the memory through which reads of a page go.  The pointer changes whenever different memory (such as another PRG bank)
+		 *	is mapped into the page.
+		 *
+		 * \param _ui16Page The page index.
+		 * \return Returns the 256 bytes read by the page, or nullptr if reads of the page go through the per-address functions.
+		 */
+		inline const uint8_t *				PageTableRead( uint16_t _ui16Page ) const { return _ui16Page < LSN_BP_PAGES ? m_pPages[_ui16Page].pui8Read : nullptr; }
+
+		/**
+		 * Gets the page table.  Code that reads and writes through it directly must do everything Read() and Write() do for direct pages.
+		 *
+		 * \return Returns the LSN_BP_PAGES page-table entries.
+		 */
+		inline const LSN_PAGE *				PageTable() const { return m_pPages; }
+
+		/**
+		 * Gets the bus memory, into which every direct-write pointer points.
+		 *
+		 * \return Returns the bus memory.
+		 */
+		inline const uint8_t *				Memory() const { return m_mMemory.ui8Ram; }
+
+		/**
+		 * Gets the bitmap of dirty pages of the bus memory, 1 bit per page.
+		 *
+		 * \return Returns the dirty-page bitmap.
+		 */
+		inline uint64_t *					DirtyPages() { return m_mMemory.ui64Dirty; }
+
+#ifdef LSN_CPU_FAST_PATH_CHECK
+		/**
+		 * Gets the number of reads and writes that went through the per-address functions rather than the page table.  The CPU checks
+		 *	that this does not change while it runs an instruction in 1 call.
+		 *
+		 * \return Returns the number of reads and writes that went through the per-address functions.
+		 */
+		inline uint64_t						HandlerAccesses() const { return m_ui64HandlerAccesses; }
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+
+		/**
+		 * Gets the per-page access counters, 1 per page (LSN_BP_PAGES in total).  Counted from construction or the last ResetPageCounts().
+		 *
+		 * \return Returns the per-page access counters, or nullptr if the bus was built without LSN_BUS_HISTOGRAM.
+		 */
+		inline const LSN_PAGE_COUNTS *		PageCounts() const {
+#ifdef LSN_BUS_HISTOGRAM
+			return m_pcCounts;
+#else
+			return nullptr;
+#endif	// #ifdef LSN_BUS_HISTOGRAM
+		}
+
+		/**
+		 * Zeroes the per-page access counters.
+		 */
+		inline void							ResetPageCounts() {
+#ifdef LSN_BUS_HISTOGRAM
+			std::memset( m_pcCounts, 0, sizeof( m_pcCounts ) );
+#endif	// #ifdef LSN_BUS_HISTOGRAM
+		}
+
+		/**
+		 * Rebuilds the page-table entries of every page whose access functions have changed since the last call.  A page whose every
+		 *	address uses StdRead() (or StdWrite()) on consecutive bytes of bus memory is accessed directly.  Call after changing the memory
+		 *	map; until then the changed pages go through their per-address functions, which is always correct, only slower.
+		 */
+		void								UpdatePageTable() {
+			if ( !m_bFastPages ) { return; }
+			for ( size_t I = 0; I < LSN_BP_WORDS; ++I ) {
+				for ( uint64_t ui64Bits = m_ui64PendingPages[I]; ui64Bits; ui64Bits &= ui64Bits - 1 ) {
+					UpdatePage( I * 64 + size_t( std::countr_zero( ui64Bits ) ) );
+				}
+				m_ui64PendingPages[I] = 0;
+			}
+		}
+
+		/**
+		 * Enables or disables the page table.  When disabled, every access goes through the per-address functions.  Used to measure the
+		 *	page table.
+		 *
+		 * \param _bEnable If true, plain-memory pages are accessed directly.
+		 */
+		void								SetFastPages( bool _bEnable ) {
+			m_bFastPages = _bEnable;
+			std::memset( m_pPages, 0, sizeof( m_pPages ) );
+			MarkAllPagesPending();
+			UpdatePageTable();
+		}
+
+		/**
+		 * Determines whether the page table is enabled.
+		 *
+		 * \return Returns true if plain-memory pages are accessed directly.
+		 */
+		inline bool							FastPages() const { return m_bFastPages; }
+
+		/**
+		 * Gets the number of pages that are read directly.
+		 *
+		 * \return Returns the number of pages whose reads bypass the per-address functions.
+		 */
+		size_t								FastReadPageCount() const {
+			size_t stCount = 0;
+			for ( size_t I = 0; I < LSN_BP_PAGES; ++I ) {
+				stCount += m_pPages[I].pui8Read != nullptr;
+			}
+			return stCount;
+		}
+
+		/**
+		 * Gets the number of pages that are written directly.
+		 *
+		 * \return Returns the number of pages whose writes bypass the per-address functions.
+		 */
+		size_t								FastWritePageCount() const {
+			size_t stCount = 0;
+			for ( size_t I = 0; I < LSN_BP_PAGES; ++I ) {
+				stCount += m_pPages[I].pui8Write != nullptr;
+			}
+			return stCount;
+		}
+
 		/**
 		 * Copy data to the bus.
 		 *
@@ -305,7 +674,10 @@ namespace lsn {
 			if ( _ui16Address < Size() ) {
 				size_t stEnd = _ui32Size + size_t( _ui16Address );
 				if ( stEnd > Size() ) { stEnd = Size(); }
-				std::memcpy( &m_ui8Ram[_ui16Address], _pui8Data, stEnd - _ui16Address );
+				std::memcpy( &m_mMemory.ui8Ram[_ui16Address], _pui8Data, stEnd - _ui16Address );
+				for ( size_t I = _ui16Address >> LSN_BP_PAGE_SHIFT; I <= ((stEnd - 1) >> LSN_BP_PAGE_SHIFT); ++I ) {
+					m_mMemory.ui64Dirty[I>>6] |= 1ULL << (I & 63);
+				}
 			}
 		}
 
@@ -316,7 +688,7 @@ namespace lsn {
 		 * \return Returns the value at the given address, bypassing normal bus access routines.
 		 */
 		inline uint8_t						DBG_Inspect( uint16_t _ui16Address ) {
-			return m_ui8Ram[_ui16Address];
+			return m_mMemory.ui8Ram[_ui16Address];
 		}
 
 		/**
@@ -326,8 +698,119 @@ namespace lsn {
 		 */
 		void								DGB_FillMemory( uint8_t _ui8Val ) {
 			for ( auto I = _uSize; I--; ) {
-				m_ui8Ram[I] = _ui8Val;
+				m_mMemory.ui8Ram[I] = _ui8Val;
 			}
+			MarkAllDirty();
+		}
+
+		/**
+		 * Writes the memory and the floating value to a stream.  The access functions are not saved; they are part of the memory map.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		inline bool							SaveState( CStream &_sStream ) const {
+			return _sStream.WriteBytes( m_mMemory.ui8Ram, _uSize ) && _sStream.WriteUi8( m_ui8LastRead );
+		}
+
+		/**
+		 * Reads the memory and the floating value from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		inline bool							LoadState( CStream &_sStream ) {
+			MarkAllDirty();
+			return _sStream.ReadBytes( m_mMemory.ui8Ram, _uSize ) && _sStream.ReadUi8( m_ui8LastRead );
+		}
+
+		/**
+		 * Marks the page containing the given offset as dirty.  Access functions that write to _pui8Data must call this (StdWrite() does).
+		 *
+		 * \param _pui8Data The memory pointer passed to the access function.
+		 * \param _ui16Offset The offset within _pui8Data that was written.
+		 */
+		static inline void					MarkDirty( uint8_t * _pui8Data, uint16_t _ui16Offset ) {
+			const size_t stPage = size_t( _ui16Offset & (_uSize - 1) ) >> LSN_BP_PAGE_SHIFT;
+			reinterpret_cast<LSN_MEMORY *>(_pui8Data)->ui64Dirty[stPage>>6] |= 1ULL << (stPage & 63);
+		}
+
+		/**
+		 * Marks every page as dirty.
+		 */
+		inline void							MarkAllDirty() {
+			std::memset( m_mMemory.ui64Dirty, 0xFF, sizeof( m_mMemory.ui64Dirty ) );
+			if constexpr ( (LSN_BP_PAGES & 63) != 0 ) {
+				m_mMemory.ui64Dirty[LSN_BP_WORDS-1] = (1ULL << (LSN_BP_PAGES & 63)) - 1;
+			}
+		}
+
+		/**
+		 * Clears the dirty-page bitmap.  Call after taking a checkpoint; pages written after this are then dirty.
+		 */
+		inline void							ClearDirtyPages() {
+			std::memset( m_mMemory.ui64Dirty, 0, sizeof( m_mMemory.ui64Dirty ) );
+		}
+
+		/**
+		 * Determines whether a page has been written since the last call to ClearDirtyPages().
+		 *
+		 * \param _stPage The index of the page.
+		 * \return Returns true if the page is dirty.
+		 */
+		inline bool							IsPageDirty( size_t _stPage ) const {
+			return _stPage < LSN_BP_PAGES && ((m_mMemory.ui64Dirty[_stPage>>6] >> (_stPage & 63)) & 1);
+		}
+
+		/**
+		 * Gets the number of pages written since the last call to ClearDirtyPages().
+		 *
+		 * \return Returns the number of dirty pages.
+		 */
+		inline size_t						DirtyPageCount() const {
+			size_t stCount = 0;
+			for ( size_t I = 0; I < LSN_BP_WORDS; ++I ) {
+				stCount += size_t( std::popcount( m_mMemory.ui64Dirty[I] ) );
+			}
+			return stCount;
+		}
+
+		/**
+		 * Writes only the pages written since the last call to ClearDirtyPages(), plus the floating value.  Loading the result with
+		 *	LoadDirtyPages() on top of the memory as it was at that checkpoint restores the memory as it is now.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the pages were written.
+		 */
+		bool								SaveDirtyPages( CStream &_sStream ) const {
+			if ( !_sStream.WriteBytes( m_mMemory.ui64Dirty, sizeof( m_mMemory.ui64Dirty ) ) ) { return false; }
+			for ( size_t I = 0; I < LSN_BP_WORDS; ++I ) {
+				for ( uint64_t ui64Bits = m_mMemory.ui64Dirty[I]; ui64Bits; ui64Bits &= ui64Bits - 1 ) {
+					const size_t stPage = I * 64 + size_t( std::countr_zero( ui64Bits ) );
+					if ( !_sStream.WriteBytes( &m_mMemory.ui8Ram[stPage<<LSN_BP_PAGE_SHIFT], LSN_BP_PAGE_SIZE ) ) { return false; }
+				}
+			}
+			return _sStream.WriteUi8( m_ui8LastRead );
+		}
+
+		/**
+		 * Reads pages previously written by SaveDirtyPages() over the current memory.  The loaded pages are marked dirty.
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the pages were read.
+		 */
+		bool								LoadDirtyPages( CStream &_sStream ) {
+			uint64_t ui64Dirty[LSN_BP_WORDS];
+			if ( !_sStream.ReadBytes( ui64Dirty, sizeof( ui64Dirty ) ) ) { return false; }
+			for ( size_t I = 0; I < LSN_BP_WORDS; ++I ) {
+				for ( uint64_t ui64Bits = ui64Dirty[I]; ui64Bits; ui64Bits &= ui64Bits - 1 ) {
+					const size_t stPage = I * 64 + size_t( std::countr_zero( ui64Bits ) );
+					if ( stPage >= LSN_BP_PAGES ) { return false; }
+					if ( !_sStream.ReadBytes( &m_mMemory.ui8Ram[stPage<<LSN_BP_PAGE_SHIFT], LSN_BP_PAGE_SIZE ) ) { return false; }
+				}
+				m_mMemory.ui64Dirty[I] |= ui64Dirty[I];
+			}
+			return _sStream.ReadUi8( m_ui8LastRead );
 		}
 
 		/**
@@ -352,6 +835,7 @@ namespace lsn {
 		 */
 		static void LSN_FASTCALL			StdWrite( void * /*_pvParm0*/, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t _ui8Val ) {
 			_pui8Data[_ui16Parm1] = _ui8Val;
+			MarkDirty( _pui8Data, _ui16Parm1 );
 		}
 
 		/**
@@ -394,6 +878,17 @@ namespace lsn {
 		 */
 		const std::vector<LSN_READ_WRITE_LOG> &
 											ReadWriteLog() const { return m_vReadWriteLog; }
+
+		/**
+		 * Adds an access made without Read() or Write() to the read/write log.
+		 *
+		 * \param _ui16Addr The address.
+		 * \param _ui8Val The value read or written.
+		 * \param _bRead True for a read.
+		 */
+		void								LogReadWrite( uint16_t _ui16Addr, uint8_t _ui8Val, bool _bRead ) {
+			m_vReadWriteLog.push_back( { .ui16Address = _ui16Addr, .ui8Value = _ui8Val, .bRead = _bRead } );
+		}
 #endif	// #ifdef LSN_CPU_VERIFY
 
 
@@ -401,8 +896,85 @@ namespace lsn {
 	protected :
 		// == Members.
 		LSN_ADDR_ACCESSOR					m_aaAccessors[_uSize];			/**< Access functions. */
-		uint8_t								m_ui8Ram[_uSize];				/**< Memory of _uSize bytes. */
+		LSN_MEMORY							m_mMemory;						/**< Memory of _uSize bytes and its dirty-page bitmap. */
+		LSN_PAGE							m_pPages[LSN_BP_PAGES];			/**< The page table, checked before m_aaAccessors. */
+		const uint8_t *						m_pui8DirectRead[LSN_BP_PAGES];	/**< Pages mapped by SetDirectReadPage(). */
+		uint64_t							m_ui64PendingPages[LSN_BP_WORDS];	/**< 1 bit per page whose access functions changed since the last UpdatePageTable(). */
 		uint8_t								m_ui8LastRead;					/**< The floating value. */
+#ifdef LSN_CPU_FAST_PATH_CHECK
+		uint64_t							m_ui64HandlerAccesses;			/**< Reads and writes through m_aaAccessors. */
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+		bool								m_bFastPages;					/**< If false, the page table is empty and every access uses m_aaAccessors. */
+#ifdef LSN_BUS_HISTOGRAM
+		LSN_PAGE_COUNTS						m_pcCounts[LSN_BP_PAGES];		/**< Per-page access counters. */
+#endif	// #ifdef LSN_BUS_HISTOGRAM
+
+
+		// == Functions.
+		/**
+		 * Removes a page's page-table entry, sending its accesses to the per-address functions until the next UpdatePageTable().
+		 *
+		 * \param _ui16Address Any address in the page.
+		 */
+		inline void							InvalidatePage( uint16_t _ui16Address ) {
+			const size_t stPage = size_t( _ui16Address ) >> LSN_BP_PAGE_SHIFT;
+			m_pPages[stPage].pui8Read = nullptr;
+			m_pPages[stPage].pui8Write = nullptr;
+			m_ui64PendingPages[stPage>>6] |= 1ULL << (stPage & 63);
+		}
+
+		/**
+		 * Removes the page-table entries of every page overlapping a range of addresses.
+		 *
+		 * \param _ui32Start The first address.
+		 * \param _ui32End The address after the last address.  Must be greater than _ui32Start.
+		 */
+		inline void							InvalidatePages( uint32_t _ui32Start, uint32_t _ui32End ) {
+			for ( size_t I = _ui32Start >> LSN_BP_PAGE_SHIFT; I <= ((_ui32End - 1) >> LSN_BP_PAGE_SHIFT); ++I ) {
+				m_pPages[I].pui8Read = nullptr;
+				m_pPages[I].pui8Write = nullptr;
+				m_ui64PendingPages[I>>6] |= 1ULL << (I & 63);
+			}
+		}
+
+		/**
+		 * Marks every page as needing to be rebuilt by UpdatePageTable().
+		 */
+		inline void							MarkAllPagesPending() {
+			std::memset( m_ui64PendingPages, 0xFF, sizeof( m_ui64PendingPages ) );
+			if constexpr ( (LSN_BP_PAGES & 63) != 0 ) {
+				m_ui64PendingPages[LSN_BP_WORDS-1] = (1ULL << (LSN_BP_PAGES & 63)) - 1;
+			}
+		}
+
+		/**
+		 * Rebuilds a page-table entry from the per-address functions of the page.
+		 *
+		 * \param _stPage The page index.
+		 */
+		void								UpdatePage( size_t _stPage ) {
+			const LSN_ADDR_ACCESSOR * paaPage = &m_aaAccessors[_stPage<<LSN_BP_PAGE_SHIFT];
+
+			const uint8_t * pui8Read = m_pui8DirectRead[_stPage];
+			if ( !pui8Read && paaPage[0].ui16ReaderParm1 <= _uSize - LSN_BP_PAGE_SIZE ) {
+				bool bLinear = true;
+				for ( size_t I = 0; I < LSN_BP_PAGE_SIZE && bLinear; ++I ) {
+					bLinear = paaPage[I].pfReader == StdRead && paaPage[I].ui16ReaderParm1 == paaPage[0].ui16ReaderParm1 + I;
+				}
+				if ( bLinear ) { pui8Read = &m_mMemory.ui8Ram[paaPage[0].ui16ReaderParm1]; }
+			}
+			m_pPages[_stPage].pui8Read = pui8Read;
+
+			uint8_t * pui8Write = nullptr;
+			if ( paaPage[0].ui16WriterParm1 <= _uSize - LSN_BP_PAGE_SIZE ) {
+				bool bLinear = true;
+				for ( size_t I = 0; I < LSN_BP_PAGE_SIZE && bLinear; ++I ) {
+					bLinear = paaPage[I].pfWriter == StdWrite && paaPage[I].ui16WriterParm1 == paaPage[0].ui16WriterParm1 + I;
+				}
+				if ( bLinear ) { pui8Write = &m_mMemory.ui8Ram[paaPage[0].ui16WriterParm1]; }
+			}
+			m_pPages[_stPage].pui8Write = pui8Write;
+		}
 
 
 #ifdef LSN_CPU_VERIFY
@@ -0,0 +1,182 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Gathers the per-page access counters of the CPU and PPU buses (only counted in builds with LSN_BUS_HISTOGRAM defined),
+ *	either once over a whole run or frame-by-frame, and formats them as CSV or JSON.
+ */
+
+#include "LSNBusHistogram.h"
+
+#include <cstdio>
+
+
+namespace lsn {
+
+	CBusHistogram::CBusHistogram() :
+		m_pbCpuBus( nullptr ),
+		m_pbPpuBus( nullptr ),
+		m_bPerFrame( false ) {
+	}
+	CBusHistogram::~CBusHistogram() {
+	}
+
+	// == Functions.
+	/**
+	 * Zeroes the counters of both buses and starts gathering.
+	 *
+	 * \param _pbCpuBus The CPU bus.
+	 * \param _pbPpuBus The PPU bus.
+	 * \param _bPerFrame If true, Frame() adds a row per touched page each frame; otherwise End() adds 1 row per touched page.
+	 * \return Returns false if the buses were built without LSN_BUS_HISTOGRAM.
+	 */
+	bool CBusHistogram::Begin( CCpuBus * _pbCpuBus, CPpuBus * _pbPpuBus, bool _bPerFrame ) {
+		m_vRows.clear();
+		m_pbCpuBus = nullptr;
+		m_pbPpuBus = nullptr;
+		if ( !_pbCpuBus || !_pbPpuBus || !_pbCpuBus->PageCounts() || !_pbPpuBus->PageCounts() ) { return false; }
+		m_pbCpuBus = _pbCpuBus;
+		m_pbPpuBus = _pbPpuBus;
+		m_bPerFrame = _bPerFrame;
+		m_pbCpuBus->ResetPageCounts();
+		m_pbPpuBus->ResetPageCounts();
+		return true;
+	}
+
+	/**
+	 * Adds the counts since the previous call as rows for the given frame, then zeroes the counters.  Does nothing unless gathering
+	 *	per frame.
+	 *
+	 * \param _ui64Frame The frame that just ended.
+	 */
+	void CBusHistogram::Frame( uint64_t _ui64Frame ) {
+		if ( !m_bPerFrame || !m_pbCpuBus ) { return; }
+		AddRows( m_pbCpuBus, LSN_HB_CPU, _ui64Frame );
+		AddRows( m_pbPpuBus, LSN_HB_PPU, _ui64Frame );
+	}
+
+	/**
+	 * Stops gathering.  Unless gathering per frame, the counts since Begin() are added as rows covering the whole run.
+	 */
+	void CBusHistogram::End() {
+		if ( !m_pbCpuBus ) { return; }
+		if ( !m_bPerFrame ) {
+			AddRows( m_pbCpuBus, LSN_HB_CPU, UINT64_MAX );
+			AddRows( m_pbPpuBus, LSN_HB_PPU, UINT64_MAX );
+		}
+		m_pbCpuBus = nullptr;
+		m_pbPpuBus = nullptr;
+	}
+
+	/**
+	 * Zeroes the counters of both buses without adding rows, so that accesses not belonging to any frame (such as run-ahead) are
+	 *	left out.
+	 */
+	void CBusHistogram::Discard() {
+		if ( !m_pbCpuBus ) { return; }
+		m_pbCpuBus->ResetPageCounts();
+		m_pbPpuBus->ResetPageCounts();
+	}
+
+	/**
+	 * Gets the totals over all rows.
+	 *
+	 * \return Returns the totals over all rows.
+	 */
+	CBusHistogram::LSN_HISTOGRAM_SUMMARY CBusHistogram::Summary() const {
+		LSN_HISTOGRAM_SUMMARY hsRet = {};
+		for ( const auto & hrRow : m_vRows ) {
+			const CCpuBus::LSN_PAGE_COUNTS & pcCounts = hrRow.pcCounts;
+			if ( hrRow.ui8Bus == LSN_HB_CPU ) {
+				hsRet.ui64CpuReads += pcCounts.ui64Reads;
+				hsRet.ui64CpuWrites += pcCounts.ui64Writes;
+			}
+			else {
+				if ( hrRow.ui16Page < (LSN_PPU_NAMETABLES >> 8) ) { hsRet.ui64PatternFetches += pcCounts.ui64Reads; }
+				else if ( hrRow.ui16Page < (LSN_PPU_PALETTE_MEMORY >> 8) ) { hsRet.ui64NametableFetches += pcCounts.ui64Reads; }
+				else { hsRet.ui64PaletteFetches += pcCounts.ui64Reads; }
+				hsRet.ui64PpuWrites += pcCounts.ui64Writes;
+			}
+			hsRet.ui64Direct += pcCounts.ui64DirectReads + pcCounts.ui64DirectWrites;
+			hsRet.ui64Std += pcCounts.ui64StdReads + pcCounts.ui64StdWrites;
+			hsRet.ui64Handler += (pcCounts.ui64Reads - pcCounts.ui64DirectReads - pcCounts.ui64StdReads) +
+				(pcCounts.ui64Writes - pcCounts.ui64DirectWrites - pcCounts.ui64StdWrites);
+		}
+		return hsRet;
+	}
+
+	/**
+	 * Formats the rows as CSV, 1 line per row.
+	 *
+	 * \return Returns the CSV text.
+	 */
+	std::string CBusHistogram::ToCsv() const {
+		std::string sRet = "frame,bus,page,region,reads,writes,direct_reads,direct_writes,std_reads,std_writes,handler_reads,handler_writes\n";
+		char szBuffer[256];
+		for ( const auto & hrRow : m_vRows ) {
+			const CCpuBus::LSN_PAGE_COUNTS & pcCounts = hrRow.pcCounts;
+			if ( hrRow.ui64Frame == UINT64_MAX ) { sRet += "all"; }
+			else { sRet += std::to_string( hrRow.ui64Frame ); }
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",%s,%02X,%s,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+				hrRow.ui8Bus == LSN_HB_CPU ? "cpu" : "ppu", hrRow.ui16Page, RegionName( hrRow.ui8Bus, hrRow.ui16Page ),
+				static_cast<unsigned long long>(pcCounts.ui64Reads), static_cast<unsigned long long>(pcCounts.ui64Writes),
+				static_cast<unsigned long long>(pcCounts.ui64DirectReads), static_cast<unsigned long long>(pcCounts.ui64DirectWrites),
+				static_cast<unsigned long long>(pcCounts.ui64StdReads), static_cast<unsigned long long>(pcCounts.ui64StdWrites),
+				static_cast<unsigned long long>(pcCounts.ui64Reads - pcCounts.ui64DirectReads - pcCounts.ui64StdReads),
+				static_cast<unsigned long long>(pcCounts.ui64Writes - pcCounts.ui64DirectWrites - pcCounts.ui64StdWrites) );
+			sRet += szBuffer;
+		}
+		return sRet;
+	}
+
+	/**
+	 * Formats the rows as a JSON object.
+	 *
+	 * \return Returns the JSON text.
+	 */
+	std::string CBusHistogram::ToJson() const {
+		std::string sRet = "{\"rows\":[";
+		char szBuffer[320];
+		for ( size_t I = 0; I < m_vRows.size(); ++I ) {
+			const LSN_HISTOGRAM_ROW & hrRow = m_vRows[I];
+			const CCpuBus::LSN_PAGE_COUNTS & pcCounts = hrRow.pcCounts;
+			if ( I ) { sRet += ","; }
+			if ( hrRow.ui64Frame != UINT64_MAX ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), "{\"frame\":%llu,", static_cast<unsigned long long>(hrRow.ui64Frame) );
+				sRet += szBuffer;
+			}
+			else { sRet += "{"; }
+			std::snprintf( szBuffer, sizeof( szBuffer ), "\"bus\":\"%s\",\"page\":%u,\"region\":\"%s\",\"reads\":%llu,\"writes\":%llu,"
+				"\"direct_reads\":%llu,\"direct_writes\":%llu,\"std_reads\":%llu,\"std_writes\":%llu}",
+				hrRow.ui8Bus == LSN_HB_CPU ? "cpu" : "ppu", hrRow.ui16Page, RegionName( hrRow.ui8Bus, hrRow.ui16Page ),
+				static_cast<unsigned long long>(pcCounts.ui64Reads), static_cast<unsigned long long>(pcCounts.ui64Writes),
+				static_cast<unsigned long long>(pcCounts.ui64DirectReads), static_cast<unsigned long long>(pcCounts.ui64DirectWrites),
+				static_cast<unsigned long long>(pcCounts.ui64StdReads), static_cast<unsigned long long>(pcCounts.ui64StdWrites) );
+			sRet += szBuffer;
+		}
+		sRet += "]}\n";
+		return sRet;
+	}
+
+	/**
+	 * Gets the name of the region of the bus in which a page lies.
+	 *
+	 * \param _ui8Bus A LSN_HISTOGRAM_BUS value.
+	 * \param _ui16Page The page index.
+	 * \return Returns the name of the region.
+	 */
+	const char * CBusHistogram::RegionName( uint8_t _ui8Bus, uint16_t _ui16Page ) {
+		const uint32_t ui32Addr = uint32_t( _ui16Page ) << 8;
+		if ( _ui8Bus == LSN_HB_CPU ) {
+			if ( ui32Addr < LSN_PPU_START ) { return "ram"; }
+			if ( ui32Addr < LSN_APU_START ) { return "ppu"; }
+			if ( ui32Addr < LSN_APU_IO_START + LSN_APU_IO ) { return "apu_io"; }
+			return "cart";
+		}
+		if ( ui32Addr < LSN_PPU_NAMETABLES ) { return "pattern"; }
+		if ( ui32Addr < LSN_PPU_PALETTE_MEMORY ) { return "nametable"; }
+		return "palette";
+	}
+
+}	// namespace lsn
@@ -0,0 +1,177 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Gathers the per-page access counters of the CPU and PPU buses (only counted in builds with LSN_BUS_HISTOGRAM defined),
+ *	either once over a whole run or frame-by-frame, and formats them as CSV or JSON.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "LSNBus.h"
+
+#include <string>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CBusHistogram
+	 * \brief Gathers the per-page access counters of the CPU and PPU buses.
+	 *
+	 * Description: Gathers the per-page access counters of the CPU and PPU buses (only counted in builds with LSN_BUS_HISTOGRAM defined),
+	 *	either once over a whole run or frame-by-frame, and formats them as CSV or JSON.
+	 */
+	class CBusHistogram {
+	public :
+		CBusHistogram();
+		~CBusHistogram();
+
+
+		// == Enumerations.
+		/** The bus of a row. */
+		enum LSN_HISTOGRAM_BUS : uint8_t {
+			LSN_HB_CPU,																		/**< The CPU bus. */
+			LSN_HB_PPU,																		/**< The PPU bus. */
+		};
+
+
+		// == Types.
+		/** The counts of 1 page over 1 frame (or the whole run). */
+		struct LSN_HISTOGRAM_ROW {
+			uint64_t										ui64Frame;						/**< The frame, or UINT64_MAX if the row covers the whole run. */
+			CCpuBus::LSN_PAGE_COUNTS						pcCounts;						/**< The counts. */
+			uint16_t										ui16Page;						/**< The page index (the address >> 8). */
+			uint8_t											ui8Bus;							/**< A LSN_HISTOGRAM_BUS value. */
+		};
+
+		/** Totals over all rows. */
+		struct LSN_HISTOGRAM_SUMMARY {
+			uint64_t										ui64CpuReads;					/**< CPU-bus reads. */
+			uint64_t										ui64CpuWrites;					/**< CPU-bus writes. */
+			uint64_t										ui64PatternFetches;				/**< PPU-bus reads of the pattern tables ($0000-$1FFF). */
+			uint64_t										ui64NametableFetches;			/**< PPU-bus reads of the nametables ($2000-$3EFF). */
+			uint64_t										ui64PaletteFetches;				/**< PPU-bus reads of the palettes ($3F00-$3FFF). */
+			uint64_t										ui64PpuWrites;					/**< PPU-bus writes. */
+			uint64_t										ui64Direct;						/**< Accesses on both buses through the page tables. */
+			uint64_t										ui64Std;						/**< Accesses on both buses through StdRead()/StdWrite(). */
+			uint64_t										ui64Handler;					/**< Accesses on both buses through any other handler. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Zeroes the counters of both buses and starts gathering.
+		 *
+		 * \param _pbCpuBus The CPU bus.
+		 * \param _pbPpuBus The PPU bus.
+		 * \param _bPerFrame If true, Frame() adds a row per touched page each frame; otherwise End() adds 1 row per touched page.
+		 * \return Returns false if the buses were built without LSN_BUS_HISTOGRAM.
+		 */
+		bool												Begin( CCpuBus * _pbCpuBus, CPpuBus * _pbPpuBus, bool _bPerFrame );
+
+		/**
+		 * Adds the counts since the previous call as rows for the given frame, then zeroes the counters.  Does nothing unless gathering
+		 *	per frame.
+		 *
+		 * \param _ui64Frame The frame that just ended.
+		 */
+		void												Frame( uint64_t _ui64Frame );
+
+		/**
+		 * Stops gathering.  Unless gathering per frame, the counts since Begin() are added as rows covering the whole run.
+		 */
+		void												End();
+
+		/**
+		 * Zeroes the counters of both buses without adding rows, so that accesses not belonging to any frame (such as run-ahead) are
+		 *	left out.
+		 */
+		void												Discard();
+
+		/**
+		 * Gets the rows.
+		 *
+		 * \return Returns the rows.
+		 */
+		inline const std::vector<LSN_HISTOGRAM_ROW> &		Rows() const { return m_vRows; }
+
+		/**
+		 * Gets the totals over all rows.
+		 *
+		 * \return Returns the totals over all rows.
+		 */
+		LSN_HISTOGRAM_SUMMARY								Summary() const;
+
+		/**
+		 * Formats the rows as CSV, 1 line per row.
+		 *
+		 * \return Returns the CSV text.
+		 */
+		std::string											ToCsv() const;
+
+		/**
+		 * Formats the rows as a JSON object.
+		 *
+		 * \return Returns the JSON text.
+		 */
+		std::string											ToJson() const;
+
+		/**
+		 * Gets the name of the region of the bus in which a page lies.
+		 *
+		 * \param _ui8Bus A LSN_HISTOGRAM_BUS value.
+		 * \param _ui16Page The page index.
+		 * \return Returns the name of the region.
+		 */
+		static const char *									RegionName( uint8_t _ui8Bus, uint16_t _ui16Page );
+
+
+	protected :
+		// == Members.
+		/** The rows. */
+		std::vector<LSN_HISTOGRAM_ROW>						m_vRows;
+		/** The CPU bus. */
+		CCpuBus *											m_pbCpuBus;
+		/** The PPU bus. */
+		CPpuBus *											m_pbPpuBus;
+		/** If true, rows are added every frame. */
+		bool												m_bPerFrame;
+
+
+		// == Functions.
+		/**
+		 * Adds a row for every touched page of a bus, then zeroes its counters.
+		 *
+		 * \param _pbBus The bus.
+		 * \param _ui8Bus The LSN_HISTOGRAM_BUS value of the bus.
+		 * \param _ui64Frame The frame of the rows.
+		 */
+		template <typename _tBus>
+		void												AddRows( _tBus * _pbBus, uint8_t _ui8Bus, uint64_t _ui64Frame ) {
+			const auto * ppcCounts = _pbBus->PageCounts();
+			if ( !ppcCounts ) { return; }
+			for ( size_t I = 0; I < _tBus::LSN_BP_PAGES; ++I ) {
+				if ( ppcCounts[I].ui64Reads || ppcCounts[I].ui64Writes ) {
+					LSN_HISTOGRAM_ROW hrRow;
+					hrRow.ui64Frame = _ui64Frame;
+					hrRow.pcCounts.ui64Reads = ppcCounts[I].ui64Reads;
+					hrRow.pcCounts.ui64Writes = ppcCounts[I].ui64Writes;
+					hrRow.pcCounts.ui64DirectReads = ppcCounts[I].ui64DirectReads;
+					hrRow.pcCounts.ui64DirectWrites = ppcCounts[I].ui64DirectWrites;
+					hrRow.pcCounts.ui64StdReads = ppcCounts[I].ui64StdReads;
+					hrRow.pcCounts.ui64StdWrites = ppcCounts[I].ui64StdWrites;
+					hrRow.ui16Page = uint16_t( I );
+					hrRow.ui8Bus = _ui8Bus;
+					m_vRows.push_back( hrRow );
+				}
+			}
+			_pbBus->ResetPageCounts();
+		}
+	};
+
+}	// namespace lsn
@@ -0,0 +1,208 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Memory watchpoints on the CPU bus.  Trampolines are inserted only on watched addresses, so every other address keeps its
+ *	original access functions (and its page-table entry) and nothing is paid when no watchpoints are set.  Hits are pushed into a
+ *	lock-free ring buffer from which a debugger or tool can drain them.
+ */
+
+#include "LSNWatchpoints.h"
+
+
+namespace lsn {
+
+	CWatchpoints::CWatchpoints( CCpuBus * _pbBus, CCpuBase * _pcbCpu ) :
+		m_pbBus( _pbBus ),
+		m_pcbCpu( _pcbCpu ),
+		m_ui32NextId( 1 ) {
+	}
+	CWatchpoints::~CWatchpoints() {
+	}
+
+	// == Functions.
+	/**
+	 * Adds a watchpoint.  If the watchpoints are installed, they are reinstalled.
+	 *
+	 * \param _ui16Start The first address to watch.
+	 * \param _ui16End The last address to watch (inclusive).
+	 * \param _ui8Flags A combination of LSN_WATCH_FLAGS.  At least one of LSN_WF_READ and LSN_WF_WRITE must be set.
+	 * \param _ui8Value The value to match if LSN_WF_VALUE is set.
+	 * \return Returns the ID of the new watchpoint, or 0 if the parameters are invalid.
+	 */
+	uint32_t CWatchpoints::Add( uint16_t _ui16Start, uint16_t _ui16End, uint8_t _ui8Flags, uint8_t _ui8Value ) {
+		if ( _ui16End < _ui16Start || !(_ui8Flags & (LSN_WF_READ | LSN_WF_WRITE)) ) { return 0; }
+		bool bInstalled = Installed();
+		Uninstall();
+		LSN_WATCHPOINT wWatch;
+		wWatch.ui32Id = m_ui32NextId++;
+		wWatch.ui16Start = _ui16Start;
+		wWatch.ui16End = _ui16End;
+		wWatch.ui8Flags = _ui8Flags;
+		wWatch.ui8Value = _ui8Value;
+		m_vWatchpoints.push_back( wWatch );
+		if ( bInstalled ) { Install(); }
+		return wWatch.ui32Id;
+	}
+
+	/**
+	 * Removes a watchpoint.  If the watchpoints are installed, they are reinstalled.
+	 *
+	 * \param _ui32Id The ID returned by Add().
+	 * \return Returns true if the watchpoint existed.
+	 */
+	bool CWatchpoints::Remove( uint32_t _ui32Id ) {
+		for ( size_t I = 0; I < m_vWatchpoints.size(); ++I ) {
+			if ( m_vWatchpoints[I].ui32Id == _ui32Id ) {
+				bool bInstalled = Installed();
+				Uninstall();
+				m_vWatchpoints.erase( m_vWatchpoints.begin() + I );
+				if ( bInstalled ) { Install(); }
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * Removes all watchpoints and their trampolines.
+	 */
+	void CWatchpoints::Clear() {
+		Uninstall();
+		m_vWatchpoints.clear();
+	}
+
+	/**
+	 * Inserts trampolines on every watched address.  Does nothing if already installed or if there are no watchpoints.
+	 */
+	void CWatchpoints::Install() {
+		if ( Installed() || m_vWatchpoints.empty() ) { return; }
+
+		std::vector<uint8_t> vKinds( m_pbBus->Size() );
+		for ( const auto & wWatch : m_vWatchpoints ) {
+			for ( uint32_t I = wWatch.ui16Start; I <= wWatch.ui16End && I < m_pbBus->Size(); ++I ) {
+				vKinds[I] |= wWatch.ui8Flags & (LSN_WF_READ | LSN_WF_WRITE);
+			}
+		}
+		m_vAddresses.clear();
+		m_vKinds.clear();
+		for ( size_t I = 0; I < vKinds.size(); ++I ) {
+			if ( vKinds[I] ) {
+				m_vAddresses.push_back( uint16_t( I ) );
+				m_vKinds.push_back( vKinds[I] );
+			}
+		}
+
+		// Only pages that get a read trampoline lose their direct mapping, so only those are saved.  The others may be remapped freely while
+		//	installed.
+		m_vDirectPages.assign( CCpuBus::LSN_BP_PAGES, nullptr );
+		for ( size_t I = 0; I < m_vAddresses.size(); ++I ) {
+			if ( m_vKinds[I] & LSN_WF_READ ) {
+				const uint16_t ui16Page = uint16_t( m_vAddresses[I] >> CCpuBus::LSN_BP_PAGE_SHIFT );
+				m_vDirectPages[ui16Page] = m_pbBus->DirectReadPage( ui16Page );
+			}
+		}
+
+		// The bus keeps pointers into this, so it must not be resized after this point.
+		m_vTrampolines.resize( m_vAddresses.size() );
+		for ( size_t I = 0; I < m_vAddresses.size(); ++I ) {
+			uint16_t ui16Addr = m_vAddresses[I];
+			CCpuBus::LSN_TRAMPOLINE * ptTramp = &m_vTrampolines[I];
+			if ( m_vKinds[I] & LSN_WF_READ ) {
+				m_pbBus->SetTrampolineReadFunc( ui16Addr, WatchRead, this, ui16Addr, ptTramp );
+			}
+			if ( m_vKinds[I] & LSN_WF_WRITE ) {
+				m_pbBus->SetTrampolineWriteFunc( ui16Addr, WatchWrite, this, ui16Addr, ptTramp );
+			}
+		}
+		m_pbBus->UpdatePageTable();
+	}
+
+	/**
+	 * Removes the trampolines, restoring the access functions they replaced.  Trampolines inserted on top of these must be removed
+	 *	first.
+	 */
+	void CWatchpoints::Uninstall() {
+		if ( !Installed() ) { return; }
+		for ( auto I = m_vTrampolines.size(); I--; ) {
+			const CCpuBus::LSN_ADDR_ACCESSOR & aaOrig = m_vTrampolines[I].aaOriginalFuncs;
+			if ( m_vKinds[I] & LSN_WF_READ ) {
+				m_pbBus->SetReadFunc( m_vAddresses[I], aaOrig.pfReader, aaOrig.pvReaderParm0, aaOrig.ui16ReaderParm1 );
+			}
+			if ( m_vKinds[I] & LSN_WF_WRITE ) {
+				m_pbBus->SetWriteFunc( m_vAddresses[I], aaOrig.pfWriter, aaOrig.pvWriterParm0, aaOrig.ui16WriterParm1 );
+			}
+		}
+		// SetReadFunc() removed the direct mapping of the pages that had read trampolines.
+		for ( size_t I = 0; I < m_vDirectPages.size(); ++I ) {
+			if ( m_vDirectPages[I] ) {
+				m_pbBus->SetDirectReadPage( uint16_t( I ), m_vDirectPages[I] );
+			}
+		}
+		Detach();
+		m_pbBus->UpdatePageTable();
+	}
+
+	/**
+	 * Forgets the trampolines without touching the bus.  Call after the bus has been remapped, which already replaced them.
+	 */
+	void CWatchpoints::Detach() {
+		m_vTrampolines.clear();
+		m_vAddresses.clear();
+		m_vKinds.clear();
+		m_vDirectPages.clear();
+	}
+
+	/**
+	 * Pushes a hit for every watchpoint matching an access.
+	 *
+	 * \param _ui16Addr The accessed address.
+	 * \param _ui8Val The value read or written.
+	 * \param _ui8Type LSN_WF_READ or LSN_WF_WRITE.
+	 */
+	void CWatchpoints::Check( uint16_t _ui16Addr, uint8_t _ui8Val, uint8_t _ui8Type ) {
+		for ( const auto & wWatch : m_vWatchpoints ) {
+			if ( (wWatch.ui8Flags & _ui8Type) && _ui16Addr >= wWatch.ui16Start && _ui16Addr <= wWatch.ui16End &&
+				(!(wWatch.ui8Flags & LSN_WF_VALUE) || wWatch.ui8Value == _ui8Val) ) {
+				LSN_WATCH_HIT whHit;
+				whHit.ui64Cycle = m_pcbCpu->GetCycleCount();
+				whHit.ui32Id = wWatch.ui32Id;
+				whHit.ui16Pc = m_pcbCpu->GetPc();
+				whHit.ui16Address = _ui16Addr;
+				whHit.ui8Value = _ui8Val;
+				whHit.ui8Type = _ui8Type;
+				m_rbHits.Push( whHit );
+			}
+		}
+	}
+
+	/**
+	 * A read trampoline that calls the original read function and then checks the watchpoints.
+	 *
+	 * \param _pvParm0 A data value assigned to this address.
+	 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  The watched address.
+	 * \param _pui8Data The buffer from which to read.
+	 * \param _ui8Ret The read value.
+	 */
+	void LSN_FASTCALL CWatchpoints::WatchRead( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t &_ui8Ret ) {
+		CCpuBus::LSN_TRAMPOLINE * ptTramp = reinterpret_cast<CCpuBus::LSN_TRAMPOLINE *>(_pvParm0);
+		ptTramp->aaOriginalFuncs.pfReader( ptTramp->aaOriginalFuncs.pvReaderParm0, ptTramp->aaOriginalFuncs.ui16ReaderParm1, _pui8Data, _ui8Ret );
+		reinterpret_cast<CWatchpoints *>(ptTramp->pvReaderParm0)->Check( _ui16Parm1, _ui8Ret, LSN_WF_READ );
+	}
+
+	/**
+	 * A write trampoline that checks the watchpoints and then calls the original write function.
+	 *
+	 * \param _pvParm0 A data value assigned to this address.
+	 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  The watched address.
+	 * \param _pui8Data The buffer to which to write.
+	 * \param _ui8Val The value to write.
+	 */
+	void LSN_FASTCALL CWatchpoints::WatchWrite( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t _ui8Val ) {
+		CCpuBus::LSN_TRAMPOLINE * ptTramp = reinterpret_cast<CCpuBus::LSN_TRAMPOLINE *>(_pvParm0);
+		reinterpret_cast<CWatchpoints *>(ptTramp->pvWriterParm0)->Check( _ui16Parm1, _ui8Val, LSN_WF_WRITE );
+		ptTramp->aaOriginalFuncs.pfWriter( ptTramp->aaOriginalFuncs.pvWriterParm0, ptTramp->aaOriginalFuncs.ui16WriterParm1, _pui8Data, _ui8Val );
+	}
+
+}	// namespace lsn
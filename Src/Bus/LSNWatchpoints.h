@@ -0,0 +1,184 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Memory watchpoints on the CPU bus.  Trampolines are inserted only on watched addresses, so every other address keeps its
+ *	original access functions (and its page-table entry) and nothing is paid when no watchpoints are set.  Hits are pushed into a
+ *	lock-free ring buffer from which a debugger or tool can drain them.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Cpu/LSNCpuBase.h"
+#include "../Utilities/LSNRingBuffer.h"
+#include "LSNBus.h"
+
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CWatchpoints
+	 * \brief Memory watchpoints on the CPU bus.
+	 *
+	 * Description: Memory watchpoints on the CPU bus.  Trampolines are inserted only on watched addresses, so every other address keeps its
+	 *	original access functions (and its page-table entry) and nothing is paid when no watchpoints are set.  Hits are pushed into a
+	 *	lock-free ring buffer from which a debugger or tool can drain them.
+	 */
+	class CWatchpoints {
+	public :
+		CWatchpoints( CCpuBus * _pbBus, CCpuBase * _pcbCpu );
+		~CWatchpoints();
+
+
+		// == Enumerations.
+		/** Watchpoint flags. */
+		enum LSN_WATCH_FLAGS : uint8_t {
+			LSN_WF_READ										= (1 << 0),						/**< Reads are watched. */
+			LSN_WF_WRITE									= (1 << 1),						/**< Writes are watched. */
+			LSN_WF_VALUE									= (1 << 2),						/**< Only accesses of a given value are hits. */
+		};
+
+
+		// == Types.
+		/** A watchpoint. */
+		struct LSN_WATCHPOINT {
+			uint32_t										ui32Id;							/**< The ID returned by Add(). */
+			uint16_t										ui16Start;						/**< The first watched address. */
+			uint16_t										ui16End;						/**< The last watched address (inclusive). */
+			uint8_t											ui8Flags;						/**< A combination of LSN_WATCH_FLAGS. */
+			uint8_t											ui8Value;						/**< The value to match if LSN_WF_VALUE is set. */
+		};
+
+		/** A watchpoint hit. */
+		struct LSN_WATCH_HIT {
+			uint64_t										ui64Cycle;						/**< The CPU cycle of the access. */
+			uint32_t										ui32Id;							/**< The ID of the watchpoint that was hit. */
+			uint16_t										ui16Pc;							/**< The program counter at the time of the access. */
+			uint16_t										ui16Address;					/**< The accessed address. */
+			uint8_t											ui8Value;						/**< The value read or written. */
+			uint8_t											ui8Type;						/**< LSN_WF_READ or LSN_WF_WRITE. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Adds a watchpoint.  If the watchpoints are installed, they are reinstalled.
+		 *
+		 * \param _ui16Start The first address to watch.
+		 * \param _ui16End The last address to watch (inclusive).
+		 * \param _ui8Flags A combination of LSN_WATCH_FLAGS.  At least one of LSN_WF_READ and LSN_WF_WRITE must be set.
+		 * \param _ui8Value The value to match if LSN_WF_VALUE is set.
+		 * \return Returns the ID of the new watchpoint, or 0 if the parameters are invalid.
+		 */
+		uint32_t											Add( uint16_t _ui16Start, uint16_t _ui16End, uint8_t _ui8Flags, uint8_t _ui8Value = 0 );
+
+		/**
+		 * Removes a watchpoint.  If the watchpoints are installed, they are reinstalled.
+		 *
+		 * \param _ui32Id The ID returned by Add().
+		 * \return Returns true if the watchpoint existed.
+		 */
+		bool												Remove( uint32_t _ui32Id );
+
+		/**
+		 * Removes all watchpoints and their trampolines.
+		 */
+		void												Clear();
+
+		/**
+		 * Gets the watchpoints.
+		 *
+		 * \return Returns the watchpoints.
+		 */
+		inline const std::vector<LSN_WATCHPOINT> &			Watchpoints() const { return m_vWatchpoints; }
+
+		/**
+		 * Inserts trampolines on every watched address.  Does nothing if already installed or if there are no watchpoints.
+		 */
+		void												Install();
+
+		/**
+		 * Removes the trampolines, restoring the access functions they replaced.  Trampolines inserted on top of these must be removed
+		 *	first.
+		 */
+		void												Uninstall();
+
+		/**
+		 * Forgets the trampolines without touching the bus.  Call after the bus has been remapped, which already replaced them.
+		 */
+		void												Detach();
+
+		/**
+		 * Determines whether trampolines are currently inserted.
+		 *
+		 * \return Returns true if trampolines are currently inserted.
+		 */
+		inline bool											Installed() const { return !m_vTrampolines.empty(); }
+
+		/**
+		 * Gets the ring buffer into which hits are pushed.
+		 *
+		 * \return Returns the ring buffer into which hits are pushed.
+		 */
+		inline CRingBuffer<LSN_WATCH_HIT> &					Hits() { return m_rbHits; }
+
+
+	protected :
+		// == Members.
+		/** The watchpoints. */
+		std::vector<LSN_WATCHPOINT>							m_vWatchpoints;
+		/** The trampolines.  The bus keeps pointers into this, so it is only resized while nothing is installed. */
+		std::vector<CCpuBus::LSN_TRAMPOLINE>				m_vTrampolines;
+		/** The address of each trampoline in m_vTrampolines. */
+		std::vector<uint16_t>								m_vAddresses;
+		/** The LSN_WF_READ/LSN_WF_WRITE trampolines inserted at each address in m_vAddresses. */
+		std::vector<uint8_t>								m_vKinds;
+		/** The direct-read memory of each page holding a read trampoline (nullptr for the other pages), restored when the trampolines are removed. */
+		std::vector<const uint8_t *>						m_vDirectPages;
+		/** The hits. */
+		CRingBuffer<LSN_WATCH_HIT>							m_rbHits;
+		/** The bus being watched. */
+		CCpuBus *											m_pbBus;
+		/** The CPU, from which the cycle and PC of each hit are taken. */
+		CCpuBase *											m_pcbCpu;
+		/** The ID of the next watchpoint. */
+		uint32_t											m_ui32NextId;
+
+
+		// == Functions.
+		/**
+		 * Pushes a hit for every watchpoint matching an access.
+		 *
+		 * \param _ui16Addr The accessed address.
+		 * \param _ui8Val The value read or written.
+		 * \param _ui8Type LSN_WF_READ or LSN_WF_WRITE.
+		 */
+		void												Check( uint16_t _ui16Addr, uint8_t _ui8Val, uint8_t _ui8Type );
+
+		/**
+		 * A read trampoline that calls the original read function and then checks the watchpoints.
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  The watched address.
+		 * \param _pui8Data The buffer from which to read.
+		 * \param _ui8Ret The read value.
+		 */
+		static void LSN_FASTCALL							WatchRead( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t &_ui8Ret );
+
+		/**
+		 * A write trampoline that checks the watchpoints and then calls the original write function.
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  The watched address.
+		 * \param _pui8Data The buffer to which to write.
+		 * \param _ui8Val The value to write.
+		 */
+		static void LSN_FASTCALL							WatchWrite( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t _ui8Val );
+	};
+
+}	// namespace lsn
@@ -1070,6 +1070,18 @@ namespace lsn {
 	};
 
 #include "LSNInstMetaData.inl"					/**< Metadata for the instructions (for assembly and disassembly etc.) */
+#include "LSNMicroOps.inl"						/**< The micro-op ID's for the switch dispatcher. */
+
+	const CCpu6502::LSN_MICRO_OP_IDS CCpu6502::m_moiMicroOpIds = CCpu6502::BuildMicroOpIds();	/**< The micro-op ID's of m_iInstructionSet. */
+
+	const CCpu6502::PfTicks CCpu6502::m_pfTickFuncs[6] = {								/**< Every tick function, indexed by the values stored in save states. */
+		&CCpu6502::Tick_NextInstructionStd,
+		&CCpu6502::Tick_InstructionCycleStd,
+		&CCpu6502::Tick_DmaStart,
+		&CCpu6502::Tick_DmaIdle,
+		&CCpu6502::Tick_DmaRead,
+		&CCpu6502::Tick_DmaWrite,
+	};
 
 	// == Various constructors.
 	CCpu6502::CCpu6502( CCpuBus * _pbBus ) :
@@ -1091,10 +1103,24 @@ namespace lsn {
 		m_bIrqStatusLine( false ),
 		m_bHandleIrq( false ),
 		m_bIsReadCycle( true ),
-		m_bRdyLow( false ) {
+		m_bRdyLow( false ),
+		m_bTickMapper( false ),
+		m_ui64FastInstructions( 0 ),
+		m_ui64FastCycles( 0 ),
+		m_ui64FastBlocks( 0 ),
+		m_ui64FastCheckFailures( 0 ),
+		m_bDecodeCache( true ),
+		m_bJit( false ),
+		m_pfInstructionCycle( &CCpu6502::Tick_InstructionCycleStd ),
+		m_ui64IdleCycle( 0 ),
+		m_ui64IdleSkips( 0 ),
+		m_ui64IdleCycles( 0 ),
+		m_ui64IdleIoCycles( 0 ),
+		m_bIdleSkip( false ) {
 		pc.PC = 0xC000;
 		m_ui8Status = 0x04;
 		std::memset( &m_ccCurContext, 0, sizeof( m_ccCurContext ) );
+		std::memset( &m_isIdleState, 0, sizeof( m_isIdleState ) );
 	}
 	CCpu6502::~CCpu6502() {
 		ResetToKnown();
@@ -1107,6 +1133,12 @@ namespace lsn {
 	void CCpu6502::ResetToKnown() {
 		ResetAnalog();
 		m_ui64CycleCount = 0;
+		m_ui64FastInstructions = m_ui64FastCycles = m_ui64FastBlocks = m_ui64FastCheckFailures = 0;
+		m_ui64IdleCycle = m_ui64IdleSkips = m_ui64IdleCycles = m_ui64IdleIoCycles = 0;
+		m_dcDecodeCache.Clear();
+		m_dcDecodeCache.ResetStats();
+		m_jJit.Clear();
+		m_jJit.ResetStats();
 		A = 0;
 		S = 0xFD;
 		X = Y = 0;
@@ -1134,33 +1166,13 @@ namespace lsn {
 		m_bHandleIrq = m_bIrqStatusLine = false;
 	}
 
-	/**
-	 * Performs a single cycle update.
-	 */
-	void CCpu6502::Tick() {
-#ifndef LSN_CPU_VERIFY
-		m_pmbMapper->Tick();
-#endif	// #ifndef LSN_CPU_VERIFY
-		(this->*m_pfTickFunc)();
-
-		//m_bHandleNmi |= (m_bNmiStatusLine && --m_ui8NmiCounter == 0);
-		m_bHandleNmi = m_bDetectedNmi;
-		//m_bDetectedNmi |= (!m_bLastNmiStatusLine && m_bNmiStatusLine);
-		m_bLastNmiStatusLine = m_bNmiStatusLine;
-		m_bHandleIrq |= m_bIrqStatusLine;
-
-		++m_ui64CycleCount;
-	}
-
 	/**
 	 * Applies the CPU's memory mapping t the bus.
 	 */
 	void CCpu6502::ApplyMemoryMap() {
 		// Apply the CPU memory map to the bus.
-		for ( uint32_t I = LSN_CPU_START; I < (LSN_CPU_START + LSN_CPU_FULL_SIZE); ++I ) {
-			m_pbBus->SetReadFunc( uint16_t( I ), CCpuBus::StdRead, this, uint16_t( ((I - LSN_CPU_START) % LSN_INTERNAL_RAM) + LSN_CPU_START ) );
-			m_pbBus->SetWriteFunc( uint16_t( I ), CCpuBus::StdWrite, this, uint16_t( ((I - LSN_CPU_START) % LSN_INTERNAL_RAM) + LSN_CPU_START ) );
-		}
+		m_pbBus->SetReadRange( LSN_CPU_START, LSN_CPU_START + LSN_CPU_FULL_SIZE, CCpuBus::StdRead, this, LSN_CPU_START, 1, LSN_INTERNAL_RAM );
+		m_pbBus->SetWriteRange( LSN_CPU_START, LSN_CPU_START + LSN_CPU_FULL_SIZE, CCpuBus::StdWrite, this, LSN_CPU_START, 1, LSN_INTERNAL_RAM );
 
 		// DMA transfer.
 		m_pbBus->SetReadFunc( 0x4014, CCpuBus::NoRead, this, 0x4014 );
@@ -1206,6 +1218,89 @@ namespace lsn {
 		m_bIrqStatusLine = true;
 	}
 
+	/**
+	 * Writes the CPU state to a stream.
+	 *
+	 * \param _sStream The stream to which to write.
+	 * \return Returns true if the state was written.
+	 */
+	bool CCpu6502::SaveState( CStream &_sStream ) const {
+		uint8_t ui8Tick = TickFuncToIndex( m_pfTickFunc );
+		uint8_t ui8TickCopy = TickFuncToIndex( m_pfTickFuncCopy );
+		if ( ui8Tick == 0xFF || ui8TickCopy == 0xFF ) { return false; }
+		if ( !_sStream.WriteUi8( ui8Tick ) ) { return false; }
+		if ( !_sStream.WriteUi8( ui8TickCopy ) ) { return false; }
+		if ( !_sStream.WriteUi64( m_ui64CycleCount ) ) { return false; }
+		if ( !_sStream.WriteBytes( &m_ccCurContext, sizeof( m_ccCurContext ) ) ) { return false; }
+		if ( !_sStream.WriteUi16( pc.PC ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16DmaCounter ) ) { return false; }
+		if ( !_sStream.WriteUi16( m_ui16DmaAddress ) ) { return false; }
+		if ( !_sStream.WriteUi8( A ) ) { return false; }
+		if ( !_sStream.WriteUi8( X ) ) { return false; }
+		if ( !_sStream.WriteUi8( Y ) ) { return false; }
+		if ( !_sStream.WriteUi8( S ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8Status ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8DmaPos ) ) { return false; }
+		if ( !_sStream.WriteUi8( m_ui8DmaValue ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bNmiStatusLine ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bLastNmiStatusLine ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bDetectedNmi ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bHandleNmi ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bIrqStatusLine ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bHandleIrq ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bIsReadCycle ) ) { return false; }
+		if ( !_sStream.WriteBool( m_bRdyLow ) ) { return false; }
+		if ( !_sStream.WriteBytes( m_ui8Inputs, sizeof( m_ui8Inputs ) ) ) { return false; }
+		if ( !_sStream.WriteBytes( m_ui8InputsState, sizeof( m_ui8InputsState ) ) ) { return false; }
+		if ( !_sStream.WriteBytes( m_ui8InputsPoll, sizeof( m_ui8InputsPoll ) ) ) { return false; }
+		return true;
+	}
+
+	/**
+	 * Reads the CPU state from a stream previously written by SaveState().
+	 *
+	 * \param _sStream The stream from which to read.
+	 * \return Returns true if the state was read.
+	 */
+	bool CCpu6502::LoadState( CStream &_sStream ) {
+		uint8_t ui8Tick, ui8TickCopy;
+		if ( !_sStream.ReadUi8( ui8Tick ) || ui8Tick >= LSN_ELEMENTS( m_pfTickFuncs ) ) { return false; }
+		if ( !_sStream.ReadUi8( ui8TickCopy ) || ui8TickCopy >= LSN_ELEMENTS( m_pfTickFuncs ) ) { return false; }
+		m_pfTickFunc = m_pfTickFuncs[ui8Tick];
+		m_pfTickFuncCopy = m_pfTickFuncs[ui8TickCopy];
+		// Save states store the pointer dispatcher's index for either dispatcher.
+		if ( m_pfTickFunc == &CCpu6502::Tick_InstructionCycleStd ) { m_pfTickFunc = m_pfInstructionCycle; }
+		if ( m_pfTickFuncCopy == &CCpu6502::Tick_InstructionCycleStd ) { m_pfTickFuncCopy = m_pfInstructionCycle; }
+		if ( !_sStream.ReadUi64( m_ui64CycleCount ) ) { return false; }
+		// No pass of an idle loop has run in the loaded timeline yet.
+		m_ui64IdleCycle = m_ui64CycleCount;
+		if ( !_sStream.ReadBytes( &m_ccCurContext, sizeof( m_ccCurContext ) ) ) { return false; }
+		// The context indexes the instruction table directly, so never trust it.
+		if ( m_ccCurContext.ui16OpCode >= LSN_ELEMENTS( m_iInstructionSet ) || m_ccCurContext.ui8FuncIdx >= LSN_M_MAX_INSTR_CYCLE_COUNT ) { return false; }
+		if ( !_sStream.ReadUi16( pc.PC ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16DmaCounter ) ) { return false; }
+		if ( !_sStream.ReadUi16( m_ui16DmaAddress ) ) { return false; }
+		if ( !_sStream.ReadUi8( A ) ) { return false; }
+		if ( !_sStream.ReadUi8( X ) ) { return false; }
+		if ( !_sStream.ReadUi8( Y ) ) { return false; }
+		if ( !_sStream.ReadUi8( S ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8Status ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8DmaPos ) ) { return false; }
+		if ( !_sStream.ReadUi8( m_ui8DmaValue ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bNmiStatusLine ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bLastNmiStatusLine ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bDetectedNmi ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bHandleNmi ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bIrqStatusLine ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bHandleIrq ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bIsReadCycle ) ) { return false; }
+		if ( !_sStream.ReadBool( m_bRdyLow ) ) { return false; }
+		if ( !_sStream.ReadBytes( m_ui8Inputs, sizeof( m_ui8Inputs ) ) ) { return false; }
+		if ( !_sStream.ReadBytes( m_ui8InputsState, sizeof( m_ui8InputsState ) ) ) { return false; }
+		if ( !_sStream.ReadBytes( m_ui8InputsPoll, sizeof( m_ui8InputsPoll ) ) ) { return false; }
+		return true;
+	}
+
 #ifdef LSN_CPU_VERIFY
 	/**
 	 * Runs a test given a JSON's value representing the test to run.
@@ -1219,20 +1314,23 @@ namespace lsn {
 		if ( !GetTest( _jJson, _jvTest, cvoVerifyMe ) ) { return false; }
 
 		// Create the initial state.
-		ResetToKnown();
-		m_pbBus->ApplyMap();				// Set default read/write functions.
-		m_ui64CycleCount = 0;
-		A = cvoVerifyMe.cvsStart.cvrRegisters.ui8A;
-		S = cvoVerifyMe.cvsStart.cvrRegisters.ui8S;
-		X = cvoVerifyMe.cvsStart.cvrRegisters.ui8X;
-		Y = cvoVerifyMe.cvsStart.cvrRegisters.ui8Y;
-		m_ui8Status = cvoVerifyMe.cvsStart.cvrRegisters.ui8P;
-		pc.PC = cvoVerifyMe.cvsStart.cvrRegisters.ui16Pc;
-
-		for ( auto I = cvoVerifyMe.cvsStart.vRam.size(); I--; ) {
-			m_pbBus->Write( cvoVerifyMe.cvsStart.vRam[I].ui16Addr, cvoVerifyMe.cvsStart.vRam[I].ui8Value );
-		}
-		m_pbBus->ApplyMap();				// Set default read/write functions.
+		auto aStart = [&]() {
+			ResetToKnown();
+			m_pbBus->ApplyMap();				// Set default read/write functions.
+			m_ui64CycleCount = 0;
+			A = cvoVerifyMe.cvsStart.cvrRegisters.ui8A;
+			S = cvoVerifyMe.cvsStart.cvrRegisters.ui8S;
+			X = cvoVerifyMe.cvsStart.cvrRegisters.ui8X;
+			Y = cvoVerifyMe.cvsStart.cvrRegisters.ui8Y;
+			m_ui8Status = cvoVerifyMe.cvsStart.cvrRegisters.ui8P;
+			pc.PC = cvoVerifyMe.cvsStart.cvrRegisters.ui16Pc;
+
+			for ( auto I = cvoVerifyMe.cvsStart.vRam.size(); I--; ) {
+				m_pbBus->Write( cvoVerifyMe.cvsStart.vRam[I].ui16Addr, cvoVerifyMe.cvsStart.vRam[I].ui8Value );
+			}
+			m_pbBus->ApplyMap();				// Set default read/write functions.
+		};
+		aStart();
 
 		if ( "10 20 b7" == cvoVerifyMe.sName ) {
 			volatile int ghg = 0;
@@ -1243,10 +1341,12 @@ namespace lsn {
 		}
 
 		// Verify.
+		bool bPassed = true;
 #define LSN_VURIFFY( REG )												\
 	if ( REG != cvoVerifyMe.cvsEnd.cvrRegisters.ui8 ## REG ) {			\
 		::OutputDebugStringA( cvoVerifyMe.sName.c_str() );				\
 		::OutputDebugStringA( "\r\nCPU Failure: " # REG "\r\n" );		\
+		bPassed = false;												\
 	}
 
 		LSN_VURIFFY( A );
@@ -1260,18 +1360,21 @@ namespace lsn {
 			::OutputDebugStringA( "\r\nCPU Failure: P\r\n" );
 			::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.cvsEnd.cvrRegisters.ui8P ) + std::string( " Got: " ) + std::to_string( m_ui8Status ) ).c_str() );
 			::OutputDebugStringA( "\r\n\r\n" );
+			bPassed = false;
 		}
 		if ( pc.PC != cvoVerifyMe.cvsEnd.cvrRegisters.ui16Pc ) {
 			::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
 			::OutputDebugStringA( "\r\nCPU Failure: PC\r\n" );
 			::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.cvsEnd.cvrRegisters.ui16Pc ) + std::string( " Got: " ) + std::to_string( pc.PC ) ).c_str() );
 			::OutputDebugStringA( "\r\n\r\n" );
+			bPassed = false;
 		}
 
 		if ( m_pbBus->ReadWriteLog().size() != cvoVerifyMe.vCycles.size() ) {
 			::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
 			::OutputDebugStringA( "\r\nInternal Error\r\n" );
 			::OutputDebugStringA( "\r\n\r\n" );
+			bPassed = false;
 		}
 		else {
 			//if ( m_pbBus->ReadWriteLog().size() != m_iInstructionSet[ui16LastInstr].
@@ -1281,22 +1384,92 @@ namespace lsn {
 					::OutputDebugStringA( "\r\nCPU Failure: Cycle Address Wrong\r\n" );
 					::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.vCycles[I].ui16Addr ) + std::string( " Got: " ) + std::to_string( m_pbBus->ReadWriteLog()[I].ui16Address ) ).c_str() );
 					::OutputDebugStringA( "\r\n\r\n" );
+					bPassed = false;
 				}
 				if ( m_pbBus->ReadWriteLog()[I].ui8Value != cvoVerifyMe.vCycles[I].ui8Value ) {
 					::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
 					::OutputDebugStringA( "\r\nCPU Failure: Cycle Value Wrong\r\n" );
 					::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.vCycles[I].ui8Value ) + std::string( " Got: " ) + std::to_string( m_pbBus->ReadWriteLog()[I].ui8Value ) ).c_str() );
 					::OutputDebugStringA( "\r\n\r\n" );
+					bPassed = false;
 				}
 				if ( m_pbBus->ReadWriteLog()[I].bRead != cvoVerifyMe.vCycles[I].bRead ) {
 					::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
 					::OutputDebugStringA( "\r\nCPU Failure: Cycle Read/Write Wrong\r\n" );
 					::OutputDebugStringA( (std::string( "Expected: ") + std::to_string( cvoVerifyMe.vCycles[I].bRead ) + std::string( " Got: " ) + std::to_string( m_pbBus->ReadWriteLog()[I].bRead ) ).c_str() );
 					::OutputDebugStringA( "\r\n\r\n" );
+					bPassed = false;
 				}
 			}
 		}
-		return true;
+
+		// Run it again through TickBlock(), then through compiled code, each of which must leave exactly what the cycle-by-cycle run
+		//	left.  Instructions they refuse (JAM, BRK, etc.) have nothing to compare.
+		struct LSN_SNAPSHOT {
+			std::vector<CCpuBus::LSN_READ_WRITE_LOG>
+											vLog;
+			std::vector<uint8_t>			vRam;
+			uint64_t						ui64Cycles;
+			uint16_t						ui16Pc;
+			uint8_t							ui8Regs[5];
+			LSN_CPU_CONTEXT					ccContext;
+			bool							bIsReadCycle;
+			uint8_t							ui8Float;
+		};
+		auto aSnapshot = [&]( LSN_SNAPSHOT &_sSnapshot ) {
+			_sSnapshot.vLog = m_pbBus->ReadWriteLog();
+			_sSnapshot.vRam.assign( m_pbBus->Memory(), m_pbBus->Memory() + m_pbBus->Size() );
+			_sSnapshot.ui64Cycles = m_ui64CycleCount;
+			_sSnapshot.ui16Pc = pc.PC;
+			const uint8_t ui8Regs[5] = { A, X, Y, S, m_ui8Status };
+			std::memcpy( _sSnapshot.ui8Regs, ui8Regs, sizeof( ui8Regs ) );
+			_sSnapshot.ccContext = m_ccCurContext;
+			_sSnapshot.bIsReadCycle = m_bIsReadCycle;
+			_sSnapshot.ui8Float = m_pbBus->GetFloat();
+		};
+		LSN_SNAPSHOT sTick, sBlock;
+		aSnapshot( sTick );
+		for ( auto I = cvoVerifyMe.cvsEnd.vRam.size(); I--; ) {
+			if ( sTick.vRam[cvoVerifyMe.cvsEnd.vRam[I].ui16Addr] != cvoVerifyMe.cvsEnd.vRam[I].ui8Value ) {
+				::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
+				::OutputDebugStringA( "\r\nCPU Failure: RAM\r\n" );
+				::OutputDebugStringA( (std::string( "Address: ") + std::to_string( cvoVerifyMe.cvsEnd.vRam[I].ui16Addr ) + std::string( " Expected: ") + std::to_string( cvoVerifyMe.cvsEnd.vRam[I].ui8Value ) + std::string( " Got: " ) + std::to_string( sTick.vRam[cvoVerifyMe.cvsEnd.vRam[I].ui16Addr] ) ).c_str() );
+				::OutputDebugStringA( "\r\n\r\n" );
+				bPassed = false;
+			}
+		}
+
+		const bool bJit = m_bJit;
+		for ( uint32_t J = 0; J < 2; ++J ) {
+			if ( J == 0 ) { m_bJit = false; }
+			else if ( !CJit6502::Available() ) { break; }
+			else { SetJit( true ); }
+
+			aStart();
+			m_pbBus->UpdatePageTable();
+			if ( !TickBlock( LSN_FP_MAX_CYCLES, 1 ) ) { continue; }
+			aSnapshot( sBlock );
+			bool bMatch = sBlock.ui64Cycles == sTick.ui64Cycles && sBlock.ui16Pc == sTick.ui16Pc &&
+				std::memcmp( sBlock.ui8Regs, sTick.ui8Regs, sizeof( sTick.ui8Regs ) ) == 0 &&
+				sBlock.ccContext.ui16OpCode == sTick.ccContext.ui16OpCode && sBlock.ccContext.a.ui16Address == sTick.ccContext.a.ui16Address &&
+				sBlock.ccContext.j.ui16JmpTarget == sTick.ccContext.j.ui16JmpTarget && sBlock.ccContext.ui8Cycle == sTick.ccContext.ui8Cycle &&
+				sBlock.ccContext.ui8FuncIdx == sTick.ccContext.ui8FuncIdx && sBlock.ccContext.ui8Operand == sTick.ccContext.ui8Operand &&
+				sBlock.ccContext.ui8Pointer == sTick.ccContext.ui8Pointer &&
+				sBlock.bIsReadCycle == sTick.bIsReadCycle && sBlock.ui8Float == sTick.ui8Float && sBlock.vRam == sTick.vRam &&
+				sBlock.vLog.size() == sTick.vLog.size();
+			for ( size_t I = 0; I < sTick.vLog.size() && bMatch; ++I ) {
+				bMatch = sBlock.vLog[I].ui16Address == sTick.vLog[I].ui16Address && sBlock.vLog[I].ui8Value == sTick.vLog[I].ui8Value &&
+					sBlock.vLog[I].bRead == sTick.vLog[I].bRead;
+			}
+			if ( !bMatch ) {
+				::OutputDebugStringA( cvoVerifyMe.sName.c_str() );
+				::OutputDebugStringA( J == 0 ? "\r\nCPU Failure: TickBlock() differs from Tick()\r\n" : "\r\nCPU Failure: TickJit() differs from Tick()\r\n" );
+				::OutputDebugStringA( "\r\n\r\n" );
+				bPassed = false;
+			}
+		}
+		m_bJit = bJit;
+		return bPassed;
 	}
 #endif	// #ifdef LSN_CPU_VERIFY
 
@@ -1354,6 +1527,571 @@ namespace lsn {
 		(this->*m_iInstructionSet[m_ccCurContext.ui16OpCode].pfHandler[m_ccCurContext.ui8FuncIdx])();
 	}
 
+	/** Performs a cycle inside an instruction, dispatching through m_moiMicroOpIds. */
+	void CCpu6502::Tick_InstructionCycleSwitch() {
+		// A dense switch becomes 1 jump table indexed by a byte, and each case is a direct call the compiler is free to inline.
+		switch ( m_moiMicroOpIds.ui8Ids[m_ccCurContext.ui16OpCode][m_ccCurContext.ui8FuncIdx] ) {
+#define LSN_MICRO_OP( ID, ... )			case LSN_MO_ ## ID : { __VA_ARGS__(); return; }
+			LSN_MICRO_OP_LIST
+#undef LSN_MICRO_OP
+			default : {
+				// Handlers missing from LSN_MICRO_OP_LIST.
+				(this->*m_iInstructionSet[m_ccCurContext.ui16OpCode].pfHandler[m_ccCurContext.ui8FuncIdx])();
+			}
+		}
+	}
+
+	/**
+	 * Builds m_moiMicroOpIds by finding each handler of m_iInstructionSet in LSN_MICRO_OP_LIST.
+	 *
+	 * \return Returns the micro-op ID's of m_iInstructionSet.
+	 */
+	CCpu6502::LSN_MICRO_OP_IDS CCpu6502::BuildMicroOpIds() {
+		static const PfCycle pfOps[LSN_MO_TOTAL] = {
+			nullptr,
+#define LSN_MICRO_OP( ID, ... )			&CCpu6502::__VA_ARGS__,
+			LSN_MICRO_OP_LIST
+#undef LSN_MICRO_OP
+		};
+		LSN_MICRO_OP_IDS moiRet = {};
+		for ( size_t I = 0; I < LSN_ELEMENTS( m_iInstructionSet ); ++I ) {
+			for ( size_t J = 0; J < LSN_M_MAX_INSTR_CYCLE_COUNT; ++J ) {
+				const PfCycle pfThis = m_iInstructionSet[I].pfHandler[J];
+				if ( !pfThis ) { continue; }
+				for ( size_t K = LSN_MO_NONE + 1; K < LSN_MO_TOTAL; ++K ) {
+					if ( pfOps[K] == pfThis ) {
+						moiRet.ui8Ids[I][J] = uint8_t( K );
+						break;
+					}
+				}
+			}
+		}
+		return moiRet;
+	}
+
+	/**
+	 * Runs the whole next instruction in 1 call if nothing outside the CPU can observe its intermediate cycles: the CPU is between
+	 *	instructions, no DMA, NMI, or IRQ is pending, and every address the instruction can touch is plain RAM/ROM in the bus page table.
+	 *	Each cycle still runs exactly as it does through Tick(); only the caller's interleaving of the other components is skipped.
+	 *
+	 * \return Returns the number of cycles run, or 0 if the instruction must be run 1 cycle at a time through Tick().
+	 */
+	uint32_t CCpu6502::TickInstruction() {
+		// DMA replaces m_pfTickFunc, so this also rules out a transfer in progress.
+		if ( m_pfTickFunc != &CCpu6502::Tick_NextInstructionStd || m_bHandleNmi || m_bHandleIrq || m_bRdyLow ) { return 0; }
+		if ( !(m_bDecodeCache ? CachedInstructionIsQuiet() : InstructionIsQuiet()) ) { return 0; }
+#ifdef LSN_CPU_FAST_PATH_CHECK
+		const uint64_t ui64Handlers = m_pbBus->HandlerAccesses();
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+
+		uint32_t ui32Cycles = 0;
+		do {
+			Tick();
+			++ui32Cycles;
+		} while ( m_pfTickFunc != &CCpu6502::Tick_NextInstructionStd && ui32Cycles < LSN_FP_MAX_CYCLES );
+
+#ifdef LSN_CPU_FAST_PATH_CHECK
+		// Only a per-address bus function can see when an access happens relative to the other components, so an instruction that
+		//	reached none of them and finished within the bound behaved exactly as it would have 1 cycle at a time.
+		if ( m_pbBus->HandlerAccesses() != ui64Handlers || m_pfTickFunc != &CCpu6502::Tick_NextInstructionStd ) {
+			++m_ui64FastCheckFailures;
+		}
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+		++m_ui64FastInstructions;
+		m_ui64FastCycles += ui32Cycles;
+		return ui32Cycles;
+	}
+
+	/**
+	 * Runs instructions through TickInstruction() back-to-back, without returning to the caller between them, for as long as each
+	 *	one is eligible and cannot run past the given number of cycles.  Stops before any instruction that touches I/O, before an
+	 *	interrupt or DMA, and wherever the bank mapping of the code changes.
+	 *
+	 * \param _ui32MaxCycles The most cycles to run.  An instruction is only started if LSN_FP_MAX_CYCLES more cycles fit.
+	 * \param _ui32MaxInstructions The most instructions to run.
+	 * \return Returns the number of cycles run, or 0 if the next instruction must be run 1 cycle at a time through Tick().
+	 */
+	uint32_t CCpu6502::TickBlock( uint32_t _ui32MaxCycles, uint32_t _ui32MaxInstructions ) {
+		// Bank switches and interrupt-line changes only happen through I/O, which TickInstruction() refuses, or between the caller's
+		//	sync points, which the budget keeps this from crossing.  A pending interrupt or DMA is seen at the next instruction boundary.
+		uint32_t ui32Cycles = 0;
+		uint16_t ui16Prev = 0xFFFF;
+		for ( uint32_t I = 0; I < _ui32MaxInstructions && ui32Cycles + LSN_FP_MAX_CYCLES <= _ui32MaxCycles; ) {
+			const uint16_t ui16Pc = pc.PC;
+			uint32_t ui32Inst = 0;
+			uint32_t ui32Count = 1;
+			// Loops are entered at the start of the block or through a jump or branch backwards.
+			if ( m_bIdleSkip && ui16Pc <= ui16Prev ) {
+				ui32Inst = TickIdleLoop( _ui32MaxCycles - ui32Cycles );
+			}
+			if ( !ui32Inst && m_bJit ) {
+				ui32Count = _ui32MaxInstructions - I;
+				bool bLooped = m_bIdleSkip;
+				ui32Inst = TickJit( _ui32MaxCycles - ui32Cycles, ui32Count, bLooped );
+				if ( ui32Inst ) {
+					// Compiled code runs past the tops of loops unless it stopped at one.
+					ui16Prev = bLooped ? 0xFFFF : 0;
+					ui32Cycles += ui32Inst;
+					I += ui32Count;
+					continue;
+				}
+				ui32Count = 1;
+			}
+			if ( !ui32Inst ) {
+				ui32Inst = TickInstruction();
+				if ( !ui32Inst ) { break; }
+			}
+			ui16Prev = ui16Pc;
+			ui32Cycles += ui32Inst;
+			I += ui32Count;
+		}
+		if ( ui32Cycles ) { ++m_ui64FastBlocks; }
+		return ui32Cycles;
+	}
+
+	/**
+	 * Skips whole passes of a short loop that cannot change anything, such as JMP * or a loop polling a RAM flag set by the NMI
+	 *	handler.  The loop at PC is run through TickInstruction() until a pass leaves the CPU exactly as it found it.  The loop writes
+	 *	nothing and reads only RAM/ROM, so every later pass would do the same, and as many passes as fit are skipped by advancing the
+	 *	cycle counter.
+	 *
+	 * \param _ui32MaxCycles The most cycles to run and skip.
+	 * \return Returns the number of cycles run and skipped, or 0 if PC is not the top of such a loop.
+	 */
+	uint32_t CCpu6502::TickIdleLoop( uint32_t _ui32MaxCycles ) {
+		if ( !IdleLoopCycles( 0 ) ) { return 0; }
+		const uint16_t ui16Top = pc.PC;
+		uint32_t ui32Cycles = 0;
+		// The context still holds whatever led into the loop, so it can take a pass before a pass repeats.
+		IdleLoopRepeats( 0 );
+		for ( uint32_t I = 0; I < 2; ++I ) {
+			uint32_t ui32Pass = 0;
+			uint32_t ui32Insts = 0;
+			do {
+				if ( ui32Cycles + ui32Pass + LSN_FP_MAX_CYCLES > _ui32MaxCycles ) { return ui32Cycles + ui32Pass; }
+				const uint32_t ui32Inst = TickInstruction();
+				if ( !ui32Inst ) { return ui32Cycles + ui32Pass; }
+				ui32Pass += ui32Inst;
+			} while ( pc.PC != ui16Top && ++ui32Insts < LSN_FP_IDLE_MAX_INSTS );
+			ui32Cycles += ui32Pass;
+			if ( pc.PC != ui16Top ) { break; }
+			if ( IdleLoopRepeats( ui32Pass ) ) {
+				const uint32_t ui32Skip = (_ui32MaxCycles - ui32Cycles) / ui32Pass * ui32Pass;
+				if ( ui32Skip ) { SkipIdleCycles( ui32Skip, false ); }
+				return ui32Cycles + ui32Skip;
+			}
+		}
+		return ui32Cycles;
+	}
+
+	/**
+	 * Gets the length of 1 pass of the loop at PC if the loop may be skipped: at most LSN_FP_IDLE_MAX_INSTS instructions ending in a
+	 *	branch or JMP back to PC, with no writes or stack accesses, while no interrupt or DMA is pending.  Reads must be plain RAM/ROM,
+	 *	except absolute reads of _ui16IoAddr, which only the caller can know to be stable.
+	 *
+	 * \param _ui16IoAddr An I/O register the loop may read, or 0 for none.
+	 * \return Returns the cycles of 1 pass, not counting page crossings of indexed reads, or 0 if the loop cannot be skipped.
+	 */
+	uint32_t CCpu6502::IdleLoopCycles( uint16_t _ui16IoAddr ) const {
+		// Per-cycle mapper counters would have to be ticked through the skipped cycles.
+		if ( m_pfTickFunc != &CCpu6502::Tick_NextInstructionStd || m_bHandleNmi || m_bHandleIrq || m_bRdyLow || m_bTickMapper ) { return 0; }
+		const CCpuBus & bBus = (*m_pbBus);
+		const uint16_t ui16Top = pc.PC;
+		uint16_t ui16Pc = ui16Top;
+		uint32_t ui32Cycles = 0;
+		for ( uint32_t I = 0; I < LSN_FP_IDLE_MAX_INSTS; ++I ) {
+			if ( !bBus.IsDirectRead( ui16Pc ) ) { return 0; }
+			const LSN_INSTR & iInstr = m_iInstructionSet[bBus.PeekDirect( ui16Pc )];
+			const uint32_t ui32Fetch = FetchBytes( iInstr );
+			for ( uint32_t J = 1; J < ui32Fetch; ++J ) {
+				if ( !bBus.IsDirectRead( uint16_t( ui16Pc + J ) ) ) { return 0; }
+			}
+			const uint16_t ui16Operand = uint16_t( bBus.PeekDirect( uint16_t( ui16Pc + 1 ) ) |
+				(iInstr.ui8Size > 2 ? (bBus.PeekDirect( uint16_t( ui16Pc + 2 ) ) << 8) : 0) );
+			const uint16_t ui16Next = uint16_t( ui16Pc + iInstr.ui8Size );
+
+			const uint8_t ui8Check = QuietCheckOf( iInstr );
+			switch ( ui8Check ) {
+				case LSN_QC_NONE : { break; }
+				case LSN_QC_ZERO_PAGE : {
+					if ( !QuietCheck( ui8Check, ui16Operand ) ) { return 0; }
+					break;
+				}
+				case LSN_QC_ABSOLUTE : {
+					if ( _ui16IoAddr && ui16Operand == _ui16IoAddr ) { break; }
+					if ( !QuietCheck( ui8Check, ui16Operand ) ) { return 0; }
+					break;
+				}
+				case LSN_QC_ABSOLUTE_X : {}
+				case LSN_QC_ABSOLUTE_Y : {}
+				case LSN_QC_INDIRECT_X : {}
+				case LSN_QC_INDIRECT_Y : {
+					// These addresses depend on registers part-way through the pass, which only TickInstruction() checks as it runs.
+					if ( _ui16IoAddr ) { return 0; }
+					break;
+				}
+				default : { return 0; }
+			}
+
+			if ( iInstr.amAddrMode == LSN_AM_RELATIVE ) {
+				const uint16_t ui16Target = uint16_t( ui16Next + int8_t( uint8_t( ui16Operand ) ) );
+				if ( ui16Target == ui16Top ) {
+					return ui32Cycles + 3 + (((ui16Target ^ ui16Next) & 0xFF00) ? 1 : 0);
+				}
+				// Any other branch must not be taken for the pass to return to the top.
+				ui32Cycles += 2;
+			}
+			else if ( iInstr.iInstruction == LSN_I_JMP ) {
+				return (iInstr.amAddrMode == LSN_AM_ABSOLUTE && ui16Operand == ui16Top) ? ui32Cycles + 3 : 0;
+			}
+			else { ui32Cycles += iInstr.ui8TotalCycles; }
+			ui16Pc = ui16Next;
+		}
+		return 0;
+	}
+
+	/**
+	 * Compares the CPU with the state it was in when this was last called, then keeps the current state for the next call.
+	 *
+	 * \param _ui32Cycles The cycles of 1 pass of the loop at PC.
+	 * \return Returns true if exactly _ui32Cycles cycles have run since the last call and the CPU state is unchanged.
+	 */
+	bool CCpu6502::IdleLoopRepeats( uint32_t _ui32Cycles ) {
+		LSN_IDLE_STATE isState;
+		GetIdleState( isState );
+		const bool bRepeats = _ui32Cycles && m_ui64CycleCount - m_ui64IdleCycle == _ui32Cycles &&
+			std::memcmp( &isState, &m_isIdleState, sizeof( isState ) ) == 0;
+		m_isIdleState = isState;
+		m_ui64IdleCycle = m_ui64CycleCount;
+		return bRepeats;
+	}
+
+	/**
+	 * Advances the CPU over whole passes of a loop that IdleLoopRepeats() showed to change nothing.
+	 *
+	 * \param _ui64Cycles The cycles to skip, a multiple of the pass length.
+	 * \param _bIo If true, the loop polls an I/O register that the caller showed to be stable.
+	 */
+	void CCpu6502::SkipIdleCycles( uint64_t _ui64Cycles, bool _bIo ) {
+		m_ui64CycleCount += _ui64Cycles;
+		// The state is that of the top of the loop again, so the next pass can be compared against it.
+		m_ui64IdleCycle = m_ui64CycleCount;
+		++m_ui64IdleSkips;
+		m_ui64IdleCycles += _ui64Cycles;
+		if ( _bIo ) { m_ui64IdleIoCycles += _ui64Cycles; }
+	}
+
+	/**
+	 * Gets the state compared by IdleLoopRepeats().
+	 *
+	 * \param _isState Holds the returned state.
+	 */
+	void CCpu6502::GetIdleState( LSN_IDLE_STATE &_isState ) const {
+		// Cleared first so that the padding compares equal.
+		std::memset( &_isState, 0, sizeof( _isState ) );
+		_isState.ccContext = m_ccCurContext;
+		_isState.ui16Pc = pc.PC;
+		_isState.ui8A = A;
+		_isState.ui8X = X;
+		_isState.ui8Y = Y;
+		_isState.ui8S = S;
+		_isState.ui8Status = m_ui8Status;
+		_isState.bNmiStatusLine = m_bNmiStatusLine;
+		_isState.bLastNmiStatusLine = m_bLastNmiStatusLine;
+		_isState.bDetectedNmi = m_bDetectedNmi;
+		_isState.bIrqStatusLine = m_bIrqStatusLine;
+		_isState.bIsReadCycle = m_bIsReadCycle;
+	}
+
+	/**
+	 * Enables or disables the decoded-block cache used by TickInstruction().  Disabling it frees the cache.
+	 *
+	 * \param _bEnable If true, TickInstruction() looks instructions up in the cache instead of decoding them each time.
+	 */
+	void CCpu6502::SetDecodeCache( bool _bEnable ) {
+		m_bDecodeCache = _bEnable;
+		if ( !_bEnable ) { m_dcDecodeCache.Clear(); }
+	}
+
+	/**
+	 * Enables or disables compiled code in TickBlock().  Disabling it frees the compiled code.  Stays disabled where CJit6502 is not
+	 *	available.
+	 *
+	 * \param _bEnable If true, TickBlock() runs instructions through TickJit() before trying TickInstruction().
+	 */
+	void CCpu6502::SetJit( bool _bEnable ) {
+		m_bJit = _bEnable && CJit6502::Available();
+		if ( !m_bJit ) {
+			m_jJit.Reset();
+			return;
+		}
+		// Compiled code addresses the CPU through offsets from this.
+		const uint8_t * pui8This = reinterpret_cast<const uint8_t *>(this);
+		auto aOff = [pui8This]( const void * _pvMember ) { return uint32_t( static_cast<const uint8_t *>(_pvMember) - pui8This ); };
+		CJit6502::LSN_LAYOUT lLayout;
+		lLayout.ui32Pc = aOff( &pc.PC );
+		lLayout.ui32A = aOff( &A );
+		lLayout.ui32X = aOff( &X );
+		lLayout.ui32Y = aOff( &Y );
+		lLayout.ui32S = aOff( &S );
+		lLayout.ui32Status = aOff( &m_ui8Status );
+		lLayout.ui32IsReadCycle = aOff( &m_bIsReadCycle );
+		lLayout.ui32OpCode = aOff( &m_ccCurContext.ui16OpCode );
+		lLayout.ui32Address = aOff( &m_ccCurContext.a.ui16Address );
+		lLayout.ui32JmpTarget = aOff( &m_ccCurContext.j.ui16JmpTarget );
+		lLayout.ui32FuncIdx = aOff( &m_ccCurContext.ui8FuncIdx );
+		lLayout.ui32Operand = aOff( &m_ccCurContext.ui8Operand );
+		lLayout.ui32Pointer = aOff( &m_ccCurContext.ui8Pointer );
+
+		CJit6502::LSN_OPCODE oOpcodes[256];
+		for ( size_t I = 0; I < LSN_ELEMENTS( oOpcodes ); ++I ) {
+			oOpcodes[I].ui8AddrMode = uint8_t( m_iInstructionSet[I].amAddrMode );
+			oOpcodes[I].ui8Instruction = uint8_t( m_iInstructionSet[I].iInstruction );
+			oOpcodes[I].ui8Size = m_iInstructionSet[I].ui8Size;
+			oOpcodes[I].ui8Fetch = uint8_t( FetchBytes( m_iInstructionSet[I] ) );
+		}
+		m_jJit.SetCpu( lLayout, oOpcodes );
+	}
+
+	/**
+	 * Runs instructions at PC through compiled x86-64 code (see CJit6502) for as long as each one can run without anything outside the
+	 *	CPU observing it.  Each instruction makes the same bus accesses and takes the same cycles as through Tick(), and leaves the same
+	 *	state behind.
+	 *
+	 * \param _ui32MaxCycles The most cycles to run.  An instruction is only started if its longest path fits.
+	 * \param _ui32Insts On input, the most instructions to run.  On output, the number run.
+	 * \param _bStopAtLoops On input, if true, stops after a jump or branch backwards.  On output, true if it did so.
+	 * \return Returns the number of cycles run, or 0 if the next instruction must be run some other way.
+	 */
+	uint32_t CCpu6502::TickJit( uint32_t _ui32MaxCycles, uint32_t &_ui32Insts, bool &_bStopAtLoops ) {
+		// Compiled code does not tick the mapper or look at the interrupt lines, so it only runs while Tick() would leave them alone:
+		//	between instructions, with no DMA, no interrupt pending or asserted, and no NMI edge waiting to be seen.  The lines only change
+		//	through I/O, which ends a run.
+		if ( m_pfTickFunc != &CCpu6502::Tick_NextInstructionStd || m_bHandleNmi || m_bHandleIrq || m_bIrqStatusLine || m_bDetectedNmi ||
+			m_bLastNmiStatusLine != m_bNmiStatusLine || m_bRdyLow || m_bTickMapper ) {
+			_ui32Insts = 0;
+			_bStopAtLoops = false;
+			return 0;
+		}
+		const uint32_t ui32Cycles = m_jJit.Run( this, (*m_pbBus), _ui32MaxCycles, _ui32Insts, _bStopAtLoops );
+		if ( ui32Cycles ) {
+			m_pfTickFuncCopy = &CCpu6502::Tick_NextInstructionStd;
+			m_ccCurContext.ui8Cycle = 1;
+			m_ui64CycleCount += ui32Cycles;
+			m_ui64FastInstructions += _ui32Insts;
+			m_ui64FastCycles += ui32Cycles;
+		}
+		return ui32Cycles;
+	}
+
+	/**
+	 * Determines whether every address the instruction at PC can read or write is plain RAM/ROM in the bus page table.  Effective
+	 *	addresses are computed from the current registers and memory, including the wrong-page addresses of indexed dummy reads.
+	 *	Instructions that never finish (JAM), read the interrupt vectors (BRK), or form their addresses from their data (SHA, SHX,
+	 *	SHY, TAS) are never eligible.
+	 *
+	 * \return Returns true if the instruction at PC has no side effects outside the CPU and bus memory.
+	 */
+	bool CCpu6502::InstructionIsQuiet() const {
+		const CCpuBus & bBus = (*m_pbBus);
+		const uint16_t ui16Pc = pc.PC;
+		if ( !bBus.IsDirectRead( ui16Pc ) ) { return false; }
+		const LSN_INSTR & iInstr = m_iInstructionSet[bBus.PeekDirect( ui16Pc )];
+		const uint32_t ui32Fetch = FetchBytes( iInstr );
+		for ( uint32_t I = 1; I < ui32Fetch; ++I ) {
+			if ( !bBus.IsDirectRead( uint16_t( ui16Pc + I ) ) ) { return false; }
+		}
+		const uint16_t ui16Operand = uint16_t( bBus.PeekDirect( uint16_t( ui16Pc + 1 ) ) |
+			(iInstr.ui8Size > 2 ? (bBus.PeekDirect( uint16_t( ui16Pc + 2 ) ) << 8) : 0) );
+		return QuietCheck( QuietCheckOf( iInstr ), ui16Operand );
+	}
+
+	/**
+	 * Determines through the decoded-block cache whether the instruction at PC has no side effects outside the CPU and bus memory.
+	 *	Falls back to InstructionIsQuiet() for an instruction that does not fit in its page.
+	 *
+	 * \return Returns true if the instruction at PC has no side effects outside the CPU and bus memory.
+	 */
+	bool CCpu6502::CachedInstructionIsQuiet() {
+		const uint16_t ui16Pc = pc.PC;
+		// The block was decoded from this memory, so every byte it fetches is still a direct read.
+		const uint8_t * pui8Page = m_pbBus->PageTableRead( uint16_t( ui16Pc >> 8 ) );
+		if ( !pui8Page ) { return false; }
+		const CDecodeCache::LSN_DECODED_INST * pdiInst = m_dcDecodeCache.Find( ui16Pc, pui8Page );
+		if ( !pdiInst ) {
+			pdiInst = DecodeBlock( ui16Pc, pui8Page );
+			if ( !pdiInst ) { return InstructionIsQuiet(); }
+		}
+		return QuietCheck( pdiInst->ui8Check, pdiInst->ui16Operand );
+	}
+
+	/**
+	 * Decodes a block of instructions into the decoded-block cache.  The block ends after a jump, branch, or return, or before an
+	 *	instruction whose fetches leave the page.
+	 *
+	 * \param _ui16Pc The address of the first instruction.
+	 * \param _pui8Page The page-table memory of the page holding _ui16Pc.
+	 * \return Returns the first instruction of the new block, or nullptr if the first instruction's fetches leave the page.
+	 */
+	const CDecodeCache::LSN_DECODED_INST * CCpu6502::DecodeBlock( uint16_t _ui16Pc, const uint8_t * _pui8Page ) {
+		uint32_t ui32Low = _ui16Pc & 0xFF;
+		if ( ui32Low + FetchBytes( m_iInstructionSet[_pui8Page[ui32Low]] ) > CCpuBus::LSN_BP_PAGE_SIZE ) { return nullptr; }
+
+		CDecodeCache::LSN_BLOCK & bBlock = m_dcDecodeCache.Begin( _ui16Pc, _pui8Page );
+		while ( bBlock.ui8Count < CDecodeCache::LSN_DC_BLOCK_INSTS && ui32Low < CCpuBus::LSN_BP_PAGE_SIZE ) {
+			const uint8_t ui8Op = _pui8Page[ui32Low];
+			const LSN_INSTR & iInstr = m_iInstructionSet[ui8Op];
+			if ( ui32Low + FetchBytes( iInstr ) > CCpuBus::LSN_BP_PAGE_SIZE ) { break; }
+
+			CDecodeCache::LSN_DECODED_INST & diInst = bBlock.diInsts[bBlock.ui8Count++];
+			diInst.ui8Op = ui8Op;
+			diInst.ui8Low = uint8_t( ui32Low );
+			diInst.ui8Size = iInstr.ui8Size;
+			diInst.ui8Check = QuietCheckOf( iInstr );
+			diInst.ui16Operand = uint16_t( (iInstr.ui8Size > 1 ? _pui8Page[ui32Low+1] : 0) |
+				(iInstr.ui8Size > 2 ? (_pui8Page[ui32Low+2] << 8) : 0) );
+
+			switch ( iInstr.iInstruction ) {
+				case LSN_I_JAM : {}
+				case LSN_I_BRK : {}
+				case LSN_I_JMP : {}
+				case LSN_I_JSR : {}
+				case LSN_I_RTS : {}
+				case LSN_I_RTI : { return &bBlock.diInsts[0]; }
+				default : {}
+			}
+			if ( iInstr.amAddrMode == LSN_AM_RELATIVE ) { break; }
+			ui32Low += iInstr.ui8Size;
+		}
+		return &bBlock.diInsts[0];
+	}
+
+	/**
+	 * Checks the addresses an instruction touches besides its own bytes against the bus page table, using the current registers
+	 *	and memory.
+	 *
+	 * \param _ui8Check The LSN_QUIET_CHECK value of the instruction, optionally combined with LSN_QC_WRITES.
+	 * \param _ui16Operand The operand bytes of the instruction, low byte first.
+	 * \return Returns true if every address the instruction touches besides its own bytes is plain RAM/ROM.
+	 */
+	bool CCpu6502::QuietCheck( uint8_t _ui8Check, uint16_t _ui16Operand ) const {
+		const CCpuBus & bBus = (*m_pbBus);
+		const bool bWrites = (_ui8Check & LSN_QC_WRITES) != 0;
+		const uint16_t ui16Stack = uint16_t( 0x100 + S );
+		const uint8_t ui8Op = uint8_t( _ui16Operand );
+
+		uint16_t ui16Base, ui16Addr;
+		switch ( _ui8Check & ~LSN_QC_WRITES ) {
+			case LSN_QC_NONE : { return true; }
+			case LSN_QC_STACK : {
+				return bBus.IsDirectRead( ui16Stack ) && bBus.IsDirectWrite( ui16Stack );
+			}
+			case LSN_QC_RTS : {
+				if ( !bBus.IsDirectRead( ui16Stack ) ) { return false; }
+				// The last cycle reads the pulled address before incrementing it.
+				const uint16_t ui16Ret = uint16_t( bBus.PeekDirect( uint16_t( 0x100 + uint8_t( S + 1 ) ) ) |
+					(bBus.PeekDirect( uint16_t( 0x100 + uint8_t( S + 2 ) ) ) << 8) );
+				return bBus.IsDirectRead( ui16Ret );
+			}
+			case LSN_QC_JMP_IND : {
+				// JMP (ind) reads its pointer without carrying into the high byte, so both bytes are on the pointer's page.
+				return bBus.IsDirectRead( _ui16Operand );
+			}
+			case LSN_QC_ZERO_PAGE : {
+				return bBus.IsDirectRead( 0x0000 ) && (!bWrites || bBus.IsDirectWrite( 0x0000 ));
+			}
+			case LSN_QC_ABSOLUTE : {
+				ui16Base = ui16Addr = _ui16Operand;
+				break;
+			}
+			case LSN_QC_ABSOLUTE_X : {
+				ui16Base = _ui16Operand;
+				ui16Addr = uint16_t( ui16Base + X );
+				break;
+			}
+			case LSN_QC_ABSOLUTE_Y : {
+				ui16Base = _ui16Operand;
+				ui16Addr = uint16_t( ui16Base + Y );
+				break;
+			}
+			case LSN_QC_INDIRECT_X : {
+				if ( !bBus.IsDirectRead( 0x0000 ) ) { return false; }
+				const uint8_t ui8Ptr = uint8_t( ui8Op + X );
+				ui16Base = ui16Addr = uint16_t( bBus.PeekDirect( ui8Ptr ) | (bBus.PeekDirect( uint8_t( ui8Ptr + 1 ) ) << 8) );
+				break;
+			}
+			case LSN_QC_INDIRECT_Y : {
+				if ( !bBus.IsDirectRead( 0x0000 ) ) { return false; }
+				ui16Base = uint16_t( bBus.PeekDirect( ui8Op ) | (bBus.PeekDirect( uint8_t( ui8Op + 1 ) ) << 8) );
+				ui16Addr = uint16_t( ui16Base + Y );
+				break;
+			}
+			default : { return false; }
+		}
+		// Indexed accesses first read the address formed before the carry into the high byte.
+		const uint16_t ui16Wrong = uint16_t( (ui16Base & 0xFF00) | (ui16Addr & 0x00FF) );
+		return bBus.IsDirectRead( ui16Wrong ) && bBus.IsDirectRead( ui16Addr ) && (!bWrites || bBus.IsDirectWrite( ui16Addr ));
+	}
+
+	/**
+	 * Gets what an instruction touches besides its own bytes.
+	 *
+	 * \param _iInstr The instruction.
+	 * \return Returns a LSN_QUIET_CHECK value, combined with LSN_QC_WRITES if the instruction writes to its effective address.
+	 */
+	uint8_t CCpu6502::QuietCheckOf( const LSN_INSTR &_iInstr ) {
+		uint8_t ui8Writes = 0;
+		switch ( _iInstr.iInstruction ) {
+			case LSN_I_JAM : {}
+			case LSN_I_BRK : {}
+			case LSN_I_SHA : {}
+			case LSN_I_SHX : {}
+			case LSN_I_SHY : {}
+			case LSN_I_TAS : { return LSN_QC_NEVER; }
+			case LSN_I_PHA : {}
+			case LSN_I_PHP : {}
+			case LSN_I_PLA : {}
+			case LSN_I_PLP : {}
+			case LSN_I_RTI : {}
+			case LSN_I_JSR : { return LSN_QC_STACK; }
+			case LSN_I_RTS : { return LSN_QC_RTS; }
+			case LSN_I_JMP : { return _iInstr.amAddrMode == LSN_AM_INDIRECT ? LSN_QC_JMP_IND : LSN_QC_NONE; }
+			case LSN_I_STA : {}
+			case LSN_I_STX : {}
+			case LSN_I_STY : {}
+			case LSN_I_SAX : { ui8Writes = LSN_QC_WRITES; break; }
+			case LSN_I_ASL : {}
+			case LSN_I_LSR : {}
+			case LSN_I_ROL : {}
+			case LSN_I_ROR : {}
+			case LSN_I_INC : {}
+			case LSN_I_DEC : {}
+			case LSN_I_SLO : {}
+			case LSN_I_RLA : {}
+			case LSN_I_SRE : {}
+			case LSN_I_RRA : {}
+			case LSN_I_DCP : {}
+			case LSN_I_ISC : { ui8Writes = LSN_QC_WRITES; break; }
+			default : {}
+		}
+
+		switch ( _iInstr.amAddrMode ) {
+			case LSN_AM_IMPLIED : {}
+			case LSN_AM_ACCUMULATOR : {}
+			case LSN_AM_IMMEDIATE : {}
+			case LSN_AM_RELATIVE : { return LSN_QC_NONE; }
+			case LSN_AM_ZERO_PAGE : {}
+			case LSN_AM_ZERO_PAGE_X : {}
+			case LSN_AM_ZERO_PAGE_Y : { return uint8_t( LSN_QC_ZERO_PAGE | ui8Writes ); }
+			case LSN_AM_ABSOLUTE : { return uint8_t( LSN_QC_ABSOLUTE | ui8Writes ); }
+			case LSN_AM_ABSOLUTE_X : { return uint8_t( LSN_QC_ABSOLUTE_X | ui8Writes ); }
+			case LSN_AM_ABSOLUTE_Y : { return uint8_t( LSN_QC_ABSOLUTE_Y | ui8Writes ); }
+			case LSN_AM_INDIRECT_X : { return uint8_t( LSN_QC_INDIRECT_X | ui8Writes ); }
+			case LSN_AM_INDIRECT_Y : { return uint8_t( LSN_QC_INDIRECT_Y | ui8Writes ); }
+			default : { return LSN_QC_NEVER; }
+		}
+	}
+
 	/** DMA start. Moves on to the DMA read/write cycle when the current CPU cycle is even (IE odd cycles take 1 extra cycle). */
 	void CCpu6502::Tick_DmaStart() {
 		if ( (m_ui64CycleCount & 0x1) == 0 ) {
@@ -1404,6 +2142,20 @@ namespace lsn {
 		}
 	}
 
+	/**
+	 * Gets the index of a tick function in m_pfTickFuncs.
+	 *
+	 * \param _pfFunc The tick function.
+	 * \return Returns the index of the tick function, or 0xFF if it is not in m_pfTickFuncs.
+	 */
+	uint8_t CCpu6502::TickFuncToIndex( PfTicks _pfFunc ) {
+		if ( _pfFunc == &CCpu6502::Tick_InstructionCycleSwitch ) { _pfFunc = &CCpu6502::Tick_InstructionCycleStd; }
+		for ( size_t I = 0; I < LSN_ELEMENTS( m_pfTickFuncs ); ++I ) {
+			if ( m_pfTickFuncs[I] == _pfFunc ) { return uint8_t( I ); }
+		}
+		return 0xFF;
+	}
+
 	/**
 	 * Reads the next instruction byte and throws it away.
 	 */
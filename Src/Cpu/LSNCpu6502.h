@@ -23,13 +23,15 @@
 #include "../System/LSNNmiable.h"
 #include "../System/LSNTickable.h"
 #include "LSNCpuBase.h"
+#include "LSNDecodeCache.h"
+#include "LSNJit6502.h"
 #include <vector>
 
 #define LSN_USE_INTRINS
 
-#ifdef LSN_USE_INTRINS
+#if defined( LSN_USE_INTRINS ) && defined( LSN_WINDOWS )
 #include <intrin.h>
-#endif	// #ifdef LSN_USE_INTRINS
+#endif	// #if defined( LSN_USE_INTRINS ) && defined( LSN_WINDOWS )
 
 #ifdef LSN_CPU_VERIFY
 #include "LSONJson.h"
@@ -83,6 +85,29 @@ namespace lsn {
 			LSN_SO_IRQ						= 0x101,										/**< The NMI instruction. */
 		};
 
+		/** Instruction-granular execution. */
+		enum LSN_FAST_PATH {
+			LSN_FP_MAX_CYCLES				= LSN_M_MAX_INSTR_CYCLE_COUNT + 1,				/**< The most cycles TickInstruction() can run: the opcode fetch plus every cycle of the instruction. */
+			LSN_FP_IDLE_MAX_INSTS			= 6,											/**< The most instructions in a loop that TickIdleLoop() can skip. */
+		};
+
+		/** What an instruction touches besides its own bytes, as checked before TickInstruction() runs it. */
+		enum LSN_QUIET_CHECK : uint8_t {
+			LSN_QC_NEVER,																	/**< Never run in 1 call (JAM, BRK, SHA, SHX, SHY, TAS). */
+			LSN_QC_NONE,																	/**< Nothing. */
+			LSN_QC_STACK,																	/**< The stack page. */
+			LSN_QC_RTS,																		/**< The stack page and the pulled return address. */
+			LSN_QC_JMP_IND,																	/**< The pointer of JMP (ind). */
+			LSN_QC_ZERO_PAGE,																/**< The zero page. */
+			LSN_QC_ABSOLUTE,																/**< The absolute operand. */
+			LSN_QC_ABSOLUTE_X,																/**< The absolute operand plus X and its wrong-page address. */
+			LSN_QC_ABSOLUTE_Y,																/**< The absolute operand plus Y and its wrong-page address. */
+			LSN_QC_INDIRECT_X,																/**< The zero page and the pointer at operand plus X. */
+			LSN_QC_INDIRECT_Y,																/**< The zero page and the pointer at the operand plus Y and its wrong-page address. */
+
+			LSN_QC_WRITES					= 0x80,											/**< The instruction writes to its effective address. */
+		};
+
 
 		// == Functions.
 		/**
@@ -98,7 +123,222 @@ namespace lsn {
 		/**
 		 * Performs a single cycle update.
 		 */
-		virtual void						Tick();
+		virtual inline void					Tick() final;
+
+		/**
+		 * Runs the whole next instruction in 1 call if nothing outside the CPU can observe its intermediate cycles: the CPU is between
+		 *	instructions, no DMA, NMI, or IRQ is pending, and every address the instruction can touch is plain RAM/ROM in the bus page table.
+		 *	Each cycle still runs exactly as it does through Tick(); only the caller's interleaving of the other components is skipped.
+		 *
+		 * \return Returns the number of cycles run, or 0 if the instruction must be run 1 cycle at a time through Tick().
+		 */
+		uint32_t							TickInstruction();
+
+		/**
+		 * Runs instructions through TickInstruction() back-to-back, without returning to the caller between them, for as long as each
+		 *	one is eligible and cannot run past the given number of cycles.  Stops before any instruction that touches I/O, before an
+		 *	interrupt or DMA, and wherever the bank mapping of the code changes.
+		 *
+		 * \param _ui32MaxCycles The most cycles to run.  An instruction is only started if LSN_FP_MAX_CYCLES more cycles fit.
+		 * \param _ui32MaxInstructions The most instructions to run.
+		 * \return Returns the number of cycles run, or 0 if the next instruction must be run 1 cycle at a time through Tick().
+		 */
+		uint32_t							TickBlock( uint32_t _ui32MaxCycles, uint32_t _ui32MaxInstructions = UINT32_MAX );
+
+		/**
+		 * Runs instructions at PC through compiled x86-64 code (see CJit6502) for as long as each one can run without anything outside the
+		 *	CPU observing it.  Each instruction makes the same bus accesses and takes the same cycles as through Tick(), and leaves the same
+		 *	state behind.
+		 *
+		 * \param _ui32MaxCycles The most cycles to run.  An instruction is only started if its longest path fits.
+		 * \param _ui32Insts On input, the most instructions to run.  On output, the number run.
+		 * \param _bStopAtLoops On input, if true, stops after a jump or branch backwards.  On output, true if it did so.
+		 * \return Returns the number of cycles run, or 0 if the next instruction must be run some other way.
+		 */
+		uint32_t							TickJit( uint32_t _ui32MaxCycles, uint32_t &_ui32Insts, bool &_bStopAtLoops );
+
+		/**
+		 * Skips whole passes of a short loop that cannot change anything, such as JMP * or a loop polling a RAM flag set by the NMI
+		 *	handler.  The loop at PC is run through TickInstruction() until a pass leaves the CPU exactly as it found it.  The loop writes
+		 *	nothing and reads only RAM/ROM, so every later pass would do the same, and as many passes as fit are skipped by advancing the
+		 *	cycle counter.
+		 *
+		 * \param _ui32MaxCycles The most cycles to run and skip.
+		 * \return Returns the number of cycles run and skipped, or 0 if PC is not the top of such a loop.
+		 */
+		uint32_t							TickIdleLoop( uint32_t _ui32MaxCycles );
+
+		/**
+		 * Gets the length of 1 pass of the loop at PC if the loop may be skipped: at most LSN_FP_IDLE_MAX_INSTS instructions ending in a
+		 *	branch or JMP back to PC, with no writes or stack accesses, while no interrupt or DMA is pending.  Reads must be plain RAM/ROM,
+		 *	except absolute reads of _ui16IoAddr, which only the caller can know to be stable.
+		 *
+		 * \param _ui16IoAddr An I/O register the loop may read, or 0 for none.
+		 * \return Returns the cycles of 1 pass, not counting page crossings of indexed reads, or 0 if the loop cannot be skipped.
+		 */
+		uint32_t							IdleLoopCycles( uint16_t _ui16IoAddr ) const;
+
+		/**
+		 * Compares the CPU with the state it was in when this was last called, then keeps the current state for the next call.
+		 *
+		 * \param _ui32Cycles The cycles of 1 pass of the loop at PC.
+		 * \return Returns true if exactly _ui32Cycles cycles have run since the last call and the CPU state is unchanged.
+		 */
+		bool								IdleLoopRepeats( uint32_t _ui32Cycles );
+
+		/**
+		 * Advances the CPU over whole passes of a loop that IdleLoopRepeats() showed to change nothing.
+		 *
+		 * \param _ui64Cycles The cycles to skip, a multiple of the pass length.
+		 * \param _bIo If true, the loop polls an I/O register that the caller showed to be stable.
+		 */
+		void								SkipIdleCycles( uint64_t _ui64Cycles, bool _bIo );
+
+		/**
+		 * Enables or disables idle-loop skipping in TickBlock().
+		 *
+		 * \param _bEnable If true, TickBlock() calls TickIdleLoop() at the top of every loop.
+		 */
+		inline void							SetIdleSkip( bool _bEnable ) { m_bIdleSkip = _bEnable; }
+
+		/**
+		 * Determines whether TickBlock() skips idle loops.
+		 *
+		 * \return Returns true if idle-loop skipping is enabled.
+		 */
+		inline bool							IsIdleSkip() const { return m_bIdleSkip; }
+
+		/**
+		 * Gets the number of times idle-loop passes were skipped since the last ResetToKnown().
+		 *
+		 * \return Returns the number of calls to SkipIdleCycles().
+		 */
+		inline uint64_t						IdleSkipCount() const { return m_ui64IdleSkips; }
+
+		/**
+		 * Gets the number of cycles skipped in idle loops since the last ResetToKnown().
+		 *
+		 * \return Returns the number of cycles passed to SkipIdleCycles().
+		 */
+		inline uint64_t						IdleCycleCount() const { return m_ui64IdleCycles; }
+
+		/**
+		 * Gets the number of cycles skipped in loops polling an I/O register since the last ResetToKnown().
+		 *
+		 * \return Returns the number of cycles passed to SkipIdleCycles() with _bIo set.
+		 */
+		inline uint64_t						IdleIoCycleCount() const { return m_ui64IdleIoCycles; }
+
+		/**
+		 * Gets the number of instructions run by TickInstruction() since the last ResetToKnown().
+		 *
+		 * \return Returns the number of instructions run in 1 call each.
+		 */
+		inline uint64_t						FastInstructionCount() const { return m_ui64FastInstructions; }
+
+		/**
+		 * Gets the number of cycles run by TickInstruction() since the last ResetToKnown().
+		 *
+		 * \return Returns the number of cycles run inside instructions run in 1 call each.
+		 */
+		inline uint64_t						FastCycleCount() const { return m_ui64FastCycles; }
+
+		/**
+		 * Gets the number of calls to TickBlock() that ran at least 1 instruction since the last ResetToKnown().
+		 *
+		 * \return Returns the number of runs of instructions run by TickBlock().
+		 */
+		inline uint64_t						FastBlockCount() const { return m_ui64FastBlocks; }
+
+		/**
+		 * Gets the number of instructions run by TickInstruction() that reached a per-address bus function or ran longer than
+		 *	LSN_FP_MAX_CYCLES.  Always 0 unless LSN_CPU_FAST_PATH_CHECK is defined.
+		 *
+		 * \return Returns the number of instructions that should not have been run in 1 call.
+		 */
+		inline uint64_t						FastCheckFailures() const { return m_ui64FastCheckFailures; }
+
+		/**
+		 * Counts an instruction that should not have been run in 1 call.  The system calls this when a check it makes around
+		 *	TickInstruction() fails in a build with LSN_CPU_FAST_PATH_CHECK defined.
+		 */
+		inline void							AddFastCheckFailure() { ++m_ui64FastCheckFailures; }
+
+		/**
+		 * Enables or disables the decoded-block cache used by TickInstruction().  Disabling it frees the cache.
+		 *
+		 * \param _bEnable If true, TickInstruction() looks instructions up in the cache instead of decoding them each time.
+		 */
+		void								SetDecodeCache( bool _bEnable );
+
+		/**
+		 * Determines whether TickInstruction() uses the decoded-block cache.
+		 *
+		 * \return Returns true if the decoded-block cache is enabled.
+		 */
+		inline bool							IsDecodeCache() const { return m_bDecodeCache; }
+
+		/**
+		 * Gets the decoded-block cache statistics since the last ResetToKnown().
+		 *
+		 * \return Returns the decoded-block cache statistics.
+		 */
+		inline const CDecodeCache::LSN_DECODE_CACHE_STATS &
+											DecodeCacheStats() const { return m_dcDecodeCache.Stats(); }
+
+		/**
+		 * Enables or disables compiled code in TickBlock().  Disabling it frees the compiled code.  Stays disabled where CJit6502 is not
+		 *	available.
+		 *
+		 * \param _bEnable If true, TickBlock() runs instructions through TickJit() before trying TickInstruction().
+		 */
+		void								SetJit( bool _bEnable );
+
+		/**
+		 * Determines whether TickBlock() runs compiled code.
+		 *
+		 * \return Returns true if compiled code is enabled.
+		 */
+		inline bool							IsJit() const { return m_bJit; }
+
+		/**
+		 * Gets the compiled-code statistics since the last ResetToKnown().
+		 *
+		 * \return Returns the compiled-code statistics.
+		 */
+		inline const CJit6502::LSN_JIT_STATS &
+											JitStats() const { return m_jJit.Stats(); }
+
+		/**
+		 * Selects how the cycles of an instruction are dispatched: through the pointers in the instruction table (the default) or
+		 *	through 1 switch on the 1-byte micro-op ID's from LSNMicroOps.inl.  Both run the same functions in the same order.
+		 *
+		 * \param _bSwitch If true, micro-ops are dispatched through the switch.
+		 */
+		inline void							SetSwitchDispatch( bool _bSwitch ) {
+			const PfTicks pfOld = m_pfInstructionCycle;
+			m_pfInstructionCycle = _bSwitch ? &CCpu6502::Tick_InstructionCycleSwitch : &CCpu6502::Tick_InstructionCycleStd;
+			// An instruction may be in flight.
+			if ( m_pfTickFunc == pfOld ) { m_pfTickFunc = m_pfInstructionCycle; }
+			if ( m_pfTickFuncCopy == pfOld ) { m_pfTickFuncCopy = m_pfInstructionCycle; }
+		}
+
+		/**
+		 * Determines whether micro-ops are dispatched through the switch.
+		 *
+		 * \return Returns true if micro-ops are dispatched through the switch.
+		 */
+		inline bool							IsSwitchDispatch() const { return m_pfInstructionCycle == &CCpu6502::Tick_InstructionCycleSwitch; }
+
+		/**
+		 * Gets the size of the table read on each cycle by a dispatcher.
+		 *
+		 * \param _bSwitch If true, the size of the micro-op ID table is returned, otherwise the size of the pointers in the instruction table.
+		 * \return Returns the size of the table in bytes.
+		 */
+		static inline size_t				DispatchTableSize( bool _bSwitch ) {
+			return _bSwitch ? sizeof( LSN_MICRO_OP_IDS ) : sizeof( PfCycle ) * LSN_M_MAX_INSTR_CYCLE_COUNT * LSN_ELEMENTS( m_iInstructionSet );
+		}
 
 		/**
 		 * Applies the CPU's memory mapping t the bus.
@@ -119,8 +359,31 @@ namespace lsn {
 		 */
 		void								SetMapper( CMapperBase * _pmbMapper ) {
 			m_pmbMapper = _pmbMapper;
+			m_bTickMapper = _pmbMapper && _pmbMapper->TicksWithCpu();
 		}
 
+		/**
+		 * Determines whether the mapper is ticked with each CPU cycle.
+		 *
+		 * \return Returns true if the mapper is ticked with each CPU cycle.
+		 */
+		inline bool							TicksMapper() const { return m_bTickMapper; }
+
+		/**
+		 * Sets whether the mapper is ticked with each CPU cycle.  The profiling system turns this off and ticks the mapper itself, just before
+		 *	each CPU cycle, so that the time can be measured separately.
+		 *
+		 * \param _bTick If true, the mapper is ticked with each CPU cycle.
+		 */
+		inline void							SetTicksMapper( bool _bTick ) { m_bTickMapper = _bTick; }
+
+		/**
+		 * Gets the program counter.
+		 *
+		 * \return Returns the current program counter.
+		 */
+		virtual uint16_t					GetPc() const { return pc.PC; }
+
 		/**
 		 * Notifies the class that an NMI has occurred.
 		 */
@@ -145,6 +408,22 @@ namespace lsn {
 			m_pipPoller = _pipPoller;
 		}
 
+		/**
+		 * Writes the CPU state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		bool								SaveState( CStream &_sStream ) const;
+
+		/**
+		 * Reads the CPU state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		bool								LoadState( CStream &_sStream );
+
 #ifdef LSN_CPU_VERIFY
 		/**
 		 * Runs a test given a JSON's value representing the test to run.
@@ -198,6 +477,27 @@ namespace lsn {
 			LSN_INSTRUCTIONS				iInstruction;									/**< The instruction. */
 		};
 
+		/** The micro-op ID's of every cycle of every instruction, laid out like LSN_INSTR::pfHandler. */
+		struct LSN_MICRO_OP_IDS {
+			uint8_t							ui8Ids[256+2][LSN_M_MAX_INSTR_CYCLE_COUNT];		/**< The LSN_MICRO_OP_ID of each cycle of each instruction. */
+		};
+
+		/** The CPU state compared between passes of an idle loop. */
+		struct LSN_IDLE_STATE {
+			LSN_CPU_CONTEXT					ccContext;										/**< The context, holding the loop's last instruction. */
+			uint16_t						ui16Pc;											/**< PC. */
+			uint8_t							ui8A;											/**< A. */
+			uint8_t							ui8X;											/**< X. */
+			uint8_t							ui8Y;											/**< Y. */
+			uint8_t							ui8S;											/**< S. */
+			uint8_t							ui8Status;										/**< The status flags. */
+			bool							bNmiStatusLine;									/**< The NMI status line. */
+			bool							bLastNmiStatusLine;								/**< The last NMI status line. */
+			bool							bDetectedNmi;									/**< The NMI edge detector. */
+			bool							bIrqStatusLine;									/**< The IRQ status line. */
+			bool							bIsReadCycle;									/**< The read/write state of the last cycle. */
+		};
+
 		/** Instruction data for assembly/disassembly. */
 		struct LSN_INSTR_META_DATA {
 			const char *					pcName;											/**< The name of the instruction. */
@@ -233,6 +533,22 @@ namespace lsn {
 		bool								m_bHandleIrq;									/**< Once the IRQ status line is detected as having triggered, this tells us to handle an IRQ on the next instruction. */
 		bool								m_bIsReadCycle;									/**< Is this CPU cycle a read cycle? */
 		bool								m_bRdyLow;										/**< When RDY is pulled low, reads inside opcodes abort the CPU cycle. */
+		bool								m_bTickMapper;									/**< If true, m_pmbMapper is ticked on each CPU cycle. */
+		uint64_t							m_ui64FastInstructions;							/**< Instructions run by TickInstruction(). */
+		uint64_t							m_ui64FastCycles;								/**< Cycles run by TickInstruction(). */
+		uint64_t							m_ui64FastBlocks;								/**< Calls to TickBlock() that ran at least 1 instruction. */
+		uint64_t							m_ui64FastCheckFailures;						/**< Instructions run by TickInstruction() that failed the LSN_CPU_FAST_PATH_CHECK checks. */
+		CDecodeCache						m_dcDecodeCache;								/**< Instructions decoded by TickInstruction(). */
+		bool								m_bDecodeCache;									/**< If true, TickInstruction() uses m_dcDecodeCache. */
+		CJit6502							m_jJit;											/**< Compiled code run by TickJit(). */
+		bool								m_bJit;											/**< If true, TickBlock() uses TickJit(). */
+		PfTicks								m_pfInstructionCycle;							/**< The tick function that performs a cycle inside an instruction: Tick_InstructionCycleStd() or Tick_InstructionCycleSwitch(). */
+		LSN_IDLE_STATE						m_isIdleState;									/**< The state at the last IdleLoopRepeats(). */
+		uint64_t							m_ui64IdleCycle;								/**< The cycle count at the last IdleLoopRepeats(). */
+		uint64_t							m_ui64IdleSkips;								/**< Calls to SkipIdleCycles(). */
+		uint64_t							m_ui64IdleCycles;								/**< Cycles skipped by SkipIdleCycles(). */
+		uint64_t							m_ui64IdleIoCycles;								/**< Cycles skipped by SkipIdleCycles() in loops polling I/O. */
+		bool								m_bIdleSkip;									/**< If true, TickBlock() skips idle loops. */
 
 
 		// Temporary input.
@@ -243,6 +559,8 @@ namespace lsn {
 		//uint8_t								m_ui8NmiCounter;
 		
 		static LSN_INSTR					m_iInstructionSet[256+2];						/**< The instruction set. */
+		static const LSN_MICRO_OP_IDS		m_moiMicroOpIds;								/**< The micro-op ID's of m_iInstructionSet. */
+		static const PfTicks				m_pfTickFuncs[6];								/**< Every tick function, indexed by the values stored in save states. */
 		static const LSN_INSTR_META_DATA	m_smdInstMetaData[LSN_I_TOTAL];					/**< Metadata for the instructions (for assembly and disassembly etc.) */
 		
 		
@@ -253,6 +571,83 @@ namespace lsn {
 		/** Performs a cycle inside an instruction. */
 		void								Tick_InstructionCycleStd();
 
+		/** Performs a cycle inside an instruction, dispatching through m_moiMicroOpIds. */
+		void								Tick_InstructionCycleSwitch();
+
+		/**
+		 * Builds m_moiMicroOpIds by finding each handler of m_iInstructionSet in LSN_MICRO_OP_LIST.
+		 *
+		 * \return Returns the micro-op ID's of m_iInstructionSet.
+		 */
+		static LSN_MICRO_OP_IDS				BuildMicroOpIds();
+
+		/**
+		 * Gets the state compared by IdleLoopRepeats().
+		 *
+		 * \param _isState Holds the returned state.
+		 */
+		void								GetIdleState( LSN_IDLE_STATE &_isState ) const;
+
+		/**
+		 * Determines whether every address the instruction at PC can read or write is plain RAM/ROM in the bus page table.  Effective
+		 *	addresses are computed from the current registers and memory, including the wrong-page addresses of indexed dummy reads.
+		 *	Instructions that never finish (JAM), read the interrupt vectors (BRK), or form their addresses from their data (SHA, SHX,
+		 *	SHY, TAS) are never eligible.
+		 *
+		 * \return Returns true if the instruction at PC has no side effects outside the CPU and bus memory.
+		 */
+		bool								InstructionIsQuiet() const;
+
+		/**
+		 * Determines through the decoded-block cache whether the instruction at PC has no side effects outside the CPU and bus memory.
+		 *	Falls back to InstructionIsQuiet() for an instruction that does not fit in its page.
+		 *
+		 * \return Returns true if the instruction at PC has no side effects outside the CPU and bus memory.
+		 */
+		bool								CachedInstructionIsQuiet();
+
+		/**
+		 * Decodes a block of instructions into the decoded-block cache.  The block ends after a jump, branch, or return, or before an
+		 *	instruction whose fetches leave the page.
+		 *
+		 * \param _ui16Pc The address of the first instruction.
+		 * \param _pui8Page The page-table memory of the page holding _ui16Pc.
+		 * \return Returns the first instruction of the new block, or nullptr if the first instruction's fetches leave the page.
+		 */
+		const CDecodeCache::LSN_DECODED_INST *
+											DecodeBlock( uint16_t _ui16Pc, const uint8_t * _pui8Page );
+
+		/**
+		 * Checks the addresses an instruction touches besides its own bytes against the bus page table, using the current registers
+		 *	and memory.
+		 *
+		 * \param _ui8Check The LSN_QUIET_CHECK value of the instruction, optionally combined with LSN_QC_WRITES.
+		 * \param _ui16Operand The operand bytes of the instruction, low byte first.
+		 * \return Returns true if every address the instruction touches besides its own bytes is plain RAM/ROM.
+		 */
+		bool								QuietCheck( uint8_t _ui8Check, uint16_t _ui16Operand ) const;
+
+		/**
+		 * Gets what an instruction touches besides its own bytes.
+		 *
+		 * \param _iInstr The instruction.
+		 * \return Returns a LSN_QUIET_CHECK value, combined with LSN_QC_WRITES if the instruction writes to its effective address.
+		 */
+		static uint8_t						QuietCheckOf( const LSN_INSTR &_iInstr );
+
+		/**
+		 * Gets the number of bytes from the opcode on that an instruction reads from the instruction stream, counting dummy reads.
+		 *
+		 * \param _iInstr The instruction.
+		 * \return Returns the number of bytes read from the instruction stream.
+		 */
+		static inline uint32_t				FetchBytes( const LSN_INSTR &_iInstr ) {
+			// A taken branch reads the next opcode, then on a page cross the target's low byte on that same page.
+			if ( _iInstr.amAddrMode == LSN_AM_RELATIVE ) { return 3; }
+			// Every instruction reads its opcode and the byte after it, even if only to discard it.
+			return _iInstr.ui8Size < 2 ? 2 : _iInstr.ui8Size;
+		}
+
 		/** DMA start. Moves on to the DMA read/write cycle when the current CPU cycle is even (IE odd cycles take 1 extra cycle). */
 		void								Tick_DmaStart();
 
@@ -265,6 +660,14 @@ namespace lsn {
 		/** DMA write cycle. */
 		void								Tick_DmaWrite();
 
+		/**
+		 * Gets the index of a tick function in m_pfTickFuncs.
+		 *
+		 * \param _pfFunc The tick function.
+		 * \return Returns the index of the tick function, or 0xFF if it is not in m_pfTickFuncs.
+		 */
+		static uint8_t						TickFuncToIndex( PfTicks _pfFunc );
+
 		/**
 		 * Writing to 0x4014 initiates a DMA transfer.
 		 *
@@ -738,6 +1141,27 @@ namespace lsn {
 	// DEFINITIONS
 	// * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * *
 	// == Fuctions.
+	/**
+	 * Performs a single cycle update.
+	 */
+	inline void CCpu6502::Tick() {
+#ifndef LSN_CPU_VERIFY
+		// Most mappers have nothing to do per-cycle, and those with cycle counters schedule their IRQ's on the system event queue instead.
+		if ( m_bTickMapper ) {
+			m_pmbMapper->Tick();
+		}
+#endif	// #ifndef LSN_CPU_VERIFY
+		(this->*m_pfTickFunc)();
+
+		//m_bHandleNmi |= (m_bNmiStatusLine && --m_ui8NmiCounter == 0);
+		m_bHandleNmi = m_bDetectedNmi;
+		//m_bDetectedNmi |= (!m_bLastNmiStatusLine && m_bNmiStatusLine);
+		m_bLastNmiStatusLine = m_bNmiStatusLine;
+		m_bHandleIrq |= m_bIrqStatusLine;
+
+		++m_ui64CycleCount;
+	}
+
 	/**
 	 * Fetches the next opcode and increments the program counter.
 	 */
@@ -815,7 +1239,7 @@ namespace lsn {
 		m_ccCurContext.ui8Cycle = 1;
 		m_ccCurContext.ui8FuncIdx = 0;
 		m_ccCurContext.ui16OpCode = _ui16Op;
-		m_pfTickFunc = m_pfTickFuncCopy = &CCpu6502::Tick_InstructionCycleStd;
+		m_pfTickFunc = m_pfTickFuncCopy = m_pfInstructionCycle;
 		LSN_CHECK_NMI;
 	}
 
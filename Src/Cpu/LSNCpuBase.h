@@ -11,9 +11,12 @@
 
 
 #include "../LSNLSpiroNes.h"
+#include "../Bus/LSNBus.h"
 
 namespace lsn {
 
+	class CJit6502;
+
 	/**
 	 * Class CCpuBase
 	 * \brief The base class for all CPUs.
@@ -21,6 +24,8 @@ namespace lsn {
 	 * Description: The base class for all CPUs.
 	 */
 	class CCpuBase {
+		// Compiles code from the addressing modes and instructions below.
+		friend class CJit6502;
 	public :
 		CCpuBase( CCpuBus * _pbBus ) :
 			m_ui64CycleCount( 0 ),
@@ -36,6 +41,13 @@ namespace lsn {
 		 */
 		inline uint64_t						GetCycleCount() const { return m_ui64CycleCount; }
 
+		/**
+		 * Gets the program counter.
+		 *
+		 * \return Returns the current program counter.
+		 */
+		virtual uint16_t					GetPc() const { return 0; }
+
 		/**
 		 * Signals an IRQ to be handled before the next instruction.
 		 */
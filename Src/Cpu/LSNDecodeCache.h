@@ -0,0 +1,191 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A cache of decoded basic blocks for CCpu6502::TickInstruction().  Blocks are keyed by their address and by the page-table
+ *	memory of their page, so mapping a different PRG bank into the page misses the old blocks.  The bytes of each instruction are compared
+ *	on every use, so code rewritten in RAM is decoded again.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CDecodeCache
+	 * \brief A cache of decoded basic blocks for CCpu6502::TickInstruction().
+	 *
+	 * Description: A cache of decoded basic blocks for CCpu6502::TickInstruction().  Blocks are keyed by their address and by the page-table
+	 *	memory of their page, so mapping a different PRG bank into the page misses the old blocks.  The bytes of each instruction are compared
+	 *	on every use, so code rewritten in RAM is decoded again.
+	 */
+	class CDecodeCache {
+	public :
+		CDecodeCache() :
+			m_pbCursor( nullptr ),
+			m_stCursor( 0 ) {
+			ResetStats();
+		}
+
+
+		// == Enumerations.
+		/** Cache sizes. */
+		enum LSN_DECODE_CACHE_SIZES : uint32_t {
+			LSN_DC_BLOCKS									= 1024,							/**< Blocks in the cache (a power of 2). */
+			LSN_DC_BLOCK_INSTS								= 16,							/**< The most instructions in a block. */
+		};
+
+
+		// == Types.
+		/** A decoded instruction. */
+		struct LSN_DECODED_INST {
+			uint16_t										ui16Operand;					/**< The operand bytes, low byte first. */
+			uint8_t											ui8Op;							/**< The opcode. */
+			uint8_t											ui8Low;							/**< The low byte of the instruction's address. */
+			uint8_t											ui8Size;						/**< The size of the instruction in bytes. */
+			uint8_t											ui8Check;						/**< What the instruction touches besides its own bytes (set by the CPU). */
+		};
+
+		/** A decoded basic block.  A block ends after a jump, branch, or return, or before an instruction that does not fit in the page. */
+		struct LSN_BLOCK {
+			const uint8_t *									pui8Page;						/**< The page-table memory of the block's page when it was decoded. */
+			uint16_t										ui16Pc;							/**< The address of the first instruction. */
+			uint8_t											ui8Count;						/**< The number of instructions in diInsts. */
+			LSN_DECODED_INST								diInsts[LSN_DC_BLOCK_INSTS];	/**< The instructions. */
+		};
+
+		/** Cache statistics. */
+		struct LSN_DECODE_CACHE_STATS {
+			uint64_t										ui64Hits;						/**< Instructions found decoded. */
+			uint64_t										ui64Misses;						/**< Instructions that had to be decoded. */
+			uint64_t										ui64Invalidations;				/**< Misses on a cached block whose PRG bank or bytes had changed. */
+			uint64_t										ui64Blocks;						/**< Blocks decoded. */
+
+
+			// == Functions.
+			/**
+			 * Gets the fraction of lookups that found the instruction decoded.
+			 *
+			 * \return Returns the hit rate from 0 to 1.
+			 */
+			inline double									HitRate() const {
+				return (ui64Hits + ui64Misses) ? double( ui64Hits ) / double( ui64Hits + ui64Misses ) : 0.0;
+			}
+		};
+
+
+		// == Functions.
+		/**
+		 * Finds a decoded instruction.  Sequential instructions of the current block are found without a lookup.
+		 *
+		 * \param _ui16Pc The address of the instruction.
+		 * \param _pui8Page The page-table memory of the page holding _ui16Pc.
+		 * \return Returns the decoded instruction, or nullptr if it must be decoded into a new block from Begin().
+		 */
+		inline const LSN_DECODED_INST *						Find( uint16_t _ui16Pc, const uint8_t * _pui8Page ) {
+			LSN_BLOCK * pbBlock = m_pbCursor;
+			size_t stIdx = m_stCursor;
+			if ( !pbBlock || stIdx >= pbBlock->ui8Count || pbBlock->pui8Page != _pui8Page ||
+				((pbBlock->ui16Pc ^ _ui16Pc) & 0xFF00) || pbBlock->diInsts[stIdx].ui8Low != uint8_t( _ui16Pc ) ) {
+				m_pbCursor = nullptr;
+				if ( m_vBlocks.empty() ) { ++m_dcsStats.ui64Misses; return nullptr; }
+				pbBlock = &m_vBlocks[Hash( _ui16Pc )];
+				if ( !pbBlock->ui8Count || pbBlock->ui16Pc != _ui16Pc ) { ++m_dcsStats.ui64Misses; return nullptr; }
+				if ( pbBlock->pui8Page != _pui8Page ) {
+					++m_dcsStats.ui64Invalidations;
+					++m_dcsStats.ui64Misses;
+					return nullptr;
+				}
+				stIdx = 0;
+			}
+			const LSN_DECODED_INST & diInst = pbBlock->diInsts[stIdx];
+			const uint8_t * pui8Code = _pui8Page + diInst.ui8Low;
+			if ( pui8Code[0] != diInst.ui8Op ||
+				(diInst.ui8Size > 1 && pui8Code[1] != uint8_t( diInst.ui16Operand )) ||
+				(diInst.ui8Size > 2 && pui8Code[2] != uint8_t( diInst.ui16Operand >> 8 )) ) {
+				m_pbCursor = nullptr;
+				++m_dcsStats.ui64Invalidations;
+				++m_dcsStats.ui64Misses;
+				return nullptr;
+			}
+			m_pbCursor = pbBlock;
+			m_stCursor = stIdx + 1;
+			++m_dcsStats.ui64Hits;
+			return &diInst;
+		}
+
+		/**
+		 * Starts a new, empty block, replacing whichever block was in its slot.  The caller adds the instructions.  The block becomes the
+		 *	current block, positioned after its first instruction.
+		 *
+		 * \param _ui16Pc The address of the first instruction.
+		 * \param _pui8Page The page-table memory of the page holding _ui16Pc.
+		 * \return Returns the new block.
+		 */
+		LSN_BLOCK &											Begin( uint16_t _ui16Pc, const uint8_t * _pui8Page ) {
+			if ( m_vBlocks.empty() ) { m_vBlocks.resize( LSN_DC_BLOCKS ); }
+			LSN_BLOCK & bBlock = m_vBlocks[Hash( _ui16Pc )];
+			bBlock.pui8Page = _pui8Page;
+			bBlock.ui16Pc = _ui16Pc;
+			bBlock.ui8Count = 0;
+			++m_dcsStats.ui64Blocks;
+			m_pbCursor = &bBlock;
+			m_stCursor = 1;
+			return bBlock;
+		}
+
+		/**
+		 * Empties the cache and frees its memory.
+		 */
+		void												Clear() {
+			m_vBlocks = std::vector<LSN_BLOCK>();
+			m_pbCursor = nullptr;
+			m_stCursor = 0;
+		}
+
+		/**
+		 * Gets the statistics.
+		 *
+		 * \return Returns the statistics since the last ResetStats().
+		 */
+		inline const LSN_DECODE_CACHE_STATS &				Stats() const { return m_dcsStats; }
+
+		/**
+		 * Zeroes the statistics.
+		 */
+		inline void											ResetStats() {
+			m_dcsStats = LSN_DECODE_CACHE_STATS();
+		}
+
+
+	protected :
+		// == Members.
+		/** The blocks, allocated on first use. */
+		std::vector<LSN_BLOCK>								m_vBlocks;
+		/** The block holding the last instruction found. */
+		LSN_BLOCK *											m_pbCursor;
+		/** The index in m_pbCursor of the instruction expected next. */
+		size_t												m_stCursor;
+		/** The statistics. */
+		LSN_DECODE_CACHE_STATS								m_dcsStats;
+
+
+		// == Functions.
+		/**
+		 * Gets the slot of a block.
+		 *
+		 * \param _ui16Pc The address of the first instruction of the block.
+		 * \return Returns the index of the block's slot in m_vBlocks.
+		 */
+		static inline size_t								Hash( uint16_t _ui16Pc ) {
+			return (_ui16Pc ^ (_ui16Pc >> 10)) & (LSN_DC_BLOCKS - 1);
+		}
+	};
+
+}	// namespace lsn
@@ -0,0 +1,1666 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Translates runs of 6502 instructions into x86-64 code for CCpu6502::TickBlock().  Each instruction does every bus access,
+ *	context update, and cycle of its cycle-by-cycle version, so the state left behind is the same.  Blocks are keyed by their address and by
+ *	the page-table memory of their page, like CDecodeCache, and their bytes are compared before each run.  Only built for x86-64 Linux.
+ */
+
+#include "LSNJit6502.h"
+#include <algorithm>
+#include <cstddef>
+#include <cstring>
+
+#ifdef LSN_JIT_X64
+#include <sys/mman.h>
+#endif	// #ifdef LSN_JIT_X64
+
+
+namespace lsn {
+
+	/** The frame compiled code reads through rbp. */
+	struct CJit6502::LSN_FRAME {
+		const CCpuBus::LSN_PAGE *							ppPages;						/**< The bus page table. */
+		const uint8_t *										pui8Ram;						/**< The bus memory, for finding dirty pages. */
+		uint64_t *											pui64Dirty;						/**< The bus dirty-page bitmap. */
+		const uint8_t *										pui8Nz;							/**< The N and Z flags of each byte value. */
+		void *												pvBus;							/**< The bus, for LogAccess(). */
+		void *												pvLog;							/**< LogAccess(). */
+		uint32_t											ui32Budget;						/**< The most cycles to run. */
+		uint32_t											ui32Left;						/**< The most instructions still to run. */
+		uint8_t												ui8Float;						/**< The last value read. */
+		uint8_t												ui8StopAtLoops;					/**< If non-zero, jumps and branches backwards leave. */
+		uint8_t												ui8Looped;						/**< Set when a jump or branch backwards left. */
+	};
+
+#ifdef LSN_JIT_X64
+	/** The entry code: ( CPU, frame, block ), returning the cycles run. */
+	typedef uint32_t (*											PfEntry)( void *, void *, const uint8_t * );
+
+	/** Flags of the status register. */
+	enum LSN_JIT_FLAGS : uint32_t {
+		LSN_JF_C											= 0x01,
+		LSN_JF_Z											= 0x02,
+		LSN_JF_I											= 0x04,
+		LSN_JF_D											= 0x08,
+		LSN_JF_B											= 0x10,
+		LSN_JF_R											= 0x20,
+		LSN_JF_V											= 0x40,
+		LSN_JF_N											= 0x80,
+	};
+
+	/** The N and Z flags of each byte value. */
+	static const struct LSN_NZ_TABLE {
+		LSN_NZ_TABLE() {
+			for ( uint32_t I = 0; I < 256; ++I ) {
+				ui8Flags[I] = uint8_t( (I & LSN_JF_N) | (I ? 0 : LSN_JF_Z) );
+			}
+		}
+		uint8_t												ui8Flags[256];
+	} g_ntNzTable;
+
+	/**
+	 * Class CJit6502::CEmitter
+	 * \brief Writes the x86-64 code of a block.
+	 *
+	 * Description: Writes the x86-64 code of a block.  Register use:
+	 *	rbx: the CPU.  rbp: the LSN_FRAME.  esi: P.  edi: cycles run.  r8: the page table.  r11: the N/Z table.
+	 *	r12d-r15d: A, X, Y, S, always 0-255.  eax, ecx, edx, r9d, r10d: scratch.
+	 */
+	class CJit6502::CEmitter {
+	public :
+		CEmitter( const LSN_LAYOUT &_lLayout, const LSN_OPCODE * _poOpcodes ) :
+			m_lLayout( _lLayout ),
+			m_poOpcodes( _poOpcodes ),
+			m_pui8Page( nullptr ),
+			m_pui8RamCode( nullptr ),
+			m_ui32RamCodeLen( 0 ),
+			m_bFloatPending( false ),
+			m_ui8Float( 0 ) {
+		}
+
+
+		// == Enumerations.
+		/** Registers. */
+		enum LSN_REG : uint32_t {
+			LSN_X_RAX, LSN_X_RCX, LSN_X_RDX, LSN_X_RBX, LSN_X_RSP, LSN_X_RBP, LSN_X_RSI, LSN_X_RDI,
+			LSN_X_R8, LSN_X_R9, LSN_X_R10, LSN_X_R11, LSN_X_R12, LSN_X_R13, LSN_X_R14, LSN_X_R15,
+			LSN_X_NONE										= 0xFF,
+
+			LSN_X_CPU										= LSN_X_RBX,
+			LSN_X_FRAME										= LSN_X_RBP,
+			LSN_X_P											= LSN_X_RSI,
+			LSN_X_CYCLES									= LSN_X_RDI,
+			LSN_X_PAGES										= LSN_X_R8,
+			LSN_X_EA										= LSN_X_R9,
+			LSN_X_TMP										= LSN_X_R10,
+			LSN_X_NZ										= LSN_X_R11,
+			LSN_X_A											= LSN_X_R12,
+			LSN_X_X											= LSN_X_R13,
+			LSN_X_Y											= LSN_X_R14,
+			LSN_X_S											= LSN_X_R15,
+		};
+
+		/** Condition codes. */
+		enum LSN_CC : uint32_t {
+			LSN_CC_O, LSN_CC_NO, LSN_CC_B, LSN_CC_AE, LSN_CC_E, LSN_CC_NE, LSN_CC_BE, LSN_CC_A,
+		};
+
+		/** ALU operations (the /n of opcodes 80-83 and the row of 00-3F). */
+		enum LSN_ALU : uint32_t {
+			LSN_ALU_ADD, LSN_ALU_OR, LSN_ALU_ADC, LSN_ALU_SBB, LSN_ALU_AND, LSN_ALU_SUB, LSN_ALU_XOR, LSN_ALU_CMP,
+		};
+
+		/** Shift operations (the /n of opcodes C0, C1, D0, and D1). */
+		enum LSN_SHIFT : uint32_t {
+			LSN_SH_ROL, LSN_SH_ROR, LSN_SH_RCL, LSN_SH_RCR, LSN_SH_SHL, LSN_SH_SHR,
+		};
+
+		/** How an instruction uses memory. */
+		enum LSN_KIND : uint32_t {
+			LSN_K_READ,
+			LSN_K_WRITE,
+			LSN_K_RMW,
+		};
+
+
+		// == Types.
+		/** A memory operand. */
+		struct LSN_MEM {
+			uint32_t										ui32Base;
+			uint32_t										ui32Index;
+			uint32_t										ui32Scale;
+			int32_t											i32Disp;
+		};
+
+
+		// == Members.
+		std::vector<uint8_t>								m_vCode;						/**< The code. */
+		std::vector<uint32_t>								m_vAbsFixups;					/**< rel32 operands to point at the exit code. */
+
+
+		// == Functions.
+		/**
+		 * Writes a block.
+		 *
+		 * \param _pui8Page The page holding the block.
+		 * \param _vInsts The instructions.
+		 * \param _pui8RamCode If the page is in bus memory, the first byte the block reads, which writes must not reach.
+		 * \param _ui32RamCodeLen The number of bytes from _pui8RamCode the block reads.
+		 */
+		void												Block( const uint8_t * _pui8Page, std::vector<LSN_INST> &_vInsts, const uint8_t * _pui8RamCode, uint32_t _ui32RamCodeLen ) {
+			m_pui8Page = _pui8Page;
+			m_pui8RamCode = _pui8RamCode;
+			m_ui32RamCodeLen = _ui32RamCodeLen;
+			m_pvInsts = &_vInsts;
+			for ( size_t I = 0; I < _vInsts.size(); ++I ) {
+				_vInsts[I].ui32Label = NewLabel();
+				_vInsts[I].ui32Exit = ExitLabel( _vInsts[I].ui16Pc );
+			}
+			bool bFallsThrough = true;
+			for ( size_t I = 0; I < _vInsts.size(); ++I ) {
+				bFallsThrough = Inst( _vInsts[I] );
+			}
+			if ( bFallsThrough ) {
+				const LSN_INST & iLast = _vInsts.back();
+				Jmp( ExitLabel( uint16_t( iLast.ui16Pc + m_poOpcodes[iLast.ui8Op].ui8Size ) ) );
+			}
+			// The stubs that leave with a known PC.
+			for ( size_t I = 0; I < m_vExits.size(); ++I ) {
+				Bind( m_vExits[I].ui32Label );
+				MovMI16( Cpu( m_lLayout.ui32Pc ), m_vExits[I].ui16Pc );
+				JmpExit();
+			}
+			for ( size_t I = 0; I < m_vLoopExits.size(); ++I ) {
+				Bind( m_vLoopExits[I].ui32Label );
+				MovMI8( Frame( offsetof( LSN_FRAME, ui8Looped ) ), 1 );
+				Jmp( ExitLabel( m_vLoopExits[I].ui16Pc ) );
+			}
+			for ( size_t I = 0; I < m_vFixups.size(); ++I ) {
+				const int32_t i32Rel = m_vLabels[m_vFixups[I].ui32Label] - int32_t( m_vFixups[I].ui32Pos + 4 );
+				std::memcpy( &m_vCode[m_vFixups[I].ui32Pos], &i32Rel, sizeof( i32Rel ) );
+			}
+		}
+
+		/**
+		 * Writes the entry code, then the exit code, returning the offset of the exit code.
+		 *
+		 * \param _ui32Entry The offset at which the code will be placed.
+		 * \return Returns the offset of the exit code.
+		 */
+		uint32_t											EntryAndExit() {
+			Push( LSN_X_RBX );
+			Push( LSN_X_RBP );
+			Push( LSN_X_R12 );
+			Push( LSN_X_R13 );
+			Push( LSN_X_R14 );
+			Push( LSN_X_R15 );
+			AluRI64( LSN_ALU_SUB, LSN_X_RSP, 8 );					// Keeps calls from compiled code 16-byte aligned.
+			MovRR64( LSN_X_CPU, LSN_X_RDI );
+			MovRR64( LSN_X_FRAME, LSN_X_RSI );
+			MovzxRM8( LSN_X_A, Cpu( m_lLayout.ui32A ) );
+			MovzxRM8( LSN_X_X, Cpu( m_lLayout.ui32X ) );
+			MovzxRM8( LSN_X_Y, Cpu( m_lLayout.ui32Y ) );
+			MovzxRM8( LSN_X_S, Cpu( m_lLayout.ui32S ) );
+			MovzxRM8( LSN_X_P, Cpu( m_lLayout.ui32Status ) );
+			AluRR32( LSN_ALU_XOR, LSN_X_CYCLES, LSN_X_CYCLES );
+			MovRM64( LSN_X_PAGES, Frame( offsetof( LSN_FRAME, ppPages ) ) );
+			MovRM64( LSN_X_NZ, Frame( offsetof( LSN_FRAME, pui8Nz ) ) );
+			JmpR( LSN_X_RDX );
+
+			const uint32_t ui32Exit = uint32_t( m_vCode.size() );
+			MovMR8( Cpu( m_lLayout.ui32A ), LSN_X_A );
+			MovMR8( Cpu( m_lLayout.ui32X ), LSN_X_X );
+			MovMR8( Cpu( m_lLayout.ui32Y ), LSN_X_Y );
+			MovMR8( Cpu( m_lLayout.ui32S ), LSN_X_S );
+			MovMR8( Cpu( m_lLayout.ui32Status ), LSN_X_P );
+			MovRR32( LSN_X_RAX, LSN_X_CYCLES );
+			AluRI64( LSN_ALU_ADD, LSN_X_RSP, 8 );
+			Pop( LSN_X_R15 );
+			Pop( LSN_X_R14 );
+			Pop( LSN_X_R13 );
+			Pop( LSN_X_R12 );
+			Pop( LSN_X_RBP );
+			Pop( LSN_X_RBX );
+			B( 0xC3 );												// ret
+			return ui32Exit;
+		}
+
+
+	protected :
+		// == Types.
+		/** A label jumped to before it is bound. */
+		struct LSN_FIXUP {
+			uint32_t										ui32Pos;						/**< The offset of the rel32. */
+			uint32_t										ui32Label;						/**< The label. */
+		};
+
+		/** A stub that leaves with a known PC. */
+		struct LSN_EXIT {
+			uint16_t										ui16Pc;							/**< The PC. */
+			uint32_t										ui32Label;						/**< The label of the stub. */
+		};
+
+
+		// == Members.
+		const LSN_LAYOUT &									m_lLayout;						/**< Where the CPU keeps its state. */
+		const LSN_OPCODE *									m_poOpcodes;					/**< The opcodes. */
+		const std::vector<LSN_INST> *						m_pvInsts;						/**< The instructions of the block. */
+		const uint8_t *										m_pui8Page;						/**< The page holding the block. */
+		const uint8_t *										m_pui8RamCode;					/**< If the page is in bus memory, the first byte the block reads. */
+		uint32_t											m_ui32RamCodeLen;				/**< The number of bytes from m_pui8RamCode the block reads. */
+		std::vector<int32_t>								m_vLabels;						/**< The offset of each label, or -1. */
+		std::vector<LSN_FIXUP>								m_vFixups;						/**< Jumps to labels. */
+		std::vector<LSN_EXIT>								m_vExits;						/**< The stubs that leave with a known PC. */
+		std::vector<LSN_EXIT>								m_vLoopExits;					/**< The stubs that leave at the top of a loop. */
+		bool												m_bFloatPending;				/**< The last read was an instruction byte not yet stored as the floating value. */
+		uint8_t												m_ui8Float;						/**< That byte. */
+
+#ifdef LSN_CPU_VERIFY
+		static constexpr bool								m_bAllReads = true;				/**< Every read is made so that it is logged. */
+#else
+		static constexpr bool								m_bAllReads = false;			/**< Reads whose values are unused and whose floating value is replaced are skipped. */
+#endif	// #ifdef LSN_CPU_VERIFY
+
+
+		// == Functions.
+		// Labels.
+		uint32_t											NewLabel() {
+			m_vLabels.push_back( -1 );
+			return uint32_t( m_vLabels.size() - 1 );
+		}
+		void												Bind( uint32_t _ui32Label ) { m_vLabels[_ui32Label] = int32_t( m_vCode.size() ); }
+		uint32_t											ExitLabel( uint16_t _ui16Pc ) {
+			for ( size_t I = 0; I < m_vExits.size(); ++I ) {
+				if ( m_vExits[I].ui16Pc == _ui16Pc ) { return m_vExits[I].ui32Label; }
+			}
+			m_vExits.push_back( { .ui16Pc = _ui16Pc, .ui32Label = NewLabel() } );
+			return m_vExits.back().ui32Label;
+		}
+		uint32_t											LoopExitLabel( uint16_t _ui16Pc ) {
+			for ( size_t I = 0; I < m_vLoopExits.size(); ++I ) {
+				if ( m_vLoopExits[I].ui16Pc == _ui16Pc ) { return m_vLoopExits[I].ui32Label; }
+			}
+			m_vLoopExits.push_back( { .ui16Pc = _ui16Pc, .ui32Label = NewLabel() } );
+			return m_vLoopExits.back().ui32Label;
+		}
+
+		// Encoding.
+		void												B( uint32_t _ui32Byte ) { m_vCode.push_back( uint8_t( _ui32Byte ) ); }
+		void												D16( uint32_t _ui32Val ) { B( _ui32Val ); B( _ui32Val >> 8 ); }
+		void												D32( uint32_t _ui32Val ) { D16( _ui32Val ); D16( _ui32Val >> 16 ); }
+		void												D64( uint64_t _ui64Val ) { D32( uint32_t( _ui64Val ) ); D32( uint32_t( _ui64Val >> 32 ) ); }
+		static LSN_MEM										M( uint32_t _ui32Base, int32_t _i32Disp = 0 ) { return { _ui32Base, LSN_X_NONE, 0, _i32Disp }; }
+		static LSN_MEM										Mi( uint32_t _ui32Base, uint32_t _ui32Index, int32_t _i32Disp = 0 ) { return { _ui32Base, _ui32Index, 0, _i32Disp }; }
+		static LSN_MEM										Cpu( uint32_t _ui32Off ) { return M( LSN_X_CPU, int32_t( _ui32Off ) ); }
+		static LSN_MEM										Frame( size_t _stOff ) { return M( LSN_X_FRAME, int32_t( _stOff ) ); }
+		static bool											IsByteReg( uint32_t _ui32Reg ) { return _ui32Reg >= LSN_X_RSP && _ui32Reg <= LSN_X_RDI; }
+
+		void												Rex( bool _bW, uint32_t _ui32Reg, uint32_t _ui32Index, uint32_t _ui32Base, bool _bForce ) {
+			const uint32_t ui32Index = _ui32Index == LSN_X_NONE ? 0 : _ui32Index;
+			const uint32_t ui32Rex = 0x40 | (uint32_t( _bW ) << 3) | (((_ui32Reg >> 3) & 1) << 2) | (((ui32Index >> 3) & 1) << 1) | ((_ui32Base >> 3) & 1);
+			if ( ui32Rex != 0x40 || _bForce ) { B( ui32Rex ); }
+		}
+		void												ModRm( uint32_t _ui32Reg, const LSN_MEM &_mMem ) {
+			const uint32_t ui32Base = _mMem.ui32Base & 7;
+			const uint32_t ui32Mod = (_mMem.i32Disp == 0 && ui32Base != 5) ? 0 :
+				((_mMem.i32Disp >= -128 && _mMem.i32Disp <= 127) ? 1 : 2);
+			if ( _mMem.ui32Index == LSN_X_NONE && ui32Base != 4 ) {
+				B( (ui32Mod << 6) | ((_ui32Reg & 7) << 3) | ui32Base );
+			}
+			else {
+				B( (ui32Mod << 6) | ((_ui32Reg & 7) << 3) | 4 );
+				const uint32_t ui32Index = _mMem.ui32Index == LSN_X_NONE ? 4 : (_mMem.ui32Index & 7);
+				B( (_mMem.ui32Scale << 6) | (ui32Index << 3) | ui32Base );
+			}
+			if ( ui32Mod == 1 ) { B( uint32_t( _mMem.i32Disp ) ); }
+			else if ( ui32Mod == 2 ) { D32( uint32_t( _mMem.i32Disp ) ); }
+		}
+		/** Writes an instruction with a register and a memory operand.  _ui32Size is 8, 16, 32, or 64. */
+		void												OpM( uint32_t _ui32Size, uint32_t _ui32Op0, uint32_t _ui32Op1, uint32_t _ui32Reg, const LSN_MEM &_mMem, bool _bByteReg = false ) {
+			if ( _ui32Size == 16 ) { B( 0x66 ); }
+			Rex( _ui32Size == 64, _ui32Reg, _mMem.ui32Index, _mMem.ui32Base, _bByteReg && IsByteReg( _ui32Reg ) );
+			B( _ui32Op0 );
+			if ( _ui32Op1 != LSN_X_NONE ) { B( _ui32Op1 ); }
+			ModRm( _ui32Reg, _mMem );
+		}
+		/** Writes an instruction with 2 register operands. */
+		void												OpR( uint32_t _ui32Size, uint32_t _ui32Op0, uint32_t _ui32Op1, uint32_t _ui32Reg, uint32_t _ui32Rm, bool _bByteReg = false, bool _bByteRm = false ) {
+			if ( _ui32Size == 16 ) { B( 0x66 ); }
+			Rex( _ui32Size == 64, _ui32Reg, LSN_X_NONE, _ui32Rm, (_bByteReg && IsByteReg( _ui32Reg )) || (_bByteRm && IsByteReg( _ui32Rm )) );
+			B( _ui32Op0 );
+			if ( _ui32Op1 != LSN_X_NONE ) { B( _ui32Op1 ); }
+			B( 0xC0 | ((_ui32Reg & 7) << 3) | (_ui32Rm & 7) );
+		}
+
+		// Instructions.
+		void												MovRR32( uint32_t _ui32Dst, uint32_t _ui32Src ) { OpR( 32, 0x8B, LSN_X_NONE, _ui32Dst, _ui32Src ); }
+		void												MovRR64( uint32_t _ui32Dst, uint32_t _ui32Src ) { OpR( 64, 0x8B, LSN_X_NONE, _ui32Dst, _ui32Src ); }
+		void												MovRI32( uint32_t _ui32Dst, uint32_t _ui32Imm ) {
+			Rex( false, 0, LSN_X_NONE, _ui32Dst, false );
+			B( 0xB8 + (_ui32Dst & 7) );
+			D32( _ui32Imm );
+		}
+		void												MovRI64( uint32_t _ui32Dst, uint64_t _ui64Imm ) {
+			Rex( true, 0, LSN_X_NONE, _ui32Dst, false );
+			B( 0xB8 + (_ui32Dst & 7) );
+			D64( _ui64Imm );
+		}
+		void												MovRM32( uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 32, 0x8B, LSN_X_NONE, _ui32Dst, _mSrc ); }
+		void												MovRM64( uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 64, 0x8B, LSN_X_NONE, _ui32Dst, _mSrc ); }
+		void												MovMR8( const LSN_MEM &_mDst, uint32_t _ui32Src ) { OpM( 8, 0x88, LSN_X_NONE, _ui32Src, _mDst, true ); }
+		void												MovMR16( const LSN_MEM &_mDst, uint32_t _ui32Src ) { OpM( 16, 0x89, LSN_X_NONE, _ui32Src, _mDst ); }
+		void												MovMI8( const LSN_MEM &_mDst, uint32_t _ui32Imm ) { OpM( 8, 0xC6, LSN_X_NONE, 0, _mDst ); B( _ui32Imm ); }
+		void												MovMI16( const LSN_MEM &_mDst, uint32_t _ui32Imm ) { OpM( 16, 0xC7, LSN_X_NONE, 0, _mDst ); D16( _ui32Imm ); }
+		void												MovzxRM8( uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 32, 0x0F, 0xB6, _ui32Dst, _mSrc ); }
+		void												MovzxRR8( uint32_t _ui32Dst, uint32_t _ui32Src ) { OpR( 32, 0x0F, 0xB6, _ui32Dst, _ui32Src, false, true ); }
+		void												MovzxRR16( uint32_t _ui32Dst, uint32_t _ui32Src ) { OpR( 32, 0x0F, 0xB7, _ui32Dst, _ui32Src ); }
+		void												LeaRM32( uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 32, 0x8D, LSN_X_NONE, _ui32Dst, _mSrc ); }
+		void												LeaRM64( uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 64, 0x8D, LSN_X_NONE, _ui32Dst, _mSrc ); }
+		void												AluRR32( uint32_t _ui32Op, uint32_t _ui32Dst, uint32_t _ui32Src ) { OpR( 32, _ui32Op * 8 + 1, LSN_X_NONE, _ui32Src, _ui32Dst ); }
+		void												AluRR64( uint32_t _ui32Op, uint32_t _ui32Dst, uint32_t _ui32Src ) { OpR( 64, _ui32Op * 8 + 1, LSN_X_NONE, _ui32Src, _ui32Dst ); }
+		void												AluRR8( uint32_t _ui32Op, uint32_t _ui32Dst, uint32_t _ui32Src ) { OpR( 8, _ui32Op * 8, LSN_X_NONE, _ui32Src, _ui32Dst, true, true ); }
+		void												AluRM8( uint32_t _ui32Op, uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 8, _ui32Op * 8 + 2, LSN_X_NONE, _ui32Dst, _mSrc, true ); }
+		void												AluRM32( uint32_t _ui32Op, uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 32, _ui32Op * 8 + 3, LSN_X_NONE, _ui32Dst, _mSrc ); }
+		void												AluRM64( uint32_t _ui32Op, uint32_t _ui32Dst, const LSN_MEM &_mSrc ) { OpM( 64, _ui32Op * 8 + 3, LSN_X_NONE, _ui32Dst, _mSrc ); }
+		void												AluRI32( uint32_t _ui32Op, uint32_t _ui32Dst, int32_t _i32Imm ) {
+			if ( _i32Imm >= -128 && _i32Imm <= 127 ) { OpR( 32, 0x83, LSN_X_NONE, _ui32Op, _ui32Dst ); B( uint32_t( _i32Imm ) ); }
+			else { OpR( 32, 0x81, LSN_X_NONE, _ui32Op, _ui32Dst ); D32( uint32_t( _i32Imm ) ); }
+		}
+		void												AluRI64( uint32_t _ui32Op, uint32_t _ui32Dst, int32_t _i32Imm ) {
+			if ( _i32Imm >= -128 && _i32Imm <= 127 ) { OpR( 64, 0x83, LSN_X_NONE, _ui32Op, _ui32Dst ); B( uint32_t( _i32Imm ) ); }
+			else { OpR( 64, 0x81, LSN_X_NONE, _ui32Op, _ui32Dst ); D32( uint32_t( _i32Imm ) ); }
+		}
+		void												AluRI8( uint32_t _ui32Op, uint32_t _ui32Dst, uint32_t _ui32Imm ) { OpR( 8, 0x80, LSN_X_NONE, _ui32Op, _ui32Dst, false, true ); B( _ui32Imm ); }
+		void												AluMI32( uint32_t _ui32Op, const LSN_MEM &_mDst, int32_t _i32Imm ) {
+			if ( _i32Imm >= -128 && _i32Imm <= 127 ) { OpM( 32, 0x83, LSN_X_NONE, _ui32Op, _mDst ); B( uint32_t( _i32Imm ) ); }
+			else { OpM( 32, 0x81, LSN_X_NONE, _ui32Op, _mDst ); D32( uint32_t( _i32Imm ) ); }
+		}
+		void												AluMI64( uint32_t _ui32Op, const LSN_MEM &_mDst, int8_t _i8Imm ) { OpM( 64, 0x83, LSN_X_NONE, _ui32Op, _mDst ); B( uint32_t( _i8Imm ) ); }
+		void												AluMI8( uint32_t _ui32Op, const LSN_MEM &_mDst, uint32_t _ui32Imm ) { OpM( 8, 0x80, LSN_X_NONE, _ui32Op, _mDst ); B( _ui32Imm ); }
+		void												TestRR8( uint32_t _ui32A, uint32_t _ui32B ) { OpR( 8, 0x84, LSN_X_NONE, _ui32B, _ui32A, true, true ); }
+		void												TestRR64( uint32_t _ui32A, uint32_t _ui32B ) { OpR( 64, 0x85, LSN_X_NONE, _ui32B, _ui32A ); }
+		void												TestRI8( uint32_t _ui32Reg, uint32_t _ui32Imm ) { OpR( 8, 0xF6, LSN_X_NONE, 0, _ui32Reg, false, true ); B( _ui32Imm ); }
+		void												ShiftRI32( uint32_t _ui32Op, uint32_t _ui32Reg, uint32_t _ui32Imm ) { OpR( 32, 0xC1, LSN_X_NONE, _ui32Op, _ui32Reg ); B( _ui32Imm ); }
+		void												ShiftRI64( uint32_t _ui32Op, uint32_t _ui32Reg, uint32_t _ui32Imm ) { OpR( 64, 0xC1, LSN_X_NONE, _ui32Op, _ui32Reg ); B( _ui32Imm ); }
+		void												Shift1R8( uint32_t _ui32Op, uint32_t _ui32Reg ) { OpR( 8, 0xD0, LSN_X_NONE, _ui32Op, _ui32Reg, false, true ); }
+		void												IncR8( uint32_t _ui32Reg ) { OpR( 8, 0xFE, LSN_X_NONE, 0, _ui32Reg, false, true ); }
+		void												DecR8( uint32_t _ui32Reg ) { OpR( 8, 0xFE, LSN_X_NONE, 1, _ui32Reg, false, true ); }
+		void												AddR8I( uint32_t _ui32Reg, uint32_t _ui32Imm ) { AluRI8( LSN_ALU_ADD, _ui32Reg, _ui32Imm ); }
+		void												NotR8( uint32_t _ui32Reg ) { OpR( 8, 0xF6, LSN_X_NONE, 2, _ui32Reg, false, true ); }
+		void												DecM32( const LSN_MEM &_mDst ) { OpM( 32, 0xFF, LSN_X_NONE, 1, _mDst ); }
+		void												SetCc( uint32_t _ui32Cc, uint32_t _ui32Reg ) { OpR( 8, 0x0F, 0x90 + _ui32Cc, 0, _ui32Reg, false, true ); }
+		void												BtRI32( uint32_t _ui32Reg, uint32_t _ui32Bit ) { OpR( 32, 0x0F, 0xBA, 4, _ui32Reg ); B( _ui32Bit ); }
+		void												BtsMR64( const LSN_MEM &_mDst, uint32_t _ui32Bit ) { OpM( 64, 0x0F, 0xAB, _ui32Bit, _mDst ); }
+		void												Push( uint32_t _ui32Reg ) { Rex( false, 0, LSN_X_NONE, _ui32Reg, false ); B( 0x50 + (_ui32Reg & 7) ); }
+		void												Pop( uint32_t _ui32Reg ) { Rex( false, 0, LSN_X_NONE, _ui32Reg, false ); B( 0x58 + (_ui32Reg & 7) ); }
+		void												JmpR( uint32_t _ui32Reg ) { OpR( 32, 0xFF, LSN_X_NONE, 4, _ui32Reg ); }
+		void												CallM( const LSN_MEM &_mDst ) { OpM( 32, 0xFF, LSN_X_NONE, 2, _mDst ); }
+		void												Jcc( uint32_t _ui32Cc, uint32_t _ui32Label ) {
+			B( 0x0F );
+			B( 0x80 + _ui32Cc );
+			m_vFixups.push_back( { .ui32Pos = uint32_t( m_vCode.size() ), .ui32Label = _ui32Label } );
+			D32( 0 );
+		}
+		void												Jmp( uint32_t _ui32Label ) {
+			B( 0xE9 );
+			m_vFixups.push_back( { .ui32Pos = uint32_t( m_vCode.size() ), .ui32Label = _ui32Label } );
+			D32( 0 );
+		}
+		void												JmpExit() {
+			B( 0xE9 );
+			m_vAbsFixups.push_back( uint32_t( m_vCode.size() ) );
+			D32( 0 );
+		}
+
+		// Flags.
+		/** Sets N and Z from a register holding 0-255. */
+		void												SetNz( uint32_t _ui32Reg ) {
+			AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_N | LSN_JF_Z ) & 0xFF );
+			AluRM8( LSN_ALU_OR, LSN_X_P, Mi( LSN_X_NZ, _ui32Reg ) );
+		}
+		/** Sets C from the host carry, and N and Z from a register holding 0-255.  Uses eax. */
+		void												SetCnz( uint32_t _ui32Reg ) {
+			SetCc( LSN_CC_B, LSN_X_RAX );
+			MovzxRR8( LSN_X_RAX, LSN_X_RAX );
+			AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_N | LSN_JF_Z | LSN_JF_C ) & 0xFF );
+			AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RAX );
+			AluRM8( LSN_ALU_OR, LSN_X_P, Mi( LSN_X_NZ, _ui32Reg ) );
+		}
+		/** A += _ui32Reg + C.  Uses eax and edx. */
+		void												Adc( uint32_t _ui32Reg, bool _bInvert ) {
+			if ( _ui32Reg != LSN_X_RAX ) { MovRR32( LSN_X_RAX, _ui32Reg ); }
+			if ( _bInvert ) { NotR8( LSN_X_RAX ); }
+			BtRI32( LSN_X_P, 0 );
+			AluRR8( LSN_ALU_ADC, LSN_X_A, LSN_X_RAX );
+			SetCc( LSN_CC_B, LSN_X_RAX );
+			SetCc( LSN_CC_O, LSN_X_RDX );
+			MovzxRR8( LSN_X_RAX, LSN_X_RAX );
+			MovzxRR8( LSN_X_RDX, LSN_X_RDX );
+			ShiftRI32( LSN_SH_SHL, LSN_X_RDX, 6 );
+			AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_N | LSN_JF_V | LSN_JF_Z | LSN_JF_C ) & 0xFF );
+			AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RAX );
+			AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RDX );
+			AluRM8( LSN_ALU_OR, LSN_X_P, Mi( LSN_X_NZ, LSN_X_A ) );
+		}
+		/** Compares a register with _ui32Val.  Uses eax and edx. */
+		void												Cmp( uint32_t _ui32Reg, uint32_t _ui32Val ) {
+			MovRR32( LSN_X_RDX, _ui32Reg );
+			AluRR8( LSN_ALU_SUB, LSN_X_RDX, _ui32Val );
+			SetCc( LSN_CC_AE, LSN_X_RAX );
+			MovzxRR8( LSN_X_RAX, LSN_X_RAX );
+			MovzxRR8( LSN_X_RDX, LSN_X_RDX );
+			AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_N | LSN_JF_Z | LSN_JF_C ) & 0xFF );
+			AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RAX );
+			AluRM8( LSN_ALU_OR, LSN_X_P, Mi( LSN_X_NZ, LSN_X_RDX ) );
+		}
+
+		// Bus accesses.
+		/** Logs an access.  _ui32AddrReg and _ui32ValReg are registers, or LSN_X_NONE to use the immediates. */
+		void												Log( uint32_t _ui32AddrReg, uint32_t _ui32Addr, uint32_t _ui32ValReg, uint32_t _ui32Val, bool _bRead ) {
+#ifdef LSN_CPU_VERIFY
+			static const uint32_t ui32Saved[] = { LSN_X_RAX, LSN_X_RCX, LSN_X_RDX, LSN_X_RSI, LSN_X_RDI, LSN_X_R8, LSN_X_R9, LSN_X_R10, LSN_X_R11 };
+			for ( size_t I = 0; I < LSN_ELEMENTS( ui32Saved ); ++I ) { Push( ui32Saved[I] ); }
+			AluRI64( LSN_ALU_SUB, LSN_X_RSP, 8 );
+			if ( _ui32AddrReg != LSN_X_NONE ) { MovRR32( LSN_X_RSI, _ui32AddrReg ); }
+			else { MovRI32( LSN_X_RSI, _ui32Addr ); }
+			if ( _ui32ValReg != LSN_X_NONE ) { MovRR32( LSN_X_RDX, _ui32ValReg ); }
+			else { MovRI32( LSN_X_RDX, _ui32Val ); }
+			MovRI32( LSN_X_RCX, _bRead ? 1 : 0 );
+			MovRM64( LSN_X_RDI, Frame( offsetof( LSN_FRAME, pvBus ) ) );
+			CallM( Frame( offsetof( LSN_FRAME, pvLog ) ) );
+			AluRI64( LSN_ALU_ADD, LSN_X_RSP, 8 );
+			for ( size_t I = LSN_ELEMENTS( ui32Saved ); I--; ) { Pop( ui32Saved[I] ); }
+#else
+			static_cast<void>(_ui32AddrReg);
+			static_cast<void>(_ui32Addr);
+			static_cast<void>(_ui32ValReg);
+			static_cast<void>(_ui32Val);
+			static_cast<void>(_bRead);
+#endif	// #ifdef LSN_CPU_VERIFY
+		}
+		/** Reads a byte of the block, whose value is known. */
+		void												CodeRead( uint16_t _ui16Addr ) {
+			m_ui8Float = m_pui8Page[_ui16Addr&0xFF];
+			m_bFloatPending = true;
+			Log( LSN_X_NONE, _ui16Addr, LSN_X_NONE, m_ui8Float, true );
+		}
+		/** Stores the last instruction byte read as the floating value if no read has come after it. */
+		void												FlushFloat() {
+			if ( m_bFloatPending ) {
+				MovMI8( Frame( offsetof( LSN_FRAME, ui8Float ) ), m_ui8Float );
+				m_bFloatPending = false;
+			}
+		}
+		/** eax = the byte at the address in a register.  Uses ecx and edx. */
+		void												ReadR( uint32_t _ui32Addr ) {
+			if ( _ui32Addr != LSN_X_RCX ) { MovRR32( LSN_X_RCX, _ui32Addr ); }
+			MovRR32( LSN_X_RDX, LSN_X_RCX );
+			ShiftRI32( LSN_SH_SHR, LSN_X_RDX, 8 );
+			ShiftRI32( LSN_SH_SHL, LSN_X_RDX, 4 );
+			MovRM64( LSN_X_RDX, Mi( LSN_X_PAGES, LSN_X_RDX, offsetof( CCpuBus::LSN_PAGE, pui8Read ) ) );
+			MovzxRR8( LSN_X_RAX, LSN_X_RCX );
+			MovzxRM8( LSN_X_RAX, Mi( LSN_X_RDX, LSN_X_RAX ) );
+			MovMR8( Frame( offsetof( LSN_FRAME, ui8Float ) ), LSN_X_RAX );
+			m_bFloatPending = false;
+			Log( LSN_X_RCX, 0, LSN_X_RAX, 0, true );
+		}
+		/** eax = the byte at an address.  Uses edx. */
+		void												ReadI( uint16_t _ui16Addr ) {
+			MovRM64( LSN_X_RDX, M( LSN_X_PAGES, int32_t( (_ui16Addr >> 8) * sizeof( CCpuBus::LSN_PAGE ) + offsetof( CCpuBus::LSN_PAGE, pui8Read ) ) ) );
+			MovzxRM8( LSN_X_RAX, M( LSN_X_RDX, _ui16Addr & 0xFF ) );
+			MovMR8( Frame( offsetof( LSN_FRAME, ui8Float ) ), LSN_X_RAX );
+			m_bFloatPending = false;
+			Log( LSN_X_NONE, _ui16Addr, LSN_X_RAX, 0, true );
+		}
+		/** Marks the page of the bus memory at rdx dirty.  Uses ecx and edx. */
+		void												Dirty() {
+			AluRM64( LSN_ALU_SUB, LSN_X_RDX, Frame( offsetof( LSN_FRAME, pui8Ram ) ) );
+			ShiftRI64( LSN_SH_SHR, LSN_X_RDX, 8 );
+			MovRM64( LSN_X_RCX, Frame( offsetof( LSN_FRAME, pui64Dirty ) ) );
+			BtsMR64( M( LSN_X_RCX ), LSN_X_RDX );
+		}
+		/** Writes al to the address in a register.  Uses ecx and edx. */
+		void												WriteR( uint32_t _ui32Addr ) {
+			if ( _ui32Addr != LSN_X_RCX ) { MovRR32( LSN_X_RCX, _ui32Addr ); }
+			Log( LSN_X_RCX, 0, LSN_X_RAX, 0, false );
+			MovRR32( LSN_X_RDX, LSN_X_RCX );
+			ShiftRI32( LSN_SH_SHR, LSN_X_RDX, 8 );
+			ShiftRI32( LSN_SH_SHL, LSN_X_RDX, 4 );
+			MovRM64( LSN_X_RDX, Mi( LSN_X_PAGES, LSN_X_RDX, offsetof( CCpuBus::LSN_PAGE, pui8Write ) ) );
+			MovzxRR8( LSN_X_RCX, LSN_X_RCX );
+			AluRR64( LSN_ALU_ADD, LSN_X_RDX, LSN_X_RCX );
+			MovMR8( M( LSN_X_RDX ), LSN_X_RAX );
+			Dirty();
+		}
+		/** Writes al to an address.  Uses ecx and edx. */
+		void												WriteI( uint16_t _ui16Addr ) {
+			Log( LSN_X_NONE, _ui16Addr, LSN_X_RAX, 0, false );
+			MovRM64( LSN_X_RDX, M( LSN_X_PAGES, int32_t( (_ui16Addr >> 8) * sizeof( CCpuBus::LSN_PAGE ) + offsetof( CCpuBus::LSN_PAGE, pui8Write ) ) ) );
+			LeaRM64( LSN_X_RDX, M( LSN_X_RDX, _ui16Addr & 0xFF ) );
+			MovMR8( M( LSN_X_RDX ), LSN_X_RAX );
+			Dirty();
+		}
+		/** ecx = 0x100 + S. */
+		void												StackAddr( int32_t _i32Offset ) {
+			if ( _i32Offset ) {
+				LeaRM32( LSN_X_RCX, M( LSN_X_S, _i32Offset ) );
+				MovzxRR8( LSN_X_RCX, LSN_X_RCX );
+				AluRI32( LSN_ALU_OR, LSN_X_RCX, 0x100 );
+			}
+			else {
+				LeaRM32( LSN_X_RCX, M( LSN_X_S, 0x100 ) );
+			}
+		}
+		/** Pushes al. */
+		void												Push8() {
+			StackAddr( 0 );
+			WriteR( LSN_X_RCX );
+			DecR8( LSN_X_S );
+		}
+		/** eax = the pulled byte. */
+		void												Pull8() {
+			StackAddr( 1 );
+			ReadR( LSN_X_RCX );
+			IncR8( LSN_X_S );
+		}
+
+		// Checks made before an instruction, which leave through _ui32Exit if they fail.
+		/** Leaves if the direct-write pointer in rdx reaches the bytes of the block.  Uses eax and edx. */
+		void												CheckRamCode( uint32_t _ui32Exit ) {
+			if ( !m_pui8RamCode ) { return; }
+			MovRI64( LSN_X_RAX, reinterpret_cast<uintptr_t>(m_pui8RamCode) );
+			AluRR64( LSN_ALU_SUB, LSN_X_RDX, LSN_X_RAX );
+			AluRI64( LSN_ALU_CMP, LSN_X_RDX, int32_t( m_ui32RamCodeLen ) );
+			Jcc( LSN_CC_B, _ui32Exit );
+		}
+		void												CheckReadI( uint16_t _ui16Addr, uint32_t _ui32Exit ) {
+			AluMI64( LSN_ALU_CMP, M( LSN_X_PAGES, int32_t( (_ui16Addr >> 8) * sizeof( CCpuBus::LSN_PAGE ) + offsetof( CCpuBus::LSN_PAGE, pui8Read ) ) ), 0 );
+			Jcc( LSN_CC_E, _ui32Exit );
+		}
+		void												CheckWriteI( uint16_t _ui16Addr, uint32_t _ui32Exit ) {
+			MovRM64( LSN_X_RDX, M( LSN_X_PAGES, int32_t( (_ui16Addr >> 8) * sizeof( CCpuBus::LSN_PAGE ) + offsetof( CCpuBus::LSN_PAGE, pui8Write ) ) ) );
+			TestRR64( LSN_X_RDX, LSN_X_RDX );
+			Jcc( LSN_CC_E, _ui32Exit );
+			if ( m_pui8RamCode ) {
+				LeaRM64( LSN_X_RDX, M( LSN_X_RDX, _ui16Addr & 0xFF ) );
+				CheckRamCode( _ui32Exit );
+			}
+		}
+		void												CheckReadR( uint32_t _ui32Addr, uint32_t _ui32Exit ) {
+			MovRR32( LSN_X_RDX, _ui32Addr );
+			ShiftRI32( LSN_SH_SHR, LSN_X_RDX, 8 );
+			ShiftRI32( LSN_SH_SHL, LSN_X_RDX, 4 );
+			AluMI64( LSN_ALU_CMP, Mi( LSN_X_PAGES, LSN_X_RDX, offsetof( CCpuBus::LSN_PAGE, pui8Read ) ), 0 );
+			Jcc( LSN_CC_E, _ui32Exit );
+		}
+		/** Checks a write to the address in a register other than eax or edx. */
+		void												CheckWriteR( uint32_t _ui32Addr, uint32_t _ui32Exit ) {
+			MovRR32( LSN_X_RDX, _ui32Addr );
+			ShiftRI32( LSN_SH_SHR, LSN_X_RDX, 8 );
+			ShiftRI32( LSN_SH_SHL, LSN_X_RDX, 4 );
+			MovRM64( LSN_X_RDX, Mi( LSN_X_PAGES, LSN_X_RDX, offsetof( CCpuBus::LSN_PAGE, pui8Write ) ) );
+			TestRR64( LSN_X_RDX, LSN_X_RDX );
+			Jcc( LSN_CC_E, _ui32Exit );
+			if ( m_pui8RamCode ) {
+				MovzxRR8( LSN_X_RAX, _ui32Addr );
+				AluRR64( LSN_ALU_ADD, LSN_X_RDX, LSN_X_RAX );
+				CheckRamCode( _ui32Exit );
+			}
+		}
+		/** Checks a push at S + _i32Offset when the block is in bus memory (the stack page itself is checked on entry). */
+		void												CheckPush( int32_t _i32Offset, uint32_t _ui32Exit ) {
+			if ( !m_pui8RamCode ) { return; }
+			StackAddr( _i32Offset );
+			CheckWriteR( LSN_X_RCX, _ui32Exit );
+		}
+
+		// Context.
+		void												Ctx8( uint32_t _ui32Off, uint32_t _ui32Imm ) { MovMI8( Cpu( _ui32Off ), _ui32Imm ); }
+		void												Ctx16( uint32_t _ui32Off, uint32_t _ui32Imm ) { MovMI16( Cpu( _ui32Off ), _ui32Imm ); }
+		void												Ctx8R( uint32_t _ui32Off, uint32_t _ui32Reg ) { MovMR8( Cpu( _ui32Off ), _ui32Reg ); }
+		void												Ctx16R( uint32_t _ui32Off, uint32_t _ui32Reg ) { MovMR16( Cpu( _ui32Off ), _ui32Reg ); }
+		/** Ends an instruction: its cycles, the micro-op it finished on, the type of its last access, and the floating value. */
+		void												Finish( uint32_t _ui32Cycles, uint32_t _ui32FuncIdx, bool _bRead ) {
+			if ( _ui32Cycles ) { AluRI32( LSN_ALU_ADD, LSN_X_CYCLES, int32_t( _ui32Cycles ) ); }
+			if ( _ui32FuncIdx != LSN_X_NONE ) { Ctx8( m_lLayout.ui32FuncIdx, _ui32FuncIdx ); }
+			Ctx8( m_lLayout.ui32IsReadCycle, _bRead ? 1 : 0 );
+			FlushFloat();
+		}
+
+		/** Continues at an address: inside the block if it is there, otherwise through an exit stub.  Jumps backwards may stop at the loop. */
+		void												Goto( uint16_t _ui16Target, uint16_t _ui16From ) {
+			if ( _ui16Target <= _ui16From ) {
+				AluMI8( LSN_ALU_CMP, Frame( offsetof( LSN_FRAME, ui8StopAtLoops ) ), 0 );
+				Jcc( LSN_CC_NE, LoopExitLabel( _ui16Target ) );
+			}
+			for ( size_t I = 0; I < m_pvInsts->size(); ++I ) {
+				if ( (*m_pvInsts)[I].ui16Pc == _ui16Target ) {
+					Jmp( (*m_pvInsts)[I].ui32Label );
+					return;
+				}
+			}
+			Jmp( ExitLabel( _ui16Target ) );
+		}
+		/** Leaves with PC in a register. */
+		void												ExitPcR( uint32_t _ui32Reg ) {
+			Ctx16R( m_lLayout.ui32Pc, _ui32Reg );
+			JmpExit();
+		}
+
+		/**
+		 * Gets how an instruction uses memory.
+		 *
+		 * \param _ui32Instr The LSN_INSTRUCTIONS value.
+		 * \return Returns the LSN_KIND.
+		 */
+		static LSN_KIND										Kind( uint32_t _ui32Instr ) {
+			switch ( _ui32Instr ) {
+				case CCpuBase::LSN_I_STA : {}
+				case CCpuBase::LSN_I_STX : {}
+				case CCpuBase::LSN_I_STY : {}
+				case CCpuBase::LSN_I_SAX : { return LSN_K_WRITE; }
+				case CCpuBase::LSN_I_ASL : {}
+				case CCpuBase::LSN_I_LSR : {}
+				case CCpuBase::LSN_I_ROL : {}
+				case CCpuBase::LSN_I_ROR : {}
+				case CCpuBase::LSN_I_INC : {}
+				case CCpuBase::LSN_I_DEC : {}
+				case CCpuBase::LSN_I_SLO : {}
+				case CCpuBase::LSN_I_RLA : {}
+				case CCpuBase::LSN_I_SRE : {}
+				case CCpuBase::LSN_I_RRA : {}
+				case CCpuBase::LSN_I_DCP : {}
+				case CCpuBase::LSN_I_ISB : { return LSN_K_RMW; }
+				default : { return LSN_K_READ; }
+			}
+		}
+
+		/** The operation of a read instruction on eax. */
+		void												ReadOp( uint32_t _ui32Instr ) {
+			switch ( _ui32Instr ) {
+				case CCpuBase::LSN_I_LDA : { MovRR32( LSN_X_A, LSN_X_RAX ); SetNz( LSN_X_A ); break; }
+				case CCpuBase::LSN_I_LDX : { MovRR32( LSN_X_X, LSN_X_RAX ); SetNz( LSN_X_X ); break; }
+				case CCpuBase::LSN_I_LDY : { MovRR32( LSN_X_Y, LSN_X_RAX ); SetNz( LSN_X_Y ); break; }
+				case CCpuBase::LSN_I_LXA : {}
+				case CCpuBase::LSN_I_LAX : { MovRR32( LSN_X_A, LSN_X_RAX ); MovRR32( LSN_X_X, LSN_X_RAX ); SetNz( LSN_X_A ); break; }
+				case CCpuBase::LSN_I_LAS : {
+					AluRR32( LSN_ALU_AND, LSN_X_RAX, LSN_X_S );
+					MovRR32( LSN_X_A, LSN_X_RAX );
+					MovRR32( LSN_X_X, LSN_X_RAX );
+					MovRR32( LSN_X_S, LSN_X_RAX );
+					SetNz( LSN_X_A );
+					break;
+				}
+				case CCpuBase::LSN_I_ORA : { AluRR8( LSN_ALU_OR, LSN_X_A, LSN_X_RAX ); SetNz( LSN_X_A ); break; }
+				case CCpuBase::LSN_I_AND : { AluRR8( LSN_ALU_AND, LSN_X_A, LSN_X_RAX ); SetNz( LSN_X_A ); break; }
+				case CCpuBase::LSN_I_EOR : { AluRR8( LSN_ALU_XOR, LSN_X_A, LSN_X_RAX ); SetNz( LSN_X_A ); break; }
+				case CCpuBase::LSN_I_ADC : { Adc( LSN_X_RAX, false ); break; }
+				case CCpuBase::LSN_I_SBC : { Adc( LSN_X_RAX, true ); break; }
+				case CCpuBase::LSN_I_CMP : { Cmp( LSN_X_A, LSN_X_RAX ); break; }
+				case CCpuBase::LSN_I_CPX : { Cmp( LSN_X_X, LSN_X_RAX ); break; }
+				case CCpuBase::LSN_I_CPY : { Cmp( LSN_X_Y, LSN_X_RAX ); break; }
+				case CCpuBase::LSN_I_BIT : {
+					AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_N | LSN_JF_V | LSN_JF_Z ) & 0xFF );
+					MovRR32( LSN_X_RDX, LSN_X_RAX );
+					AluRI32( LSN_ALU_AND, LSN_X_RDX, LSN_JF_N | LSN_JF_V );
+					AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RDX );
+					TestRR8( LSN_X_RAX, LSN_X_A );
+					SetCc( LSN_CC_E, LSN_X_RDX );
+					MovzxRR8( LSN_X_RDX, LSN_X_RDX );
+					AluRR32( LSN_ALU_ADD, LSN_X_RDX, LSN_X_RDX );
+					AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RDX );
+					break;
+				}
+				case CCpuBase::LSN_I_ANC : {}
+				case CCpuBase::LSN_I_ANC2 : {
+					AluRR8( LSN_ALU_AND, LSN_X_A, LSN_X_RAX );
+					SetNz( LSN_X_A );
+					MovRR32( LSN_X_RAX, LSN_X_A );
+					ShiftRI32( LSN_SH_SHR, LSN_X_RAX, 7 );
+					AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_C ) & 0xFF );
+					AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RAX );
+					break;
+				}
+				case CCpuBase::LSN_I_ASR : {
+					AluRR8( LSN_ALU_AND, LSN_X_A, LSN_X_RAX );
+					Shift1R8( LSN_SH_SHR, LSN_X_A );
+					SetCnz( LSN_X_A );
+					break;
+				}
+				case CCpuBase::LSN_I_ARR : {
+					AluRR8( LSN_ALU_AND, LSN_X_A, LSN_X_RAX );
+					BtRI32( LSN_X_P, 0 );
+					Shift1R8( LSN_SH_RCR, LSN_X_A );
+					// C is bit 7 before the shift (now bit 6), and V is C ^ bit 5.
+					AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_N | LSN_JF_V | LSN_JF_Z | LSN_JF_C ) & 0xFF );
+					MovRR32( LSN_X_RAX, LSN_X_A );
+					ShiftRI32( LSN_SH_SHR, LSN_X_RAX, 6 );
+					AluRI32( LSN_ALU_AND, LSN_X_RAX, 1 );
+					AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RAX );
+					MovRR32( LSN_X_RDX, LSN_X_A );
+					ShiftRI32( LSN_SH_SHR, LSN_X_RDX, 5 );
+					AluRR32( LSN_ALU_XOR, LSN_X_RDX, LSN_X_RAX );
+					AluRI32( LSN_ALU_AND, LSN_X_RDX, 1 );
+					ShiftRI32( LSN_SH_SHL, LSN_X_RDX, 6 );
+					AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RDX );
+					AluRM8( LSN_ALU_OR, LSN_X_P, Mi( LSN_X_NZ, LSN_X_A ) );
+					break;
+				}
+				case CCpuBase::LSN_I_ANE : {
+					AluRI8( LSN_ALU_OR, LSN_X_A, 0xEE );
+					AluRR8( LSN_ALU_AND, LSN_X_A, LSN_X_X );
+					AluRR8( LSN_ALU_AND, LSN_X_A, LSN_X_RAX );
+					SetNz( LSN_X_A );
+					break;
+				}
+				case CCpuBase::LSN_I_SBX : {
+					MovRR32( LSN_X_RDX, LSN_X_A );
+					AluRR32( LSN_ALU_AND, LSN_X_RDX, LSN_X_X );
+					AluRR8( LSN_ALU_SUB, LSN_X_RDX, LSN_X_RAX );
+					SetCc( LSN_CC_AE, LSN_X_RAX );
+					MovzxRR8( LSN_X_RAX, LSN_X_RAX );
+					MovzxRR8( LSN_X_X, LSN_X_RDX );
+					AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_N | LSN_JF_Z | LSN_JF_C ) & 0xFF );
+					AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RAX );
+					AluRM8( LSN_ALU_OR, LSN_X_P, Mi( LSN_X_NZ, LSN_X_X ) );
+					break;
+				}
+				default : {}	// NOP.
+			}
+		}
+
+		/** eax = the value stored by a write instruction. */
+		void												StoreValue( uint32_t _ui32Instr ) {
+			switch ( _ui32Instr ) {
+				case CCpuBase::LSN_I_STA : { MovRR32( LSN_X_RAX, LSN_X_A ); break; }
+				case CCpuBase::LSN_I_STX : { MovRR32( LSN_X_RAX, LSN_X_X ); break; }
+				case CCpuBase::LSN_I_STY : { MovRR32( LSN_X_RAX, LSN_X_Y ); break; }
+				default : {		// SAX.
+					MovRR32( LSN_X_RAX, LSN_X_A );
+					AluRR32( LSN_ALU_AND, LSN_X_RAX, LSN_X_X );
+				}
+			}
+		}
+
+		/** The operation of a read-modify-write instruction on a register.  Uses eax and edx. */
+		void												ModifyOp( uint32_t _ui32Instr, uint32_t _ui32Reg ) {
+			switch ( _ui32Instr ) {
+				case CCpuBase::LSN_I_ASL : { Shift1R8( LSN_SH_SHL, _ui32Reg ); SetCnz( _ui32Reg ); break; }
+				case CCpuBase::LSN_I_LSR : { Shift1R8( LSN_SH_SHR, _ui32Reg ); SetCnz( _ui32Reg ); break; }
+				case CCpuBase::LSN_I_ROL : { BtRI32( LSN_X_P, 0 ); Shift1R8( LSN_SH_RCL, _ui32Reg ); SetCnz( _ui32Reg ); break; }
+				case CCpuBase::LSN_I_ROR : { BtRI32( LSN_X_P, 0 ); Shift1R8( LSN_SH_RCR, _ui32Reg ); SetCnz( _ui32Reg ); break; }
+				case CCpuBase::LSN_I_INC : { IncR8( _ui32Reg ); SetNz( _ui32Reg ); break; }
+				case CCpuBase::LSN_I_DEC : { DecR8( _ui32Reg ); SetNz( _ui32Reg ); break; }
+				case CCpuBase::LSN_I_SLO : {
+					Shift1R8( LSN_SH_SHL, _ui32Reg );
+					SetCnz( _ui32Reg );
+					AluRR8( LSN_ALU_OR, LSN_X_A, _ui32Reg );
+					SetNz( LSN_X_A );
+					break;
+				}
+				case CCpuBase::LSN_I_RLA : {
+					BtRI32( LSN_X_P, 0 );
+					Shift1R8( LSN_SH_RCL, _ui32Reg );
+					SetCnz( _ui32Reg );
+					AluRR8( LSN_ALU_AND, LSN_X_A, _ui32Reg );
+					SetNz( LSN_X_A );
+					break;
+				}
+				case CCpuBase::LSN_I_SRE : {
+					Shift1R8( LSN_SH_SHR, _ui32Reg );
+					SetCnz( _ui32Reg );
+					AluRR8( LSN_ALU_XOR, LSN_X_A, _ui32Reg );
+					SetNz( LSN_X_A );
+					break;
+				}
+				case CCpuBase::LSN_I_RRA : {
+					BtRI32( LSN_X_P, 0 );
+					Shift1R8( LSN_SH_RCR, _ui32Reg );
+					SetCnz( _ui32Reg );
+					Adc( _ui32Reg, false );
+					break;
+				}
+				case CCpuBase::LSN_I_DCP : { DecR8( _ui32Reg ); Cmp( LSN_X_A, _ui32Reg ); break; }
+				case CCpuBase::LSN_I_ISB : { IncR8( _ui32Reg ); Adc( _ui32Reg, true ); break; }
+				default : {}
+			}
+		}
+
+		/**
+		 * Gets the most cycles an instruction can take.
+		 *
+		 * \param _oOp The opcode.
+		 * \return Returns the most cycles the instruction can take.
+		 */
+		static uint32_t										MaxCycles( const LSN_OPCODE &_oOp ) {
+			const LSN_KIND kKind = Kind( _oOp.ui8Instruction );
+			switch ( _oOp.ui8AddrMode ) {
+				case CCpuBase::LSN_AM_ZERO_PAGE : { return kKind == LSN_K_RMW ? 5 : 3; }
+				case CCpuBase::LSN_AM_ZERO_PAGE_X : {}
+				case CCpuBase::LSN_AM_ZERO_PAGE_Y : { return kKind == LSN_K_RMW ? 6 : 4; }
+				case CCpuBase::LSN_AM_ABSOLUTE : {
+					if ( _oOp.ui8Instruction == CCpuBase::LSN_I_JMP ) { return 3; }
+					if ( _oOp.ui8Instruction == CCpuBase::LSN_I_JSR ) { return 6; }
+					return kKind == LSN_K_RMW ? 6 : 4;
+				}
+				case CCpuBase::LSN_AM_ABSOLUTE_X : {}
+				case CCpuBase::LSN_AM_ABSOLUTE_Y : { return kKind == LSN_K_RMW ? 7 : 5; }
+				case CCpuBase::LSN_AM_INDIRECT_X : { return kKind == LSN_K_RMW ? 8 : 6; }
+				case CCpuBase::LSN_AM_INDIRECT_Y : { return kKind == LSN_K_RMW ? 8 : 6; }
+				case CCpuBase::LSN_AM_INDIRECT : { return 5; }
+				case CCpuBase::LSN_AM_RELATIVE : { return 4; }
+				default : {
+					switch ( _oOp.ui8Instruction ) {
+						case CCpuBase::LSN_I_PHA : {}
+						case CCpuBase::LSN_I_PHP : { return 3; }
+						case CCpuBase::LSN_I_PLA : {}
+						case CCpuBase::LSN_I_PLP : { return 4; }
+						case CCpuBase::LSN_I_RTS : {}
+						case CCpuBase::LSN_I_RTI : { return 6; }
+						default : { return 2; }
+					}
+				}
+			}
+		}
+
+		/**
+		 * Writes an instruction.
+		 *
+		 * \param _iInst The instruction.
+		 * \return Returns true if the next instruction follows it.
+		 */
+		bool												Inst( const LSN_INST &_iInst ) {
+			const LSN_OPCODE & oOp = m_poOpcodes[_iInst.ui8Op];
+			const uint32_t ui32Instr = oOp.ui8Instruction;
+			const uint16_t ui16Pc = _iInst.ui16Pc;
+			const uint32_t ui32Exit = _iInst.ui32Exit;
+			const LSN_KIND kKind = Kind( ui32Instr );
+			Bind( _iInst.ui32Label );
+			m_bFloatPending = false;
+
+			// The cycle budget and the instruction limit.
+			LeaRM32( LSN_X_RAX, M( LSN_X_CYCLES, int32_t( MaxCycles( oOp ) ) ) );
+			AluRM32( LSN_ALU_CMP, LSN_X_RAX, Frame( offsetof( LSN_FRAME, ui32Budget ) ) );
+			Jcc( LSN_CC_A, ui32Exit );
+			AluMI32( LSN_ALU_CMP, Frame( offsetof( LSN_FRAME, ui32Left ) ), 0 );
+			Jcc( LSN_CC_E, ui32Exit );
+
+			const uint16_t ui16Abs = uint16_t( _iInst.ui8B1 | (_iInst.ui8B2 << 8) );
+			const uint32_t ui32Idx = oOp.ui8AddrMode == CCpuBase::LSN_AM_ZERO_PAGE_Y || oOp.ui8AddrMode == CCpuBase::LSN_AM_ABSOLUTE_Y ? LSN_X_Y : LSN_X_X;
+
+			// Effective addresses and the checks made before anything happens.  r9d = the effective address.  r10d = the address read on
+			//	the wrong page (indexed modes) or the pointer (indirect X).
+			switch ( oOp.ui8AddrMode ) {
+				case CCpuBase::LSN_AM_ZERO_PAGE : {
+					if ( kKind != LSN_K_READ && m_pui8RamCode ) { CheckWriteI( _iInst.ui8B1, ui32Exit ); }
+					break;
+				}
+				case CCpuBase::LSN_AM_ZERO_PAGE_X : {}
+				case CCpuBase::LSN_AM_ZERO_PAGE_Y : {
+					LeaRM32( LSN_X_EA, M( ui32Idx, _iInst.ui8B1 ) );
+					MovzxRR8( LSN_X_EA, LSN_X_EA );
+					if ( kKind != LSN_K_READ && m_pui8RamCode ) { CheckWriteR( LSN_X_EA, ui32Exit ); }
+					break;
+				}
+				case CCpuBase::LSN_AM_ABSOLUTE : {
+					if ( ui32Instr == CCpuBase::LSN_I_JMP ) { break; }
+					if ( ui32Instr == CCpuBase::LSN_I_JSR ) {
+						CheckPush( 0, ui32Exit );
+						CheckPush( -1, ui32Exit );
+						break;
+					}
+					if ( kKind != LSN_K_WRITE ) { CheckReadI( ui16Abs, ui32Exit ); }
+					if ( kKind != LSN_K_READ ) { CheckWriteI( ui16Abs, ui32Exit ); }
+					break;
+				}
+				case CCpuBase::LSN_AM_ABSOLUTE_X : {}
+				case CCpuBase::LSN_AM_ABSOLUTE_Y : {
+					LeaRM32( LSN_X_EA, M( ui32Idx, ui16Abs ) );
+					MovzxRR16( LSN_X_EA, LSN_X_EA );
+					MovzxRR8( LSN_X_TMP, LSN_X_EA );
+					if ( ui16Abs & 0xFF00 ) { AluRI32( LSN_ALU_OR, LSN_X_TMP, ui16Abs & 0xFF00 ); }
+					CheckReadI( ui16Abs, ui32Exit );
+					if ( kKind != LSN_K_WRITE ) { CheckReadR( LSN_X_EA, ui32Exit ); }
+					if ( kKind != LSN_K_READ ) { CheckWriteR( LSN_X_EA, ui32Exit ); }
+					break;
+				}
+				case CCpuBase::LSN_AM_INDIRECT_X : {
+					LeaRM32( LSN_X_TMP, M( LSN_X_X, _iInst.ui8B1 ) );
+					MovzxRR8( LSN_X_TMP, LSN_X_TMP );
+					MovRM64( LSN_X_RDX, M( LSN_X_PAGES, offsetof( CCpuBus::LSN_PAGE, pui8Read ) ) );
+					MovzxRM8( LSN_X_EA, Mi( LSN_X_RDX, LSN_X_TMP ) );
+					LeaRM32( LSN_X_RAX, M( LSN_X_TMP, 1 ) );
+					MovzxRR8( LSN_X_RAX, LSN_X_RAX );
+					MovzxRM8( LSN_X_RAX, Mi( LSN_X_RDX, LSN_X_RAX ) );
+					ShiftRI32( LSN_SH_SHL, LSN_X_RAX, 8 );
+					AluRR32( LSN_ALU_OR, LSN_X_EA, LSN_X_RAX );
+					if ( kKind != LSN_K_WRITE ) { CheckReadR( LSN_X_EA, ui32Exit ); }
+					if ( kKind != LSN_K_READ ) { CheckWriteR( LSN_X_EA, ui32Exit ); }
+					break;
+				}
+				case CCpuBase::LSN_AM_INDIRECT_Y : {
+					MovRM64( LSN_X_RDX, M( LSN_X_PAGES, offsetof( CCpuBus::LSN_PAGE, pui8Read ) ) );
+					MovzxRM8( LSN_X_RCX, M( LSN_X_RDX, _iInst.ui8B1 ) );
+					MovzxRM8( LSN_X_RAX, M( LSN_X_RDX, uint8_t( _iInst.ui8B1 + 1 ) ) );
+					ShiftRI32( LSN_SH_SHL, LSN_X_RAX, 8 );
+					AluRR32( LSN_ALU_OR, LSN_X_RCX, LSN_X_RAX );
+					LeaRM32( LSN_X_EA, Mi( LSN_X_RCX, LSN_X_Y ) );
+					MovzxRR16( LSN_X_EA, LSN_X_EA );
+					MovzxRR8( LSN_X_TMP, LSN_X_EA );
+					AluRI32( LSN_ALU_AND, LSN_X_RCX, 0xFF00 );
+					AluRR32( LSN_ALU_OR, LSN_X_TMP, LSN_X_RCX );
+					CheckReadR( LSN_X_TMP, ui32Exit );
+					if ( kKind != LSN_K_WRITE ) { CheckReadR( LSN_X_EA, ui32Exit ); }
+					if ( kKind != LSN_K_READ ) { CheckWriteR( LSN_X_EA, ui32Exit ); }
+					break;
+				}
+				case CCpuBase::LSN_AM_INDIRECT : {
+					CheckReadI( ui16Abs, ui32Exit );
+					break;
+				}
+				case CCpuBase::LSN_AM_RELATIVE : { break; }
+				default : {
+					switch ( ui32Instr ) {
+						case CCpuBase::LSN_I_PHA : {}
+						case CCpuBase::LSN_I_PHP : { CheckPush( 0, ui32Exit ); break; }
+						case CCpuBase::LSN_I_RTS : {
+							// r9d = the address pulled, at which RTS makes its last read.
+							MovRM64( LSN_X_RDX, M( LSN_X_PAGES, sizeof( CCpuBus::LSN_PAGE ) + offsetof( CCpuBus::LSN_PAGE, pui8Read ) ) );
+							LeaRM32( LSN_X_RAX, M( LSN_X_S, 1 ) );
+							MovzxRR8( LSN_X_RAX, LSN_X_RAX );
+							MovzxRM8( LSN_X_EA, Mi( LSN_X_RDX, LSN_X_RAX ) );
+							IncR8( LSN_X_RAX );
+							MovzxRM8( LSN_X_RAX, Mi( LSN_X_RDX, LSN_X_RAX ) );
+							ShiftRI32( LSN_SH_SHL, LSN_X_RAX, 8 );
+							AluRR32( LSN_ALU_OR, LSN_X_EA, LSN_X_RAX );
+							CheckReadR( LSN_X_EA, ui32Exit );
+							break;
+						}
+						default : {}
+					}
+				}
+			}
+
+			// Committed.
+			DecM32( Frame( offsetof( LSN_FRAME, ui32Left ) ) );
+			Ctx16( m_lLayout.ui32OpCode, _iInst.ui8Op );
+			CodeRead( ui16Pc );
+			const uint16_t ui16Pc1 = uint16_t( ui16Pc + 1 );
+			const uint16_t ui16Pc2 = uint16_t( ui16Pc + 2 );
+
+			switch ( oOp.ui8AddrMode ) {
+				case CCpuBase::LSN_AM_IMMEDIATE : {
+					CodeRead( ui16Pc1 );
+					MovRI32( LSN_X_RAX, _iInst.ui8B1 );
+					ReadOp( ui32Instr );
+					Finish( 2, 0, true );
+					return true;
+				}
+				case CCpuBase::LSN_AM_ZERO_PAGE : {
+					CodeRead( ui16Pc1 );
+					Ctx16( m_lLayout.ui32Address, _iInst.ui8B1 );
+					if ( kKind == LSN_K_READ ) {
+						ReadI( _iInst.ui8B1 );
+						ReadOp( ui32Instr );
+						Finish( 3, 1, true );
+					}
+					else if ( kKind == LSN_K_WRITE ) {
+						StoreValue( ui32Instr );
+						WriteI( _iInst.ui8B1 );
+						Finish( 3, 1, false );
+					}
+					else {
+						ReadI( _iInst.ui8B1 );
+						MovRR32( LSN_X_TMP, LSN_X_RAX );
+						WriteI( _iInst.ui8B1 );
+						ModifyOp( ui32Instr, LSN_X_TMP );
+						MovRR32( LSN_X_RAX, LSN_X_TMP );
+						WriteI( _iInst.ui8B1 );
+						Ctx8R( m_lLayout.ui32Operand, LSN_X_TMP );
+						Finish( 5, 3, false );
+					}
+					return true;
+				}
+				case CCpuBase::LSN_AM_ZERO_PAGE_X : {}
+				case CCpuBase::LSN_AM_ZERO_PAGE_Y : {
+					CodeRead( ui16Pc1 );
+					Ctx16R( m_lLayout.ui32Address, LSN_X_EA );
+					if ( m_bAllReads || kKind == LSN_K_WRITE ) { ReadI( _iInst.ui8B1 ); }
+					MemOp( ui32Instr, kKind, 4, 2 );
+					return true;
+				}
+				case CCpuBase::LSN_AM_ABSOLUTE : {
+					CodeRead( ui16Pc1 );
+					if ( ui32Instr == CCpuBase::LSN_I_JSR ) {
+						if ( m_bAllReads ) {
+							StackAddr( 0 );
+							ReadR( LSN_X_RCX );
+						}
+						MovRI32( LSN_X_RAX, ui16Pc2 >> 8 );
+						Push8();
+						MovRI32( LSN_X_RAX, ui16Pc2 & 0xFF );
+						Push8();
+						CodeRead( ui16Pc2 );
+						Ctx16( m_lLayout.ui32JmpTarget, ui16Abs );
+						Finish( 6, 4, true );
+						Goto( ui16Abs, ui16Pc );
+						return false;
+					}
+					CodeRead( ui16Pc2 );
+					if ( ui32Instr == CCpuBase::LSN_I_JMP ) {
+						Ctx16( m_lLayout.ui32JmpTarget, ui16Abs );
+						Finish( 3, 1, true );
+						Goto( ui16Abs, ui16Pc );
+						return false;
+					}
+					Ctx8( m_lLayout.ui32JmpTarget, _iInst.ui8B1 );
+					Ctx16( m_lLayout.ui32Address, ui16Abs );
+					if ( kKind == LSN_K_READ ) {
+						ReadI( ui16Abs );
+						ReadOp( ui32Instr );
+						Finish( 4, 2, true );
+					}
+					else if ( kKind == LSN_K_WRITE ) {
+						StoreValue( ui32Instr );
+						WriteI( ui16Abs );
+						Finish( 4, 2, false );
+					}
+					else {
+						ReadI( ui16Abs );
+						MovRR32( LSN_X_TMP, LSN_X_RAX );
+						WriteI( ui16Abs );
+						ModifyOp( ui32Instr, LSN_X_TMP );
+						MovRR32( LSN_X_RAX, LSN_X_TMP );
+						WriteI( ui16Abs );
+						Ctx8R( m_lLayout.ui32Operand, LSN_X_TMP );
+						Finish( 6, 4, false );
+					}
+					return true;
+				}
+				case CCpuBase::LSN_AM_ABSOLUTE_X : {}
+				case CCpuBase::LSN_AM_ABSOLUTE_Y : {
+					CodeRead( ui16Pc1 );
+					CodeRead( ui16Pc2 );
+					Ctx16R( m_lLayout.ui32Address, LSN_X_EA );
+					Ctx16R( m_lLayout.ui32JmpTarget, LSN_X_EA );
+					IndexedOp( ui32Instr, kKind, 4 );
+					return true;
+				}
+				case CCpuBase::LSN_AM_INDIRECT_X : {
+					CodeRead( ui16Pc1 );
+					Ctx8R( m_lLayout.ui32Pointer, LSN_X_TMP );
+					Ctx16R( m_lLayout.ui32Address, LSN_X_EA );
+					if ( m_bAllReads ) {
+						ReadI( _iInst.ui8B1 );
+						ReadR( LSN_X_TMP );
+					}
+					if ( m_bAllReads || kKind == LSN_K_WRITE ) {
+						LeaRM32( LSN_X_RCX, M( LSN_X_TMP, 1 ) );
+						MovzxRR8( LSN_X_RCX, LSN_X_RCX );
+						ReadR( LSN_X_RCX );
+					}
+					MemOp( ui32Instr, kKind, 6, 4 );
+					return true;
+				}
+				case CCpuBase::LSN_AM_INDIRECT_Y : {
+					CodeRead( ui16Pc1 );
+					Ctx8( m_lLayout.ui32Pointer, _iInst.ui8B1 );
+					Ctx16R( m_lLayout.ui32Address, LSN_X_EA );
+					Ctx16R( m_lLayout.ui32JmpTarget, LSN_X_EA );
+					if ( m_bAllReads ) {
+						ReadI( _iInst.ui8B1 );
+						ReadI( uint8_t( _iInst.ui8B1 + 1 ) );
+					}
+					IndexedOp( ui32Instr, kKind, 5 );
+					return true;
+				}
+				case CCpuBase::LSN_AM_INDIRECT : {
+					CodeRead( ui16Pc1 );
+					CodeRead( ui16Pc2 );
+					Ctx16( m_lLayout.ui32Address, ui16Abs );
+					ReadI( ui16Abs );
+					MovRR32( LSN_X_EA, LSN_X_RAX );
+					ReadI( uint16_t( (ui16Abs & 0xFF00) | uint8_t( ui16Abs + 1 ) ) );
+					ShiftRI32( LSN_SH_SHL, LSN_X_RAX, 8 );
+					AluRR32( LSN_ALU_OR, LSN_X_EA, LSN_X_RAX );
+					Ctx16R( m_lLayout.ui32JmpTarget, LSN_X_EA );
+					Finish( 5, 3, true );
+					ExitPcR( LSN_X_EA );
+					return false;
+				}
+				case CCpuBase::LSN_AM_RELATIVE : {
+					Branch( _iInst );
+					return true;
+				}
+				default : { return Implied( _iInst ); }
+			}
+		}
+
+		/**
+		 * The memory access and operation of a non-indexed mode once the effective address is in r9d.
+		 *
+		 * \param _ui32Instr The instruction.
+		 * \param _kKind How it uses memory.
+		 * \param _ui32Cycles The cycles of a read or write.
+		 * \param _ui32FuncIdx The micro-op on which a read or write finishes.
+		 */
+		void												MemOp( uint32_t _ui32Instr, LSN_KIND _kKind, uint32_t _ui32Cycles, uint32_t _ui32FuncIdx ) {
+			if ( _kKind == LSN_K_READ ) {
+				ReadR( LSN_X_EA );
+				ReadOp( _ui32Instr );
+				Finish( _ui32Cycles, _ui32FuncIdx, true );
+			}
+			else if ( _kKind == LSN_K_WRITE ) {
+				StoreValue( _ui32Instr );
+				WriteR( LSN_X_EA );
+				Finish( _ui32Cycles, _ui32FuncIdx, false );
+			}
+			else {
+				ReadR( LSN_X_EA );
+				MovRR32( LSN_X_TMP, LSN_X_RAX );
+				WriteR( LSN_X_EA );
+				ModifyOp( _ui32Instr, LSN_X_TMP );
+				MovRR32( LSN_X_RAX, LSN_X_TMP );
+				WriteR( LSN_X_EA );
+				Ctx8R( m_lLayout.ui32Operand, LSN_X_TMP );
+				Finish( _ui32Cycles + 2, _ui32FuncIdx + 2, false );
+			}
+		}
+
+		/**
+		 * The memory access and operation of absolute X/Y and indirect Y once the effective address is in r9d and the address on the
+		 *	wrong page in r10d.
+		 *
+		 * \param _ui32Instr The instruction.
+		 * \param _kKind How it uses memory.
+		 * \param _ui32Cycles The cycles of a read that crosses no page.
+		 */
+		void												IndexedOp( uint32_t _ui32Instr, LSN_KIND _kKind, uint32_t _ui32Cycles ) {
+			const uint32_t ui32FuncIdx = _ui32Cycles - 2;
+			if ( _kKind == LSN_K_READ ) {
+				// A page crossing reads the wrong page first and takes 1 more cycle.
+				const uint32_t ui32NoCross = NewLabel();
+				const uint32_t ui32Join = NewLabel();
+				AluRR32( LSN_ALU_CMP, LSN_X_EA, LSN_X_TMP );
+				Jcc( LSN_CC_E, ui32NoCross );
+				if ( m_bAllReads ) { ReadR( LSN_X_TMP ); }
+				AluRI32( LSN_ALU_ADD, LSN_X_CYCLES, 1 );
+				Ctx8( m_lLayout.ui32FuncIdx, ui32FuncIdx + 1 );
+				Jmp( ui32Join );
+				Bind( ui32NoCross );
+				Ctx8( m_lLayout.ui32FuncIdx, ui32FuncIdx );
+				Bind( ui32Join );
+				ReadR( LSN_X_EA );
+				ReadOp( _ui32Instr );
+				Finish( _ui32Cycles, LSN_X_NONE, true );
+			}
+			else if ( _kKind == LSN_K_WRITE ) {
+				ReadR( LSN_X_TMP );
+				Ctx8R( m_lLayout.ui32Operand, LSN_X_RAX );
+				StoreValue( _ui32Instr );
+				WriteR( LSN_X_EA );
+				Finish( _ui32Cycles + 1, ui32FuncIdx + 1, false );
+			}
+			else {
+				if ( m_bAllReads ) { ReadR( LSN_X_TMP ); }
+				ReadR( LSN_X_EA );
+				MovRR32( LSN_X_TMP, LSN_X_RAX );
+				WriteR( LSN_X_EA );
+				ModifyOp( _ui32Instr, LSN_X_TMP );
+				MovRR32( LSN_X_RAX, LSN_X_TMP );
+				WriteR( LSN_X_EA );
+				Ctx8R( m_lLayout.ui32Operand, LSN_X_TMP );
+				Finish( _ui32Cycles + 3, ui32FuncIdx + 3, false );
+			}
+		}
+
+		/**
+		 * Writes a branch.
+		 *
+		 * \param _iInst The instruction.
+		 */
+		void												Branch( const LSN_INST &_iInst ) {
+			const uint16_t ui16Next = uint16_t( _iInst.ui16Pc + 2 );
+			const uint16_t ui16Target = uint16_t( ui16Next + int8_t( _iInst.ui8B1 ) );
+			uint32_t ui32Flag = LSN_JF_N;
+			bool bSet = false;
+			switch ( m_poOpcodes[_iInst.ui8Op].ui8Instruction ) {
+				case CCpuBase::LSN_I_BPL : { ui32Flag = LSN_JF_N; bSet = false; break; }
+				case CCpuBase::LSN_I_BMI : { ui32Flag = LSN_JF_N; bSet = true; break; }
+				case CCpuBase::LSN_I_BVC : { ui32Flag = LSN_JF_V; bSet = false; break; }
+				case CCpuBase::LSN_I_BVS : { ui32Flag = LSN_JF_V; bSet = true; break; }
+				case CCpuBase::LSN_I_BCC : { ui32Flag = LSN_JF_C; bSet = false; break; }
+				case CCpuBase::LSN_I_BCS : { ui32Flag = LSN_JF_C; bSet = true; break; }
+				case CCpuBase::LSN_I_BNE : { ui32Flag = LSN_JF_Z; bSet = false; break; }
+				case CCpuBase::LSN_I_BEQ : { ui32Flag = LSN_JF_Z; bSet = true; break; }
+				default : {}
+			}
+			CodeRead( uint16_t( _iInst.ui16Pc + 1 ) );
+			Ctx8( m_lLayout.ui32Operand, _iInst.ui8B1 );
+			const uint32_t ui32NotTaken = NewLabel();
+			TestRI8( LSN_X_P, ui32Flag );
+			Jcc( bSet ? LSN_CC_E : LSN_CC_NE, ui32NotTaken );
+
+			// Taken: the next opcode is read, then on a page crossing the target's low byte on the next opcode's page.
+			const bool bFloatPending = m_bFloatPending;
+			const uint8_t ui8Float = m_ui8Float;
+			CodeRead( ui16Next );
+			Ctx16( m_lLayout.ui32JmpTarget, ui16Target );
+			if ( (ui16Target ^ ui16Next) & 0xFF00 ) {
+				MovRI64( LSN_X_RAX, reinterpret_cast<uintptr_t>(m_pui8Page) );
+				MovzxRM8( LSN_X_RAX, M( LSN_X_RAX, ui16Target & 0xFF ) );
+				MovMR8( Frame( offsetof( LSN_FRAME, ui8Float ) ), LSN_X_RAX );
+				m_bFloatPending = false;
+				Log( LSN_X_NONE, (ui16Next & 0xFF00) | (ui16Target & 0xFF), LSN_X_RAX, 0, true );
+				Finish( 4, 2, true );
+			}
+			else {
+				Finish( 3, 1, true );
+			}
+			Goto( ui16Target, _iInst.ui16Pc );
+
+			Bind( ui32NotTaken );
+			m_bFloatPending = bFloatPending;
+			m_ui8Float = ui8Float;
+			Finish( 2, 0, true );
+		}
+
+		/**
+		 * Writes an implied-mode instruction.
+		 *
+		 * \param _iInst The instruction.
+		 * \return Returns true if the next instruction follows it.
+		 */
+		bool												Implied( const LSN_INST &_iInst ) {
+			const uint32_t ui32Instr = m_poOpcodes[_iInst.ui8Op].ui8Instruction;
+			CodeRead( uint16_t( _iInst.ui16Pc + 1 ) );
+			switch ( ui32Instr ) {
+				case CCpuBase::LSN_I_PHA : {}
+				case CCpuBase::LSN_I_PHP : {
+					if ( ui32Instr == CCpuBase::LSN_I_PHA ) {
+						MovRR32( LSN_X_RAX, LSN_X_A );
+					}
+					else {
+						AluRI32( LSN_ALU_OR, LSN_X_P, LSN_JF_R );
+						MovRR32( LSN_X_RAX, LSN_X_P );
+						AluRI32( LSN_ALU_OR, LSN_X_RAX, LSN_JF_B | LSN_JF_R );
+					}
+					Push8();
+					Finish( 3, 1, false );
+					return true;
+				}
+				case CCpuBase::LSN_I_PLA : {}
+				case CCpuBase::LSN_I_PLP : {
+					if ( m_bAllReads ) {
+						StackAddr( 0 );
+						ReadR( LSN_X_RCX );
+					}
+					Pull8();
+					if ( ui32Instr == CCpuBase::LSN_I_PLA ) {
+						MovRR32( LSN_X_A, LSN_X_RAX );
+						SetNz( LSN_X_A );
+					}
+					else {
+						AluRI32( LSN_ALU_AND, LSN_X_RAX, ~int32_t( LSN_JF_B | LSN_JF_R ) & 0xFF );
+						AluRI32( LSN_ALU_OR, LSN_X_RAX, LSN_JF_R );
+						MovRR32( LSN_X_P, LSN_X_RAX );
+					}
+					Finish( 4, 2, true );
+					return true;
+				}
+				case CCpuBase::LSN_I_RTS : {
+					// The address pulled is already in r9d.
+					if ( m_bAllReads ) {
+						StackAddr( 0 );
+						ReadR( LSN_X_RCX );
+						Pull8();
+						Pull8();
+					}
+					else {
+						AddR8I( LSN_X_S, 2 );
+					}
+					ReadR( LSN_X_EA );
+					Finish( 6, 4, true );
+					LeaRM32( LSN_X_EA, M( LSN_X_EA, 1 ) );
+					MovzxRR16( LSN_X_EA, LSN_X_EA );
+					ExitPcR( LSN_X_EA );
+					return false;
+				}
+				case CCpuBase::LSN_I_RTI : {
+					if ( m_bAllReads ) {
+						StackAddr( 0 );
+						ReadR( LSN_X_RCX );
+					}
+					Pull8();
+					AluRI32( LSN_ALU_AND, LSN_X_RAX, ~int32_t( LSN_JF_B | LSN_JF_R ) & 0xFF );
+					AluRI32( LSN_ALU_AND, LSN_X_P, LSN_JF_B | LSN_JF_R );
+					AluRR32( LSN_ALU_OR, LSN_X_P, LSN_X_RAX );
+					Pull8();
+					MovRR32( LSN_X_EA, LSN_X_RAX );
+					Pull8();
+					ShiftRI32( LSN_SH_SHL, LSN_X_RAX, 8 );
+					AluRR32( LSN_ALU_OR, LSN_X_EA, LSN_X_RAX );
+					Finish( 6, 4, true );
+					ExitPcR( LSN_X_EA );
+					return false;
+				}
+				case CCpuBase::LSN_I_CLC : { AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_C ) & 0xFF ); break; }
+				case CCpuBase::LSN_I_SEC : { AluRI32( LSN_ALU_OR, LSN_X_P, LSN_JF_C ); break; }
+				case CCpuBase::LSN_I_CLI : { AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_I ) & 0xFF ); break; }
+				case CCpuBase::LSN_I_SEI : { AluRI32( LSN_ALU_OR, LSN_X_P, LSN_JF_I ); break; }
+				case CCpuBase::LSN_I_CLD : { AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_D ) & 0xFF ); break; }
+				case CCpuBase::LSN_I_SED : { AluRI32( LSN_ALU_OR, LSN_X_P, LSN_JF_D ); break; }
+				case CCpuBase::LSN_I_CLV : { AluRI32( LSN_ALU_AND, LSN_X_P, ~int32_t( LSN_JF_V ) & 0xFF ); break; }
+				case CCpuBase::LSN_I_TAX : { MovRR32( LSN_X_X, LSN_X_A ); SetNz( LSN_X_X ); break; }
+				case CCpuBase::LSN_I_TAY : { MovRR32( LSN_X_Y, LSN_X_A ); SetNz( LSN_X_Y ); break; }
+				case CCpuBase::LSN_I_TXA : { MovRR32( LSN_X_A, LSN_X_X ); SetNz( LSN_X_A ); break; }
+				case CCpuBase::LSN_I_TYA : { MovRR32( LSN_X_A, LSN_X_Y ); SetNz( LSN_X_A ); break; }
+				case CCpuBase::LSN_I_TSX : { MovRR32( LSN_X_X, LSN_X_S ); SetNz( LSN_X_X ); break; }
+				case CCpuBase::LSN_I_TXS : { MovRR32( LSN_X_S, LSN_X_X ); break; }
+				case CCpuBase::LSN_I_INX : { IncR8( LSN_X_X ); SetNz( LSN_X_X ); break; }
+				case CCpuBase::LSN_I_INY : { IncR8( LSN_X_Y ); SetNz( LSN_X_Y ); break; }
+				case CCpuBase::LSN_I_DEX : { DecR8( LSN_X_X ); SetNz( LSN_X_X ); break; }
+				case CCpuBase::LSN_I_DEY : { DecR8( LSN_X_Y ); SetNz( LSN_X_Y ); break; }
+				case CCpuBase::LSN_I_ASL : {}
+				case CCpuBase::LSN_I_LSR : {}
+				case CCpuBase::LSN_I_ROL : {}
+				case CCpuBase::LSN_I_ROR : { ModifyOp( ui32Instr, LSN_X_A ); break; }
+				default : {}	// NOP.
+			}
+			Finish( 2, 0, true );
+			return true;
+		}
+	};
+#endif	// #ifdef LSN_JIT_X64
+
+	CJit6502::CJit6502() :
+		m_pui8Exec( nullptr ),
+		m_stExecUsed( 0 ),
+		m_stEntryEnd( 0 ),
+		m_stExitCode( 0 ) {
+		std::memset( &m_lLayout, 0, sizeof( m_lLayout ) );
+		std::memset( m_oOpcodes, 0, sizeof( m_oOpcodes ) );
+		ResetStats();
+	}
+	CJit6502::~CJit6502() {
+		Reset();
+	}
+
+	// == Functions.
+	/**
+	 * Sets where the CPU keeps its state and how it decodes each opcode.  Must be called before Run().
+	 *
+	 * \param _lLayout The offsets of the CPU's state.
+	 * \param _poOpcodes The 256 opcodes.
+	 */
+	void CJit6502::SetCpu( const LSN_LAYOUT &_lLayout, const LSN_OPCODE * _poOpcodes ) {
+		Reset();
+		m_lLayout = _lLayout;
+		std::memcpy( m_oOpcodes, _poOpcodes, sizeof( m_oOpcodes ) );
+	}
+
+	/**
+	 * Runs compiled blocks from PC for as long as they can run.
+	 *
+	 * \param _pvCpu The CPU whose state is described by the layout given to SetCpu().
+	 * \param _bBus The CPU bus.
+	 * \param _ui32MaxCycles The most cycles to run.
+	 * \param _ui32Insts On input, the most instructions to run.  On output, the number run.
+	 * \param _bStopAtLoops On input, if true, returns after any jump or branch backwards, so the caller can check for an idle loop.  On
+	 *	output, true if it did so.
+	 * \return Returns the number of cycles run, or 0 if the instruction at PC must be run some other way.
+	 */
+	uint32_t CJit6502::Run( void * _pvCpu, CCpuBus &_bBus, uint32_t _ui32MaxCycles, uint32_t &_ui32Insts, bool &_bStopAtLoops ) {
+#ifdef LSN_JIT_X64
+		// Compiled code goes straight to the zero page and stack.
+		const CCpuBus::LSN_PAGE * ppPages = _bBus.PageTable();
+		const uint32_t ui32MaxInsts = _ui32Insts;
+		_ui32Insts = 0;
+		if ( !ppPages[0].pui8Read || !ppPages[0].pui8Write || !ppPages[1].pui8Read || !ppPages[1].pui8Write ) {
+			_bStopAtLoops = false;
+			return 0;
+		}
+
+		LSN_FRAME fFrame;
+		fFrame.ppPages = ppPages;
+		fFrame.pui8Ram = _bBus.Memory();
+		fFrame.pui64Dirty = _bBus.DirtyPages();
+		fFrame.pui8Nz = g_ntNzTable.ui8Flags;
+		fFrame.pvBus = &_bBus;
+#ifdef LSN_CPU_VERIFY
+		fFrame.pvLog = reinterpret_cast<void *>(&CJit6502::LogAccess);
+#else
+		fFrame.pvLog = nullptr;
+#endif	// #ifdef LSN_CPU_VERIFY
+		fFrame.ui8Float = _bBus.GetFloat();
+		fFrame.ui8StopAtLoops = _bStopAtLoops;
+		fFrame.ui8Looped = 0;
+		_bStopAtLoops = false;
+
+		const uint16_t & ui16Pc = (*reinterpret_cast<uint16_t *>(static_cast<uint8_t *>(_pvCpu) + m_lLayout.ui32Pc));
+		uint32_t ui32Cycles = 0;
+		uint32_t ui32Insts = 0;
+		while ( ui32Insts < ui32MaxInsts ) {
+			const uint16_t ui16Start = ui16Pc;
+			const uint8_t * pui8Page = _bBus.PageTableRead( ui16Start >> 8 );
+			if ( !pui8Page ) { break; }
+			const LSN_BLOCK & bBlock = Find( ui16Start, pui8Page, _bBus );
+			if ( !bBlock.pui8Code ) { break; }
+
+			fFrame.ui32Budget = _ui32MaxCycles - ui32Cycles;
+			fFrame.ui32Left = ui32MaxInsts - ui32Insts;
+			const uint32_t ui32Run = reinterpret_cast<PfEntry>(m_pui8Exec)( _pvCpu, &fFrame, bBlock.pui8Code );
+			const uint32_t ui32Ran = (ui32MaxInsts - ui32Insts) - fFrame.ui32Left;
+			if ( !ui32Ran ) { break; }
+			ui32Cycles += ui32Run;
+			ui32Insts += ui32Ran;
+			++m_jsStats.ui64Runs;
+			if ( fFrame.ui8Looped ) {
+				_bStopAtLoops = true;
+				break;
+			}
+		}
+		if ( ui32Insts ) {
+			_bBus.SetFloat( fFrame.ui8Float );
+			m_jsStats.ui64Instructions += ui32Insts;
+		}
+		_ui32Insts = ui32Insts;
+		return ui32Cycles;
+#else
+		static_cast<void>(_pvCpu);
+		static_cast<void>(_bBus);
+		static_cast<void>(_ui32MaxCycles);
+		_bStopAtLoops = false;
+		_ui32Insts = 0;
+		return 0;
+#endif	// #ifdef LSN_JIT_X64
+	}
+
+	/**
+	 * Drops every compiled block.
+	 */
+	void CJit6502::Clear() {
+		for ( size_t I = 0; I < m_vBlocks.size(); ++I ) {
+			m_vBlocks[I] = LSN_BLOCK();
+		}
+		m_vBytes.clear();
+		m_stExecUsed = m_stEntryEnd;
+	}
+
+	/**
+	 * Drops every compiled block and frees the executable memory.
+	 */
+	void CJit6502::Reset() {
+		m_vBlocks = std::vector<LSN_BLOCK>();
+		m_vBytes = std::vector<uint8_t>();
+#ifdef LSN_JIT_X64
+		if ( m_pui8Exec ) {
+			::munmap( m_pui8Exec, LSN_JS_CODE_SIZE );
+		}
+#endif	// #ifdef LSN_JIT_X64
+		m_pui8Exec = nullptr;
+		m_stExecUsed = m_stEntryEnd = 0;
+	}
+
+	/**
+	 * Finds or compiles the block at an address.
+	 *
+	 * \param _ui16Pc The address.
+	 * \param _pui8Page The page-table memory of the page holding _ui16Pc.
+	 * \param _bBus The CPU bus.
+	 * \return Returns the block, whose pui8Code is nullptr if its first instruction cannot be compiled.
+	 */
+	const CJit6502::LSN_BLOCK & CJit6502::Find( uint16_t _ui16Pc, const uint8_t * _pui8Page, const CCpuBus &_bBus ) {
+		if ( m_vBlocks.empty() ) { m_vBlocks.resize( LSN_JS_BLOCKS ); }
+		LSN_BLOCK & bBlock = m_vBlocks[Hash( _ui16Pc )];
+		if ( bBlock.pui8Page == _pui8Page && bBlock.ui16Pc == _ui16Pc ) {
+			if ( std::memcmp( _pui8Page + bBlock.ui8Low, &m_vBytes[bBlock.ui32Bytes], size_t( bBlock.ui8Len ) + 1 ) == 0 ) { return bBlock; }
+			++m_jsStats.ui64Invalidations;
+		}
+		bBlock.pui8Page = _pui8Page;
+		bBlock.ui16Pc = _ui16Pc;
+		Compile( bBlock, _bBus );
+		return bBlock;
+	}
+
+	/**
+	 * Determines whether an opcode can be compiled.
+	 *
+	 * \param _oOp The opcode.
+	 * \return Returns true if the opcode can be compiled.
+	 */
+	bool CJit6502::Compilable( const LSN_OPCODE &_oOp ) {
+		switch ( _oOp.ui8Instruction ) {
+			// Left to the cycle-by-cycle path: interrupts, JAM, and the stores whose values depend on the address.
+			case CCpuBase::LSN_I_BRK : {}
+			case CCpuBase::LSN_I_JAM : {}
+			case CCpuBase::LSN_I_SHA : {}
+			case CCpuBase::LSN_I_SHX : {}
+			case CCpuBase::LSN_I_SHY : {}
+			case CCpuBase::LSN_I_SHS : {}
+			case CCpuBase::LSN_I_NMI : {}
+			case CCpuBase::LSN_I_IRQ : { return false; }
+			default : { return _oOp.ui8Fetch != 0; }
+		}
+	}
+
+	/**
+	 * Compiles a block.
+	 *
+	 * \param _bBlock The block, with pui8Page and ui16Pc set.
+	 * \param _bBus The CPU bus.
+	 */
+	void CJit6502::Compile( LSN_BLOCK &_bBlock, const CCpuBus &_bBus ) {
+		const uint8_t * pui8Page = _bBlock.pui8Page;
+		const uint16_t ui16Pc = _bBlock.ui16Pc;
+		const uint32_t ui32Low = ui16Pc & 0xFF;
+		uint32_t ui32End = ui32Low + 1;
+#ifdef LSN_JIT_X64
+		// Instructions up to the end of the page, the first one that cannot be compiled, or an unconditional jump or return.  Branches
+		//	fall through.
+		std::vector<LSN_INST> vInsts;
+		for ( uint32_t ui32Off = ui32Low; ui32Off < 0x100 && vInsts.size() < LSN_JS_BLOCK_INSTS; ) {
+			const uint8_t ui8Op = pui8Page[ui32Off];
+			const LSN_OPCODE & oOp = m_oOpcodes[ui8Op];
+			if ( !Compilable( oOp ) || ui32Off + oOp.ui8Fetch > 0x100 ) { break; }
+			LSN_INST iInst = {};
+			iInst.ui16Pc = uint16_t( (ui16Pc & 0xFF00) | ui32Off );
+			iInst.ui8Op = ui8Op;
+			iInst.ui8B1 = pui8Page[ui32Off+1];
+			iInst.ui8B2 = oOp.ui8Fetch > 2 ? pui8Page[ui32Off+2] : 0;
+			vInsts.push_back( iInst );
+			ui32End = std::max( ui32End, ui32Off + oOp.ui8Fetch );
+			ui32Off += oOp.ui8Size;
+			if ( oOp.ui8Instruction == CCpuBase::LSN_I_JMP || oOp.ui8Instruction == CCpuBase::LSN_I_JSR ||
+				oOp.ui8Instruction == CCpuBase::LSN_I_RTS || oOp.ui8Instruction == CCpuBase::LSN_I_RTI ) { break; }
+		}
+#endif	// #ifdef LSN_JIT_X64
+
+		_bBlock.pui8Code = nullptr;
+		_bBlock.ui8Low = uint8_t( ui32Low );
+		_bBlock.ui8Len = uint8_t( ui32End - ui32Low - 1 );
+		_bBlock.ui32Bytes = uint32_t( m_vBytes.size() );
+		m_vBytes.insert( m_vBytes.end(), pui8Page + ui32Low, pui8Page + ui32End );
+
+#ifdef LSN_JIT_X64
+		if ( vInsts.empty() ) { return; }
+		// Code in bus memory can be written by the block itself.
+		const uintptr_t uiptrRam = reinterpret_cast<uintptr_t>(_bBus.Memory());
+		const bool bRam = reinterpret_cast<uintptr_t>(pui8Page) >= uiptrRam && reinterpret_cast<uintptr_t>(pui8Page) < uiptrRam + _bBus.Size();
+		CEmitter eEmitter( m_lLayout, m_oOpcodes );
+		eEmitter.Block( pui8Page, vInsts, bRam ? pui8Page + ui32Low : nullptr, ui32End - ui32Low );
+		_bBlock.pui8Code = Install( eEmitter.m_vCode, eEmitter.m_vAbsFixups );
+		if ( !_bBlock.pui8Code ) {
+			// Full.  Start over with only this block.
+			++m_jsStats.ui64Flushes;
+			const LSN_BLOCK bCopy = _bBlock;
+			std::vector<uint8_t> vBytes( m_vBytes.begin() + bCopy.ui32Bytes, m_vBytes.end() );
+			Clear();
+			_bBlock = bCopy;
+			_bBlock.ui32Bytes = 0;
+			m_vBytes = vBytes;
+			_bBlock.pui8Code = Install( eEmitter.m_vCode, eEmitter.m_vAbsFixups );
+		}
+		if ( _bBlock.pui8Code ) { ++m_jsStats.ui64Blocks; }
+#else
+		static_cast<void>(_bBus);
+#endif	// #ifdef LSN_JIT_X64
+	}
+
+	/**
+	 * Copies code into the executable memory, allocating the memory and writing the entry and exit code first if needed.
+	 *
+	 * \param _vCode The code.
+	 * \param _vAbsFixups Offsets into _vCode of rel32 operands to be pointed at the exit code.
+	 * \return Returns the address of the copy, or nullptr if it does not fit.
+	 */
+	const uint8_t * CJit6502::Install( const std::vector<uint8_t> &_vCode, const std::vector<uint32_t> &_vAbsFixups ) {
+#ifdef LSN_JIT_X64
+		if ( !m_pui8Exec ) {
+			void * pvMem = ::mmap( nullptr, LSN_JS_CODE_SIZE, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0 );
+			if ( pvMem == MAP_FAILED ) { return nullptr; }
+			m_pui8Exec = static_cast<uint8_t *>(pvMem);
+			CEmitter eEntry( m_lLayout, m_oOpcodes );
+			m_stExitCode = eEntry.EntryAndExit();
+			std::memcpy( m_pui8Exec, eEntry.m_vCode.data(), eEntry.m_vCode.size() );
+			m_stEntryEnd = m_stExecUsed = (eEntry.m_vCode.size() + 15) & ~size_t( 15 );
+		}
+		else if ( ::mprotect( m_pui8Exec, LSN_JS_CODE_SIZE, PROT_READ | PROT_WRITE ) != 0 ) { return nullptr; }
+
+		uint8_t * pui8Dst = nullptr;
+		if ( m_stExecUsed + _vCode.size() <= LSN_JS_CODE_SIZE ) {
+			pui8Dst = m_pui8Exec + m_stExecUsed;
+			std::memcpy( pui8Dst, _vCode.data(), _vCode.size() );
+			for ( size_t I = 0; I < _vAbsFixups.size(); ++I ) {
+				const int32_t i32Rel = int32_t( intptr_t( m_stExitCode ) - intptr_t( m_stExecUsed + _vAbsFixups[I] + 4 ) );
+				std::memcpy( pui8Dst + _vAbsFixups[I], &i32Rel, sizeof( i32Rel ) );
+			}
+			m_stExecUsed = (m_stExecUsed + _vCode.size() + 15) & ~size_t( 15 );
+		}
+		if ( ::mprotect( m_pui8Exec, LSN_JS_CODE_SIZE, PROT_READ | PROT_EXEC ) != 0 ) { return nullptr; }
+		return pui8Dst;
+#else
+		static_cast<void>(_vCode);
+		static_cast<void>(_vAbsFixups);
+		return nullptr;
+#endif	// #ifdef LSN_JIT_X64
+	}
+
+#ifdef LSN_CPU_VERIFY
+	/**
+	 * Adds an access made by compiled code to the bus's read/write log.
+	 *
+	 * \param _pvBus The CCpuBus.
+	 * \param _ui32Addr The address.
+	 * \param _ui32Val The value.
+	 * \param _ui32Read Non-zero for a read.
+	 */
+	void CJit6502::LogAccess( void * _pvBus, uint32_t _ui32Addr, uint32_t _ui32Val, uint32_t _ui32Read ) {
+		static_cast<CCpuBus *>(_pvBus)->LogReadWrite( uint16_t( _ui32Addr ), uint8_t( _ui32Val ), _ui32Read != 0 );
+	}
+#endif	// #ifdef LSN_CPU_VERIFY
+
+}	// namespace lsn
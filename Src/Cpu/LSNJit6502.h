@@ -0,0 +1,246 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Translates runs of 6502 instructions into x86-64 code for CCpu6502::TickBlock().  Each instruction does every bus access,
+ *	context update, and cycle of its cycle-by-cycle version, so the state left behind is the same.  Blocks are keyed by their address and by
+ *	the page-table memory of their page, like CDecodeCache, and their bytes are compared before each run.  Only built for x86-64 Linux.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Bus/LSNBus.h"
+#include "LSNCpuBase.h"
+#include <vector>
+
+#if defined( __x86_64__ ) && defined( __linux__ ) && !defined( LSN_BUS_HISTOGRAM )
+#define LSN_JIT_X64
+#endif	// #if defined( __x86_64__ ) && defined( __linux__ ) && !defined( LSN_BUS_HISTOGRAM )
+
+
+namespace lsn {
+
+	/**
+	 * Class CJit6502
+	 * \brief Translates runs of 6502 instructions into x86-64 code.
+	 *
+	 * Description: Translates runs of 6502 instructions into x86-64 code for CCpu6502::TickBlock().  Each instruction does every bus access,
+	 *	context update, and cycle of its cycle-by-cycle version, so the state left behind is the same.  Blocks are keyed by their address and by
+	 *	the page-table memory of their page, like CDecodeCache, and their bytes are compared before each run.  Only built for x86-64 Linux.
+	 *
+	 * Compiled code runs only while nothing outside the CPU can observe it: every access it makes goes through the bus page table, and
+	 *	before each instruction it checks that the instruction's addresses are mapped there and that its cycles fit in the budget.  If not, it
+	 *	stops with PC at that instruction, which is then run 1 cycle at a time.  I/O, bank switches, and interrupt-line changes all happen
+	 *	through per-address bus functions, so they always end a run.
+	 */
+	class CJit6502 {
+	public :
+		CJit6502();
+		~CJit6502();
+
+
+		// == Enumerations.
+		/** Sizes. */
+		enum LSN_JIT_SIZES : uint32_t {
+			LSN_JS_BLOCKS									= 4096,							/**< Blocks in the cache (a power of 2). */
+			LSN_JS_BLOCK_INSTS								= 64,							/**< The most instructions in a block. */
+			LSN_JS_CODE_SIZE								= 8 * 1024 * 1024,				/**< Bytes of executable memory.  Everything is flushed when it fills. */
+		};
+
+
+		// == Types.
+		/** Where the CPU keeps the state compiled code reads and writes, as byte offsets from the pointer given to Run(). */
+		struct LSN_LAYOUT {
+			uint32_t										ui32Pc;							/**< The 16-bit program counter. */
+			uint32_t										ui32A;							/**< A. */
+			uint32_t										ui32X;							/**< X. */
+			uint32_t										ui32Y;							/**< Y. */
+			uint32_t										ui32S;							/**< S. */
+			uint32_t										ui32Status;						/**< The status register. */
+			uint32_t										ui32IsReadCycle;				/**< The bool set by each bus access. */
+			uint32_t										ui32OpCode;						/**< The 16-bit opcode of the context. */
+			uint32_t										ui32Address;					/**< The 16-bit address of the context. */
+			uint32_t										ui32JmpTarget;					/**< The 16-bit jump target of the context. */
+			uint32_t										ui32FuncIdx;					/**< The micro-op index of the context. */
+			uint32_t										ui32Operand;					/**< The operand of the context. */
+			uint32_t										ui32Pointer;					/**< The pointer of the context. */
+		};
+
+		/** An opcode as described by the CPU's instruction table. */
+		struct LSN_OPCODE {
+			uint8_t											ui8AddrMode;					/**< The LSN_ADDRESSING_MODES value. */
+			uint8_t											ui8Instruction;					/**< The LSN_INSTRUCTIONS value. */
+			uint8_t											ui8Size;						/**< The size of the instruction in bytes. */
+			uint8_t											ui8Fetch;						/**< The bytes read from the instruction's address onward, including dummy reads. */
+		};
+
+		/** Statistics. */
+		struct LSN_JIT_STATS {
+			uint64_t										ui64Blocks;						/**< Blocks compiled. */
+			uint64_t										ui64Instructions;				/**< Instructions run by compiled code. */
+			uint64_t										ui64Runs;						/**< Calls into compiled code that ran at least 1 instruction. */
+			uint64_t										ui64Invalidations;				/**< Blocks compiled again because their bytes had changed. */
+			uint64_t										ui64Flushes;					/**< Times the executable memory filled and was cleared. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Determines whether compiled code can run on this host.
+		 *
+		 * \return Returns true on x86-64 Linux.
+		 */
+		static constexpr bool								Available() {
+#ifdef LSN_JIT_X64
+			return true;
+#else
+			return false;
+#endif	// #ifdef LSN_JIT_X64
+		}
+
+		/**
+		 * Sets where the CPU keeps its state and how it decodes each opcode.  Must be called before Run().
+		 *
+		 * \param _lLayout The offsets of the CPU's state.
+		 * \param _poOpcodes The 256 opcodes.
+		 */
+		void												SetCpu( const LSN_LAYOUT &_lLayout, const LSN_OPCODE * _poOpcodes );
+
+		/**
+		 * Runs compiled blocks from PC for as long as they can run.
+		 *
+		 * \param _pvCpu The CPU whose state is described by the layout given to SetCpu().
+		 * \param _bBus The CPU bus.
+		 * \param _ui32MaxCycles The most cycles to run.
+		 * \param _ui32Insts On input, the most instructions to run.  On output, the number run.
+		 * \param _bStopAtLoops On input, if true, returns after any jump or branch backwards, so the caller can check for an idle loop.  On
+		 *	output, true if it did so.
+		 * \return Returns the number of cycles run, or 0 if the instruction at PC must be run some other way.
+		 */
+		uint32_t											Run( void * _pvCpu, CCpuBus &_bBus, uint32_t _ui32MaxCycles, uint32_t &_ui32Insts, bool &_bStopAtLoops );
+
+		/**
+		 * Drops every compiled block.
+		 */
+		void												Clear();
+
+		/**
+		 * Drops every compiled block and frees the executable memory.
+		 */
+		void												Reset();
+
+		/**
+		 * Gets the statistics since the last ResetStats().
+		 *
+		 * \return Returns the statistics.
+		 */
+		inline const LSN_JIT_STATS &						Stats() const { return m_jsStats; }
+
+		/**
+		 * Resets the statistics.
+		 */
+		inline void											ResetStats() { m_jsStats = LSN_JIT_STATS(); }
+
+
+	protected :
+		// == Types.
+		/** A compiled block. */
+		struct LSN_BLOCK {
+			const uint8_t *									pui8Page;						/**< The page-table memory of the block's page when it was compiled. */
+			const uint8_t *									pui8Code;						/**< The block's code, or nullptr if its first instruction cannot be compiled. */
+			uint32_t										ui32Bytes;						/**< The offset of the block's bytes in m_vBytes. */
+			uint16_t										ui16Pc;							/**< The address of the first instruction. */
+			uint8_t											ui8Low;							/**< The offset in the page of the first byte the block reads. */
+			uint8_t											ui8Len;							/**< The number of bytes from ui8Low the block reads, less 1. */
+		};
+
+		/** An instruction being compiled. */
+		struct LSN_INST {
+			uint16_t										ui16Pc;							/**< The address of the instruction. */
+			uint8_t											ui8Op;							/**< The opcode. */
+			uint8_t											ui8B1;							/**< The byte after the opcode. */
+			uint8_t											ui8B2;							/**< The byte after that. */
+			uint32_t										ui32Label;						/**< The label at the top of the instruction. */
+			uint32_t										ui32Exit;						/**< The label of the stub that leaves with PC at the instruction. */
+		};
+
+		/** The frame compiled code reads through rbp. */
+		struct LSN_FRAME;
+
+		/** Writes the x86-64 code of a block. */
+		class CEmitter;
+
+
+		// == Members.
+		LSN_LAYOUT											m_lLayout;						/**< Where the CPU keeps its state. */
+		LSN_OPCODE											m_oOpcodes[256];				/**< The opcodes. */
+		std::vector<LSN_BLOCK>								m_vBlocks;						/**< The cache. */
+		std::vector<uint8_t>								m_vBytes;						/**< The bytes each block was compiled from. */
+		uint8_t *											m_pui8Exec;						/**< The executable memory. */
+		size_t												m_stExecUsed;					/**< Bytes of m_pui8Exec in use. */
+		size_t												m_stEntryEnd;					/**< The end of the entry and exit code at the start of m_pui8Exec. */
+		size_t												m_stExitCode;					/**< The offset of the exit code in m_pui8Exec. */
+		LSN_JIT_STATS										m_jsStats;						/**< Statistics. */
+
+
+		// == Functions.
+		/**
+		 * Gets the cache slot of an address.
+		 *
+		 * \param _ui16Pc The address.
+		 * \return Returns the index into m_vBlocks.
+		 */
+		static inline size_t								Hash( uint16_t _ui16Pc ) { return (_ui16Pc ^ (_ui16Pc >> 12)) & (LSN_JS_BLOCKS - 1); }
+
+		/**
+		 * Finds or compiles the block at an address.
+		 *
+		 * \param _ui16Pc The address.
+		 * \param _pui8Page The page-table memory of the page holding _ui16Pc.
+		 * \param _bBus The CPU bus.
+		 * \return Returns the block, whose pui8Code is nullptr if its first instruction cannot be compiled.
+		 */
+		const LSN_BLOCK &									Find( uint16_t _ui16Pc, const uint8_t * _pui8Page, const CCpuBus &_bBus );
+
+		/**
+		 * Determines whether an opcode can be compiled.
+		 *
+		 * \param _oOp The opcode.
+		 * \return Returns true if the opcode can be compiled.
+		 */
+		static bool											Compilable( const LSN_OPCODE &_oOp );
+
+		/**
+		 * Compiles a block.
+		 *
+		 * \param _bBlock The block, with pui8Page and ui16Pc set.
+		 * \param _bBus The CPU bus.
+		 */
+		void												Compile( LSN_BLOCK &_bBlock, const CCpuBus &_bBus );
+
+		/**
+		 * Copies code into the executable memory, allocating the memory and writing the entry and exit code first if needed.
+		 *
+		 * \param _vCode The code.
+		 * \param _vAbsFixups Offsets into _vCode of rel32 operands to be pointed at the exit code.
+		 * \return Returns the address of the copy, or nullptr if it does not fit.
+		 */
+		const uint8_t *										Install( const std::vector<uint8_t> &_vCode, const std::vector<uint32_t> &_vAbsFixups );
+
+#ifdef LSN_CPU_VERIFY
+		/**
+		 * Adds an access made by compiled code to the bus's read/write log.
+		 *
+		 * \param _pvBus The CCpuBus.
+		 * \param _ui32Addr The address.
+		 * \param _ui32Val The value.
+		 * \param _ui32Read Non-zero for a read.
+		 */
+		static void											LogAccess( void * _pvBus, uint32_t _ui32Addr, uint32_t _ui32Val, uint32_t _ui32Read );
+#endif	// #ifdef LSN_CPU_VERIFY
+	};
+
+}	// namespace lsn
@@ -0,0 +1,156 @@
+// Every micro-op referenced by CCpu6502::m_iInstructionSet, as LSN_MICRO_OP( ID, HANDLER ).  The switch dispatcher (see
+//	CCpu6502::SetSwitchDispatch()) gives each a LSN_MICRO_OP_ID and calls it directly from 1 switch; a handler missing from this list
+//	is still called through its pointer.
+#define LSN_MICRO_OP_LIST																													\
+	LSN_MICRO_OP( ADC_Imm,								ADC_Imm )																			\
+	LSN_MICRO_OP( ADC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		ADC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( ADC_IzY_AbX_AbY_1,					ADC_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( ANC_Imm,								ANC_Imm )																			\
+	LSN_MICRO_OP( AND_Imm,								AND_Imm )																			\
+	LSN_MICRO_OP( AND_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		AND_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( AND_IzY_AbX_AbY_1,					AND_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( ANE,									ANE )																				\
+	LSN_MICRO_OP( ARR_Imm,								ARR_Imm )																			\
+	LSN_MICRO_OP( ASL_Imp,								ASL_Imp )																			\
+	LSN_MICRO_OP( ASL_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		ASL_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( ASR_Imm,								ASR_Imm )																			\
+	LSN_MICRO_OP( BIT_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		BIT_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( Branch_Cycle2_C0,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_CARRY ), 0> )						\
+	LSN_MICRO_OP( Branch_Cycle2_C1,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_CARRY ), 1> )						\
+	LSN_MICRO_OP( Branch_Cycle2_N0,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_NEGATIVE ), 0> )					\
+	LSN_MICRO_OP( Branch_Cycle2_N1,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_NEGATIVE ), 1> )					\
+	LSN_MICRO_OP( Branch_Cycle2_V0,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_OVERFLOW ), 0> )					\
+	LSN_MICRO_OP( Branch_Cycle2_V1,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_OVERFLOW ), 1> )					\
+	LSN_MICRO_OP( Branch_Cycle2_Z0,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_ZERO ), 0> )						\
+	LSN_MICRO_OP( Branch_Cycle2_Z1,						Branch_Cycle2<uint8_t( LSN_STATUS_FLAGS::LSN_SF_ZERO ), 1> )						\
+	LSN_MICRO_OP( Branch_Cycle3,						Branch_Cycle3 )																		\
+	LSN_MICRO_OP( Branch_Cycle4,						Branch_Cycle4 )																		\
+	LSN_MICRO_OP( CLC,									CLC )																				\
+	LSN_MICRO_OP( CLD,									CLD )																				\
+	LSN_MICRO_OP( CLI,									CLI )																				\
+	LSN_MICRO_OP( CLV,									CLV )																				\
+	LSN_MICRO_OP( CMP_Imm,								CMP_Imm )																			\
+	LSN_MICRO_OP( CMP_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		CMP_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( CMP_IzY_AbX_AbY_1,					CMP_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( CPX_Imm,								CPX_Imm )																			\
+	LSN_MICRO_OP( CPX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		CPX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( CPY_Imm,								CPY_Imm )																			\
+	LSN_MICRO_OP( CPY_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		CPY_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( CopyVectorPch,						CopyVectorPch )																		\
+	LSN_MICRO_OP( CopyVectorPcl,						CopyVectorPcl )																		\
+	LSN_MICRO_OP( DCP_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		DCP_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( DEC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		DEC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( DEX,									DEX )																				\
+	LSN_MICRO_OP( DEY,									DEY )																				\
+	LSN_MICRO_OP( EOR_Imm,								EOR_Imm )																			\
+	LSN_MICRO_OP( EOR_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		EOR_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( EOR_IzY_AbX_AbY_1,					EOR_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( FetchAddressAndIncPc_Zp,				FetchAddressAndIncPc_Zp )															\
+	LSN_MICRO_OP( FetchEffectiveAddressHigh_IzX,		FetchEffectiveAddressHigh_IzX )														\
+	LSN_MICRO_OP( FetchEffectiveAddressHigh_IzY,		FetchEffectiveAddressHigh_IzY )														\
+	LSN_MICRO_OP( FetchEffectiveAddressLow_IzX,			FetchEffectiveAddressLow_IzX )														\
+	LSN_MICRO_OP( FetchEffectiveAddressLow_IzY,			FetchEffectiveAddressLow_IzY )														\
+	LSN_MICRO_OP( FetchHighAddrByteAndIncPc,			FetchHighAddrByteAndIncPc )															\
+	LSN_MICRO_OP( FetchHighAddrByteAndIncPcAndAddX,		FetchHighAddrByteAndIncPcAndAddX )													\
+	LSN_MICRO_OP( FetchHighAddrByteAndIncPcAndAddY,		FetchHighAddrByteAndIncPcAndAddY )													\
+	LSN_MICRO_OP( FetchLowAddrByteAndIncPc,				FetchLowAddrByteAndIncPc )															\
+	LSN_MICRO_OP( FetchLowAddrByteAndIncPc_WriteImm,	FetchLowAddrByteAndIncPc_WriteImm )													\
+	LSN_MICRO_OP( FetchPointerAndIncPc,					FetchPointerAndIncPc )																\
+	LSN_MICRO_OP( FinalWriteCycle,						FinalWriteCycle )																	\
+	LSN_MICRO_OP( INC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		INC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( INX,									INX )																				\
+	LSN_MICRO_OP( INY,									INY )																				\
+	LSN_MICRO_OP( ISB_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		ISB_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( JAM,									JAM )																				\
+	LSN_MICRO_OP( JAM_Cycle2,							JAM_Cycle2 )																		\
+	LSN_MICRO_OP( JMP_Abs,								JMP_Abs )																			\
+	LSN_MICRO_OP( JMP_Ind,								JMP_Ind )																			\
+	LSN_MICRO_OP( JSR,									JSR )																				\
+	LSN_MICRO_OP( Jmp_Ind_Cycle4,						Jmp_Ind_Cycle4 )																	\
+	LSN_MICRO_OP( Jsr_Cycle3,							Jsr_Cycle3 )																		\
+	LSN_MICRO_OP( Jsr_Cycle4,							Jsr_Cycle4 )																		\
+	LSN_MICRO_OP( Jsr_Cycle5,							Jsr_Cycle5 )																		\
+	LSN_MICRO_OP( LAS_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		LAS_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( LAS_IzY_AbX_AbY_1,					LAS_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( LAX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		LAX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( LAX_IzY_AbX_AbY_1,					LAX_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( LDA_Imm,								LDA_Imm )																			\
+	LSN_MICRO_OP( LDA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		LDA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( LDA_IzY_AbX_AbY_1,					LDA_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( LDX_Imm,								LDX_Imm )																			\
+	LSN_MICRO_OP( LDX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		LDX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( LDX_IzY_AbX_AbY_1,					LDX_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( LDY_Imm,								LDY_Imm )																			\
+	LSN_MICRO_OP( LDY_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		LDY_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( LDY_IzY_AbX_AbY_1,					LDY_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( LSR_Imp,								LSR_Imp )																			\
+	LSN_MICRO_OP( LSR_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		LSR_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( LXA,									LXA )																				\
+	LSN_MICRO_OP( NOP_Imm,								NOP_Imm )																			\
+	LSN_MICRO_OP( NOP_Imp,								NOP_Imp )																			\
+	LSN_MICRO_OP( NOP_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		NOP_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( NOP_IzY_AbX_AbY_1,					NOP_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( ORA_Imm,								ORA_Imm )																			\
+	LSN_MICRO_OP( ORA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		ORA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( ORA_IzY_AbX_AbY_1,					ORA_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( PHA,									PHA )																				\
+	LSN_MICRO_OP( PHP,									PHP )																				\
+	LSN_MICRO_OP( PLA,									PLA )																				\
+	LSN_MICRO_OP( PLA_PLP_RTI_RTS_Cycle3,				PLA_PLP_RTI_RTS_Cycle3 )															\
+	LSN_MICRO_OP( PLP,									PLP )																				\
+	LSN_MICRO_OP( PullPch,								PullPch )																			\
+	LSN_MICRO_OP( PullPcl,								PullPcl )																			\
+	LSN_MICRO_OP( PullStatusWithoutB,					PullStatusWithoutB )																\
+	LSN_MICRO_OP( PushPch,								PushPch )																			\
+	LSN_MICRO_OP( PushPcl,								PushPcl )																			\
+	LSN_MICRO_OP( PushStatusAndBAndSetAddressByIrq,		PushStatusAndBAndSetAddressByIrq )													\
+	LSN_MICRO_OP( PushStatusAndNoBAndSetAddressByIrq,	PushStatusAndNoBAndSetAddressByIrq )												\
+	LSN_MICRO_OP( RLA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		RLA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( ROL_Imp,								ROL_Imp )																			\
+	LSN_MICRO_OP( ROL_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		ROL_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( ROR_Imp,								ROR_Imp )																			\
+	LSN_MICRO_OP( ROR_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		ROR_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( RRA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		RRA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( RTI,									RTI )																				\
+	LSN_MICRO_OP( RTS,									RTS )																				\
+	LSN_MICRO_OP( ReadAddressAddX_IzX,					ReadAddressAddX_IzX )																\
+	LSN_MICRO_OP( ReadEffectiveAddressFixHighByte_IzY_AbX_AbY,	ReadEffectiveAddressFixHighByte_IzY_AbX_AbY<false> )						\
+	LSN_MICRO_OP( ReadFromAddressAndAddX_ZpX,			ReadFromAddressAndAddX_ZpX )														\
+	LSN_MICRO_OP( ReadFromAddressAndAddX_ZpY,			ReadFromAddressAndAddX_ZpY )														\
+	LSN_MICRO_OP( ReadFromEffectiveAddress_IzX_IzY_ZpX_AbX_AbY_Abs,	ReadFromEffectiveAddress_IzX_IzY_ZpX_AbX_AbY_Abs )						\
+	LSN_MICRO_OP( ReadFromEffectiveAddress_Zp,			ReadFromEffectiveAddress_Zp )														\
+	LSN_MICRO_OP( ReadNextInstByteAndDiscard,			ReadNextInstByteAndDiscard )														\
+	LSN_MICRO_OP( ReadNextInstByteAndDiscardAndIncPc,	ReadNextInstByteAndDiscardAndIncPc )												\
+	LSN_MICRO_OP( SAX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		SAX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( SBC_Imm,								SBC_Imm )																			\
+	LSN_MICRO_OP( SBC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		SBC_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( SBC_IzY_AbX_AbY_1,					SBC_IzY_AbX_AbY_1 )																	\
+	LSN_MICRO_OP( SBX,									SBX )																				\
+	LSN_MICRO_OP( SEC,									SEC )																				\
+	LSN_MICRO_OP( SED,									SED )																				\
+	LSN_MICRO_OP( SEI,									SEI )																				\
+	LSN_MICRO_OP( SHA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		SHA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( SHS,									SHS )																				\
+	LSN_MICRO_OP( SHX,									SHX )																				\
+	LSN_MICRO_OP( SHY,									SHY )																				\
+	LSN_MICRO_OP( SLO_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		SLO_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( SRE_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		SRE_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( STA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		STA_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( STX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		STX_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( STY_IzX_IzY_ZpX_AbX_AbY_Zp_Abs,		STY_IzX_IzY_ZpX_AbX_AbY_Zp_Abs )													\
+	LSN_MICRO_OP( TAX,									TAX )																				\
+	LSN_MICRO_OP( TAY,									TAY )																				\
+	LSN_MICRO_OP( TSX,									TSX )																				\
+	LSN_MICRO_OP( TXA,									TXA )																				\
+	LSN_MICRO_OP( TXS,									TXS )																				\
+	LSN_MICRO_OP( TYA,									TYA )
+
+/** The ID of each micro-op in LSN_MICRO_OP_LIST.  0 marks an unused or unlisted handler. */
+enum LSN_MICRO_OP_ID : uint8_t {
+	LSN_MO_NONE,
+#define LSN_MICRO_OP( ID, ... )																LSN_MO_ ## ID,
+	LSN_MICRO_OP_LIST
+#undef LSN_MICRO_OP
+
+	LSN_MO_TOTAL
+};
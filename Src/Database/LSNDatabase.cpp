@@ -549,11 +549,13 @@ namespace lsn {
 			{ .ui32Crc = 0x084F61CD, .ui32PgmRomSize = 8 * 1024 },
 		};
 		for ( auto I = LSN_ELEMENTS( eEntries ); I--; ) {
+#ifdef LSN_WINDOWS
 			if ( m_mDatabase.end() != m_mDatabase.find( eEntries[I].ui32Crc ) ) {
 				char szBuffer[128];
 				std::sprintf( szBuffer, "************ Duplicate Entry in Database: 0x%.8X.\r\n", eEntries[I].ui32Crc );
 				::OutputDebugStringA( szBuffer );
 			}
+#endif	// #ifdef LSN_WINDOWS
 			m_mDatabase.insert( std::pair<uint32_t, LSN_ENTRY>( eEntries[I].ui32Crc, eEntries[I] ) );
 		}
 	}
@@ -53,6 +53,13 @@ namespace lsn {
 		 */
 		void									SetDisplayHost( CDisplayHost * _pdhHost ) { m_pdhHost = _pdhHost; }
 
+		/**
+		 * Gets the CDisplayHost pointer.
+		 *
+		 * \return Returns the display host, which may be nullptr.
+		 */
+		CDisplayHost *							GetDisplayHost() const { return m_pdhHost; }
+
 		/**
 		 * Detatches from the display host.
 		 */
@@ -67,21 +74,21 @@ namespace lsn {
 		 *
 		 * \return Returns the pixel width of the display area.
 		 */
-		virtual uint32_t						DisplayWidth() const = 0 { return 0; }
+		virtual uint32_t						DisplayWidth() const = 0;
 
 		/**
 		 * Gets the display height in pixels.  Used to create render targets.
 		 *
 		 * \return Returns the pixel height of the display area.
 		 */
-		virtual uint32_t						DisplayHeight() const = 0 { return 0; }
+		virtual uint32_t						DisplayHeight() const = 0;
 
 		/**
 		 * Gets the display ratio in pixels.
 		 *
 		 * \return Returns the ratio of the display area.
 		 */
-		virtual double							DisplayRatio() const = 0 { return 1.0; }
+		virtual double							DisplayRatio() const = 0;
 
 		/**
 		 * Sets the render target.
@@ -97,19 +104,28 @@ namespace lsn {
 			m_bFlipOutput = _bFlip;
 		}
 
+		/**
+		 * Sets the render target to the one used by another display client so that both render into the same buffer.
+		 *
+		 * \param _dcOther The display client whose render target is to be shared.
+		 */
+		void									ShareRenderTarget( const CDisplayClient &_dcOther ) {
+			SetRenderTarget( _dcOther.m_pui8RenderTarget, _dcOther.m_stRenderTargetStride, _dcOther.m_pofOutFormat, _dcOther.m_bFlipOutput );
+		}
+
 		/**
 		 * Gets the frame count.
 		 *
 		 * \return Returns the frame count.
 		 */
-		virtual uint64_t						FrameCount() const = 0 { return 0; }
+		virtual uint64_t						FrameCount() const = 0;
 
 		/**
 		 * Gets the PPU region.
 		 *
 		 * \return Returns the PPU region.
 		 */
-		virtual LSN_PPU_METRICS					PpuRegion() const = 0 { return LSN_PM_NTSC; }
+		virtual LSN_PPU_METRICS					PpuRegion() const = 0;
 
 		/**
 		 * If true, extra room is added to the side of the view to display some debug information.
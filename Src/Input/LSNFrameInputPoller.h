@@ -0,0 +1,68 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: An input poller that plays back a fixed list of per-frame inputs.  Used for headless runs.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "LSNInputPoller.h"
+#include "../System/LSNSystemBase.h"
+
+
+namespace lsn {
+
+	/**
+	 * Class CFrameInputPoller
+	 * \brief An input poller that plays back a fixed list of per-frame inputs.
+	 *
+	 * Description: An input poller that plays back a fixed list of per-frame inputs.  Used for headless runs.
+	 */
+	class CFrameInputPoller : public CInputPoller {
+	public :
+		CFrameInputPoller( const CSystemBase * _psbSystem, const std::vector<uint16_t> * _pvInput ) :
+			m_psbSystem( _psbSystem ),
+			m_pvInput( _pvInput ) {
+		}
+
+
+		// == Functions.
+		/**
+		 * Polls the given port and returns a byte containing the result of polling by combining the LSN_INPUT_BITS values.
+		 *
+		 * \param _ui8Port The port being polled (0 or 1).
+		 * \return Returns the result of polling the given port.
+		 */
+		virtual uint8_t									PollPort( uint8_t _ui8Port ) {
+			uint64_t ui64Frame = m_psbSystem->GetPpuFrameCount();
+			if ( ui64Frame >= m_pvInput->size() ) { return 0; }
+			return uint8_t( (*m_pvInput)[size_t(ui64Frame)] >> (_ui8Port ? 8 : 0) );
+		}
+
+		/**
+		 * Loads per-frame input from a file.  The file holds 2 bytes per frame: port 0 then port 1, each a combination of LSN_INPUT_BITS.
+		 *
+		 * \param _vFile The file contents.
+		 * \param _vInput Holds the returned input, 1 entry per frame with port 0 in the low byte and port 1 in the high byte.
+		 */
+		static void										FromFile( const std::vector<uint8_t> &_vFile, std::vector<uint16_t> &_vInput ) {
+			_vInput.resize( _vFile.size() / 2 );
+			for ( size_t I = 0; I < _vInput.size(); ++I ) {
+				_vInput[I] = uint16_t( _vFile[I*2] | (_vFile[I*2+1] << 8) );
+			}
+		}
+
+
+	protected :
+		// == Members.
+		/** The system, for the current frame. */
+		const CSystemBase *								m_psbSystem;
+		/** The input.  The low byte is port 0 and the high byte is port 1. */
+		const std::vector<uint16_t> *					m_pvInput;
+	};
+
+}	// namespace lsn
@@ -0,0 +1,345 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Records the input read through CInputPoller::PollPort() once per frame and plays it back deterministically.  Save-state
+ *	keyframes are embedded every N frames so that seeking costs 1 restore plus at most N frames of emulation.
+ */
+
+#include "LSNInputMovie.h"
+#include "../MiniZ/miniz.h"
+#include "../Utilities/LSNStream.h"
+
+#include <cstring>
+
+
+namespace lsn {
+
+	CInputMovie::CInputMovie() :
+		m_psbSystem( nullptr ),
+		m_pipSource( nullptr ),
+		m_mmMode( LSN_MM_OFF ),
+		m_ui64StartFrame( 0 ),
+		m_ui32RomCrc( 0 ),
+		m_ui32KeyframeInterval( LSN_IM_DEFAULT_KEYFRAME_INTERVAL ),
+		m_ui64LatchedFrame( UINT64_MAX ) {
+	}
+
+	// == Functions.
+	/**
+	 * Polls the given port and returns a byte containing the result of polling by combining the LSN_INPUT_BITS values.  The first poll
+	 *	in each frame latches both ports; every later poll in the same frame returns the latched value, so playback is exact.
+	 *
+	 * \param _ui8Port The port being polled (0 or 1).
+	 * \return Returns the result of polling the given port.
+	 */
+	uint8_t CInputMovie::PollPort( uint8_t _ui8Port ) {
+		switch ( m_mmMode ) {
+			case LSN_MM_RECORD : {
+				const uint64_t ui64Frame = CurFrame( (*m_psbSystem) );
+				if ( ui64Frame != m_ui64LatchedFrame ) {
+					if ( m_vInput.size() <= ui64Frame ) {
+						// Frames without a poll repeat the previous input; they are never read back.
+						m_vInput.resize( size_t( ui64Frame + 1 ), m_vInput.size() ? m_vInput.back() : uint16_t( 0 ) );
+					}
+					uint16_t ui16Input = 0;
+					if ( m_pipSource ) {
+						ui16Input = uint16_t( m_pipSource->PollPort( 0 ) | (m_pipSource->PollPort( 1 ) << 8) );
+					}
+					m_vInput[size_t(ui64Frame)] = ui16Input;
+					m_ui64LatchedFrame = ui64Frame;
+				}
+				return uint8_t( m_vInput[size_t(ui64Frame)] >> (_ui8Port ? 8 : 0) );
+			}
+			case LSN_MM_PLAYBACK : {
+				const uint64_t ui64Frame = CurFrame( (*m_psbSystem) );
+				if ( ui64Frame >= m_vInput.size() ) { return 0; }
+				return uint8_t( m_vInput[size_t(ui64Frame)] >> (_ui8Port ? 8 : 0) );
+			}
+			default : {
+				return m_pipSource ? m_pipSource->PollPort( _ui8Port ) : 0;
+			}
+		}
+	}
+
+	/**
+	 * Starts recording from the current state of the given system, which is saved as the first keyframe.  The system's input poller
+	 *	must be this object.
+	 *
+	 * \param _sbSystem The system.  A ROM must be loaded.
+	 * \param _ui32KeyframeInterval The number of frames between keyframes.
+	 * \return Returns false if the state could not be saved.
+	 */
+	bool CInputMovie::StartRecording( const CSystemBase &_sbSystem, uint32_t _ui32KeyframeInterval ) {
+		Stop();
+		if ( !_sbSystem.GetRom() ) { return false; }
+		m_vInput.clear();
+		m_vKeyframes.clear();
+		m_ui64StartFrame = _sbSystem.GetPpuFrameCount();
+		m_ui32RomCrc = _sbSystem.GetRom()->riInfo.ui32Crc;
+		m_ui32KeyframeInterval = _ui32KeyframeInterval ? _ui32KeyframeInterval : 1;
+		m_vKeyframes.resize( 1 );
+		if ( !Capture( _sbSystem, m_vKeyframes[0] ) ) {
+			m_vKeyframes.clear();
+			return false;
+		}
+		m_psbSystem = &_sbSystem;
+		m_mmMode = LSN_MM_RECORD;
+		return true;
+	}
+
+	/**
+	 * Starts playing back from the first keyframe.  The system's input poller must be this object.
+	 *
+	 * \param _sbSystem The system.  Must have the ROM with which the movie was recorded.
+	 * \return Returns false if there is no movie or the first keyframe could not be loaded.
+	 */
+	bool CInputMovie::StartPlayback( CSystemBase &_sbSystem ) {
+		Stop();
+		return Seek( _sbSystem, 0 );
+	}
+
+	/**
+	 * Stops recording or playing back.  The recorded movie is kept.
+	 */
+	void CInputMovie::Stop() {
+		m_mmMode = LSN_MM_OFF;
+		m_ui64LatchedFrame = UINT64_MAX;
+	}
+
+	/**
+	 * Informs the movie that the system has finished a frame.  Call once per frame, between calls that run the system.  While
+	 *	recording, keyframes are captured here.
+	 *
+	 * \param _sbSystem The system.
+	 */
+	void CInputMovie::OnFrame( const CSystemBase &_sbSystem ) {
+		if ( m_mmMode == LSN_MM_PLAYBACK ) {
+			// Hand control back to the live input once the movie runs out.
+			if ( CurFrame( _sbSystem ) >= m_vInput.size() ) { Stop(); }
+			return;
+		}
+		if ( m_mmMode != LSN_MM_RECORD ) { return; }
+
+		const uint64_t ui64Frame = CurFrame( _sbSystem );
+		if ( _sbSystem.GetPpuFrameCount() < m_ui64StartFrame ) {
+			// Rewound past the start of the movie.
+			Stop();
+			return;
+		}
+		if ( m_vKeyframes.size() && ui64Frame < m_vKeyframes.back().ui64Frame ) {
+			// Rewound: the recording continues from here.
+			while ( m_vKeyframes.size() > 1 && m_vKeyframes.back().ui64Frame > ui64Frame ) {
+				m_vKeyframes.pop_back();
+			}
+		}
+		if ( m_vInput.size() > ui64Frame + 1 ) {
+			// The input of the current frame may already have been read by the restored state, so it is kept.
+			m_vInput.resize( size_t( ui64Frame + 1 ) );
+			m_ui64LatchedFrame = ui64Frame;
+		}
+		else if ( m_vInput.size() < ui64Frame ) {
+			// Frames on which the game did not poll still belong to the movie (they repeat the previous input, as in PollPort()).
+			m_vInput.resize( size_t( ui64Frame ), m_vInput.size() ? m_vInput.back() : uint16_t( 0 ) );
+		}
+		if ( m_vKeyframes.size() && ui64Frame >= m_vKeyframes.back().ui64Frame + m_ui32KeyframeInterval ) {
+			LSN_KEYFRAME kfKeyframe;
+			if ( Capture( _sbSystem, kfKeyframe ) ) {
+				m_vKeyframes.push_back( std::move( kfKeyframe ) );
+			}
+		}
+	}
+
+	/**
+	 * Moves the system to the start of the given frame using the nearest keyframe at or before it.  Playback is started if it was not.
+	 *	Call SyncRealTime() on the system before going back to Tick().
+	 *
+	 * \param _sbSystem The system.
+	 * \param _ui64Frame The frame, relative to the start of the movie.
+	 * \return Returns false if the frame is past the end of the movie or the keyframe could not be loaded.
+	 */
+	bool CInputMovie::Seek( CSystemBase &_sbSystem, uint64_t _ui64Frame ) {
+		if ( !m_vKeyframes.size() || _ui64Frame > m_vInput.size() ) { return false; }
+		if ( !_sbSystem.GetRom() || _sbSystem.GetRom()->riInfo.ui32Crc != m_ui32RomCrc ) { return false; }
+		if ( m_mmMode == LSN_MM_RECORD ) { Stop(); }
+
+		// Binary search for the last keyframe at or before the target.
+		size_t stLo = 0, stHi = m_vKeyframes.size();
+		while ( stHi - stLo > 1 ) {
+			size_t stMid = (stLo + stHi) / 2;
+			if ( m_vKeyframes[stMid].ui64Frame <= _ui64Frame ) { stLo = stMid; }
+			else { stHi = stMid; }
+		}
+		const LSN_KEYFRAME & kfKeyframe = m_vKeyframes[stLo];
+		if ( kfKeyframe.ui64Frame > _ui64Frame ) { return false; }
+
+		std::vector<uint8_t> vState;
+		if ( !Decompress( kfKeyframe, vState ) ) { return false; }
+		CStream sStream( vState );
+		if ( !_sbSystem.LoadState( sStream ) ) { return false; }
+
+		m_psbSystem = &_sbSystem;
+		m_mmMode = LSN_MM_PLAYBACK;
+		m_ui64LatchedFrame = UINT64_MAX;
+		if ( _ui64Frame > kfKeyframe.ui64Frame ) {
+			_sbSystem.RunFrames( _ui64Frame - kfKeyframe.ui64Frame );
+		}
+		return true;
+	}
+
+	/**
+	 * Plays the whole movie back from the first keyframe and checks that the system reaches every later keyframe bit-for-bit.
+	 *
+	 * \param _sbSystem The system.  Must have the ROM with which the movie was recorded.
+	 * \param _ui64FirstBadFrame Holds the returned frame of the first keyframe that did not match, if any.
+	 * \return Returns true if every keyframe matched.
+	 */
+	bool CInputMovie::Verify( CSystemBase &_sbSystem, uint64_t &_ui64FirstBadFrame ) {
+		_ui64FirstBadFrame = 0;
+		if ( !StartPlayback( _sbSystem ) ) { return false; }
+		std::vector<uint8_t> vExpected, vActual;
+		for ( size_t I = 1; I < m_vKeyframes.size(); ++I ) {
+			const LSN_KEYFRAME & kfKeyframe = m_vKeyframes[I];
+			_ui64FirstBadFrame = kfKeyframe.ui64Frame;
+			// Keyframes are taken wherever the recording driver stopped, not necessarily on a frame boundary, so run to the exact cycle.
+			if ( kfKeyframe.ui64MasterCycle < _sbSystem.GetMasterCounter() ) { return false; }
+			_sbSystem.RunCycles( kfKeyframe.ui64MasterCycle - _sbSystem.GetMasterCounter() );
+			if ( !Decompress( kfKeyframe, vExpected ) ) { return false; }
+			vActual.clear();
+			CStream sStream( vActual );
+			if ( !_sbSystem.SaveState( sStream ) ) { return false; }
+			if ( vActual.size() != vExpected.size() || std::memcmp( vActual.data(), vExpected.data(), vActual.size() ) != 0 ) { return false; }
+		}
+		if ( CurFrame( _sbSystem ) < m_vInput.size() ) {
+			_sbSystem.RunFrames( m_vInput.size() - CurFrame( _sbSystem ) );
+		}
+		_ui64FirstBadFrame = 0;
+		return true;
+	}
+
+	/**
+	 * Writes the movie to a file image.
+	 *
+	 * \param _vFile Holds the returned file image.
+	 * \return Returns true if the movie was written.
+	 */
+	bool CInputMovie::Save( std::vector<uint8_t> &_vFile ) const {
+		_vFile.clear();
+		CStream sStream( _vFile );
+		if ( !sStream.WriteUi32( LSN_INPUT_MOVIE_MAGIC ) ) { return false; }
+		if ( !sStream.WriteUi32( LSN_INPUT_MOVIE_VERSION ) ) { return false; }
+		if ( !sStream.WriteUi32( m_ui32RomCrc ) ) { return false; }
+		if ( !sStream.WriteUi32( m_ui32KeyframeInterval ) ) { return false; }
+		if ( !sStream.WriteUi64( m_ui64StartFrame ) ) { return false; }
+		if ( !sStream.WriteUi64( m_vInput.size() ) ) { return false; }
+
+		// Input is stored as (run length, value) pairs; held buttons compress to almost nothing.
+		for ( size_t I = 0; I < m_vInput.size(); ) {
+			size_t J = I + 1;
+			while ( J < m_vInput.size() && m_vInput[J] == m_vInput[I] && J - I < UINT32_MAX ) { ++J; }
+			if ( !sStream.WriteUi32( uint32_t( J - I ) ) ) { return false; }
+			if ( !sStream.WriteUi16( m_vInput[I] ) ) { return false; }
+			I = J;
+		}
+
+		if ( !sStream.WriteUi32( uint32_t( m_vKeyframes.size() ) ) ) { return false; }
+		for ( size_t I = 0; I < m_vKeyframes.size(); ++I ) {
+			const LSN_KEYFRAME & kfKeyframe = m_vKeyframes[I];
+			if ( !sStream.WriteUi64( kfKeyframe.ui64Frame ) ) { return false; }
+			if ( !sStream.WriteUi64( kfKeyframe.ui64MasterCycle ) ) { return false; }
+			if ( !sStream.WriteUi32( kfKeyframe.ui32Size ) ) { return false; }
+			if ( !sStream.WriteUi32( uint32_t( kfKeyframe.vState.size() ) ) ) { return false; }
+			if ( !sStream.WriteBytes( kfKeyframe.vState.data(), kfKeyframe.vState.size() ) ) { return false; }
+		}
+		return true;
+	}
+
+	/**
+	 * Reads a movie from a file image.  Stops recording or playing back.
+	 *
+	 * \param _vFile The file image.
+	 * \return Returns false if the file is not a valid movie.
+	 */
+	bool CInputMovie::Load( const std::vector<uint8_t> &_vFile ) {
+		Stop();
+		std::vector<uint8_t> vFile = _vFile;
+		CStream sStream( vFile );
+		uint32_t ui32Magic, ui32Version, ui32Crc, ui32Interval, ui32Count;
+		uint64_t ui64Start, ui64Frames;
+		if ( !sStream.ReadUi32( ui32Magic ) || ui32Magic != LSN_INPUT_MOVIE_MAGIC ) { return false; }
+		if ( !sStream.ReadUi32( ui32Version ) || ui32Version != LSN_INPUT_MOVIE_VERSION ) { return false; }
+		if ( !sStream.ReadUi32( ui32Crc ) ) { return false; }
+		if ( !sStream.ReadUi32( ui32Interval ) || !ui32Interval ) { return false; }
+		if ( !sStream.ReadUi64( ui64Start ) ) { return false; }
+		if ( !sStream.ReadUi64( ui64Frames ) || ui64Frames > vFile.size() * uint64_t( UINT32_MAX ) ) { return false; }
+
+		std::vector<uint16_t> vInput;
+		vInput.reserve( size_t( ui64Frames ) );
+		while ( vInput.size() < ui64Frames ) {
+			uint32_t ui32Run;
+			uint16_t ui16Value;
+			if ( !sStream.ReadUi32( ui32Run ) || !ui32Run || vInput.size() + ui32Run > ui64Frames ) { return false; }
+			if ( !sStream.ReadUi16( ui16Value ) ) { return false; }
+			vInput.insert( vInput.end(), ui32Run, ui16Value );
+		}
+
+		if ( !sStream.ReadUi32( ui32Count ) || !ui32Count ) { return false; }
+		std::vector<LSN_KEYFRAME> vKeyframes;
+		vKeyframes.resize( ui32Count );
+		for ( uint32_t I = 0; I < ui32Count; ++I ) {
+			LSN_KEYFRAME & kfKeyframe = vKeyframes[I];
+			uint32_t ui32Compressed;
+			if ( !sStream.ReadUi64( kfKeyframe.ui64Frame ) ) { return false; }
+			if ( I && kfKeyframe.ui64Frame <= vKeyframes[I-1].ui64Frame ) { return false; }
+			if ( !sStream.ReadUi64( kfKeyframe.ui64MasterCycle ) ) { return false; }
+			if ( !sStream.ReadUi32( kfKeyframe.ui32Size ) ) { return false; }
+			if ( !sStream.ReadUi32( ui32Compressed ) || ui32Compressed > vFile.size() ) { return false; }
+			kfKeyframe.vState.resize( ui32Compressed );
+			if ( !sStream.ReadBytes( kfKeyframe.vState.data(), ui32Compressed ) ) { return false; }
+		}
+		if ( vKeyframes[0].ui64Frame != 0 ) { return false; }
+
+		m_vInput = std::move( vInput );
+		m_vKeyframes = std::move( vKeyframes );
+		m_ui32RomCrc = ui32Crc;
+		m_ui32KeyframeInterval = ui32Interval;
+		m_ui64StartFrame = ui64Start;
+		return true;
+	}
+
+	/**
+	 * Saves the state of a system as a keyframe.
+	 *
+	 * \param _sbSystem The system.
+	 * \param _kfKeyframe Holds the returned keyframe.
+	 * \return Returns false if the state could not be saved or compressed.
+	 */
+	bool CInputMovie::Capture( const CSystemBase &_sbSystem, LSN_KEYFRAME &_kfKeyframe ) const {
+		std::vector<uint8_t> vState;
+		CStream sStream( vState );
+		if ( !_sbSystem.SaveState( sStream ) ) { return false; }
+		_kfKeyframe.ui64Frame = CurFrame( _sbSystem );
+		_kfKeyframe.ui64MasterCycle = _sbSystem.GetMasterCounter();
+		_kfKeyframe.ui32Size = uint32_t( vState.size() );
+		mz_ulong ulLen = mz_compressBound( mz_ulong( vState.size() ) );
+		_kfKeyframe.vState.resize( ulLen );
+		if ( mz_compress2( _kfKeyframe.vState.data(), &ulLen, vState.data(), mz_ulong( vState.size() ), MZ_BEST_SPEED ) != MZ_OK ) { return false; }
+		_kfKeyframe.vState.resize( ulLen );
+		return true;
+	}
+
+	/**
+	 * Decompresses a keyframe.
+	 *
+	 * \param _kfKeyframe The keyframe.
+	 * \param _vState Holds the returned state.
+	 * \return Returns false if the keyframe is corrupt.
+	 */
+	bool CInputMovie::Decompress( const LSN_KEYFRAME &_kfKeyframe, std::vector<uint8_t> &_vState ) {
+		_vState.resize( _kfKeyframe.ui32Size );
+		mz_ulong ulLen = mz_ulong( _vState.size() );
+		return mz_uncompress( _vState.data(), &ulLen, _kfKeyframe.vState.data(), mz_ulong( _kfKeyframe.vState.size() ) ) == MZ_OK && ulLen == _vState.size();
+	}
+
+}	// namespace lsn
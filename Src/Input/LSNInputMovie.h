@@ -0,0 +1,218 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Records the input read through CInputPoller::PollPort() once per frame and plays it back deterministically.  Save-state
+ *	keyframes are embedded every N frames so that seeking costs 1 restore plus at most N frames of emulation.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "LSNInputPoller.h"
+#include "../System/LSNSystemBase.h"
+
+#include <vector>
+
+#define LSN_INPUT_MOVIE_MAGIC							0x564D4E42			// "BNMV".
+#define LSN_INPUT_MOVIE_VERSION							1
+
+
+namespace lsn {
+
+	/**
+	 * Class CInputMovie
+	 * \brief Records and plays back per-frame input.
+	 *
+	 * Description: Records the input read through CInputPoller::PollPort() once per frame and plays it back deterministically.  Save-state
+	 *	keyframes are embedded every N frames so that seeking costs 1 restore plus at most N frames of emulation.
+	 */
+	class CInputMovie : public CInputPoller {
+	public :
+		CInputMovie();
+
+
+		// == Enumerations.
+		/** The mode. */
+		enum LSN_MOVIE_MODE {
+			LSN_MM_OFF,																	/**< Input is passed through from the source poller. */
+			LSN_MM_RECORD,																/**< Input is passed through from the source poller and recorded. */
+			LSN_MM_PLAYBACK,															/**< Recorded input is played back. */
+		};
+
+		/** Defaults. */
+		enum LSN_INPUT_MOVIE {
+			LSN_IM_DEFAULT_KEYFRAME_INTERVAL			= 300,							/**< The default number of frames between keyframes. */
+		};
+
+
+		// == Types.
+		/** A keyframe. */
+		struct LSN_KEYFRAME {
+			uint64_t									ui64Frame;						/**< The frame, relative to the start of the movie, at which the state was saved. */
+			uint64_t									ui64MasterCycle;				/**< The master cycle at which the state was saved. */
+			uint32_t									ui32Size;						/**< The uncompressed size of the state. */
+			std::vector<uint8_t>						vState;							/**< The miniz-compressed state. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Polls the given port and returns a byte containing the result of polling by combining the LSN_INPUT_BITS values.  The first poll
+		 *	in each frame latches both ports; every later poll in the same frame returns the latched value, so playback is exact.
+		 *
+		 * \param _ui8Port The port being polled (0 or 1).
+		 * \return Returns the result of polling the given port.
+		 */
+		virtual uint8_t									PollPort( uint8_t _ui8Port );
+
+		/**
+		 * Sets the poller from which live input is read when not playing back.
+		 *
+		 * \param _pipSource The source poller.
+		 */
+		inline void										SetSource( CInputPoller * _pipSource ) { m_pipSource = _pipSource; }
+
+		/**
+		 * Gets the mode.
+		 *
+		 * \return Returns the mode.
+		 */
+		inline LSN_MOVIE_MODE							Mode() const { return m_mmMode; }
+
+		/**
+		 * Starts recording from the current state of the given system, which is saved as the first keyframe.  The system's input poller
+		 *	must be this object.
+		 *
+		 * \param _sbSystem The system.  A ROM must be loaded.
+		 * \param _ui32KeyframeInterval The number of frames between keyframes.
+		 * \return Returns false if the state could not be saved.
+		 */
+		bool											StartRecording( const CSystemBase &_sbSystem, uint32_t _ui32KeyframeInterval = LSN_IM_DEFAULT_KEYFRAME_INTERVAL );
+
+		/**
+		 * Starts playing back from the first keyframe.  The system's input poller must be this object.
+		 *
+		 * \param _sbSystem The system.  Must have the ROM with which the movie was recorded.
+		 * \return Returns false if there is no movie or the first keyframe could not be loaded.
+		 */
+		bool											StartPlayback( CSystemBase &_sbSystem );
+
+		/**
+		 * Stops recording or playing back.  The recorded movie is kept.
+		 */
+		void											Stop();
+
+		/**
+		 * Informs the movie that the system has finished a frame.  Call once per frame, between calls that run the system.  While
+		 *	recording, keyframes are captured here.
+		 *
+		 * \param _sbSystem The system.
+		 */
+		void											OnFrame( const CSystemBase &_sbSystem );
+
+		/**
+		 * Moves the system to the start of the given frame using the nearest keyframe at or before it.  Playback is started if it was not.
+		 *	Call SyncRealTime() on the system before going back to Tick().
+		 *
+		 * \param _sbSystem The system.
+		 * \param _ui64Frame The frame, relative to the start of the movie.
+		 * \return Returns false if the frame is past the end of the movie or the keyframe could not be loaded.
+		 */
+		bool											Seek( CSystemBase &_sbSystem, uint64_t _ui64Frame );
+
+		/**
+		 * Plays the whole movie back from the first keyframe and checks that the system reaches every later keyframe bit-for-bit.
+		 *
+		 * \param _sbSystem The system.  Must have the ROM with which the movie was recorded.
+		 * \param _ui64FirstBadFrame Holds the returned frame of the first keyframe that did not match, if any.
+		 * \return Returns true if every keyframe matched.
+		 */
+		bool											Verify( CSystemBase &_sbSystem, uint64_t &_ui64FirstBadFrame );
+
+		/**
+		 * Gets the number of frames in the movie.
+		 *
+		 * \return Returns the number of frames in the movie.
+		 */
+		inline uint64_t									Frames() const { return m_vInput.size(); }
+
+		/**
+		 * Gets the current frame of the given system relative to the start of the movie.
+		 *
+		 * \param _sbSystem The system.
+		 * \return Returns the current frame relative to the start of the movie.
+		 */
+		inline uint64_t									CurFrame( const CSystemBase &_sbSystem ) const {
+			return _sbSystem.GetPpuFrameCount() >= m_ui64StartFrame ? _sbSystem.GetPpuFrameCount() - m_ui64StartFrame : 0;
+		}
+
+		/**
+		 * Gets the keyframes.
+		 *
+		 * \return Returns the keyframes.
+		 */
+		inline const std::vector<LSN_KEYFRAME> &		Keyframes() const { return m_vKeyframes; }
+
+		/**
+		 * Writes the movie to a file image.
+		 *
+		 * \param _vFile Holds the returned file image.
+		 * \return Returns true if the movie was written.
+		 */
+		bool											Save( std::vector<uint8_t> &_vFile ) const;
+
+		/**
+		 * Reads a movie from a file image.  Stops recording or playing back.
+		 *
+		 * \param _vFile The file image.
+		 * \return Returns false if the file is not a valid movie.
+		 */
+		bool											Load( const std::vector<uint8_t> &_vFile );
+
+
+	protected :
+		// == Members.
+		/** The input.  1 entry per frame with port 0 in the low byte and port 1 in the high byte. */
+		std::vector<uint16_t>							m_vInput;
+		/** The keyframes, in order. */
+		std::vector<LSN_KEYFRAME>						m_vKeyframes;
+		/** The system being recorded or played back. */
+		const CSystemBase *								m_psbSystem;
+		/** The live input source. */
+		CInputPoller *									m_pipSource;
+		/** The mode. */
+		LSN_MOVIE_MODE									m_mmMode;
+		/** The absolute PPU frame at which the movie starts. */
+		uint64_t										m_ui64StartFrame;
+		/** The CRC of the ROM with which the movie was recorded. */
+		uint32_t										m_ui32RomCrc;
+		/** The number of frames between keyframes. */
+		uint32_t										m_ui32KeyframeInterval;
+		/** The frame whose input has been latched while recording, or UINT64_MAX. */
+		uint64_t										m_ui64LatchedFrame;
+
+
+		// == Functions.
+		/**
+		 * Saves the state of a system as a keyframe.
+		 *
+		 * \param _sbSystem The system.
+		 * \param _kfKeyframe Holds the returned keyframe.
+		 * \return Returns false if the state could not be saved or compressed.
+		 */
+		bool											Capture( const CSystemBase &_sbSystem, LSN_KEYFRAME &_kfKeyframe ) const;
+
+		/**
+		 * Decompresses a keyframe.
+		 *
+		 * \param _kfKeyframe The keyframe.
+		 * \param _vState Holds the returned state.
+		 * \return Returns false if the keyframe is corrupt.
+		 */
+		static bool										Decompress( const LSN_KEYFRAME &_kfKeyframe, std::vector<uint8_t> &_vState );
+	};
+
+}	// namespace lsn
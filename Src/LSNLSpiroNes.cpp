@@ -11,10 +11,17 @@
 #include "File/LSNStdFile.h"
 #endif	// #ifdef LSN_CPU_VERIFY
 
+#ifndef LSN_USE_WINDOWS
+#include "Database/LSNDatabase.h"
+#include "System/LSNBenchmark.h"
+#endif	// #ifndef LSN_USE_WINDOWS
 
+
+#ifdef LSN_USE_WINDOWS
 int main() {
 	return 0;
 }
+#endif	// #ifdef LSN_USE_WINDOWS
 
 #ifdef LSN_USE_WINDOWS
 #if !defined( LSN_CPU_VERIFY )
@@ -115,62 +122,54 @@ int WINAPI wWinMain( _In_ HINSTANCE /*_hInstance*/, _In_opt_ HINSTANCE /*_hPrevI
 	return 0;
 }
 #endif	// #if !defined( LSN_CPU_VERIFY )
-#else
-int wmain( int /*_iArgC*/, wchar_t * /*_pwcArgv*/[] ) {
-#define LSN_PATH				u"J:\\My Projects\\L. Spiro NES\\Tests\\nestest.nes"
-	std::unique_ptr<lsn::CNtscSystem> pnsSystem = std::make_unique<lsn::CNtscSystem>();
-	std::vector<uint8_t> vExtracted;
-	std::u16string s16Path;
-	{
-		lsn::CZipFile fbFile;
-		fbFile.Open( LSN_PATH );
-		/*std::vector<uint8_t> vData;
-		fbFile.LoadToMemory( vData );*/
-		std::vector<std::u16string> vFiles;
-		fbFile.GatherArchiveFiles( vFiles );
-		if ( vFiles.size() ) {
-			for ( auto I = vFiles.size(); I--; ) {
-				std::u16string s16Ext = lsn::CUtilities::GetFileExtension( vFiles[I] );
-				if ( ::_wcsicmp( reinterpret_cast<const wchar_t *>(s16Ext.c_str()), L"NES" ) == 0 ) {
-					s16Path = lsn::CUtilities::GetFileName( vFiles[I] );
-					fbFile.ExtractToMemory( vFiles[I], vExtracted );
-					break;
-				}
-			}
+#elif defined( LSN_CPU_VERIFY )
+#include "LSONJson.h"
+int main( int _iArgC, char * _ppcArgV[] ) {
+	// Runs 00.json to FF.json from the given directory; the tests are those of https://github.com/TomHarte/ProcessorTests (nes6502/v1).
+	if ( _iArgC < 2 ) {
+		std::fprintf( stderr, "Usage: %s <nes6502/v1 directory>\n", _ppcArgV[0] );
+		return 1;
+	}
+	std::unique_ptr<lsn::CCpuBus> pbBus = std::make_unique<lsn::CCpuBus>();
+	pbBus->ApplyMap();
+	std::unique_ptr<lsn::CCpu6502> pcCpu = std::make_unique<lsn::CCpu6502>( pbBus.get() );
+
+	uint64_t ui64Tests = 0, ui64Failures = 0;
+	for ( uint32_t I = 0x00; I < 256; ++I ) {
+		lson::CJson jSon;
+		std::vector<uint8_t> vBytes;
+		lsn::CStdFile sfFile;
+		char szFile[16];
+		std::snprintf( szFile, sizeof( szFile ), "/%.2X.json", I );
+		const std::string sPath = std::string( _ppcArgV[1] ) + szFile;
+		if ( !sfFile.Open( reinterpret_cast<const char8_t *>(sPath.c_str()) ) ) { continue; }
+		sfFile.LoadToMemory( vBytes );
+		vBytes.push_back( 0 );
+
+		if ( !jSon.SetJson( reinterpret_cast<const char *>(vBytes.data()) ) ) {
+			std::fprintf( stderr, "JSON FAIL: %s\n", sPath.c_str() );
+			++ui64Failures;
+			continue;
 		}
-		else {
-			s16Path = LSN_PATH;
-			fbFile.LoadToMemory( vExtracted );
+		pcCpu->ResetToKnown();
+		pbBus->ApplyMap();
+
+		const lson::CJsonContainer::LSON_JSON_VALUE & jvRoot = jSon.GetContainer()->GetValue( jSon.GetContainer()->GetRoot() );
+		for ( size_t J = 0; J < jvRoot.vArray.size(); ++J ) {
+			const lson::CJsonContainer::LSON_JSON_VALUE & jvThis = jSon.GetContainer()->GetValue( jvRoot.vArray[J] );
+			++ui64Tests;
+			if ( !pcCpu->RunJsonTest( jSon, jvThis ) ) { ++ui64Failures; }
 		}
 	}
-#undef LSN_PATH
-
-	lsn::CClock cClock;
-	pnsSystem->LoadRom( vExtracted, s16Path );
-	pnsSystem->ResetState( false );
-	uint64_t ui64TickCount = 0;
-#define LSN_TIME								(1ULL * 10)
-	while ( pnsSystem->GetAccumulatedRealTime() / pnsSystem->GetClockResolution() < LSN_TIME ) {
-		pnsSystem->Tick();
-		++ui64TickCount;
-	}
-	uint64_t ui64Time = cClock.GetRealTick() - cClock.GetStartTick();
-	// If there are more Tick()'s than cycles then we definitely didn't go slower than the real system, so we can shave off excess time.
-
-	double dTime = (ui64TickCount >= pnsSystem->GetMasterCounter()) ?
-		double( LSN_TIME ) :
-		ui64Time / double( cClock.GetResolution() );
-	char szBuffer[256];
-	::sprintf_s( szBuffer, "Ticks: %llu. Time: %.8f.\r\n"
-		"Master Cycles: %llu (%.8f per second; expected %.8f).\r\n"
-		"%.8f cycles per Tick().\r\n"
-		"%.8f FPS.\r\n",
-		ui64TickCount, dTime,
-		pnsSystem->GetMasterCounter(), pnsSystem->GetMasterCounter() / dTime, double( pnsSystem->MasterHz() ) / pnsSystem->MasterDiv(),
-		pnsSystem->GetMasterCounter() / double( ui64TickCount ),
-		pnsSystem->GetPpu().GetFrameCount() / dTime
-		);
-	::OutputDebugStringA( szBuffer );
-	return 0;
+	std::printf( "Tests: %llu\nFailures: %llu\n", static_cast<unsigned long long>(ui64Tests), static_cast<unsigned long long>(ui64Failures) );
+	return ui64Failures ? 1 : 0;
+}
+#else
+int main( int _iArgC, char * _ppcArgV[] ) {
+	// Headless benchmark; see lsn::CBenchmark::Usage().
+	lsn::CDatabase::Init();
+	int iRet = lsn::CBenchmark::Main( _iArgC, _ppcArgV );
+	lsn::CDatabase::Reset();
+	return iRet;
 }
 #endif	// #ifdef LSN_USE_WINDOWS
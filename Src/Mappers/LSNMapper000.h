@@ -47,9 +47,18 @@ namespace lsn {
 		 */
 		virtual void									ApplyMap( CCpuBus * _pbCpuBus, CPpuBus * _pbPpuBus ) {
 			CMapperBase::ApplyMap( _pbCpuBus, _pbPpuBus );
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::StdMapperCpuRead, this, uint16_t( (I - 0x8000) % m_prRom->vPrgRom.size() ) );
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CCpuBus::NoWrite, nullptr, uint16_t( I ) );	// Treated as ROM.
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::StdMapperCpuRead, this, 0, 1, uint32_t( m_prRom->vPrgRom.size() ) );
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &CCpuBus::NoWrite, nullptr, 0x8000 );	// Treated as ROM.
+			// Nothing is banked, so the CPU and PPU read the ROM directly.
+			if ( m_prRom->vPrgRom.size() % CCpuBus::LSN_BP_PAGE_SIZE == 0 ) {
+				for ( uint32_t I = 0x8000; I < 0x10000; I += CCpuBus::LSN_BP_PAGE_SIZE ) {
+					_pbCpuBus->SetDirectReadPage( uint16_t( I >> CCpuBus::LSN_BP_PAGE_SHIFT ), &m_prRom->vPrgRom[(I-0x8000)%m_prRom->vPrgRom.size()] );
+				}
+			}
+			if ( m_prRom->vChrRom.size() && m_prRom->vChrRom.size() % CPpuBus::LSN_BP_PAGE_SIZE == 0 ) {
+				for ( uint32_t I = LSN_PPU_PATTERN_TABLES; I < LSN_PPU_NAMETABLES; I += CPpuBus::LSN_BP_PAGE_SIZE ) {
+					_pbPpuBus->SetDirectReadPage( uint16_t( I >> CPpuBus::LSN_BP_PAGE_SHIFT ), &m_prRom->vChrRom[((I-LSN_PPU_PATTERN_TABLES)%LSN_PPU_PATTERN_TABLE_SIZE)%m_prRom->vChrRom.size()] );
+				}
 			}
 		}
 
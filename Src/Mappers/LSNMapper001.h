@@ -54,7 +54,9 @@ namespace lsn {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase );
 			SanitizeRegs<PgmBankSize() * 2, ChrBankSize() * 2>();
 			SetPgmBank2x<2, PgmBankSize()>( 3 );
-			SetChrBank2x<0, ChrBankSize()>( 0 );
+			// CHR register 0 is only read as an 8-kilobyte bank; register 1 is the low 4-kilobyte bank.
+			SetChrBank<0, ChrBankSize() * 2>( 0 );
+			SetChrBank<1, ChrBankSize()>( 1 );
 			m_ui8Control = 0x1C;
 			m_ui8Load = 0;
 			m_ui8LoadCnt = 0;
@@ -77,29 +79,21 @@ namespace lsn {
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper001::Read_PGM_8000_FFFF, this, uint16_t( (I - 0x8000) % m_prRom->vPrgRom.size() ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapper001::Read_PGM_8000_FFFF, this, 0, 1, uint32_t( m_prRom->vPrgRom.size() ) );
 			// PPU.
 			if ( m_prRom->vChrRom.size() ) {
-				for ( uint32_t I = 0x0000; I < 0x2000; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapper001::Read_CHR_0000_1FFF, this, uint16_t( I - 0x0000 ) );
-				}
+				_pbPpuBus->SetReadRange( 0x0000, 0x2000, &CMapper001::Read_CHR_0000_1FFF, this, 0 );
 			}
 			// RAM.
-			for ( uint32_t I = 0x6000; I < 0x8000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper001::Mapper001PgmRamRead, this, uint16_t( I - 0x6000 ) );
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper001::Mapper001PgmRamWrite, this, uint16_t( I - 0x6000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x6000, 0x8000, &CMapper001::Mapper001PgmRamRead, this, 0 );
+			_pbCpuBus->SetWriteRange( 0x6000, 0x8000, &CMapper001::Mapper001PgmRamWrite, this, 0 );
 
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// PGM bank-select.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper001::Write_PGM_8000_FFFF, this, uint16_t( I ) );
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &CMapper001::Write_PGM_8000_FFFF, this, 0x8000 );
 
 
 			// ================
@@ -108,6 +102,38 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );			
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteBytes( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Control ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Load ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8LoadCnt ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bRamEnabled ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Control ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Load ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8LoadCnt ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bRamEnabled ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -168,16 +194,16 @@ namespace lsn {
 				// 8-kilobyte chunks.
 				if ( _ui16Parm1 >= 0xC000 - 0x8000 ) {
 					// Hi chunk.
-					_ui8Ret = pmThis->m_prRom->vPrgRom.data()[pmThis->m_ui8PgmBanks[3]*PgmBankSize()+(_ui16Parm1&0x3FFF)];
+					_ui8Ret = pmThis->m_pui8PgmBankPtrs[3][_ui16Parm1&0x3FFF];
 				}
 				else {
 					// Lo chunk.
-					_ui8Ret = pmThis->m_prRom->vPrgRom.data()[pmThis->m_ui8PgmBanks[2]*PgmBankSize()+(_ui16Parm1&0x3FFF)];
+					_ui8Ret = pmThis->m_pui8PgmBankPtrs[2][_ui16Parm1&0x3FFF];
 				}
 			}
 			else {
 				// 32 kikobytes.
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[pmThis->m_ui8PgmBank*(PgmBankSize()*2)+(_ui16Parm1&0x7FFF)];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[0][_ui16Parm1&0x7FFF];
 			}
 		}
 
@@ -341,16 +367,16 @@ namespace lsn {
 					// 4-kilobyte chunks.
 					if ( _ui16Parm1 >= ChrBankSize() ) {
 						// Hi chunk.
-						_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[2]*ChrBankSize()+(_ui16Parm1&0x0FFF)];
+						_ui8Ret = pmThis->m_pui8ChrBankPtrs[2][_ui16Parm1&0x0FFF];
 					}
 					else {
 						// Lo chunk.
-						_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[1]*ChrBankSize()+(_ui16Parm1&0x0FFF)];
+						_ui8Ret = pmThis->m_pui8ChrBankPtrs[1][_ui16Parm1&0x0FFF];
 					}
 				}
 				else {
 					// 8 kilobytes.
-					_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBank*(ChrBankSize()*2)+(_ui16Parm1&0x1FFF)];
+					_ui8Ret = pmThis->m_pui8ChrBankPtrs[0][_ui16Parm1&0x1FFF];
 				}
 			}
 		}
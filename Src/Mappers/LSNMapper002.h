@@ -37,7 +37,7 @@ namespace lsn {
 		 */
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase );
-			m_ui8PgmBank = 0;
+			SetPgmBank<0, 0x4000>( 0 );
 			m_ui8Mask = 0b0111;
 		}
 
@@ -52,18 +52,36 @@ namespace lsn {
 
 			// Set the reads of the fixed bank at the end.		
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), 0x4000 ) - 0x4000;
-			for ( uint32_t I = 0xC000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( I - 0xC000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xC000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0 );
 			// Set the reads of the selectable bank.
-			for ( uint32_t I = 0x8000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_4000, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xC000, &CMapperBase::PgmBankRead_4000, this, 0 );
 
 			// Writes to the whole area are used to select a bank.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper002::SelectBank, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &CMapper002::SelectBank, this, 0, 0 );	// Treated as ROM.
+		}
+
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Mask ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Mask ) ) { return false; }
+			return true;
 		}
 
 
@@ -84,7 +102,7 @@ namespace lsn {
 		 */
 		static void LSN_FASTCALL						SelectBank( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t _ui8Val ) {
 			CMapper002 * pmThis = reinterpret_cast<CMapper002 *>(_pvParm0);
-			pmThis->m_ui8PgmBank = (_ui8Val & pmThis->m_ui8Mask) % (pmThis->m_prRom->vPrgRom.size() / 0x4000);
+			pmThis->SetPgmBank<0, 0x4000>( _ui8Val & pmThis->m_ui8Mask );
 
 		}
 	};
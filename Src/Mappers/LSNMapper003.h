@@ -49,14 +49,10 @@ namespace lsn {
 		virtual void									ApplyMap( CCpuBus * _pbCpuBus, CPpuBus * _pbPpuBus ) {
 			CMapperBase::ApplyMap( _pbCpuBus, _pbPpuBus );
 
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::StdMapperCpuRead, this, uint16_t( (I - 0x8000) % m_prRom->vPrgRom.size() ) );
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &Mapper003CpuWrite, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::StdMapperCpuRead, this, 0, 1, uint32_t( m_prRom->vPrgRom.size() ) );
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &Mapper003CpuWrite, this, 0, 0 );	// Treated as ROM.
 
-			for ( uint32_t I = 0x0000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead_2000, this, uint16_t( I ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x2000, &CMapperBase::ChrBankRead_2000, this, 0x0000 );
 		}
 
 
@@ -72,59 +72,33 @@ namespace lsn {
 			// ================
 			// Set the reads of the fixed bank at the end.		
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), PgmBankSize() ) - PgmBankSize();
-			for ( uint32_t I = 0xE000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( (I - 0xE000) % m_prRom->vPrgRom.size() ) );
-			}
+			_pbCpuBus->SetReadRange( 0xE000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0, 1, uint32_t( m_prRom->vPrgRom.size() ) );
 			
 
 			// ================
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &Read_PGM_8000_9FFF, this, uint16_t( I - 0x8000 ) );
-			}
-			for ( uint32_t I = 0xA000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<1, PgmBankSize()>, this, uint16_t( I - 0xA000 ) );
-			}
-			for ( uint32_t I = 0xC000; I < 0xE000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &Read_PGM_C000_DFFF, this, uint16_t( I - 0xC000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xA000, &Read_PGM_8000_9FFF, this, 0 );
+			_pbCpuBus->SetReadRange( 0xA000, 0xC000, &CMapperBase::PgmBankRead<1, PgmBankSize()>, this, 0 );
+			_pbCpuBus->SetReadRange( 0xC000, 0xE000, &Read_PGM_C000_DFFF, this, 0 );
 			/*for ( uint32_t I = 0xE000; I < 0x10000; ++I ) {
 				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<3, PgmBankSize()>, this, uint16_t( I - 0xE000 ) );
 			}*/
 			// PPU.
 			if ( m_prRom->vChrRom.size() ) {
-				for ( uint32_t I = 0x0000; I < 0x0400; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_0000_03FF, this, uint16_t( I - 0x0000 ) );
-				}
-				for ( uint32_t I = 0x0400; I < 0x0800; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_0400_07FF, this, uint16_t( I - 0x0400 ) );
-				}
-				for ( uint32_t I = 0x0800; I < 0x0C00; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_0800_0BFF, this, uint16_t( I - 0x0800 ) );
-				}
-				for ( uint32_t I = 0x0C00; I < 0x1000; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_0C00_0FFF, this, uint16_t( I - 0x0C00 ) );
-				}
-				for ( uint32_t I = 0x1000; I < 0x1400; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_1000_13FF, this, uint16_t( I - 0x1000 ) );
-				}
-				for ( uint32_t I = 0x1400; I < 0x1800; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_1400_17FF, this, uint16_t( I - 0x1400 ) );
-				}
-				for ( uint32_t I = 0x1800; I < 0x1C00; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_1800_1BFF, this, uint16_t( I - 0x1800 ) );
-				}
-				for ( uint32_t I = 0x1C00; I < 0x2000; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &Read_CHR_1C00_1FFF, this, uint16_t( I - 0x1C00 ) );
-				}
+				_pbPpuBus->SetReadRange( 0x0000, 0x0400, &Read_CHR_0000_03FF, this, 0 );
+				_pbPpuBus->SetReadRange( 0x0400, 0x0800, &Read_CHR_0400_07FF, this, 0 );
+				_pbPpuBus->SetReadRange( 0x0800, 0x0C00, &Read_CHR_0800_0BFF, this, 0 );
+				_pbPpuBus->SetReadRange( 0x0C00, 0x1000, &Read_CHR_0C00_0FFF, this, 0 );
+				_pbPpuBus->SetReadRange( 0x1000, 0x1400, &Read_CHR_1000_13FF, this, 0 );
+				_pbPpuBus->SetReadRange( 0x1400, 0x1800, &Read_CHR_1400_17FF, this, 0 );
+				_pbPpuBus->SetReadRange( 0x1800, 0x1C00, &Read_CHR_1800_1BFF, this, 0 );
+				_pbPpuBus->SetReadRange( 0x1C00, 0x2000, &Read_CHR_1C00_1FFF, this, 0 );
 			}
 			// RAM.
-			for ( uint32_t I = 0x6000; I < 0x8000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &Mapper004PgmRamRead, this, uint16_t( I - 0x6000 ) );
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &Mapper004PgmRamWrite, this, uint16_t( I - 0x6000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x6000, 0x8000, &Mapper004PgmRamRead, this, 0 );
+			_pbCpuBus->SetWriteRange( 0x6000, 0x8000, &Mapper004PgmRamWrite, this, 0 );
 
 
 			// ================
@@ -162,6 +136,42 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteBytes( m_ui8PrgRam, sizeof( m_ui8PrgRam ) ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg0 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg1 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg2 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Reg3 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8BankMode ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrMode ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_ui8PrgRam, sizeof( m_ui8PrgRam ) ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg0 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg1 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg2 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Reg3 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8BankMode ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrMode ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -336,11 +346,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b01000000 ) {
 				// $8000.D6 = 1
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[pmThis->m_ui8PgmBanks[2]*PgmBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[2][_ui16Parm1];
 			}
 			else {
 				// $8000.D6 = 0
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[pmThis->m_ui8PgmBanks[0]*PgmBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[0][_ui16Parm1];
 			}
 		}
 
@@ -356,11 +366,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b01000000 ) {
 				// $8000.D6 = 1
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[pmThis->m_ui8PgmBanks[0]*PgmBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[0][_ui16Parm1];
 			}
 			else {
 				// $8000.D6 = 0
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[pmThis->m_ui8PgmBanks[2]*PgmBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[2][_ui16Parm1];
 			}
 		}
 
@@ -376,11 +386,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[4]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[4][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[0]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[0][_ui16Parm1];
 			}
 		}
 
@@ -396,11 +406,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[5]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[5][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[1]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[1][_ui16Parm1];
 			}
 		}
 
@@ -416,11 +426,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[6]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[6][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[2]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[2][_ui16Parm1];
 			}
 		}
 
@@ -436,11 +446,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[7]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[7][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[3]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[3][_ui16Parm1];
 			}
 		}
 
@@ -456,11 +466,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[0]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[0][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[4]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[4][_ui16Parm1];
 			}
 		}
 
@@ -476,11 +486,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[1]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[1][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[5]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[5][_ui16Parm1];
 			}
 		}
 
@@ -496,11 +506,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[2]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[2][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[6]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[6][_ui16Parm1];
 			}
 		}
 
@@ -516,11 +526,11 @@ namespace lsn {
 			CMapper004 * pmThis = reinterpret_cast<CMapper004 *>(_pvParm0);
 			if ( pmThis->m_ui8Reg0 & 0b10000000 ) {
 				// $8000.D7 = 1
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[3]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[3][_ui16Parm1];
 			}
 			else {
 				// $8000.D7 = 0
-				_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBanks[7]*ChrBankSize()+_ui16Parm1];
+				_ui8Ret = pmThis->m_pui8ChrBankPtrs[7][_ui16Parm1];
 			}
 		}
 
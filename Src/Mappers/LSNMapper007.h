@@ -52,7 +52,7 @@ namespace lsn {
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase );
 			SanitizeRegs<PgmBankSize(), ChrBankSize()>();
-			m_ui8PgmBank = 0;
+			SetPgmBank<0, PgmBankSize()>( 0 );
 		}
 
 		/**
@@ -68,18 +68,14 @@ namespace lsn {
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_8000, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::PgmBankRead_8000, this, 0 );
 
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// PGM bank-select.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper007::SelectBank8000_FFFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &CMapper007::SelectBank8000_FFFF, this, 0, 0 );	// Treated as ROM.
 
 			// ================
 			// MIRRORING
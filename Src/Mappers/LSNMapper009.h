@@ -36,7 +36,7 @@ namespace lsn {
 		 */
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase );
-			m_ui8PgmBank = 0;
+			SetPgmBank<0, 8 * 1024>( 0 );
 			m_ui8Latch0 = 0xFD;
 			m_ui8Latch1 = 0xFD;
 
@@ -57,56 +57,34 @@ namespace lsn {
 			// ================
 			// Last 3 banks are fixed 8-kilobyte banks.
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), (8 * 1024) * 3 ) - (8 * 1024) * 3;
-			for ( uint32_t I = 0xA000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( I - 0xA000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xA000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0 );
 
 			// ================
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_2000, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xA000, &CMapperBase::PgmBankRead_2000, this, 0 );
 			// PPU.
-			for ( uint32_t I = 0x0000; I < 0x1000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapper009::Mapper009ChrBankRead_0000_0FFF, this, uint16_t( I - 0x0000 ) );
-			}
-			for ( uint32_t I = 0x1000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapper009::Mapper009ChrBankRead_1000_1FFF, this, uint16_t( I - 0x1000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x1000, &CMapper009::Mapper009ChrBankRead_0000_0FFF, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1000, 0x2000, &CMapper009::Mapper009ChrBankRead_1000_1FFF, this, 0 );
 
 			// ================
 			// RAM
 			// ================
 			// Set the reads and writes of the RAM.
-			for ( uint32_t I = 0x6000; I < 0x8000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper009::Mapper009PgmRamRead, this, uint16_t( I - 0x6000 ) );
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper009::Mapper009PgmRamWrite, this, uint16_t( I - 0x6000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x6000, 0x8000, &CMapper009::Mapper009PgmRamRead, this, 0 );
+			_pbCpuBus->SetWriteRange( 0x6000, 0x8000, &CMapper009::Mapper009PgmRamWrite, this, 0 );
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// Select banks/mirroring.
-			for ( uint32_t I = 0xA000; I < 0xB000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper009::SelectBankA000_AFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xB000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper009::SelectBankB000_BFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xC000; I < 0xD000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper009::SelectBankC000_CFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xD000; I < 0xE000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper009::SelectBankD000_DFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xE000; I < 0xF000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper009::SelectBankE000_EFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xF000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper009::SetMirroringF000_FFFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0xA000, 0xB000, &CMapper009::SelectBankA000_AFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xB000, 0xC000, &CMapper009::SelectBankB000_BFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xC000, 0xD000, &CMapper009::SelectBankC000_CFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xD000, 0xE000, &CMapper009::SelectBankD000_DFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xE000, 0xF000, &CMapper009::SelectBankE000_EFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xF000, 0x10000, &CMapper009::SetMirroringF000_FFFF, this, 0, 0 );	// Treated as ROM.
 
 			// ================
 			// PPU READS
@@ -130,6 +108,42 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteBytes( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch0_FD ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch0_FE ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch1_FD ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBankLatch1_FE ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Latch0 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Latch1 ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch0_FD ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch0_FE ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch1_FD ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBankLatch1_FE ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Latch0 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Latch1 ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -245,7 +259,7 @@ namespace lsn {
 			 *		 ||||
 			 *		 ++++- Select 8 KB PRG ROM bank for CPU $8000-$9FFF
 			 */
-			pmThis->m_ui8PgmBank = (_ui8Val & 0b1111) % (pmThis->m_prRom->vPrgRom.size() / (8 * 1024));
+			pmThis->SetPgmBank<0, 8 * 1024>( _ui8Val & 0b1111 );
 		}
 
 		/**
@@ -76,56 +76,34 @@ namespace lsn {
 			// ================
 			// 16-kilobyte fixed bank.
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), (PgmBankSize()) ) - (PgmBankSize());
-			for ( uint32_t I = 0xC000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( I - 0xC000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xC000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0 );
 
 			// ================
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_4000, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xC000, &CMapperBase::PgmBankRead_4000, this, 0 );
 			// PPU.
-			for ( uint32_t I = 0x0000; I < 0x1000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapper010::Mapper010ChrBankRead_0000_0FFF, this, uint16_t( I - 0x0000 ) );
-			}
-			for ( uint32_t I = 0x1000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapper010::Mapper010ChrBankRead_1000_1FFF, this, uint16_t( I - 0x1000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x1000, &CMapper010::Mapper010ChrBankRead_0000_0FFF, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1000, 0x2000, &CMapper010::Mapper010ChrBankRead_1000_1FFF, this, 0 );
 
 			// ================
 			// RAM
 			// ================
 			// Set the reads and writes of the RAM.
-			for ( uint32_t I = 0x6000; I < 0x8000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper010::Mapper010PgmRamRead, this, uint16_t( I - 0x6000 ) );
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper010::Mapper010PgmRamWrite, this, uint16_t( I - 0x6000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x6000, 0x8000, &CMapper010::Mapper010PgmRamRead, this, 0 );
+			_pbCpuBus->SetWriteRange( 0x6000, 0x8000, &CMapper010::Mapper010PgmRamWrite, this, 0 );
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// Select banks/mirroring.
-			for ( uint32_t I = 0xA000; I < 0xB000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper010::SelectBankA000_AFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xB000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper010::SelectBankB000_BFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xC000; I < 0xD000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper010::SelectBankC000_CFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xD000; I < 0xE000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper010::SelectBankD000_DFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xE000; I < 0xF000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper010::SelectBankE000_EFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xF000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper010::SetMirroringF000_FFFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0xA000, 0xB000, &CMapper010::SelectBankA000_AFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xB000, 0xC000, &CMapper010::SelectBankB000_BFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xC000, 0xD000, &CMapper010::SelectBankC000_CFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xD000, 0xE000, &CMapper010::SelectBankD000_DFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xE000, 0xF000, &CMapper010::SelectBankE000_EFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xF000, 0x10000, &CMapper010::SetMirroringF000_FFFF, this, 0, 0 );	// Treated as ROM.
 
 			// ================
 			// PPU READS
@@ -149,6 +127,34 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteBytes( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Latch0 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Latch1 ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_ui8PgmRam, sizeof( m_ui8PgmRam ) ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Latch0 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Latch1 ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -215,11 +221,11 @@ namespace lsn {
 			CMapper010 * pmThis = reinterpret_cast<CMapper010 *>(_pvParm0);
 			switch ( pmThis->m_ui8Latch0 ) {
 				case 0xFD : {
-					_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch0_FD*(ChrBankSize())+_ui16Parm1];
+					_ui8Ret = pmThis->m_pui8ChrBankPtrs[0][_ui16Parm1];
 					break;
 				}
 				case 0xFE : {
-					_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch0_FE*(ChrBankSize())+_ui16Parm1];
+					_ui8Ret = pmThis->m_pui8ChrBankPtrs[1][_ui16Parm1];
 					break;
 				}
 				// I guess if the latch is invalid then return the open bus by doing nothing?  Read the value in _pui8Data? 
@@ -238,11 +244,11 @@ namespace lsn {
 			CMapper010 * pmThis = reinterpret_cast<CMapper010 *>(_pvParm0);
 			switch ( pmThis->m_ui8Latch1 ) {
 				case 0xFD : {
-					_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch1_FD*(ChrBankSize())+_ui16Parm1];
+					_ui8Ret = pmThis->m_pui8ChrBankPtrs[2][_ui16Parm1];
 					break;
 				}
 				case 0xFE : {
-					_ui8Ret = pmThis->m_prRom->vChrRom.data()[pmThis->m_ui8ChrBankLatch1_FE*(ChrBankSize())+_ui16Parm1];
+					_ui8Ret = pmThis->m_pui8ChrBankPtrs[3][_ui16Parm1];
 					break;
 				}
 				default : {
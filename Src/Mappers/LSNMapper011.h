@@ -67,22 +67,16 @@ namespace lsn {
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, 0 );
 			// PPU.
-			for ( uint32_t I = 0x0000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<0, ChrBankSize()>, this, uint16_t( I - 0x0000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x2000, &CMapperBase::ChrBankRead<0, ChrBankSize()>, this, 0 );
 
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// PGM bank-select.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper011::SelectBank8000_FFFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &CMapper011::SelectBank8000_FFFF, this, 0, 0 );	// Treated as ROM.
 		}
 
 
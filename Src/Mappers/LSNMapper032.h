@@ -61,71 +61,39 @@ namespace lsn {
 			// FIXED BANKS
 			// ================
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), 0x2000 ) - 0x2000;
-			for ( uint32_t I = 0xE000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( I - 0xE000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xE000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0 );
 
 			 
 			// ================
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper032::PgmBankRead_8000_A000, this, uint16_t( I - 0x8000 ) );
-			}
-			for ( uint32_t I = 0xA000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper032::PgmBankRead_A000_C000, this, uint16_t( I - 0xA000 ) );
-			}
-			for ( uint32_t I = 0xC000; I < 0xE000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper032::PgmBankRead_C000_E000, this, uint16_t( I - 0xC000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xA000, &CMapper032::PgmBankRead_8000_A000, this, 0 );
+			_pbCpuBus->SetReadRange( 0xA000, 0xC000, &CMapper032::PgmBankRead_A000_C000, this, 0 );
+			_pbCpuBus->SetReadRange( 0xC000, 0xE000, &CMapper032::PgmBankRead_C000_E000, this, 0 );
 			// PPU.
-			for ( uint32_t I = 0x0000; I < 0x0400; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<0, 0x0400>, this, uint16_t( I - 0x0000 ) );
-			}
-			for ( uint32_t I = 0x0400; I < 0x0800; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<1, 0x0400>, this, uint16_t( I - 0x0400 ) );
-			}
-			for ( uint32_t I = 0x0800; I < 0x0C00; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<2, 0x0400>, this, uint16_t( I - 0x0800 ) );
-			}
-			for ( uint32_t I = 0x0C00; I < 0x1000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<3, 0x0400>, this, uint16_t( I - 0x0C00 ) );
-			}
-			for ( uint32_t I = 0x1000; I < 0x1400; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<4, 0x0400>, this, uint16_t( I - 0x1000 ) );
-			}
-			for ( uint32_t I = 0x1400; I < 0x1800; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<5, 0x0400>, this, uint16_t( I - 0x1400 ) );
-			}
-			for ( uint32_t I = 0x1800; I < 0x1C00; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<6, 0x0400>, this, uint16_t( I - 0x1800 ) );
-			}
-			for ( uint32_t I = 0x1C00; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<7, 0x0400>, this, uint16_t( I - 0x1C00 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x0400, &CMapperBase::ChrBankRead<0, 0x0400>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x0400, 0x0800, &CMapperBase::ChrBankRead<1, 0x0400>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x0800, 0x0C00, &CMapperBase::ChrBankRead<2, 0x0400>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x0C00, 0x1000, &CMapperBase::ChrBankRead<3, 0x0400>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1000, 0x1400, &CMapperBase::ChrBankRead<4, 0x0400>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1400, 0x1800, &CMapperBase::ChrBankRead<5, 0x0400>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1800, 0x1C00, &CMapperBase::ChrBankRead<6, 0x0400>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1C00, 0x2000, &CMapperBase::ChrBankRead<7, 0x0400>, this, 0 );
 
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// PGM bank-select 0.
-			for ( uint32_t I = 0x8000; I <= 0x8007; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper032::SelectBank8000_8007, this, uint16_t( I - 0x8000 ) );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x8007 + 1, &CMapper032::SelectBank8000_8007, this, 0 );	// Treated as ROM.
 			// PGM bank-select 1.
-			for ( uint32_t I = 0xA000; I <= 0xA007; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper032::SelectBankA000_A007, this, uint16_t( I - 0xA000 ) );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0xA000, 0xA007 + 1, &CMapper032::SelectBankA000_A007, this, 0 );	// Treated as ROM.
 			// CHR bank-select.
-			for ( uint32_t I = 0xB000; I <= 0xB007; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper032::SelectBankB000_B007, this, uint16_t( I - 0xB000 ) );
-			}
+			_pbCpuBus->SetWriteRange( 0xB000, 0xB007 + 1, &CMapper032::SelectBankB000_B007, this, 0 );
 			// Mode/mirroring.
 			if ( m_prRom->riInfo.ui16SubMapper != 1 && m_prRom->riInfo.ui32Crc != LSN_MAJOR_BALL_CRC ) {
-				for ( uint32_t I = 0x9000; I <= 0x9007; ++I ) {
-					_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper032::SelectModeEtc9000_9007, this, uint16_t( I - 0x9000 ) );
-				}
+				_pbCpuBus->SetWriteRange( 0x9000, 0x9007 + 1, &CMapper032::SelectModeEtc9000_9007, this, 0 );
 			}
 
 
@@ -141,6 +109,34 @@ namespace lsn {
 #undef LSN_MAJOR_BALL_CRC
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Mode ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Neg1Bank ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Neg2Bank ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Mode ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Neg1Bank ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Neg2Bank ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -226,7 +222,7 @@ namespace lsn {
 		static void LSN_FASTCALL						PgmBankRead_8000_A000( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * /*_pui8Data*/, uint8_t &_ui8Ret ) {
 			CMapper032 * pmThis = reinterpret_cast<CMapper032 *>(_pvParm0);
 			if ( !pmThis->m_ui8Mode ) {
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8PgmBanks[0])*0x2000)];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[0][_ui16Parm1];
 			}
 			else {
 				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8Neg2Bank)*0x2000)];
@@ -244,10 +240,10 @@ namespace lsn {
 		static void LSN_FASTCALL						PgmBankRead_A000_C000( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * /*_pui8Data*/, uint8_t &_ui8Ret ) {
 			CMapper032 * pmThis = reinterpret_cast<CMapper032 *>(_pvParm0);
 			if ( !pmThis->m_ui8Mode ) {
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8PgmBanks[1])*0x2000)];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[1][_ui16Parm1];
 			}
 			else {
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8PgmBanks[0])*0x2000)];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[0][_ui16Parm1];
 			}
 		}
 
@@ -265,7 +261,7 @@ namespace lsn {
 				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8Neg2Bank)*0x2000)];
 			}
 			else {
-				_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8PgmBanks[1])*0x2000)];
+				_ui8Ret = pmThis->m_pui8PgmBankPtrs[1][_ui16Parm1];
 			}
 		}
 	};
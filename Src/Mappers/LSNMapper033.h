@@ -68,49 +68,29 @@ namespace lsn {
 			// ================
 			// Set the reads of the fixed bank at the end.		
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), PgmBankSize() * 2 ) - PgmBankSize() * 2;
-			for ( uint32_t I = 0xC000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( I - 0xC000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xC000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0 );
 			
 
 			// ================
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, uint16_t( I - 0x8000 ) );
-			}
-			for ( uint32_t I = 0xA000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<1, PgmBankSize()>, this, uint16_t( I - 0xA000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xA000, &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, 0 );
+			_pbCpuBus->SetReadRange( 0xA000, 0xC000, &CMapperBase::PgmBankRead<1, PgmBankSize()>, this, 0 );
 			// PPU.
-			for ( uint32_t I = 0x0000; I < 0x0800; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<0, ChrBankSize() * 2>, this, uint16_t( I - 0x0000 ) );
-			}
-			for ( uint32_t I = 0x0800; I < 0x1000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<1, ChrBankSize() * 2>, this, uint16_t( I - 0x0800 ) );
-			}
-			for ( uint32_t I = 0x1000; I < 0x1400; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<2, ChrBankSize()>, this, uint16_t( I - 0x1000 ) );
-			}
-			for ( uint32_t I = 0x1400; I < 0x1800; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<3, ChrBankSize()>, this, uint16_t( I - 0x1400 ) );
-			}
-			for ( uint32_t I = 0x1800; I < 0x1C00; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<4, ChrBankSize()>, this, uint16_t( I - 0x1800 ) );
-			}
-			for ( uint32_t I = 0x1C00; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<5, ChrBankSize()>, this, uint16_t( I - 0x1C00 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x0800, &CMapperBase::ChrBankRead<0, ChrBankSize() * 2>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x0800, 0x1000, &CMapperBase::ChrBankRead<1, ChrBankSize() * 2>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1000, 0x1400, &CMapperBase::ChrBankRead<2, ChrBankSize()>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1400, 0x1800, &CMapperBase::ChrBankRead<3, ChrBankSize()>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1800, 0x1C00, &CMapperBase::ChrBankRead<4, ChrBankSize()>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1C00, 0x2000, &CMapperBase::ChrBankRead<5, ChrBankSize()>, this, 0 );
 
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// PGM bank-select.
-			for ( uint32_t I = 0x8000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper033::SelectBank8000_BFFF, this, uint16_t( I ) );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0xC000, &CMapper033::SelectBank8000_BFFF, this, 0x8000 );	// Treated as ROM.
 
 
 			// ================
@@ -70,17 +70,11 @@ namespace lsn {
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, 0 );
 			if ( m_prRom->vChrRom.size() ) {
 				// PPU.
-				for ( uint32_t I = 0x0000; I < 0x1000; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<0, ChrBankSize()>, this, uint16_t( I - 0x0000 ) );
-				}
-				for ( uint32_t I = 0x1000; I < 0x2000; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<1, ChrBankSize()>, this, uint16_t( I - 0x1000 ) );
-				}
+				_pbPpuBus->SetReadRange( 0x0000, 0x1000, &CMapperBase::ChrBankRead<0, ChrBankSize()>, this, 0 );
+				_pbPpuBus->SetReadRange( 0x1000, 0x2000, &CMapperBase::ChrBankRead<1, ChrBankSize()>, this, 0 );
 			}
 
 
@@ -88,9 +82,7 @@ namespace lsn {
 			// BANK-SELECT
 			// ================
 			// PGM bank-select.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper034::SelectBank8000_FFFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &CMapper034::SelectBank8000_FFFF, this, 0, 0 );	// Treated as ROM.
 			
 			_pbCpuBus->SetWriteFunc( 0x7FFD, &CMapper034::SelectBank7FFD, this, 0 );	// Treated as ROM.
 			if ( m_prRom->vChrRom.size() ) {
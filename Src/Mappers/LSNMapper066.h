@@ -69,21 +69,15 @@ namespace lsn {
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_8000, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::PgmBankRead_8000, this, 0 );
 			// PPU.
-			for ( uint32_t I = 0x0000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead_2000, this, uint16_t( I - 0x0000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x2000, &CMapperBase::ChrBankRead_2000, this, 0 );
 
 			// ================
 			// BANK-SELECT
 			// ================
 			// Writes to the whole area are used to select a bank.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper066::SelectBank8000_FFFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x10000, &CMapper066::SelectBank8000_FFFF, this, 0, 0 );	// Treated as ROM.
 		}
 
 
@@ -112,7 +106,6 @@ namespace lsn {
 			 */
 			//pmThis->m_ui8PgmBank = ((_ui8Val & 0b00110000) >> 4) % (pmThis->m_prRom->vPrgRom.size() / (PgmBankSize()));
 			pmThis->SetPgmBank<0, PgmBankSize()>( (_ui8Val & 0b00110000) >> 4 );
-			pmThis->m_ui8ChrBank = (_ui8Val & 0b00000011) % (pmThis->m_prRom->vChrRom.size() / (ChrBankSize()));
 			pmThis->SetChrBank<0, ChrBankSize()>( _ui8Val & 0b00000011 );
 		}
 	};
@@ -44,10 +44,10 @@ namespace lsn {
 		 */
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase );
-			m_ui8PgmBank = 0;
+			SetPgmBank<0, 0x2000>( 0 );
 			m_ui8PgmBank1 = 1;
 			m_ui8PgmBank2 = 2;
-			m_ui8ChrBank = 0;
+			SetChrBank<0, 0x1000>( 0 );
 			m_ui8ChrBank1 = 1;
 
 		}
@@ -62,57 +62,61 @@ namespace lsn {
 			CMapperBase::ApplyMap( _pbCpuBus, _pbPpuBus );
 
 			// PGM bank 0.
-			for ( uint32_t I = 0x8000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_2000, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xA000, &CMapperBase::PgmBankRead_2000, this, 0 );
 			// PGM bank 1.
-			for ( uint32_t I = 0xA000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper075::PgmBank1Read_2000, this, uint16_t( I - 0xA000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xA000, 0xC000, &CMapper075::PgmBank1Read_2000, this, 0 );
 			// PGM bank 2.
-			for ( uint32_t I = 0xC000; I < 0xE000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapper075::PgmBank2Read_2000, this, uint16_t( I - 0xC000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xC000, 0xE000, &CMapper075::PgmBank2Read_2000, this, 0 );
 
 			// Set the reads of the fixed bank at the end.		
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), 0x2000 ) - 0x2000;
-			for ( uint32_t I = 0xE000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( I - 0xE000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xE000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0 );
 
 			// CHR bank 0.
-			for ( uint32_t I = 0x0000; I < 0x1000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead_1000, this, uint16_t( I - 0x0000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x1000, &CMapperBase::ChrBankRead_1000, this, 0 );
 			// CHR bank 1.
-			for ( uint32_t I = 0x1000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapper075::ChrBank1Read_1000, this, uint16_t( I - 0x1000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x1000, 0x2000, &CMapper075::ChrBank1Read_1000, this, 0 );
 
 			// Select banks.
-			for ( uint32_t I = 0x8000; I < 0x9000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper075::SelectBank8000_8FFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0x9000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper075::SelectBank9000_9FFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xA000; I < 0xB000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper075::SelectBankA000_AFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xC000; I < 0xD000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper075::SelectBankC000_CFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xE000; I < 0xF000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper075::SelectBankE000_EFFF, this, 0 );	// Treated as ROM.
-			}
-			for ( uint32_t I = 0xF000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper075::SelectBankF000_FFFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x8000, 0x9000, &CMapper075::SelectBank8000_8FFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0x9000, 0xA000, &CMapper075::SelectBank9000_9FFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xA000, 0xB000, &CMapper075::SelectBankA000_AFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xC000, 0xD000, &CMapper075::SelectBankC000_CFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xE000, 0xF000, &CMapper075::SelectBankE000_EFFF, this, 0, 0 );	// Treated as ROM.
+			_pbCpuBus->SetWriteRange( 0xF000, 0x10000, &CMapper075::SelectBankF000_FFFF, this, 0, 0 );	// Treated as ROM.
 
 
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8PgmBank1 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8PgmBank2 ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBank1 ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8PgmBank1 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8PgmBank2 ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBank1 ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -176,7 +180,7 @@ namespace lsn {
 		 */
 		static void LSN_FASTCALL						SelectBank8000_8FFF( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t _ui8Val ) {
 			CMapper075 * pmThis = reinterpret_cast<CMapper075 *>(_pvParm0);
-			pmThis->m_ui8PgmBank = (_ui8Val & LSN_M_MASK) % (pmThis->m_prRom->vPrgRom.size() / 0x2000);
+			pmThis->SetPgmBank<0, 0x2000>( _ui8Val & LSN_M_MASK );
 		}
 
 		/**
@@ -234,10 +238,9 @@ namespace lsn {
 					break;
 				}
 			}
-			pmThis->m_ui8ChrBank = (pmThis->m_ui8ChrBank & 0b01111) | ((_ui8Val & 0b00010) << 3);
+			pmThis->SetChrBank<0, 0x1000>( (pmThis->m_ui8ChrBank & 0b01111) | ((_ui8Val & 0b00010) << 3) );
 			pmThis->m_ui8ChrBank1 = (pmThis->m_ui8ChrBank1 & 0b01111) | ((_ui8Val & 0b00100) << 2);
 
-			pmThis->m_ui8ChrBank = (pmThis->m_ui8ChrBank) % (pmThis->m_prRom->vChrRom.size() / 0x1000);
 			pmThis->m_ui8ChrBank1 = (pmThis->m_ui8ChrBank1) % (pmThis->m_prRom->vChrRom.size() / 0x1000);
 		}
 
@@ -251,8 +254,7 @@ namespace lsn {
 		 */
 		static void LSN_FASTCALL						SelectBankE000_EFFF( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t _ui8Val ) {
 			CMapper075 * pmThis = reinterpret_cast<CMapper075 *>(_pvParm0);
-			pmThis->m_ui8ChrBank = (pmThis->m_ui8ChrBank & 0b10000) | (_ui8Val & 0b01111);
-			pmThis->m_ui8ChrBank = (pmThis->m_ui8ChrBank) % (pmThis->m_prRom->vChrRom.size() / 0x1000);
+			pmThis->SetChrBank<0, 0x1000>( (pmThis->m_ui8ChrBank & 0b10000) | (_ui8Val & 0b01111) );
 		}
 
 		/**
@@ -55,49 +55,25 @@ namespace lsn {
 			// ================
 			// Set the reads of the fixed bank at the end.		
 			m_stFixedOffset = std::max<size_t>( m_prRom->vPrgRom.size(), 8 * 1024 ) - 8 * 1024;
-			for ( uint32_t I = 0xE000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead_Fixed, this, uint16_t( I - 0xE000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0xE000, 0x10000, &CMapperBase::PgmBankRead_Fixed, this, 0 );
 			
 
 			// ================
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<0, 8 * 1024>, this, uint16_t( I - 0x8000 ) );
-			}
-			for ( uint32_t I = 0xA000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<1, 8 * 1024>, this, uint16_t( I - 0xA000 ) );
-			}
-			for ( uint32_t I = 0xC000; I < 0xE000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<2, 8 * 1024>, this, uint16_t( I - 0xC000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xA000, &CMapperBase::PgmBankRead<0, 8 * 1024>, this, 0 );
+			_pbCpuBus->SetReadRange( 0xA000, 0xC000, &CMapperBase::PgmBankRead<1, 8 * 1024>, this, 0 );
+			_pbCpuBus->SetReadRange( 0xC000, 0xE000, &CMapperBase::PgmBankRead<2, 8 * 1024>, this, 0 );
 			// PPU.
-			for ( uint32_t I = 0x0000; I < 0x0400; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<0, 1 * 1024>, this, uint16_t( I - 0x0000 ) );
-			}
-			for ( uint32_t I = 0x0400; I < 0x0800; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<1, 1 * 1024>, this, uint16_t( I - 0x0400 ) );
-			}
-			for ( uint32_t I = 0x0800; I < 0x0C00; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<2, 1 * 1024>, this, uint16_t( I - 0x0800 ) );
-			}
-			for ( uint32_t I = 0x0C00; I < 0x1000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<3, 1 * 1024>, this, uint16_t( I - 0x0C00 ) );
-			}
-			for ( uint32_t I = 0x1000; I < 0x1400; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<4, 1 * 1024>, this, uint16_t( I - 0x1000 ) );
-			}
-			for ( uint32_t I = 0x1400; I < 0x1800; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<5, 1 * 1024>, this, uint16_t( I - 0x1400 ) );
-			}
-			for ( uint32_t I = 0x1800; I < 0x1C00; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<6, 1 * 1024>, this, uint16_t( I - 0x1800 ) );
-			}
-			for ( uint32_t I = 0x1C00; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<7, 1 * 1024>, this, uint16_t( I - 0x1C00 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x0400, &CMapperBase::ChrBankRead<0, 1 * 1024>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x0400, 0x0800, &CMapperBase::ChrBankRead<1, 1 * 1024>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x0800, 0x0C00, &CMapperBase::ChrBankRead<2, 1 * 1024>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x0C00, 0x1000, &CMapperBase::ChrBankRead<3, 1 * 1024>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1000, 0x1400, &CMapperBase::ChrBankRead<4, 1 * 1024>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1400, 0x1800, &CMapperBase::ChrBankRead<5, 1 * 1024>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1800, 0x1C00, &CMapperBase::ChrBankRead<6, 1 * 1024>, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1C00, 0x2000, &CMapperBase::ChrBankRead<7, 1 * 1024>, this, 0 );
 			// RAM.
 			for ( uint32_t I = 0x7F00; I < 0x8000; ++I ) {
 				uint16_t ui16Final = uint16_t( I - 0x7F00 );
@@ -146,6 +122,32 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteBytes( m_ui8ChrRam, sizeof( m_ui8ChrRam ) ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bRamAllowed ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_ui8ChrRam, sizeof( m_ui8ChrRam ) ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bRamAllowed ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
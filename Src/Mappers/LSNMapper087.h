@@ -38,7 +38,7 @@ namespace lsn {
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase );
 			m_ui8PgmBank = 0;
-			m_ui8ChrBank = uint8_t( m_prRom->vChrRom.size() / (8 * 1024) - 1 );
+			SetChrBank<0, 8 * 1024>( -1 );
 		}
 
 		/**
@@ -50,18 +50,12 @@ namespace lsn {
 		virtual void									ApplyMap( CCpuBus * _pbCpuBus, CPpuBus * _pbPpuBus ) {
 			CMapperBase::ApplyMap( _pbCpuBus, _pbPpuBus );
 
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::StdMapperCpuRead, this, uint16_t( (I - 0x8000) % m_prRom->vPrgRom.size() ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::StdMapperCpuRead, this, 0, 1, uint32_t( m_prRom->vPrgRom.size() ) );
 			// CHR ROM.
-			for ( uint32_t I = 0x0000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead_2000, this, uint16_t( I - 0x0000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x2000, &CMapperBase::ChrBankRead_2000, this, 0 );
 
 			// Bank select.
-			for ( uint32_t I = 0x6000; I < 0x8000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper087::SelectBank6000_7FFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x6000, 0x8000, &CMapper087::SelectBank6000_7FFF, this, 0, 0 );	// Treated as ROM.
 		}
 
 
@@ -80,8 +74,7 @@ namespace lsn {
 		 */
 		static void LSN_FASTCALL						SelectBank6000_7FFF( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t _ui8Val ) {
 			CMapper087 * pmThis = reinterpret_cast<CMapper087 *>(_pvParm0);
-			pmThis->m_ui8ChrBank = (((_ui8Val & 0b01) << 1) & ((_ui8Val & 0b10) >> 1))
-				% (pmThis->m_prRom->vChrRom.size() / (8 * 1024));
+			pmThis->SetChrBank<0, 8 * 1024>( ((_ui8Val & 0b01) << 1) & ((_ui8Val & 0b10) >> 1) );
 		}
 	};
 
@@ -67,12 +67,8 @@ namespace lsn {
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0xA000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, uint16_t( I - 0x8000 ) );
-			}
-			for ( uint32_t I = 0xA000; I < 0xC000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<1, PgmBankSize()>, this, uint16_t( I - 0xA000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0xA000, &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, 0 );
+			_pbCpuBus->SetReadRange( 0xA000, 0xC000, &CMapperBase::PgmBankRead<1, PgmBankSize()>, this, 0 );
 			// PPU.
 #define LSN_CHR_BANK( X )																												\
 	for ( uint32_t I = (X) * 0x0400; I < ((X) + 1) * 0x0400; ++I ) {																	\
@@ -108,6 +104,30 @@ namespace lsn {
 			ApplyControllableMirrorMap( _pbPpuBus );
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8BankSelect ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8BankSelect ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
@@ -71,14 +71,10 @@ namespace lsn {
 			// SWAPPABLE BANKS
 			// ================
 			// CPU.
-			for ( uint32_t I = 0x8000; I < 0x10000; ++I ) {
-				_pbCpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, uint16_t( I - 0x8000 ) );
-			}
+			_pbCpuBus->SetReadRange( 0x8000, 0x10000, &CMapperBase::PgmBankRead<0, PgmBankSize()>, this, 0 );
 			if ( m_prRom->vChrRom.size() ) {
 				// PPU.
-				for ( uint32_t I = 0x0000; I < 0x2000; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead<0, ChrBankSize()>, this, uint16_t( I - 0x0000 ) );
-				}
+				_pbPpuBus->SetReadRange( 0x0000, 0x2000, &CMapperBase::ChrBankRead<0, ChrBankSize()>, this, 0 );
 			}
 
 
@@ -108,6 +104,38 @@ namespace lsn {
 			}
 		}
 
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Rrr ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Ppp ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8S ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bIncrMode ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bInvMode ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Rrr ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Ppp ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8S ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bIncrMode ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bInvMode ) ) { return false; }
+			return true;
+		}
+
 
 	protected :
 		// == Members.
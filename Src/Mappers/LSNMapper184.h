@@ -38,7 +38,8 @@ namespace lsn {
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase ) {
 			CMapperBase::InitWithRom( _rRom, _pcbCpuBase );
 			//m_ui8PgmBank = 0;
-			m_ui8ChrBank1 = m_ui8ChrBank = 0;
+			m_ui8ChrBank1 = 0;
+			SetChrBank<0, 4 * 1024>( 0 );
 		}
 
 		/**
@@ -51,17 +52,35 @@ namespace lsn {
 			CMapperBase::ApplyMap( _pbCpuBus, _pbPpuBus );
 
 			// Set the reads of the selectable bank.
-			for ( uint32_t I = 0x0000; I < 0x1000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapperBase::ChrBankRead_1000, this, uint16_t( I - 0x0000 ) );
-			}
-			for ( uint32_t I = 0x1000; I < 0x2000; ++I ) {
-				_pbPpuBus->SetReadFunc( uint16_t( I ), &CMapper184::ChrBank1Read_1000, this, uint16_t( I - 0x1000 ) );
-			}
+			_pbPpuBus->SetReadRange( 0x0000, 0x1000, &CMapperBase::ChrBankRead_1000, this, 0 );
+			_pbPpuBus->SetReadRange( 0x1000, 0x2000, &CMapper184::ChrBank1Read_1000, this, 0 );
 
 			// Writes to the whole area are used to select a bank.
-			for ( uint32_t I = 0x6000; I < 0x8000; ++I ) {
-				_pbCpuBus->SetWriteFunc( uint16_t( I ), &CMapper184::SelectBank6000_7FFF, this, 0 );	// Treated as ROM.
-			}
+			_pbCpuBus->SetWriteRange( 0x6000, 0x8000, &CMapper184::SelectBank6000_7FFF, this, 0, 0 );	// Treated as ROM.
+		}
+
+		/**
+		 * Writes the mapper state to a stream.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !CMapperBase::SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ChrBank1 ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !CMapperBase::LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ChrBank1 ) ) { return false; }
+			return true;
 		}
 
 
@@ -96,7 +115,7 @@ namespace lsn {
 		static void LSN_FASTCALL						SelectBank6000_7FFF( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * /*_pui8Data*/, uint8_t _ui8Val ) {
 			CMapper184 * pmThis = reinterpret_cast<CMapper184 *>(_pvParm0);
 			pmThis->m_ui8ChrBank1 = ((_ui8Val & 0b01110000) >> 4) % (pmThis->m_prRom->vChrRom.size() / (4 * 1024));
-			pmThis->m_ui8ChrBank = (_ui8Val & 0b00000111) % (pmThis->m_prRom->vChrRom.size() / (4 * 1024));
+			pmThis->SetChrBank<0, 4 * 1024>( _ui8Val & 0b00000111 );
 			// The most significant bit of H is always set in hardware. (i.e. its range is 4 to 7)
 			pmThis->m_ui8ChrBank1 |= 0x100;
 		}
@@ -13,6 +13,7 @@
 #include "../Bus/LSNBus.h"
 #include "../Cpu/LSNCpuBase.h"
 #include "../Roms/LSNRom.h"
+#include "../System/LSNEventQueue.h"
 
 namespace lsn {
 
@@ -27,6 +28,7 @@ namespace lsn {
 		CMapperBase() :
 			m_prRom( nullptr ),
 			m_pcbCpu( nullptr ),
+			m_peqEvents( nullptr ),
 			m_stFixedOffset( 0 ),
 			m_mmMirror( LSN_MM_HORIZONTAL ),
 			m_ui8PgmBank( m_ui8PgmBanks[0] ),
@@ -46,6 +48,11 @@ namespace lsn {
 		virtual void									InitWithRom( LSN_ROM &_rRom, CCpuBase * _pcbCpuBase ) {
 			m_prRom = &_rRom;
 			m_pcbCpu = _pcbCpuBase;
+			for ( auto I = LSN_ELEMENTS( m_ui32PgmBankSizes ); I--; ) {
+				m_ui32PgmBankSizes[I] = 0;
+				m_ui32ChrBankSizes[I] = 0;
+			}
+			UpdateBankPtrs();
 		}
 
 		/**
@@ -57,9 +64,11 @@ namespace lsn {
 		virtual void									ApplyMap( CCpuBus * /*_pbCpuBus*/, CPpuBus * _pbPpuBus ) {
 			if ( m_prRom->vChrRom.size() == 0 ) {
 				// RAM.
-				for ( uint32_t I = 0x0000; I < 0x2000; ++I ) {
-					_pbPpuBus->SetReadFunc( uint16_t( I ), &DefaultChrRamRead, this, uint16_t( I - 0x0000 ) );
-					_pbPpuBus->SetWriteFunc( uint16_t( I ), &DefaultChrRamWrite, this, uint16_t( I - 0x0000 ) );
+				_pbPpuBus->SetReadRange( 0x0000, 0x2000, &DefaultChrRamRead, this, 0x0000 );
+				_pbPpuBus->SetWriteRange( 0x0000, 0x2000, &DefaultChrRamWrite, this, 0x0000 );
+				// Reading CHR RAM has no side effects, so the PPU reads it directly.  Writes still go through DefaultChrRamWrite().
+				for ( uint32_t I = 0x0000; I < 0x2000; I += CPpuBus::LSN_BP_PAGE_SIZE ) {
+					_pbPpuBus->SetDirectReadPage( uint16_t( I >> CPpuBus::LSN_BP_PAGE_SHIFT ), &m_ui8DefaultChrRam[I] );
 				}
 			}
 			else {
@@ -68,10 +77,70 @@ namespace lsn {
 		}
 
 		/**
-		 * Ticks with the CPU.
+		 * Ticks with the CPU.  Only called if TicksWithCpu() returns true.
 		 */
 		virtual void									Tick() {}
 
+		/**
+		 * Determines whether Tick() should be called on every CPU cycle.  Mappers with cycle counters should prefer scheduling events on
+		 *	the event queue (see ScheduleCpuEvent()) over being ticked.
+		 *
+		 * \return Returns true if Tick() should be called on every CPU cycle.
+		 */
+		virtual bool									TicksWithCpu() const { return false; }
+
+		/**
+		 * Writes the mapper state to a stream.  Mappers with additional registers or RAM override this and call the base version first.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !_sStream.WriteBytes( m_ui8PgmBanks, sizeof( m_ui8PgmBanks ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( m_ui8ChrBanks, sizeof( m_ui8ChrBanks ) ) ) { return false; }
+			for ( size_t I = 0; I < LSN_ELEMENTS( m_ui32PgmBankSizes ); ++I ) {
+				if ( !_sStream.WriteUi32( m_ui32PgmBankSizes[I] ) ) { return false; }
+				if ( !_sStream.WriteUi32( m_ui32ChrBankSizes[I] ) ) { return false; }
+			}
+			if ( !_sStream.WriteBytes( m_ui8DefaultChrRam, sizeof( m_ui8DefaultChrRam ) ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_stFixedOffset ) ) { return false; }
+			if ( !_sStream.WriteUi8( uint8_t( m_mmMirror ) ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the mapper state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			uint64_t ui64FixedOffset;
+			uint8_t ui8Mirror;
+			if ( !_sStream.ReadBytes( m_ui8PgmBanks, sizeof( m_ui8PgmBanks ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_ui8ChrBanks, sizeof( m_ui8ChrBanks ) ) ) { return false; }
+			for ( size_t I = 0; I < LSN_ELEMENTS( m_ui32PgmBankSizes ); ++I ) {
+				if ( !_sStream.ReadUi32( m_ui32PgmBankSizes[I] ) ) { return false; }
+				if ( !_sStream.ReadUi32( m_ui32ChrBankSizes[I] ) ) { return false; }
+			}
+			if ( !_sStream.ReadBytes( m_ui8DefaultChrRam, sizeof( m_ui8DefaultChrRam ) ) ) { return false; }
+			if ( !_sStream.ReadUi64( ui64FixedOffset ) ) { return false; }
+			if ( !_sStream.ReadUi8( ui8Mirror ) ) { return false; }
+			m_stFixedOffset = size_t( ui64FixedOffset );
+			m_mmMirror = static_cast<LSN_MIRROR_MODE>(ui8Mirror);
+			UpdateBankPtrs();
+			return true;
+		}
+
+		/**
+		 * Sets the system event queue, which mappers can use to schedule IRQ's and other timed events.
+		 *
+		 * \param _peqEvents A pointer to the event queue.
+		 */
+		void											SetEventQueue( CEventQueue * _peqEvents ) {
+			m_peqEvents = _peqEvents;
+		}
+
 		/**
 		 * Applies a mirroring mode to a PPU bus.
 		 *
@@ -84,15 +153,18 @@ namespace lsn {
 		static void										ApplyMirroring( uint16_t _ui16Mirror, CPpuBus * _pbPpuBus, void * _pvParm0,
 			uint16_t _ui16NametableStart = LSN_PPU_NAMETABLES,
 			uint16_t _ui16NametableEnd = LSN_PPU_PALETTE_MEMORY ) {
-			for ( uint32_t I = _ui16NametableStart; I < _ui16NametableEnd; ++I ) {
+			// Every mirroring mode maps whole screens, so each screen-sized block is mapped as 1 range.
+			for ( uint32_t I = _ui16NametableStart; I < _ui16NametableEnd; ) {
 				uint16_t ui16Root = ((I - _ui16NametableStart) % LSN_PPU_NAMETABLES_SIZE);	// Mirror The $3000-$3EFF range down to $2000-$2FFF.
+				uint32_t ui32End = std::min<uint32_t>( I + (LSN_PPU_NAMETABLES_SCREEN - (ui16Root % LSN_PPU_NAMETABLES_SCREEN)), _ui16NametableEnd );
 				uint16_t ui16Final = MirrorAddress( ui16Root, static_cast<LSN_MIRROR_MODE>(_ui16Mirror) );
 				// MirrorAddress() is built for speed since it is used for run-time mirroring, so it
 				//	always sets LSN_PPU_NAMETABLES.
 				ui16Final &= ~LSN_PPU_NAMETABLES;
 				ui16Final += _ui16NametableStart;
-				_pbPpuBus->SetReadFunc( uint16_t( I ), CPpuBus::StdRead, _pvParm0, ui16Final );
-				_pbPpuBus->SetWriteFunc( uint16_t( I ), CPpuBus::StdWrite, _pvParm0, ui16Final );
+				_pbPpuBus->SetReadRange( I, ui32End, CPpuBus::StdRead, _pvParm0, ui16Final );
+				_pbPpuBus->SetWriteRange( I, ui32End, CPpuBus::StdWrite, _pvParm0, ui16Final );
+				I = ui32End;
 			}
 		}
 
@@ -103,12 +175,22 @@ namespace lsn {
 		uint8_t											m_ui8PgmBanks[32];
 		/** The CHR ROM banks. */
 		uint8_t											m_ui8ChrBanks[32];
+		/** The start of each selected PGM bank, recomputed whenever m_ui8PgmBanks is set through SetPgmBank(). */
+		const uint8_t *									m_pui8PgmBankPtrs[32];
+		/** The start of each selected CHR ROM bank, recomputed whenever m_ui8ChrBanks is set through SetChrBank(). */
+		const uint8_t *									m_pui8ChrBankPtrs[32];
+		/** The size of each PGM bank, as last passed to SetPgmBank(). */
+		uint32_t										m_ui32PgmBankSizes[32];
+		/** The size of each CHR ROM bank, as last passed to SetChrBank(). */
+		uint32_t										m_ui32ChrBankSizes[32];
 		/** If the ROM CHR size is 0, it uses CHR RAM instead. */
 		uint8_t											m_ui8DefaultChrRam[8*1024];
 		/** The ROM used to initialize this mapper. */
 		LSN_ROM *										m_prRom;
 		/** The CPU, for reading information such as cycle counts and for sending IRQs. */
 		CCpuBase *										m_pcbCpu;
+		/** The system event queue. */
+		CEventQueue *									m_peqEvents;
 		/** The offset of the fixed bank. */
 		size_t											m_stFixedOffset;
 		/** The PGM bank. */
@@ -120,18 +202,30 @@ namespace lsn {
 
 
 		// == Functions.
+		/**
+		 * Schedules an event to run a given number of CPU cycles after the current CPU cycle.  Any previously scheduled event with the same
+		 *	function and parameter is replaced.  Intended for cycle-counter IRQ's, which would otherwise need to be ticked on every CPU cycle.
+		 *
+		 * \param _ui64CpuCycles The number of CPU cycles from the current CPU cycle at which to run the event.
+		 * \param _pfFunc The function to call.
+		 * \param _pvParm The parameter to pass to _pfFunc.
+		 * \return Returns true if the event was scheduled.
+		 */
+		bool											ScheduleCpuEvent( uint64_t _ui64CpuCycles, CEventQueue::PfEventFunc _pfFunc, void * _pvParm ) {
+			if ( !m_peqEvents || !m_pcbCpu ) { return false; }
+			m_peqEvents->Cancel( _pfFunc, _pvParm );
+			return m_peqEvents->Schedule( m_peqEvents->CpuCycleToMaster( m_pcbCpu->GetCycleCount() + _ui64CpuCycles ), _pfFunc, _pvParm );
+		}
+
 		/**
 		 * Applies a controllable mirroring map.
 		 *
 		 * \param _pbPpuBus A pointer to the PPU bus.
 		 */
 		void											ApplyControllableMirrorMap( CPpuBus * _pbPpuBus ) {
-			for ( uint32_t I = LSN_PPU_NAMETABLES; I < LSN_PPU_PALETTE_MEMORY; ++I ) {
-				uint16_t ui16Root = ((I - LSN_PPU_NAMETABLES) % LSN_PPU_NAMETABLES_SIZE);	// Mirror The $3000-$3EFF range down to $2000-$2FFF.
-				//ui16Root += LSN_PPU_NAMETABLES;
-				_pbPpuBus->SetReadFunc( uint16_t( I ), CMapperBase::Read_ControllableMirror, this, ui16Root );
-				_pbPpuBus->SetWriteFunc( uint16_t( I ), CMapperBase::Write_ControllableMirror, this, ui16Root );
-			}
+			// Mirror The $3000-$3EFF range down to $2000-$2FFF.
+			_pbPpuBus->SetReadRange( LSN_PPU_NAMETABLES, LSN_PPU_PALETTE_MEMORY, CMapperBase::Read_ControllableMirror, this, 0, 1, LSN_PPU_NAMETABLES_SIZE );
+			_pbPpuBus->SetWriteRange( LSN_PPU_NAMETABLES, LSN_PPU_PALETTE_MEMORY, CMapperBase::Write_ControllableMirror, this, 0, 1, LSN_PPU_NAMETABLES_SIZE );
 		}
 
 		/**
@@ -142,12 +236,10 @@ namespace lsn {
 		void											ApplyStdChrRom( CPpuBus * _pbPpuBus ) {
 			if ( m_prRom && m_prRom->vChrRom.size() ) {
 				m_ui8ChrBank = 0;
-				for ( uint32_t I = LSN_PPU_PATTERN_TABLES; I < LSN_PPU_NAMETABLES; ++I ) {
-					uint16_t ui16MappedAddr = ((I - LSN_PPU_PATTERN_TABLES) % LSN_PPU_PATTERN_TABLE_SIZE);
-					ui16MappedAddr %= m_prRom->vChrRom.size();
-					_pbPpuBus->SetReadFunc( uint16_t( I ), CMapperBase::ChrBankRead_2000, this, ui16MappedAddr | LSN_PPU_PATTERN_TABLES );
-					_pbPpuBus->SetWriteFunc( uint16_t( I ), CPpuBus::NoWrite, this, ui16MappedAddr | LSN_PPU_PATTERN_TABLES );
-				}
+				// The pattern tables are $0000-$1FFF, so the CHR ROM simply repeats every min( size, $2000 ) bytes.
+				uint32_t ui32Mirror = uint32_t( std::min<size_t>( m_prRom->vChrRom.size(), LSN_PPU_PATTERN_TABLE_SIZE ) );
+				_pbPpuBus->SetReadRange( LSN_PPU_PATTERN_TABLES, LSN_PPU_NAMETABLES, CMapperBase::ChrBankRead_2000, this, LSN_PPU_PATTERN_TABLES, 1, ui32Mirror );
+				_pbPpuBus->SetWriteRange( LSN_PPU_PATTERN_TABLES, LSN_PPU_NAMETABLES, CPpuBus::NoWrite, this, LSN_PPU_PATTERN_TABLES, 1, ui32Mirror );
 			}
 		}
 
@@ -179,7 +271,8 @@ namespace lsn {
 		}
 
 		/**
-		 * Reads from PGM ROM using m_ui8PgmBanks[_uReg] to select a bank among _uSize-sized banks.
+		 * Reads from PGM ROM using m_ui8PgmBanks[_uReg] to select a bank among _uSize-sized banks.  The bank's address is computed by
+		 *	SetPgmBank(), so this is a single load.
 		 *
 		 * \param _pvParm0 A data value assigned to this address.
 		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to read from _pui8Data.  It is not constant because sometimes reads do modify status registers etc.
@@ -191,11 +284,12 @@ namespace lsn {
 		template <unsigned _uReg, unsigned _uSize>
 		static void LSN_FASTCALL						PgmBankRead( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * /*_pui8Data*/, uint8_t &_ui8Ret ) {
 			CMapperBase * pmThis = reinterpret_cast<CMapperBase *>(_pvParm0);
-			_ui8Ret = pmThis->m_prRom->vPrgRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8PgmBanks[_uReg])*_uSize)];
+			_ui8Ret = pmThis->m_pui8PgmBankPtrs[_uReg][_ui16Parm1];
 		}
 
 		/**
-		 * Reads from CHR ROM using m_ui8PgmBanks[_uReg] to select a bank among _uSize-sized banks.
+		 * Reads from CHR ROM using m_ui8ChrBanks[_uReg] to select a bank among _uSize-sized banks.  The bank's address is computed by
+		 *	SetChrBank(), so this is a single load.
 		 *
 		 * \param _pvParm0 A data value assigned to this address.
 		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to read from _pui8Data.  It is not constant because sometimes reads do modify status registers etc.
@@ -207,7 +301,7 @@ namespace lsn {
 		template <unsigned _uReg, unsigned _uSize>
 		static void LSN_FASTCALL						ChrBankRead( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * /*_pui8Data*/, uint8_t &_ui8Ret ) {
 			CMapperBase * pmThis = reinterpret_cast<CMapperBase *>(_pvParm0);
-			_ui8Ret = pmThis->m_prRom->vChrRom.data()[size_t(_ui16Parm1)+(size_t(pmThis->m_ui8ChrBanks[_uReg])*_uSize)];
+			_ui8Ret = pmThis->m_pui8ChrBankPtrs[_uReg][_ui16Parm1];
 		}
 
 		/**
@@ -233,6 +327,8 @@ namespace lsn {
 			else {
 				m_ui8PgmBanks[_uReg] = 0;
 			}
+			m_ui32PgmBankSizes[_uReg] = _uSize;
+			UpdatePgmBankPtr( _uReg );
 		}
 
 		/**
@@ -258,6 +354,8 @@ namespace lsn {
 			else {
 				m_ui8PgmBanks[_ui16Reg] = 0;
 			}
+			m_ui32PgmBankSizes[_ui16Reg] = _uSize;
+			UpdatePgmBankPtr( _ui16Reg );
 		}
 
 		/**
@@ -309,6 +407,8 @@ namespace lsn {
 			else {
 				m_ui8ChrBanks[_uReg] = 0;
 			}
+			m_ui32ChrBankSizes[_uReg] = _uSize;
+			UpdateChrBankPtr( _uReg );
 		}
 
 		/**
@@ -334,6 +434,8 @@ namespace lsn {
 			else {
 				m_ui8ChrBanks[_ui16Reg] = 0;
 			}
+			m_ui32ChrBankSizes[_ui16Reg] = _uSize;
+			UpdateChrBankPtr( _ui16Reg );
 		}
 
 		/**
@@ -362,6 +464,34 @@ namespace lsn {
 			SetChrBank<_uSize>( _ui16Reg + 1, _i16Bank + 1 );
 		}
 
+		/**
+		 * Recomputes the address of a PGM bank from its register and bank size.
+		 *
+		 * \param _stReg The register index.
+		 */
+		inline void										UpdatePgmBankPtr( size_t _stReg ) {
+			m_pui8PgmBankPtrs[_stReg] = m_prRom ? m_prRom->vPrgRom.data() + size_t( m_ui8PgmBanks[_stReg] ) * m_ui32PgmBankSizes[_stReg] : nullptr;
+		}
+
+		/**
+		 * Recomputes the address of a CHR ROM bank from its register and bank size.
+		 *
+		 * \param _stReg The register index.
+		 */
+		inline void										UpdateChrBankPtr( size_t _stReg ) {
+			m_pui8ChrBankPtrs[_stReg] = m_prRom ? m_prRom->vChrRom.data() + size_t( m_ui8ChrBanks[_stReg] ) * m_ui32ChrBankSizes[_stReg] : nullptr;
+		}
+
+		/**
+		 * Recomputes the addresses of all PGM and CHR ROM banks.  Called after the bank registers are restored from a save state.
+		 */
+		void											UpdateBankPtrs() {
+			for ( auto I = LSN_ELEMENTS( m_pui8PgmBankPtrs ); I--; ) {
+				UpdatePgmBankPtr( I );
+				UpdateChrBankPtr( I );
+			}
+		}
+
 		/**
 		 * Sanitizes all bank registers without initializing their values.
 		 */
@@ -547,7 +677,9 @@ namespace lsn {
 		 */
 		static void LSN_FASTCALL						Write_ControllableMirror( void * _pvParm0, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t _ui8Val ) {
 			CMapperBase * pmThis = reinterpret_cast<CMapperBase *>(_pvParm0);
-			_pui8Data[MirrorAddress( _ui16Parm1, pmThis->m_mmMirror )] = _ui8Val;
+			const uint16_t ui16Addr = MirrorAddress( _ui16Parm1, pmThis->m_mmMirror );
+			_pui8Data[ui16Addr] = _ui8Val;
+			CPpuBus::MarkDirty( _pui8Data, ui16Addr );
 		}
 
 	};
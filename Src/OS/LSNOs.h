@@ -9,7 +9,12 @@
 #pragma once
 
 #include "LSNWindows.h"
+#include "LSNPosix.h"
 
 #ifndef LSN_FASTCALL
 #define LSN_FASTCALL
-#endif	// LSN_FASTCALL
\ No newline at end of file
+#endif	// LSN_FASTCALL
+
+#ifndef LSN_NO_OPTIMIZE
+#define LSN_NO_OPTIMIZE
+#endif	// LSN_NO_OPTIMIZE
\ No newline at end of file
@@ -0,0 +1,93 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Stand-ins for the MSVC keywords and intrinsics used by the emulator core, for GCC and Clang on non-Windows hosts.
+ */
+
+#pragma once
+
+#ifndef LSN_WINDOWS
+
+#include <cstdint>
+#include <cstdio>
+
+#if defined( __x86_64__ ) || defined( __i386__ )
+#include <x86intrin.h>
+#endif	// #if defined( __x86_64__ ) || defined( __i386__ )
+
+#ifndef __forceinline
+#define __forceinline						inline
+#endif	// #ifndef __forceinline
+
+// Generated straight-line tables (the PPU cycle tables) make GCC's dead-store and alias passes quadratic; they run once and need no optimization.
+#if defined( __clang__ )
+#define LSN_NO_OPTIMIZE						__attribute__( (optnone) )
+#elif defined( __GNUC__ )
+#define LSN_NO_OPTIMIZE						__attribute__( (optimize( "O0" )) )
+#endif	// #if defined( __clang__ )
+
+/**
+ * Multiplies 2 64-bit unsigned integers into a 128-bit product.
+ *
+ * \param _ui64Multiplier The first factor.
+ * \param _ui64Multiplicand The second factor.
+ * \param _pui64ProductHi Holds the high 64 bits of the product.
+ * \return Returns the low 64 bits of the product.
+ */
+inline uint64_t _umul128( uint64_t _ui64Multiplier, uint64_t _ui64Multiplicand, uint64_t * _pui64ProductHi ) {
+	unsigned __int128 ui128Product = static_cast<unsigned __int128>(_ui64Multiplier) * _ui64Multiplicand;
+	(*_pui64ProductHi) = static_cast<uint64_t>(ui128Product >> 64);
+	return static_cast<uint64_t>(ui128Product);
+}
+
+/**
+ * Divides a 128-bit unsigned integer by a 64-bit unsigned integer.  The quotient must fit in 64 bits.
+ *
+ * \param _ui64HighDividend The high 64 bits of the dividend.
+ * \param _ui64LowDividend The low 64 bits of the dividend.
+ * \param _ui64Divisor The divisor.
+ * \param _pui64Remainder If not nullptr, holds the remainder.
+ * \return Returns the quotient.
+ */
+inline uint64_t _udiv128( uint64_t _ui64HighDividend, uint64_t _ui64LowDividend, uint64_t _ui64Divisor, uint64_t * _pui64Remainder ) {
+	unsigned __int128 ui128Dividend = (static_cast<unsigned __int128>(_ui64HighDividend) << 64) | _ui64LowDividend;
+	if ( _pui64Remainder ) { (*_pui64Remainder) = static_cast<uint64_t>(ui128Dividend % _ui64Divisor); }
+	return static_cast<uint64_t>(ui128Dividend / _ui64Divisor);
+}
+
+/**
+ * Rotates an 8-bit value right.
+ *
+ * \param _ui8Value The value to rotate.
+ * \param _ui8Shift The number of bits by which to rotate.
+ * \return Returns the rotated value.
+ */
+inline uint8_t _rotr8( uint8_t _ui8Value, uint8_t _ui8Shift ) {
+	_ui8Shift &= 7;
+	return static_cast<uint8_t>((_ui8Value >> _ui8Shift) | (_ui8Value << ((8 - _ui8Shift) & 7)));
+}
+
+/**
+ * Rotates an 8-bit value left.
+ *
+ * \param _ui8Value The value to rotate.
+ * \param _ui8Shift The number of bits by which to rotate.
+ * \return Returns the rotated value.
+ */
+inline uint8_t _rotl8( uint8_t _ui8Value, uint8_t _ui8Shift ) {
+	_ui8Shift &= 7;
+	return static_cast<uint8_t>((_ui8Value << _ui8Shift) | (_ui8Value >> ((8 - _ui8Shift) & 7)));
+}
+
+/**
+ * Writes a debug string to stderr.
+ *
+ * \param _pcString The string to write.
+ */
+inline void OutputDebugStringA( const char * _pcString ) {
+	std::fputs( _pcString, stderr );
+}
+
+#endif	// #ifndef LSN_WINDOWS
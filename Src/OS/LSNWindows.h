@@ -30,12 +30,14 @@
 #define _WIN32_WINNT_WIN10                  0x0A00 // Windows 10  
 */
 
+#if defined( WIN32 ) || defined( _WIN32 ) || defined( _WIN64 )
 #define _WIN32_IE							0x0601
 #define WINVER								0x0601
 #define _WIN32_WINNT						0x0601
 #define WIN32_LEAN_AND_MEAN
 #define NOMINMAX
 #include <Windows.h>
+#endif	// #if defined( WIN32 ) || defined( _WIN32 ) || defined( _WIN64 )
 
 #endif  // #ifdef LSN_USE_WINDOWS
 
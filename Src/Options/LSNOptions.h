@@ -26,6 +26,10 @@ namespace lsn {
 		LSN_INPUT_OPTIONS					ioGlobalInputOptions;
 		/** This games input options. */
 		LSN_INPUT_OPTIONS					ioThisGameInputOptions;
+		/** The number of frames to run ahead of the emulated frame.  0 disables run-ahead. */
+		uint32_t							ui32RunAheadFrames = 0;
+		/** If true, run-ahead frames are run on a second system instead of rolling the main system back. */
+		bool								bRunAheadSecondInstance = false;
 	};
 
 }	// namespace lsn
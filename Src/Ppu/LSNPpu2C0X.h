@@ -20,7 +20,9 @@
 #include "../Utilities/LSNDelayedValue.h"
 
 #include <cmath>
+#ifdef LSN_WINDOWS
 #include <intrin.h>
+#endif	// #ifdef LSN_WINDOWS
 
 #define LSN_CTRL_NAMETABLE_X( OBJ )						(OBJ.s.ui8Nametable & 0x01)
 #define LSN_CTRL_NAMETABLE_Y( OBJ )						((OBJ.s.ui8Nametable >> 1) & 0x01)
@@ -89,9 +91,7 @@ namespace lsn {
 #ifdef LSN_GEN_PPU
 			GenerateCycleFuncs();
 #else
-#include "LSNCreateCycleTableNtsc.inl"
-#include "LSNCreateCycleTablePal.inl"
-#include "LSNCreateCycleTableDendy.inl"
+			CreateCycleTable();
 #endif	// #ifdef LSN_GEN_PPU
 		}
 		~CPpu2C0X() {
@@ -112,7 +112,7 @@ namespace lsn {
 		/**
 		 * Performs a single cycle update.
 		 */
-		virtual void									Tick() {
+		virtual void									Tick() final {
 			m_ui16CurX = GetCurrentRowPos();
 			m_ui16CurY = GetCurrentScanline();
 			
@@ -228,19 +228,15 @@ namespace lsn {
 		 */
 		void											ApplyMemoryMap() {
 			// == Pattern Tables
-			for ( uint32_t I = LSN_PPU_PATTERN_TABLES; I < LSN_PPU_NAMETABLES; ++I ) {
-				m_bBus.SetReadFunc( uint16_t( I ), CPpuBus::StdRead, this, uint16_t( ((I - LSN_PPU_PATTERN_TABLES) % LSN_PPU_PATTERN_TABLE_SIZE) + LSN_PPU_PATTERN_TABLES ) );
-				m_bBus.SetWriteFunc( uint16_t( I ), CPpuBus::StdWrite, this, uint16_t( ((I - LSN_PPU_PATTERN_TABLES) % LSN_PPU_PATTERN_TABLE_SIZE) + LSN_PPU_PATTERN_TABLES ) );
-			}
+			m_bBus.SetReadRange( LSN_PPU_PATTERN_TABLES, LSN_PPU_NAMETABLES, CPpuBus::StdRead, this, LSN_PPU_PATTERN_TABLES, 1, LSN_PPU_PATTERN_TABLE_SIZE );
+			m_bBus.SetWriteRange( LSN_PPU_PATTERN_TABLES, LSN_PPU_NAMETABLES, CPpuBus::StdWrite, this, LSN_PPU_PATTERN_TABLES, 1, LSN_PPU_PATTERN_TABLE_SIZE );
 
 			// == Nametables
 			ApplyVerticalMirroring();
 
 			// == Palettes
-			for ( uint32_t I = LSN_PPU_PALETTE_MEMORY; I < LSN_PPU_MEM_FULL_SIZE; ++I ) {
-				m_bBus.SetReadFunc( uint16_t( I ), PaletteRead, this, uint16_t( ((I - LSN_PPU_PALETTE_MEMORY) % LSN_PPU_PALETTE_MEMORY_SIZE) + LSN_PPU_PALETTE_MEMORY ) );
-				m_bBus.SetWriteFunc( uint16_t( I ), CPpuBus::StdWrite, this, uint16_t( ((I - LSN_PPU_PALETTE_MEMORY) % LSN_PPU_PALETTE_MEMORY_SIZE) + LSN_PPU_PALETTE_MEMORY ) );
-			}
+			m_bBus.SetReadRange( LSN_PPU_PALETTE_MEMORY, LSN_PPU_MEM_FULL_SIZE, PaletteRead, this, LSN_PPU_PALETTE_MEMORY, 1, LSN_PPU_PALETTE_MEMORY_SIZE );
+			m_bBus.SetWriteRange( LSN_PPU_PALETTE_MEMORY, LSN_PPU_MEM_FULL_SIZE, CPpuBus::StdWrite, this, LSN_PPU_PALETTE_MEMORY, 1, LSN_PPU_PALETTE_MEMORY_SIZE );
 			// 4th color of each entry mirrors the background color at LSN_PPU_PALETTE_MEMORY.
 			for ( uint32_t I = LSN_PPU_PALETTE_MEMORY + 4; I < LSN_PPU_MEM_FULL_SIZE; I += 4 ) {
 				/*m_bBus.SetReadFunc( uint16_t( I ), CCpuBus::StdRead, this, uint16_t( ((I - LSN_PPU_PALETTE_MEMORY) % (LSN_PPU_PALETTE_MEMORY_SIZE / 2)) + LSN_PPU_PALETTE_MEMORY ) );
@@ -249,39 +245,38 @@ namespace lsn {
 				m_bBus.SetWriteFunc( uint16_t( I ), WritePaletteIdx4, this, uint16_t( ((I - LSN_PPU_PALETTE_MEMORY) % (LSN_PPU_PALETTE_MEMORY_SIZE / 1)) + LSN_PPU_PALETTE_MEMORY ) );
 			}
 
-			for ( uint32_t I = LSN_PPU_START; I < LSN_APU_START; I += LSN_PPU ) {
-				// 0x2000: PPUCTRL.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x00 ), PpuNoRead, this, LSN_PPU_START );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x00 ), Write2000, this, 0 );
+			// The 8 registers repeat every LSN_PPU bytes up to LSN_APU_START.
+			// 0x2000: PPUCTRL.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x00, LSN_APU_START, PpuNoRead, this, LSN_PPU_START, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x00, LSN_APU_START, Write2000, this, 0, 0, 0, LSN_PPU );
 
-				// 0x2001: PPUMASK.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x01 ), PpuNoRead, this, LSN_PPU_START + 0x01 );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x01 ), Write2001, this, 0 );
+			// 0x2001: PPUMASK.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x01, LSN_APU_START, PpuNoRead, this, LSN_PPU_START + 0x01, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x01, LSN_APU_START, Write2001, this, 0, 0, 0, LSN_PPU );
 
-				// 0x2002: PPUSTATUS.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x02 ), Read2002, this, 0 );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x02 ), Write2002, this, 0 );
+			// 0x2002: PPUSTATUS.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x02, LSN_APU_START, Read2002, this, 0, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x02, LSN_APU_START, Write2002, this, 0, 0, 0, LSN_PPU );
 
-				// 0x2003: OAMADDR.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x03 ), PpuNoRead, this, LSN_PPU_START + 0x03 );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x03 ), Write2003, this, 0 );
+			// 0x2003: OAMADDR.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x03, LSN_APU_START, PpuNoRead, this, LSN_PPU_START + 0x03, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x03, LSN_APU_START, Write2003, this, 0, 0, 0, LSN_PPU );
 
-				// 0x2004: OAMDATA.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x04 ), Read2004, this, 0 );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x04 ), Write2004, this, 0 );
+			// 0x2004: OAMDATA.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x04, LSN_APU_START, Read2004, this, 0, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x04, LSN_APU_START, Write2004, this, 0, 0, 0, LSN_PPU );
 
-				// 0x2005: PPUSCROLL.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x05 ), PpuNoRead, this, LSN_PPU_START + 0x05 );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x05 ), Write2005, this, 0 );
+			// 0x2005: PPUSCROLL.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x05, LSN_APU_START, PpuNoRead, this, LSN_PPU_START + 0x05, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x05, LSN_APU_START, Write2005, this, 0, 0, 0, LSN_PPU );
 
-				// 0x2006: PPUADDR.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x06 ), PpuNoRead, this, LSN_PPU_START + 0x06 );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x06 ), Write2006, this, 0 );
+			// 0x2006: PPUADDR.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x06, LSN_APU_START, PpuNoRead, this, LSN_PPU_START + 0x06, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x06, LSN_APU_START, Write2006, this, 0, 0, 0, LSN_PPU );
 
-				// 0x2007: PPUDATA.
-				m_pbBus->SetReadFunc( uint16_t( I + 0x07 ), Read2007, this, 0 );
-				m_pbBus->SetWriteFunc( uint16_t( I + 0x07 ), Write2007, this, 0 );
-			}
+			// 0x2007: PPUDATA.
+			m_pbBus->SetReadRange( LSN_PPU_START + 0x07, LSN_APU_START, Read2007, this, 0, 0, 0, LSN_PPU );
+			m_pbBus->SetWriteRange( LSN_PPU_START + 0x07, LSN_APU_START, Write2007, this, 0, 0, 0, LSN_PPU );
 		}
 
 		/**
@@ -289,7 +284,9 @@ namespace lsn {
 		 */
 		void											ApplyVerticalMirroring() {
 			CMapperBase::ApplyMirroring( LSN_MM_VERTICAL, &m_bBus, this );
+#ifdef LSN_WINDOWS
 			::OutputDebugStringA( "****** LSN_MM_VERTICAL.\r\n" );
+#endif	// #ifdef LSN_WINDOWS
 		}
 
 		/**
@@ -297,7 +294,9 @@ namespace lsn {
 		 */
 		void											ApplyHorizontalMirroring() {
 			CMapperBase::ApplyMirroring( LSN_MM_HORIZONTAL, &m_bBus, this );
+#ifdef LSN_WINDOWS
 			::OutputDebugStringA( "****** LSN_MM_HORIZONTAL.\r\n" );
+#endif	// #ifdef LSN_WINDOWS
 		}
 
 		/**
@@ -305,7 +304,9 @@ namespace lsn {
 		 */
 		void											ApplyFourScreensMirroring() {
 			CMapperBase::ApplyMirroring( LSN_MM_4_SCREENS, &m_bBus, this );
+#ifdef LSN_WINDOWS
 			::OutputDebugStringA( "****** LSN_MM_4_SCREENS.\r\n" );
+#endif	// #ifdef LSN_WINDOWS
 		}
 
 		/**
@@ -313,7 +314,9 @@ namespace lsn {
 		 */
 		void											ApplyOneScreenMirroring() {
 			CMapperBase::ApplyMirroring( LSN_MM_1_SCREEN_A, &m_bBus, this );
+#ifdef LSN_WINDOWS
 			::OutputDebugStringA( "****** LSN_MM_1_SCREEN_A.\r\n" );
+#endif	// #ifdef LSN_WINDOWS
 		}
 
 		/**
@@ -321,7 +324,9 @@ namespace lsn {
 		 */
 		void											ApplyOneScreenMirroring_B() {
 			CMapperBase::ApplyMirroring( LSN_MM_1_SCREEN_B, &m_bBus, this );
+#ifdef LSN_WINDOWS
 			::OutputDebugStringA( "****** LSN_MM_1_SCREEN_B.\r\n" );
+#endif	// #ifdef LSN_WINDOWS
 		}
 
 		/**
@@ -380,6 +385,166 @@ namespace lsn {
 		 */
 		inline uint16_t									GetCurrentScanline() const { return uint16_t( m_stCurCycle / _tDotWidth ); }
 
+		/**
+		 * Gets the number of ticks that will run before the next tick that can change the CPU's NMI line on its own (the start and end of
+		 *	v-blank) or that ends the frame.  Used by schedulers that let the CPU run ahead of the PPU.
+		 *
+		 * \return Returns the number of ticks that can run before the next NMI-line change or end of frame.
+		 */
+		inline size_t									TicksToNextSyncPoint() const {
+			constexpr size_t stVBlankStart = size_t( _tPreRender + _tRender + _tPostRender ) * _tDotWidth + 1;
+			constexpr size_t stVBlankEnd = size_t( _tDotHeight - 1 ) * _tDotWidth + 1;
+			constexpr size_t stFrameEnd = size_t( _tDotHeight ) * _tDotWidth - 1;
+			if ( m_stCurCycle <= stVBlankStart ) { return stVBlankStart - m_stCurCycle; }
+			if ( m_stCurCycle <= stVBlankEnd ) { return stVBlankEnd - m_stCurCycle; }
+			return stFrameEnd - m_stCurCycle;
+		}
+
+		/**
+		 * Gets the number of ticks during which reading PPUSTATUS ($2002) would return the same value and change nothing.  Used by
+		 *	schedulers that skip loops polling PPUSTATUS.
+		 *
+		 * \return Returns the number of ticks from now during which a read of $2002 has no effect, or 0.
+		 */
+		inline size_t									TicksStatusReadIsIdle() const {
+			// A read clears the v-blank flag and the address latch and copies the flags into the I/O latch, so it only does nothing once
+			//	a read has already done all of that.
+			if ( m_psPpuStatus.s.ui8VBlank || m_bAddresLatch || ((m_ui8IoBusLatch ^ m_psPpuStatus.ui8Reg) & 0xE0) ) { return 0; }
+			// Sprite 0 hit and sprite overflow can only be raised on the rendered scanlines, and they are not lowered before the end of v-blank.
+			const uint16_t ui16Scan = GetCurrentScanline();
+			if ( (ui16Scan < (_tPreRender + _tRender) || ui16Scan == (_tDotHeight - 1)) &&
+				!(m_psPpuStatus.s.ui8Sprite0Hit && m_psPpuStatus.s.ui8SpriteOverflow) ) { return 0; }
+			// Stop short of the sync point, since reads just before v-blank starts suppress the NMI.
+			const size_t stTicks = TicksToNextSyncPoint();
+			return stTicks > 3 ? stTicks - 3 : 0;
+		}
+
+		/**
+		 * Writes the PPU state, including its bus, to a stream.  The palette and render target are not part of the state.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		bool											SaveState( CStream &_sStream ) const {
+			if ( !_sStream.WriteUi64( m_ui64Frame ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64Cycle ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_stCurCycle ) ) { return false; }
+			if ( !m_bBus.SaveState( _sStream ) ) { return false; }
+#ifdef LSN_INT_OAM_DECAY
+			if ( !_sStream.WriteBytes( m_ui64OamDecay, sizeof( m_ui64OamDecay ) ) ) { return false; }
+#else
+			if ( !_sStream.WriteBytes( m_vOamDecay.data(), m_vOamDecay.size() * sizeof( float ) ) ) { return false; }
+#endif	// #ifdef LSN_INT_OAM_DECAY
+			if ( !_sStream.WriteBytes( &m_asActiveSprites, sizeof( m_asActiveSprites ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( &m_oOam, sizeof( m_oOam ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( &m_soSecondaryOam, sizeof( m_soSecondaryOam ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( &m_paPpuAddrT, sizeof( m_paPpuAddrT ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( &m_paPpuAddrV, sizeof( m_paPpuAddrV ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( &m_pcPpuCtrl, sizeof( m_pcPpuCtrl ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( &m_psPpuStatus, sizeof( m_psPpuStatus ) ) ) { return false; }
+			if ( !_sStream.WriteBytes( &m_sesStage, sizeof( m_sesStage ) ) ) { return false; }
+			if ( !m_dvPpuMaskDelay.SaveState( _sStream ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16CurX ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16CurY ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftPatternLo ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftPatternHi ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftAttribLo ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16ShiftAttribHi ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16SpritePatternTmp ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_ui16VAddrCopy ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8IoBusLatch ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8DataBuffer ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8FineScrollX ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NtAtBuffer ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8OamAddr ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8OamLatch ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8Oam2ClearIdx ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteN ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteM ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteAttrib ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteX ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8SpriteCount ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileId ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileAttribute ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileLsb ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8NextTileMsb ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8ThisLineSpriteCount ) ) { return false; }
+			if ( !_sStream.WriteUi8( m_ui8VAddrUpdateCounter ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bVAddrPending ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bRendering ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bShowBg ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bShowSprites ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bAddresLatch ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bSprite0IsInSecondary ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bSprite0IsInSecondaryThisLine ) ) { return false; }
+			if ( !_sStream.WriteBool( m_bSuppressNmi ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Reads the PPU state from a stream previously written by SaveState().
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		bool											LoadState( CStream &_sStream ) {
+			if ( !_sStream.ReadUi64( m_ui64Frame ) ) { return false; }
+			if ( !_sStream.ReadUi64( m_ui64Cycle ) ) { return false; }
+			uint64_t ui64CurCycle;
+			if ( !_sStream.ReadUi64( ui64CurCycle ) || ui64CurCycle >= LSN_ELEMENTS( m_cCycle ) ) { return false; }
+			m_stCurCycle = size_t( ui64CurCycle );
+			if ( !m_bBus.LoadState( _sStream ) ) { return false; }
+#ifdef LSN_INT_OAM_DECAY
+			if ( !_sStream.ReadBytes( m_ui64OamDecay, sizeof( m_ui64OamDecay ) ) ) { return false; }
+#else
+			if ( !_sStream.ReadBytes( m_vOamDecay.data(), m_vOamDecay.size() * sizeof( float ) ) ) { return false; }
+#endif	// #ifdef LSN_INT_OAM_DECAY
+			if ( !_sStream.ReadBytes( &m_asActiveSprites, sizeof( m_asActiveSprites ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( &m_oOam, sizeof( m_oOam ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( &m_soSecondaryOam, sizeof( m_soSecondaryOam ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( &m_paPpuAddrT, sizeof( m_paPpuAddrT ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( &m_paPpuAddrV, sizeof( m_paPpuAddrV ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( &m_pcPpuCtrl, sizeof( m_pcPpuCtrl ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( &m_psPpuStatus, sizeof( m_psPpuStatus ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( &m_sesStage, sizeof( m_sesStage ) ) ) { return false; }
+			if ( !m_dvPpuMaskDelay.LoadState( _sStream ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16CurX ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16CurY ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftPatternLo ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftPatternHi ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftAttribLo ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16ShiftAttribHi ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16SpritePatternTmp ) ) { return false; }
+			if ( !_sStream.ReadUi16( m_ui16VAddrCopy ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8IoBusLatch ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8DataBuffer ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8FineScrollX ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NtAtBuffer ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8OamAddr ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8OamLatch ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8Oam2ClearIdx ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteN ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteM ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteAttrib ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteX ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8SpriteCount ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileId ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileAttribute ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileLsb ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8NextTileMsb ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8ThisLineSpriteCount ) ) { return false; }
+			if ( !_sStream.ReadUi8( m_ui8VAddrUpdateCounter ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bVAddrPending ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bRendering ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bShowBg ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bShowSprites ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bAddresLatch ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bSprite0IsInSecondary ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bSprite0IsInSecondaryThisLine ) ) { return false; }
+			if ( !_sStream.ReadBool( m_bSuppressNmi ) ) { return false; }
+			return true;
+		}
+
 		/**
 		 * Gets the PPU bus.
 		 *
@@ -422,6 +587,13 @@ namespace lsn {
 		 */
 		CPpuBus &										GetBus() { return m_bBus; }
 
+		/**
+		 * Gets a constant reference to the PPU bus.
+		 *
+		 * \return Returns a constant reference to the PPU bus.
+		 */
+		const CPpuBus &									GetBus() const { return m_bBus; }
+
 		/**
 		 * Gets the palette.
 		 *
@@ -984,6 +1156,7 @@ namespace lsn {
 		 */
 		static void LSN_FASTCALL						WritePaletteIdx4( void * /*_pvParm0*/, uint16_t _ui16Parm1, uint8_t * _pui8Data, uint8_t _ui8Val ) {
 			_pui8Data[_ui16Parm1] = _pui8Data[_ui16Parm1^0x10] = _ui8Val;
+			CPpuBus::MarkDirty( _pui8Data, _ui16Parm1 );
 		}
 
 		/**
@@ -1616,6 +1789,17 @@ namespace lsn {
 			}
 		}
 
+#ifndef LSN_GEN_PPU
+		/**
+		 * Fills m_cCycle with the generated cycle functions.  Runs once per construction, so it is left unoptimized to keep build times sane.
+		 */
+		LSN_NO_OPTIMIZE void							CreateCycleTable() {
+#include "LSNCreateCycleTableNtsc.inl"
+#include "LSNCreateCycleTablePal.inl"
+#include "LSNCreateCycleTableDendy.inl"
+		}
+#endif	// #ifndef LSN_GEN_PPU
+
 #ifdef LSN_GEN_PPU
 		/**
 		 * Executing a single PPU cycle.
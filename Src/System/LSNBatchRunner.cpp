@@ -0,0 +1,94 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Runs many ROM/input combinations headlessly across all cores.  Systems come from a CSystemPool and jobs are spread over a
+ *	work-stealing CThreadPool.
+ */
+
+#include "LSNBatchRunner.h"
+#include "../Time/LSNClock.h"
+
+
+namespace lsn {
+
+	CBatchRunner::CBatchRunner( size_t _stThreads ) :
+		m_tpPool( _stThreads ) {
+	}
+
+	// == Functions.
+	/**
+	 * Runs a batch of jobs and waits for them to finish.  _vResults is filled with one result per job, in the same order as _vJobs.
+	 *
+	 * \param _vJobs The jobs to run.
+	 * \param _vResults Holds the returned per-job results.
+	 * \param _bsStats Holds the returned batch statistics.
+	 * \return Returns true if every job succeeded.
+	 */
+	bool CBatchRunner::Run( const std::vector<LSN_BATCH_JOB> &_vJobs, std::vector<LSN_BATCH_RESULT> &_vResults, LSN_BATCH_STATS &_bsStats ) {
+		_vResults.clear();
+		_vResults.resize( _vJobs.size() );
+		_bsStats = LSN_BATCH_STATS();
+
+		CClock cClock;
+		uint64_t ui64Steals = m_tpPool.Steals();
+		for ( size_t I = 0; I < _vJobs.size(); ++I ) {
+			const LSN_BATCH_JOB * pbjJob = &_vJobs[I];
+			LSN_BATCH_RESULT * pbrResult = &_vResults[I];
+			m_tpPool.Submit( [this, pbjJob, pbrResult]{ RunJob( (*pbjJob), (*pbrResult) ); } );
+		}
+		m_tpPool.WaitAll();
+		_bsStats.dWallTime = (cClock.GetRealTick() - cClock.GetStartTick()) / double( cClock.GetResolution() );
+
+		for ( size_t I = 0; I < _vResults.size(); ++I ) {
+			_bsStats.ui64Frames += _vResults[I].ui64Frames;
+			if ( !_vResults[I].bSuccess ) { ++_bsStats.ui64Failed; }
+		}
+		_bsStats.ui64Steals = m_tpPool.Steals() - ui64Steals;
+		_bsStats.stSystemsCreated = m_spSystems.Created();
+		_bsStats.dFps = _bsStats.dWallTime ? _bsStats.ui64Frames / _bsStats.dWallTime : 0.0;
+		return _bsStats.ui64Failed == 0;
+	}
+
+	/**
+	 * Runs a single job.
+	 *
+	 * \param _bjJob The job to run.
+	 * \param _brResult Holds the returned result.
+	 */
+	void CBatchRunner::RunJob( const LSN_BATCH_JOB &_bjJob, LSN_BATCH_RESULT &_brResult ) {
+		CClock cClock;
+		_brResult = LSN_BATCH_RESULT();
+		if ( !_bjJob.prRom ) { return; }
+
+		LSN_PPU_METRICS pmRegion = _bjJob.pmRegion;
+		if ( pmRegion == LSN_PM_UNKNOWN ) {
+			pmRegion = _bjJob.prRom->riInfo.pmConsoleRegion;
+		}
+		if ( pmRegion == LSN_PM_UNKNOWN ) {
+			pmRegion = LSN_PM_NTSC;
+		}
+
+		std::unique_ptr<CSystemBase> psbSystem = m_spSystems.Acquire( pmRegion );
+		if ( !psbSystem ) { return; }
+
+		// CSystemBase::LoadRom() takes the ROM data, so each job needs its own copy.
+		LSN_ROM rRom = (*_bjJob.prRom);
+		if ( psbSystem->LoadRom( rRom ) ) {
+			CFrameInputPoller fipPoller( psbSystem.get(), &_bjJob.vInput );
+			psbSystem->SetInputPoller( &fipPoller );
+			psbSystem->ResetState( false );
+
+			psbSystem->RunFrames( _bjJob.ui64Frames );
+
+			_brResult.ui64Frames = psbSystem->GetPpuFrameCount();
+			_brResult.ui64MasterCycles = psbSystem->GetMasterCounter();
+			_brResult.bSuccess = true;
+		}
+
+		m_spSystems.Release( pmRegion, std::move( psbSystem ) );
+		_brResult.dWallTime = (cClock.GetRealTick() - cClock.GetStartTick()) / double( cClock.GetResolution() );
+	}
+
+}	// namespace lsn
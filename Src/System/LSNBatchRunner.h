@@ -0,0 +1,105 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Runs many ROM/input combinations headlessly across all cores.  Systems come from a CSystemPool and jobs are spread over a
+ *	work-stealing CThreadPool.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Input/LSNFrameInputPoller.h"
+#include "../Utilities/LSNThreadPool.h"
+#include "LSNSystemPool.h"
+
+
+namespace lsn {
+
+	/**
+	 * Class CBatchRunner
+	 * \brief Runs many ROM/input combinations headlessly across all cores.
+	 *
+	 * Description: Runs many ROM/input combinations headlessly across all cores.  Systems come from a CSystemPool and jobs are spread over a
+	 *	work-stealing CThreadPool.
+	 */
+	class CBatchRunner {
+	public :
+		CBatchRunner( size_t _stThreads = 0 );
+
+
+		// == Types.
+		/** A job. */
+		struct LSN_BATCH_JOB {
+			const LSN_ROM *								prRom = nullptr;					/**< The ROM, previously populated by CSystemBase::LoadRom().  Not modified; each job runs on its own copy. */
+			LSN_PPU_METRICS								pmRegion = LSN_PM_UNKNOWN;			/**< The region to run.  If LSN_PM_UNKNOWN, the ROM's region is used. */
+			uint64_t									ui64Frames = 0;						/**< The number of frames to run. */
+			std::vector<uint16_t>						vInput;								/**< Per-frame input.  The low byte is port 0 and the high byte is port 1 (LSN_INPUT_BITS).  Frames past the end read as 0. */
+		};
+
+		/** The result of a job. */
+		struct LSN_BATCH_RESULT {
+			uint64_t									ui64Frames = 0;						/**< The number of frames that were run. */
+			uint64_t									ui64MasterCycles = 0;				/**< The number of master cycles that were run. */
+			double										dWallTime = 0.0;					/**< The wall time of the job in seconds, including loading the ROM. */
+			bool										bSuccess = false;					/**< True if the ROM loaded and the job ran. */
+		};
+
+		/** The statistics for a whole batch. */
+		struct LSN_BATCH_STATS {
+			uint64_t									ui64Frames = 0;						/**< The total number of frames run by all jobs. */
+			uint64_t									ui64Failed = 0;						/**< The number of jobs that failed. */
+			uint64_t									ui64Steals = 0;						/**< The number of jobs taken by a worker from another worker's queue. */
+			size_t										stSystemsCreated = 0;				/**< The number of systems constructed so far by the pool. */
+			double										dWallTime = 0.0;					/**< The wall time of the whole batch in seconds. */
+			double										dFps = 0.0;							/**< Aggregate emulated frames per second (ui64Frames / dWallTime). */
+		};
+
+
+		// == Functions.
+		/**
+		 * Runs a batch of jobs and waits for them to finish.  _vResults is filled with one result per job, in the same order as _vJobs.
+		 *
+		 * \param _vJobs The jobs to run.
+		 * \param _vResults Holds the returned per-job results.
+		 * \param _bsStats Holds the returned batch statistics.
+		 * \return Returns true if every job succeeded.
+		 */
+		bool											Run( const std::vector<LSN_BATCH_JOB> &_vJobs, std::vector<LSN_BATCH_RESULT> &_vResults, LSN_BATCH_STATS &_bsStats );
+
+		/**
+		 * Gets the number of worker threads.
+		 *
+		 * \return Returns the number of worker threads.
+		 */
+		inline size_t									Threads() const { return m_tpPool.Threads(); }
+
+		/**
+		 * Gets the system pool.
+		 *
+		 * \return Returns the system pool.
+		 */
+		inline CSystemPool &							SystemPool() { return m_spSystems; }
+
+
+	protected :
+		// == Members.
+		/** The systems. */
+		CSystemPool										m_spSystems;
+		/** The worker threads.  Declared last so that the workers are stopped before the systems are destroyed. */
+		CThreadPool										m_tpPool;
+
+
+		// == Functions.
+		/**
+		 * Runs a single job.
+		 *
+		 * \param _bjJob The job to run.
+		 * \param _brResult Holds the returned result.
+		 */
+		void											RunJob( const LSN_BATCH_JOB &_bjJob, LSN_BATCH_RESULT &_brResult );
+	};
+
+}	// namespace lsn
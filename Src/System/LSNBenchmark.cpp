@@ -0,0 +1,1236 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The headless command-line benchmark.  Loads a ROM, runs it uncapped for a number of frames, and reports the emulation speed
+ *	as text or JSON.
+ */
+
+#include "LSNBenchmark.h"
+#include "../File/LSNStdFile.h"
+#include "../File/LSNZipFile.h"
+#include "../Input/LSNFrameInputPoller.h"
+#include "../Time/LSNClock.h"
+#include "../Time/LSNFramePacer.h"
+#include "../Utilities/LSNStream.h"
+#include "../Utilities/LSNUtilities.h"
+#include "LSNLoopbackTransport.h"
+#include "LSNSystemPool.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#include <immintrin.h>
+#define LSN_HOST_CYCLES()						__rdtsc()
+#else
+#define LSN_HOST_CYCLES()						0ULL
+#endif	// #if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Runs the benchmark from the command line: parses arguments, runs, and prints the results to stdout.
+	 *
+	 * \param _iArgC The number of arguments.
+	 * \param _ppcArgV The arguments, in UTF-8.
+	 * \return Returns the process exit code.
+	 */
+	int CBenchmark::Main( int _iArgC, char * _ppcArgV[] ) {
+		LSN_BENCH_OPTIONS boOptions;
+		std::string sError;
+		if ( !ParseCommandLine( _iArgC, _ppcArgV, boOptions, sError ) ) {
+			std::fprintf( stderr, "%s\n\n%s", sError.c_str(), Usage() );
+			return 2;
+		}
+
+		LSN_BENCH_RESULTS brResults;
+		if ( !Run( boOptions, brResults, sError ) ) {
+			if ( boOptions.bJson ) {
+				std::printf( "{\"error\":\"%s\"}\n", sError.c_str() );
+			}
+			else {
+				std::fprintf( stderr, "%s\n", sError.c_str() );
+			}
+			return 1;
+		}
+		std::string sOut = boOptions.bJson ? ToJson( brResults ) : ToText( brResults );
+		std::fputs( sOut.c_str(), stdout );
+		return 0;
+	}
+
+	/**
+	 * Parses the command line.
+	 *
+	 * \param _iArgC The number of arguments.
+	 * \param _ppcArgV The arguments, in UTF-8.
+	 * \param _boOptions Holds the returned options.
+	 * \param _sError Holds the returned error message.
+	 * \return Returns true if the command line was valid.
+	 */
+	bool CBenchmark::ParseCommandLine( int _iArgC, char * _ppcArgV[], LSN_BENCH_OPTIONS &_boOptions, std::string &_sError ) {
+		_boOptions = LSN_BENCH_OPTIONS();
+		for ( int I = 1; I < _iArgC; ++I ) {
+			const char * pcArg = _ppcArgV[I];
+			const char * pcNext = (I + 1 < _iArgC) ? _ppcArgV[I+1] : nullptr;
+			if ( std::strcmp( pcArg, "--json" ) == 0 ) {
+				_boOptions.bJson = true;
+			}
+			else if ( std::strcmp( pcArg, "--unrolled" ) == 0 ) {
+				_boOptions.bUnrolled = true;
+			}
+			else if ( std::strcmp( pcArg, "--lazy-ppu" ) == 0 ) {
+				_boOptions.bLazyPpu = true;
+			}
+			else if ( std::strcmp( pcArg, "--no-fast-pages" ) == 0 ) {
+				_boOptions.bFastPages = false;
+			}
+			else if ( std::strcmp( pcArg, "--fast-cpu" ) == 0 ) {
+				_boOptions.bFastCpu = true;
+			}
+			else if ( std::strcmp( pcArg, "--block-cpu" ) == 0 ) {
+				_boOptions.bBlockCpu = true;
+			}
+			else if ( std::strcmp( pcArg, "--jit-cpu" ) == 0 ) {
+				_boOptions.bJitCpu = true;
+			}
+			else if ( std::strcmp( pcArg, "--no-decode-cache" ) == 0 ) {
+				_boOptions.bDecodeCache = false;
+			}
+			else if ( std::strcmp( pcArg, "--switch-dispatch" ) == 0 ) {
+				_boOptions.bSwitchDispatch = true;
+			}
+			else if ( std::strcmp( pcArg, "--idle-skip" ) == 0 ) {
+				_boOptions.bIdleSkip = true;
+			}
+			else if ( std::strcmp( pcArg, "--cache-counters" ) == 0 ) {
+				_boOptions.bCacheCounters = true;
+			}
+			else if ( std::strcmp( pcArg, "--profile" ) == 0 ) {
+				_boOptions.bProfile = true;
+			}
+			else if ( std::strcmp( pcArg, "--rewind" ) == 0 ) {
+				_boOptions.bRewind = true;
+			}
+			else if ( std::strcmp( pcArg, "--dirty-pages" ) == 0 ) {
+				_boOptions.bDirtyPages = true;
+			}
+			else if ( std::strcmp( pcArg, "--watch" ) == 0 && pcNext ) {
+				++I;
+				CWatchpoints::LSN_WATCHPOINT wWatch;
+				if ( !ParseWatch( pcNext, wWatch ) ) {
+					_sError = std::string( "Invalid watchpoint: " ) + pcNext;
+					return false;
+				}
+				_boOptions.vWatches.push_back( wWatch );
+			}
+			else if ( std::strcmp( pcArg, "--bus-histogram" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.s16BusHistogramPath = CUtilities::Utf8ToUtf16( reinterpret_cast<const char8_t *>(pcNext) );
+			}
+			else if ( std::strcmp( pcArg, "--bus-histogram-per-frame" ) == 0 ) {
+				_boOptions.bBusHistogramPerFrame = true;
+			}
+			else if ( std::strcmp( pcArg, "--run-ahead" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.ui32RunAhead = uint32_t( std::strtoul( pcNext, nullptr, 10 ) );
+				if ( !_boOptions.ui32RunAhead ) {
+					_sError = std::string( "Invalid run-ahead frame count: " ) + pcNext;
+					return false;
+				}
+			}
+			else if ( std::strcmp( pcArg, "--run-ahead-second" ) == 0 ) {
+				_boOptions.bRunAheadSecondInstance = true;
+			}
+			else if ( std::strcmp( pcArg, "--run-ahead-budget" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.dRunAheadBudget = std::strtod( pcNext, nullptr );
+			}
+			else if ( std::strcmp( pcArg, "--record-movie" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.s16RecordMoviePath = CUtilities::Utf8ToUtf16( reinterpret_cast<const char8_t *>(pcNext) );
+			}
+			else if ( std::strcmp( pcArg, "--keyframe-interval" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.ui32KeyframeInterval = uint32_t( std::strtoul( pcNext, nullptr, 10 ) );
+				if ( !_boOptions.ui32KeyframeInterval ) {
+					_sError = std::string( "Invalid keyframe interval: " ) + pcNext;
+					return false;
+				}
+			}
+			else if ( std::strcmp( pcArg, "--movie" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.s16MoviePath = CUtilities::Utf8ToUtf16( reinterpret_cast<const char8_t *>(pcNext) );
+			}
+			else if ( std::strcmp( pcArg, "--seek" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.ui64SeekFrame = std::strtoull( pcNext, nullptr, 10 );
+			}
+			else if ( std::strcmp( pcArg, "--rollback" ) == 0 ) {
+				_boOptions.bRollback = true;
+			}
+			else if ( std::strcmp( pcArg, "--rollback-latency" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.dRollbackLatency = std::max( std::strtod( pcNext, nullptr ), 0.0 );
+			}
+			else if ( std::strcmp( pcArg, "--rollback-jitter" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.dRollbackJitter = std::max( std::strtod( pcNext, nullptr ), 0.0 );
+			}
+			else if ( std::strcmp( pcArg, "--rollback-delay" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.ui32RollbackDelay = uint32_t( std::strtoul( pcNext, nullptr, 10 ) );
+			}
+			else if ( std::strcmp( pcArg, "--rollback-max" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.ui32RollbackMax = uint32_t( std::strtoul( pcNext, nullptr, 10 ) );
+			}
+			else if ( std::strcmp( pcArg, "--region" ) == 0 && pcNext ) {
+				++I;
+				if ( std::strcmp( pcNext, "ntsc" ) == 0 ) { _boOptions.pmRegion = LSN_PM_NTSC; }
+				else if ( std::strcmp( pcNext, "pal" ) == 0 ) { _boOptions.pmRegion = LSN_PM_PAL; }
+				else if ( std::strcmp( pcNext, "dendy" ) == 0 ) { _boOptions.pmRegion = LSN_PM_DENDY; }
+				else if ( std::strcmp( pcNext, "auto" ) == 0 ) { _boOptions.pmRegion = LSN_PM_UNKNOWN; }
+				else {
+					_sError = std::string( "Unknown region: " ) + pcNext;
+					return false;
+				}
+			}
+			else if ( std::strcmp( pcArg, "--frames" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.ui64Frames = std::strtoull( pcNext, nullptr, 10 );
+				if ( !_boOptions.ui64Frames ) {
+					_sError = std::string( "Invalid frame count: " ) + pcNext;
+					return false;
+				}
+			}
+			else if ( std::strcmp( pcArg, "--input" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.s16InputPath = CUtilities::Utf8ToUtf16( reinterpret_cast<const char8_t *>(pcNext) );
+			}
+			else if ( std::strcmp( pcArg, "--tick-seconds" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.dTickSeconds = std::strtod( pcNext, nullptr );
+			}
+			else if ( std::strcmp( pcArg, "--pace-frames" ) == 0 && pcNext ) {
+				++I;
+				_boOptions.ui64PaceFrames = std::strtoull( pcNext, nullptr, 10 );
+			}
+			else if ( pcArg[0] == '-' ) {
+				_sError = std::string( "Unknown option: " ) + pcArg;
+				return false;
+			}
+			else if ( _boOptions.s16RomPath.size() ) {
+				_sError = std::string( "Only 1 ROM can be given: " ) + pcArg;
+				return false;
+			}
+			else {
+				_boOptions.s16RomPath = CUtilities::Utf8ToUtf16( reinterpret_cast<const char8_t *>(pcArg) );
+			}
+		}
+		if ( !_boOptions.s16RomPath.size() ) {
+			_sError = "No ROM given.";
+			return false;
+		}
+		if ( _boOptions.s16RecordMoviePath.size() && _boOptions.s16MoviePath.size() ) {
+			_sError = "--record-movie and --movie cannot be used together.";
+			return false;
+		}
+		if ( _boOptions.ui64SeekFrame != UINT64_MAX && !_boOptions.s16RecordMoviePath.size() && !_boOptions.s16MoviePath.size() ) {
+			_sError = "--seek requires --record-movie or --movie.";
+			return false;
+		}
+		if ( _boOptions.bRollback && (_boOptions.bRewind || _boOptions.ui32RunAhead || _boOptions.bDirtyPages || _boOptions.vWatches.size() ||
+			_boOptions.s16BusHistogramPath.size() || _boOptions.s16RecordMoviePath.size()) ) {
+			_sError = "--rollback cannot be used with --rewind, --run-ahead, --dirty-pages, --watch, --bus-histogram, or --record-movie.";
+			return false;
+		}
+		if ( _boOptions.bBusHistogramPerFrame && !_boOptions.s16BusHistogramPath.size() ) {
+			_sError = "--bus-histogram-per-frame requires --bus-histogram.";
+			return false;
+		}
+		return true;
+	}
+
+	/**
+	 * Runs the benchmark.
+	 *
+	 * \param _boOptions The options.
+	 * \param _brResults Holds the returned results.
+	 * \param _sError Holds the returned error message.
+	 * \return Returns true if the benchmark ran.
+	 */
+	bool CBenchmark::Run( const LSN_BENCH_OPTIONS &_boOptions, LSN_BENCH_RESULTS &_brResults, std::string &_sError ) {
+		_brResults = LSN_BENCH_RESULTS();
+
+		std::vector<uint8_t> vFile;
+		std::u16string s16Name;
+		if ( !LoadFile( _boOptions.s16RomPath, vFile, s16Name, true ) ) {
+			_sError = "Failed to load ROM file.";
+			return false;
+		}
+		LSN_ROM rRom;
+		if ( !CSystemBase::LoadRom( vFile, rRom, s16Name ) ) {
+			_sError = "Not a valid ROM.";
+			return false;
+		}
+
+		std::vector<uint16_t> vInput;
+		if ( _boOptions.s16InputPath.size() ) {
+			std::vector<uint8_t> vInputFile;
+			std::u16string s16InputName;
+			if ( !LoadFile( _boOptions.s16InputPath, vInputFile, s16InputName, false ) ) {
+				_sError = "Failed to load input file.";
+				return false;
+			}
+			CFrameInputPoller::FromFile( vInputFile, vInput );
+		}
+		else if ( _boOptions.bRollback ) {
+			// Without real input nothing is ever mispredicted, so both players mash buttons, changing every few frames.
+			vInput.resize( size_t( _boOptions.ui64Frames + 16 ) );
+			uint32_t ui32Random = 0x2545F491;
+			uint16_t ui16Held = 0;
+			for ( size_t I = 0; I < vInput.size(); ++I ) {
+				ui32Random = ui32Random * 1664525 + 1013904223;
+				if ( (ui32Random >> 28) < 3 ) { ui16Held = uint16_t( ui32Random >> 8 ); }
+				vInput[I] = ui16Held;
+			}
+		}
+
+		LSN_PPU_METRICS pmRegion = _boOptions.pmRegion;
+		if ( pmRegion == LSN_PM_UNKNOWN ) { pmRegion = rRom.riInfo.pmConsoleRegion; }
+		if ( pmRegion == LSN_PM_UNKNOWN ) { pmRegion = LSN_PM_NTSC; }
+
+		CSystemPool spPool;
+		std::unique_ptr<CSystemBase> psbSystem;
+		if ( _boOptions.bProfile ) {
+			switch ( pmRegion ) {
+				case LSN_PM_NTSC : { psbSystem = std::make_unique<CNtscProfiledSystem>(); break; }
+				case LSN_PM_PAL : { psbSystem = std::make_unique<CPalProfiledSystem>(); break; }
+				case LSN_PM_DENDY : { psbSystem = std::make_unique<CDendyProfiledSystem>(); break; }
+				default : {}
+			}
+		}
+		else {
+			psbSystem = spPool.Acquire( pmRegion );
+		}
+		if ( !psbSystem ) {
+			_sError = "Unsupported region.";
+			return false;
+		}
+		// Keep a copy for the Tick() pass; LoadRom() takes the ROM data.
+		LSN_ROM rRomCopy = rRom;
+		if ( !psbSystem->LoadRom( rRom ) ) {
+			_sError = "Unsupported mapper.";
+			return false;
+		}
+		CFrameInputPoller fipPoller( psbSystem.get(), &vInput );
+		CInputMovie imMovie;
+		imMovie.SetSource( &fipPoller );
+		psbSystem->SetInputPoller( &imMovie );
+		psbSystem->SetUnrolledScheduler( _boOptions.bUnrolled );
+		psbSystem->SetLazyPpu( _boOptions.bLazyPpu );
+		psbSystem->SetFastPages( _boOptions.bFastPages );
+		psbSystem->SetFastCpu( _boOptions.bFastCpu );
+		psbSystem->SetBlockCpu( _boOptions.bBlockCpu );
+		psbSystem->SetJitCpu( _boOptions.bJitCpu );
+		psbSystem->SetDecodeCache( _boOptions.bDecodeCache );
+		psbSystem->SetSwitchDispatch( _boOptions.bSwitchDispatch );
+		psbSystem->SetIdleSkip( _boOptions.bIdleSkip );
+		psbSystem->ResetState( false );
+		CWatchpoints * pwWatch = _boOptions.vWatches.size() ? psbSystem->GetWatchpoints() : nullptr;
+		if ( pwWatch ) {
+			for ( const auto & wWatch : _boOptions.vWatches ) {
+				pwWatch->Add( wWatch.ui16Start, wWatch.ui16End, wWatch.ui8Flags, wWatch.ui8Value );
+			}
+			pwWatch->Hits().Reset();
+			pwWatch->Install();
+		}
+		std::vector<CWatchpoints::LSN_WATCH_HIT> vHits;
+		CBusHistogram bhHistogram;
+		if ( _boOptions.s16BusHistogramPath.size() &&
+			!bhHistogram.Begin( psbSystem->GetCpuBus(), psbSystem->GetPpuBus(), _boOptions.bBusHistogramPerFrame ) ) {
+			_sError = "--bus-histogram requires a build with LSN_BUS_HISTOGRAM defined.";
+			return false;
+		}
+
+		// Uncapped run.
+		CClock cClock;
+		std::unique_ptr<CRewindBuffer> prbRewind;
+		if ( _boOptions.bRewind ) {
+			prbRewind = std::make_unique<CRewindBuffer>();
+			prbRewind->Capture( (*psbSystem) );
+		}
+		if ( _boOptions.s16RecordMoviePath.size() ) {
+			if ( !imMovie.StartRecording( (*psbSystem), _boOptions.ui32KeyframeInterval ) ) {
+				_sError = "Failed to start recording the movie.";
+				return false;
+			}
+		}
+		CCacheCounters ccCounters;
+		_brResults.bCacheCounted = _boOptions.bCacheCounters && ccCounters.Start();
+		_brResults.bCacheUnavailable = _boOptions.bCacheCounters && !_brResults.bCacheCounted;
+		uint64_t ui64Start = cClock.GetRealTick();
+		uint64_t ui64HostStart = LSN_HOST_CYCLES();
+		CRunAhead raRunAhead;
+		raRunAhead.SetFrames( _boOptions.ui32RunAhead );
+		if ( _boOptions.ui32RunAhead && _boOptions.bRunAheadSecondInstance ) {
+			if ( !raRunAhead.CreateSecondInstance( (*psbSystem), pmRegion, &fipPoller ) ) {
+				_sError = "Failed to create the second run-ahead system.";
+				return false;
+			}
+		}
+		if ( _boOptions.bRollback ) {
+			// A second system plays the other side; both start from the same state and meet over the loopback link.
+			std::unique_ptr<CSystemBase> psbRemote = spPool.Acquire( pmRegion );
+			LSN_ROM rRemoteRom = rRomCopy;
+			if ( !psbRemote || !psbRemote->LoadRom( rRemoteRom ) ) {
+				_sError = "Failed to create the second rollback system.";
+				return false;
+			}
+			psbRemote->SetUnrolledScheduler( _boOptions.bUnrolled );
+			psbRemote->SetLazyPpu( _boOptions.bLazyPpu );
+			psbRemote->SetFastPages( _boOptions.bFastPages );
+			psbRemote->SetFastCpu( _boOptions.bFastCpu );
+			psbRemote->SetBlockCpu( _boOptions.bBlockCpu );
+			psbRemote->SetJitCpu( _boOptions.bJitCpu );
+			psbRemote->SetDecodeCache( _boOptions.bDecodeCache );
+			psbRemote->SetSwitchDispatch( _boOptions.bSwitchDispatch );
+			psbRemote->SetIdleSkip( _boOptions.bIdleSkip );
+			psbRemote->ResetState( false );
+			CFrameInputPoller fipRemote( psbRemote.get(), &vInput );
+
+			const uint64_t ui64FrameMicros = psbSystem->GetMasterHz() ?
+				1000000ULL * psbSystem->GetMasterDiv() * psbSystem->GetMasterCyclesPerFrame() / psbSystem->GetMasterHz() : 16639;
+			CLoopbackLink llLink( uint64_t( _boOptions.dRollbackLatency * 1000.0 ), uint64_t( _boOptions.dRollbackJitter * 1000.0 ) );
+			CRollbackSession rsSessions[2];
+			if ( !rsSessions[0].Start( (*psbSystem), 0, &fipPoller, &llLink.Endpoint( 0 ), _boOptions.ui32RollbackDelay, _boOptions.ui32RollbackMax ) ||
+				!rsSessions[1].Start( (*psbRemote), 1, &fipRemote, &llLink.Endpoint( 1 ), _boOptions.ui32RollbackDelay, _boOptions.ui32RollbackMax ) ) {
+				_sError = "Invalid rollback settings.";
+				return false;
+			}
+			// 1 pass per host frame.  A side that gets too far ahead waits for the other.
+			for ( uint64_t I = 0; I < _boOptions.ui64Frames * 4 + 1000; ++I ) {
+				if ( rsSessions[0].Frame() >= _boOptions.ui64Frames && rsSessions[1].Frame() >= _boOptions.ui64Frames ) { break; }
+				llLink.Step( ui64FrameMicros );
+				for ( size_t J = 0; J < 2; ++J ) {
+					if ( rsSessions[J].Frame() < _boOptions.ui64Frames ) { rsSessions[J].AdvanceFrame(); }
+				}
+			}
+			// Deliver everything still in flight, then both sides must be in the same state.
+			llLink.Step( uint64_t( (_boOptions.dRollbackLatency + _boOptions.dRollbackJitter) * 1000.0 ) + 1 );
+			rsSessions[0].Synchronize();
+			rsSessions[1].Synchronize();
+			if ( rsSessions[0].Frame() == rsSessions[1].Frame() &&
+				rsSessions[0].ConfirmedFrame() >= rsSessions[0].Frame() && rsSessions[1].ConfirmedFrame() >= rsSessions[1].Frame() ) {
+				std::vector<uint8_t> vStates[2];
+				CStream sLocal( vStates[0] ), sRemote( vStates[1] );
+				_brResults.bRollbackSynced = psbSystem->SaveState( sLocal ) && psbRemote->SaveState( sRemote ) && vStates[0] == vStates[1];
+			}
+			for ( size_t J = 0; J < 2; ++J ) {
+				_brResults.rsRollback[J] = rsSessions[J].Stats();
+				rsSessions[J].Stop();
+			}
+			_brResults.dRollbackBudget = double( ui64FrameMicros );
+			_brResults.bRollback = true;
+			psbSystem->SetInputPoller( &imMovie );
+			spPool.Release( pmRegion, std::move( psbRemote ) );
+		}
+		else if ( prbRewind || raRunAhead.Frames() || _boOptions.bDirtyPages || pwWatch || _boOptions.bBusHistogramPerFrame ||
+			imMovie.Mode() == CInputMovie::LSN_MM_RECORD ) {
+			// Frame-by-frame, capturing each frame and running ahead as the interactive emulator does.
+			psbSystem->ClearDirtyPages();
+			for ( uint64_t I = 0; I < _boOptions.ui64Frames; ++I ) {
+				psbSystem->RunFrames( 1 );
+				if ( _boOptions.bDirtyPages ) {
+					const uint64_t ui64Pages = psbSystem->DirtyPageCount();
+					_brResults.ui64DirtyPages += ui64Pages;
+					_brResults.ui64MaxDirtyPages = std::max( _brResults.ui64MaxDirtyPages, ui64Pages );
+				}
+				if ( prbRewind ) {
+					prbRewind->Capture( (*psbSystem) );
+				}
+				if ( pwWatch ) {
+					// Drained before run-ahead so that the hits of the frames run ahead are not counted.
+					vHits.clear();
+					pwWatch->Hits().Drain( vHits );
+					if ( vHits.size() && !_brResults.ui64WatchHits ) { _brResults.whFirstHit = vHits[0]; }
+					_brResults.ui64WatchHits += vHits.size();
+				}
+				bhHistogram.Frame( I );
+				imMovie.OnFrame( (*psbSystem) );
+				raRunAhead.Run( (*psbSystem), nullptr );
+				if ( _boOptions.bBusHistogramPerFrame ) {
+					bhHistogram.Discard();
+				}
+				if ( pwWatch ) {
+					vHits.clear();
+					pwWatch->Hits().Drain( vHits );
+				}
+				if ( _boOptions.bDirtyPages ) {
+					// Run-ahead loads the whole state back, which marks every page dirty.
+					psbSystem->ClearDirtyPages();
+				}
+			}
+			_brResults.bDirtyTracked = _boOptions.bDirtyPages;
+			if ( pwWatch ) {
+				_brResults.ui64WatchDropped = pwWatch->Hits().Dropped();
+				_brResults.bWatched = true;
+				pwWatch->Clear();
+			}
+		}
+		else {
+			psbSystem->RunFrames( _boOptions.ui64Frames );
+		}
+		_brResults.ui64HostCycles = LSN_HOST_CYCLES() - ui64HostStart;
+		_brResults.dWallTime = (cClock.GetRealTick() - ui64Start) / double( cClock.GetResolution() );
+		if ( _brResults.bCacheCounted ) {
+			_brResults.ccCache = ccCounters.Stop();
+		}
+		if ( _boOptions.s16BusHistogramPath.size() ) {
+			bhHistogram.End();
+			_brResults.hsBus = bhHistogram.Summary();
+			_brResults.bBusHistogram = true;
+			std::u16string s16Ext = CUtilities::GetFileExtension( _boOptions.s16BusHistogramPath );
+			const bool bJson = s16Ext.size() == 4 &&
+				(s16Ext[0] | 0x20) == u'j' && (s16Ext[1] | 0x20) == u's' && (s16Ext[2] | 0x20) == u'o' && (s16Ext[3] | 0x20) == u'n';
+			const std::string sText = bJson ? bhHistogram.ToJson() : bhHistogram.ToCsv();
+			CStdFile sfFile;
+			if ( !sfFile.Create( _boOptions.s16BusHistogramPath.c_str() ) || !sfFile.WriteToFile( std::vector<uint8_t>( sText.begin(), sText.end() ) ) ) {
+				_sError = "Failed to write the bus histogram.";
+				return false;
+			}
+		}
+		_brResults.bFastPages = psbSystem->IsFastPages();
+		_brResults.ui64FastReadPages = psbSystem->FastReadPageCount();
+		_brResults.ui64FastWritePages = psbSystem->FastWritePageCount();
+		_brResults.bFastCpu = psbSystem->IsFastCpu() && psbSystem->IsLazyPpu();
+		_brResults.ui64FastCpuInstructions = psbSystem->FastCpuInstructions();
+		_brResults.ui64FastCpuCycles = psbSystem->FastCpuCycles();
+		_brResults.bBlockCpu = _brResults.bFastCpu && psbSystem->IsBlockCpu();
+		_brResults.ui64FastCpuBlocks = psbSystem->FastCpuBlocks();
+		_brResults.bJitCpu = _brResults.bBlockCpu && psbSystem->IsJitCpu();
+		_brResults.ui64JitInstructions = psbSystem->JitInstructions();
+		_brResults.ui64JitBlocks = psbSystem->JitBlocks();
+		_brResults.ui64FastCpuCheckFailures = psbSystem->FastCpuCheckFailures();
+		_brResults.bIdleSkip = _brResults.bFastCpu && psbSystem->IsIdleSkip();
+		_brResults.ui64IdleSkips = psbSystem->IdleSkips();
+		_brResults.ui64IdleCycles = psbSystem->IdleCycles();
+		_brResults.ui64IdleStatusCycles = psbSystem->IdleStatusCycles();
+		_brResults.bDecodeCache = _brResults.bFastCpu && psbSystem->IsDecodeCache();
+		_brResults.dcsDecodeCache = psbSystem->DecodeCacheStats();
+		_brResults.bSwitchDispatch = psbSystem->IsSwitchDispatch();
+		_brResults.ui64DispatchTableSize = CCpu6502::DispatchTableSize( _brResults.bSwitchDispatch );
+		_brResults.ui64PointerTableSize = CCpu6502::DispatchTableSize( false );
+		if ( prbRewind ) {
+			prbRewind->Flush();
+			_brResults.rsRewind = prbRewind->Stats();
+			_brResults.bRewound = true;
+			prbRewind.reset();
+		}
+		if ( raRunAhead.Frames() ) {
+			_brResults.rasRunAhead = raRunAhead.Stats();
+			_brResults.dRunAheadBudget = _boOptions.dRunAheadBudget;
+			if ( _brResults.dRunAheadBudget <= 0.0 && psbSystem->GetMasterHz() ) {
+				_brResults.dRunAheadBudget = 1000000.0 * psbSystem->GetMasterDiv() * psbSystem->GetMasterCyclesPerFrame() / psbSystem->GetMasterHz();
+			}
+			_brResults.ui32RunAheadBudgetFrames = raRunAhead.FramesForBudget( _brResults.dRunAheadBudget );
+			_brResults.bRanAhead = true;
+			raRunAhead.DestroySecondInstance();
+		}
+
+		_brResults.s16RomName = s16Name;
+		_brResults.pmRegion = pmRegion;
+		_brResults.ui64Frames = psbSystem->GetPpuFrameCount();
+		_brResults.ui64MasterCycles = psbSystem->GetMasterCounter();
+		_brResults.ui64CpuCycles = psbSystem->GetCpuDiv() ? _brResults.ui64MasterCycles / psbSystem->GetCpuDiv() : 0;
+		if ( _brResults.dWallTime ) {
+			_brResults.dMasterMhz = _brResults.ui64MasterCycles / _brResults.dWallTime / 1000000.0;
+			_brResults.dCpuMhz = _brResults.ui64CpuCycles / _brResults.dWallTime / 1000000.0;
+			_brResults.dFps = _brResults.ui64Frames / _brResults.dWallTime;
+		}
+		if ( psbSystem->GetMasterDiv() && psbSystem->GetMasterCyclesPerFrame() ) {
+			double dRealFps = double( psbSystem->GetMasterHz() ) / psbSystem->GetMasterDiv() / psbSystem->GetMasterCyclesPerFrame();
+			_brResults.dSpeed = _brResults.dFps / dRealFps;
+		}
+		if ( _brResults.ui64MasterCycles ) {
+			_brResults.dHostCyclesPerMasterCycle = double( _brResults.ui64HostCycles ) / _brResults.ui64MasterCycles;
+		}
+		if ( psbSystem->GetProfiler() ) {
+			_brResults.pfProfile = psbSystem->GetProfiler()->Totals();
+			_brResults.bProfiled = true;
+		}
+
+		// ROM load to first frame, on a system of its own so that the run above is not disturbed.
+		{
+			std::unique_ptr<CSystemBase> psbLoad = spPool.Acquire( pmRegion );
+			if ( psbLoad ) {
+				CFrameInputPoller fipLoad( psbLoad.get(), &vInput );
+				uint64_t ui64LoadStart = cClock.GetRealTick();
+				LSN_ROM rLoadRom;
+				if ( CSystemBase::LoadRom( vFile, rLoadRom, s16Name ) && psbLoad->LoadRom( rLoadRom ) ) {
+					psbLoad->SetInputPoller( &fipLoad );
+					psbLoad->SetUnrolledScheduler( _boOptions.bUnrolled );
+					psbLoad->SetLazyPpu( _boOptions.bLazyPpu );
+					psbLoad->SetFastPages( _boOptions.bFastPages );
+					psbLoad->SetFastCpu( _boOptions.bFastCpu );
+					psbLoad->SetBlockCpu( _boOptions.bBlockCpu );
+					psbLoad->SetJitCpu( _boOptions.bJitCpu );
+					psbLoad->SetDecodeCache( _boOptions.bDecodeCache );
+					psbLoad->SetSwitchDispatch( _boOptions.bSwitchDispatch );
+					psbLoad->SetIdleSkip( _boOptions.bIdleSkip );
+					psbLoad->ResetState( false );
+					uint64_t ui64Loaded = cClock.GetRealTick();
+					psbLoad->RunFrames( 1 );
+					uint64_t ui64FirstFrame = cClock.GetRealTick();
+					_brResults.dLoadMicros = (ui64Loaded - ui64LoadStart) * 1000000.0 / cClock.GetResolution();
+					_brResults.dFirstFrameMicros = (ui64FirstFrame - ui64LoadStart) * 1000000.0 / cClock.GetResolution();
+
+					// Later resets copy back the map built by the first.
+					constexpr uint32_t ui32Resets = 16;
+					uint64_t ui64ResetStart = cClock.GetRealTick();
+					for ( uint32_t I = 0; I < ui32Resets; ++I ) {
+						psbLoad->ResetState( false );
+					}
+					_brResults.dResetMicros = (cClock.GetRealTick() - ui64ResetStart) * 1000000.0 / cClock.GetResolution() / ui32Resets;
+				}
+				psbLoad->SetInputPoller( nullptr );
+				spPool.Release( pmRegion, std::move( psbLoad ) );
+			}
+		}
+
+		// Movie playback, after the results above have been gathered since it moves the system.
+		if ( _boOptions.s16RecordMoviePath.size() || _boOptions.s16MoviePath.size() ) {
+			std::vector<uint8_t> vMovie;
+			if ( _boOptions.s16RecordMoviePath.size() ) {
+				imMovie.Stop();
+				CStdFile sfFile;
+				if ( !imMovie.Save( vMovie ) || !sfFile.Create( _boOptions.s16RecordMoviePath.c_str() ) || !sfFile.WriteToFile( vMovie ) ) {
+					_sError = "Failed to write the movie file.";
+					return false;
+				}
+			}
+			else {
+				std::u16string s16MovieName;
+				if ( !LoadFile( _boOptions.s16MoviePath, vMovie, s16MovieName, false ) || !imMovie.Load( vMovie ) ) {
+					_sError = "Failed to load the movie file.";
+					return false;
+				}
+			}
+			_brResults.ui64MovieFrames = imMovie.Frames();
+			_brResults.ui64MovieKeyframes = imMovie.Keyframes().size();
+			_brResults.ui64MovieBytes = vMovie.size();
+			uint64_t ui64VerifyStart = cClock.GetRealTick();
+			_brResults.bMovieSynced = imMovie.Verify( (*psbSystem), _brResults.ui64MovieBadFrame );
+			_brResults.dMovieVerifySeconds = (cClock.GetRealTick() - ui64VerifyStart) / double( cClock.GetResolution() );
+			_brResults.bMovie = true;
+
+			if ( _boOptions.ui64SeekFrame != UINT64_MAX ) {
+				uint64_t ui64SeekStart = cClock.GetRealTick();
+				if ( !imMovie.Seek( (*psbSystem), _boOptions.ui64SeekFrame ) ) {
+					_sError = "Failed to seek the movie.";
+					return false;
+				}
+				_brResults.dSeekMicros = (cClock.GetRealTick() - ui64SeekStart) * 1000000.0 / cClock.GetResolution();
+				_brResults.ui64SeekFrame = _boOptions.ui64SeekFrame;
+				for ( size_t I = imMovie.Keyframes().size(); I--; ) {
+					if ( imMovie.Keyframes()[I].ui64Frame <= _boOptions.ui64SeekFrame ) {
+						_brResults.ui64SeekFramesRun = _boOptions.ui64SeekFrame - imMovie.Keyframes()[I].ui64Frame;
+						break;
+					}
+				}
+				_brResults.bSeeked = true;
+			}
+			imMovie.Stop();
+		}
+
+		// Real-time pass, measuring master cycles per Tick() the way the emulator runs interactively.
+		if ( _boOptions.dTickSeconds > 0.0 && psbSystem->LoadRom( rRomCopy ) ) {
+			psbSystem->ResetState( false );
+			uint64_t ui64Ticks = 0;
+			while ( psbSystem->GetAccumulatedRealTime() < uint64_t( _boOptions.dTickSeconds * psbSystem->GetClockResolution() ) ) {
+				psbSystem->Tick();
+				++ui64Ticks;
+			}
+			_brResults.ui64Ticks = ui64Ticks;
+			_brResults.dCyclesPerTick = ui64Ticks ? psbSystem->GetMasterCounter() / double( ui64Ticks ) : 0.0;
+		}
+
+		// Paced pass, running 1 frame per frame period the way the emulator thread does, to check that the pacer sleeps rather than spins.
+		if ( _boOptions.ui64PaceFrames && psbSystem->LoadRom( rRomCopy ) ) {
+			psbSystem->ResetState( false );
+			CFramePacer fpPacer;
+			fpPacer.SetPeriod( psbSystem->GetMasterCyclesPerFrame() * psbSystem->GetMasterDiv(), psbSystem->GetMasterHz() );
+			const std::clock_t cCpuStart = std::clock();
+			const uint64_t ui64PaceStart = cClock.GetRealTick();
+			for ( uint64_t I = 0; I < _boOptions.ui64PaceFrames; ++I ) {
+				psbSystem->RunFrames( 1 );
+				fpPacer.Wait();
+			}
+			_brResults.dPacedWallTime = (cClock.GetRealTick() - ui64PaceStart) / double( cClock.GetResolution() );
+			_brResults.dPacedCpuTime = double( std::clock() - cCpuStart ) / CLOCKS_PER_SEC;
+			_brResults.dPacedExpectedTime = double( psbSystem->GetMasterCyclesPerFrame() * psbSystem->GetMasterDiv() ) * _boOptions.ui64PaceFrames / psbSystem->GetMasterHz();
+			_brResults.ui64PacedFrames = _boOptions.ui64PaceFrames;
+			_brResults.ui64PacedLate = fpPacer.LatePeriods();
+		}
+		psbSystem->SetInputPoller( nullptr );
+		return true;
+	}
+
+	/**
+	 * Formats results as human-readable text.
+	 *
+	 * \param _brResults The results.
+	 * \return Returns the formatted results.
+	 */
+	std::string CBenchmark::ToText( const LSN_BENCH_RESULTS &_brResults ) {
+		char szBuffer[1024];
+		std::snprintf( szBuffer, sizeof( szBuffer ),
+			"ROM: %s (%s).\n"
+			"Frames: %llu. Time: %.8f.\n"
+			"Master Cycles: %llu (%.8f MHz).\n"
+			"CPU Cycles: %llu (%.8f MHz).\n"
+			"%.8f FPS (%.4fx real time).\n"
+			"%.8f host cycles per master cycle.\n",
+			CUtilities::Utf16ToUtf8( _brResults.s16RomName.c_str() ).c_str(), RegionName( _brResults.pmRegion ),
+			static_cast<unsigned long long>(_brResults.ui64Frames), _brResults.dWallTime,
+			static_cast<unsigned long long>(_brResults.ui64MasterCycles), _brResults.dMasterMhz,
+			static_cast<unsigned long long>(_brResults.ui64CpuCycles), _brResults.dCpuMhz,
+			_brResults.dFps, _brResults.dSpeed,
+			_brResults.dHostCyclesPerMasterCycle );
+		std::string sRet = szBuffer;
+		if ( _brResults.ui64Ticks ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Ticks: %llu. %.8f cycles per Tick().\n",
+				static_cast<unsigned long long>(_brResults.ui64Ticks), _brResults.dCyclesPerTick );
+			sRet += szBuffer;
+		}
+		if ( _brResults.ui64PacedFrames ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Paced: %llu frames in %.6f s (real console %.6f s), %.6f s of CPU time, %llu late.\n",
+				static_cast<unsigned long long>(_brResults.ui64PacedFrames), _brResults.dPacedWallTime, _brResults.dPacedExpectedTime,
+				_brResults.dPacedCpuTime, static_cast<unsigned long long>(_brResults.ui64PacedLate) );
+			sRet += szBuffer;
+		}
+		std::snprintf( szBuffer, sizeof( szBuffer ), "Load: %.3f us. Load to first frame: %.3f us. Reset: %.3f us.\n",
+			_brResults.dLoadMicros, _brResults.dFirstFrameMicros, _brResults.dResetMicros );
+		sRet += szBuffer;
+		std::snprintf( szBuffer, sizeof( szBuffer ), "Page tables: %s, %llu of %u pages read directly, %llu written directly.\n",
+			_brResults.bFastPages ? "on" : "off",
+			static_cast<unsigned long long>(_brResults.ui64FastReadPages), unsigned( CCpuBus::LSN_BP_PAGES ) + unsigned( CPpuBus::LSN_BP_PAGES ),
+			static_cast<unsigned long long>(_brResults.ui64FastWritePages) );
+		sRet += szBuffer;
+		if ( _brResults.bFastCpu ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Fast CPU: %llu instructions, %llu of %llu CPU cycles (%.4f%%) run an instruction at a time.\n",
+				static_cast<unsigned long long>(_brResults.ui64FastCpuInstructions), static_cast<unsigned long long>(_brResults.ui64FastCpuCycles),
+				static_cast<unsigned long long>(_brResults.ui64CpuCycles),
+				_brResults.ui64CpuCycles ? _brResults.ui64FastCpuCycles * 100.0 / _brResults.ui64CpuCycles : 0.0 );
+			sRet += szBuffer;
+			if ( _brResults.bBlockCpu ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), "Block CPU: %llu runs, %.2f instructions per run.\n",
+					static_cast<unsigned long long>(_brResults.ui64FastCpuBlocks),
+					_brResults.ui64FastCpuBlocks ? double( _brResults.ui64FastCpuInstructions ) / _brResults.ui64FastCpuBlocks : 0.0 );
+				sRet += szBuffer;
+			}
+			if ( _brResults.bJitCpu ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), "JIT CPU: %llu instructions run through compiled code (%.4f%% of fast instructions), %llu blocks compiled.\n",
+					static_cast<unsigned long long>(_brResults.ui64JitInstructions),
+					_brResults.ui64FastCpuInstructions ? _brResults.ui64JitInstructions * 100.0 / _brResults.ui64FastCpuInstructions : 0.0,
+					static_cast<unsigned long long>(_brResults.ui64JitBlocks) );
+				sRet += szBuffer;
+			}
+			if ( _brResults.bIdleSkip ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), "Idle loops: %llu skips, %llu CPU cycles skipped (%.4f%% of CPU cycles), %llu in PPUSTATUS polling loops.\n",
+					static_cast<unsigned long long>(_brResults.ui64IdleSkips), static_cast<unsigned long long>(_brResults.ui64IdleCycles),
+					_brResults.ui64CpuCycles ? _brResults.ui64IdleCycles * 100.0 / _brResults.ui64CpuCycles : 0.0,
+					static_cast<unsigned long long>(_brResults.ui64IdleStatusCycles) );
+				sRet += szBuffer;
+			}
+#ifdef LSN_CPU_FAST_PATH_CHECK
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Fast CPU self-check failures: %llu.\n",
+				static_cast<unsigned long long>(_brResults.ui64FastCpuCheckFailures) );
+			sRet += szBuffer;
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+			if ( _brResults.bDecodeCache ) {
+				const CDecodeCache::LSN_DECODE_CACHE_STATS & dcsStats = _brResults.dcsDecodeCache;
+				std::snprintf( szBuffer, sizeof( szBuffer ), "Decode cache: %llu hits, %llu misses (%.4f%% hit rate), %llu invalidations, %llu blocks decoded.\n",
+					static_cast<unsigned long long>(dcsStats.ui64Hits), static_cast<unsigned long long>(dcsStats.ui64Misses),
+					dcsStats.HitRate() * 100.0,
+					static_cast<unsigned long long>(dcsStats.ui64Invalidations), static_cast<unsigned long long>(dcsStats.ui64Blocks) );
+				sRet += szBuffer;
+			}
+		}
+		std::snprintf( szBuffer, sizeof( szBuffer ), "Micro-op dispatch: %s, %llu-byte table (pointer table %llu bytes).\n",
+			_brResults.bSwitchDispatch ? "switch" : "pointers",
+			static_cast<unsigned long long>(_brResults.ui64DispatchTableSize), static_cast<unsigned long long>(_brResults.ui64PointerTableSize) );
+		sRet += szBuffer;
+		if ( _brResults.bCacheCounted ) {
+			const CCacheCounters::LSN_CACHE_COUNTS & ccCache = _brResults.ccCache;
+			sRet += "Host cache:";
+			for ( size_t I = 0; I < CCacheCounters::LSN_CC_TOTAL; ++I ) {
+				if ( ccCache.bValid[I] ) {
+					std::snprintf( szBuffer, sizeof( szBuffer ), " %s %llu", CCacheCounters::CounterName( CCacheCounters::LSN_CACHE_COUNTER( I ) ),
+						static_cast<unsigned long long>(ccCache.ui64Counts[I]) );
+				}
+				else {
+					std::snprintf( szBuffer, sizeof( szBuffer ), " %s n/a", CCacheCounters::CounterName( CCacheCounters::LSN_CACHE_COUNTER( I ) ) );
+				}
+				sRet += szBuffer;
+			}
+			const double dL1 = ccCache.MissRate( CCacheCounters::LSN_CC_L1D_READS, CCacheCounters::LSN_CC_L1D_READ_MISSES );
+			const double dLl = ccCache.MissRate( CCacheCounters::LSN_CC_LL_READS, CCacheCounters::LSN_CC_LL_READ_MISSES );
+			const double dBr = ccCache.MissRate( CCacheCounters::LSN_CC_BRANCHES, CCacheCounters::LSN_CC_BRANCH_MISSES );
+			std::snprintf( szBuffer, sizeof( szBuffer ), ".\n  L1D miss rate %.4f%%, last-level miss rate %.4f%%, branch miss rate %.4f%%.\n",
+				dL1 * 100.0, dLl * 100.0, dBr * 100.0 );
+			sRet += szBuffer;
+		}
+		else if ( _brResults.bCacheUnavailable ) {
+			sRet += "Host cache: unavailable (the host exposes no hardware performance counters).\n";
+		}
+		if ( _brResults.bProfiled ) {
+			const CSystemProfiler::LSN_PROFILE_FRAME & pfProfile = _brResults.pfProfile;
+			const uint64_t ui64Total = pfProfile.HostCycles();
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Profile (%llu frames):\n", static_cast<unsigned long long>(pfProfile.ui64Frame) );
+			sRet += szBuffer;
+			for ( size_t I = 0; I < CSystemProfiler::LSN_PC_TOTAL; ++I ) {
+				const CSystemProfiler::LSN_PROFILE_COUNTER & pcCounter = pfProfile.pcCounters[I];
+				std::snprintf( szBuffer, sizeof( szBuffer ), "  %-10s %14llu calls %18llu host cycles (%6.2f%%) %14.1f per frame\n",
+					CSystemProfiler::ComponentName( CSystemProfiler::LSN_PROFILE_COMPONENT( I ) ),
+					static_cast<unsigned long long>(pcCounter.ui64Calls), static_cast<unsigned long long>(pcCounter.ui64HostCycles),
+					ui64Total ? pcCounter.ui64HostCycles * 100.0 / ui64Total : 0.0,
+					pfProfile.ui64Frame ? double( pcCounter.ui64HostCycles ) / pfProfile.ui64Frame : 0.0 );
+				sRet += szBuffer;
+			}
+		}
+		if ( _brResults.bRewound ) {
+			const CRewindBuffer::LSN_REWIND_STATS & rsRewind = _brResults.rsRewind;
+			std::snprintf( szBuffer, sizeof( szBuffer ),
+				"Rewind: %llu frames (%llu keyframes), %llu-byte states.\n"
+				"  %llu bytes held (%.2f bytes per frame, %.2f%% of raw).\n"
+				"  %.3f us per capture, %.3f us per background encode.\n",
+				static_cast<unsigned long long>(rsRewind.ui64Frames), static_cast<unsigned long long>(rsRewind.ui64Keyframes),
+				static_cast<unsigned long long>(rsRewind.ui64StateSize),
+				static_cast<unsigned long long>(rsRewind.ui64Bytes),
+				rsRewind.ui64Frames ? double( rsRewind.ui64Bytes ) / rsRewind.ui64Frames : 0.0,
+				rsRewind.ui64RawBytes ? rsRewind.ui64Bytes * 100.0 / rsRewind.ui64RawBytes : 0.0,
+				rsRewind.dCaptureMicros, rsRewind.dEncodeMicros );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bDirtyTracked ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Dirty pages: %.2f per frame (%.2f bytes), %llu max, of %u (%u bytes).\n",
+				_brResults.ui64Frames ? double( _brResults.ui64DirtyPages ) / _brResults.ui64Frames : 0.0,
+				_brResults.ui64Frames ? double( _brResults.ui64DirtyPages * CCpuBus::LSN_BP_PAGE_SIZE ) / _brResults.ui64Frames : 0.0,
+				static_cast<unsigned long long>(_brResults.ui64MaxDirtyPages),
+				unsigned( CCpuBus::LSN_BP_PAGES ) + unsigned( CPpuBus::LSN_BP_PAGES ), unsigned( LSN_MEM_FULL_SIZE + LSN_PPU_MEM_FULL_SIZE ) );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bBusHistogram ) {
+			const CBusHistogram::LSN_HISTOGRAM_SUMMARY & hsBus = _brResults.hsBus;
+			const uint64_t ui64Total = hsBus.ui64Direct + hsBus.ui64Std + hsBus.ui64Handler;
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Bus accesses: CPU %llu reads, %llu writes; PPU %llu pattern, %llu nametable, %llu palette fetches, %llu writes.\n"
+				"  %.2f%% through the page tables, %.2f%% through StdRead()/StdWrite(), %.2f%% through other handlers.\n",
+				static_cast<unsigned long long>(hsBus.ui64CpuReads), static_cast<unsigned long long>(hsBus.ui64CpuWrites),
+				static_cast<unsigned long long>(hsBus.ui64PatternFetches), static_cast<unsigned long long>(hsBus.ui64NametableFetches),
+				static_cast<unsigned long long>(hsBus.ui64PaletteFetches), static_cast<unsigned long long>(hsBus.ui64PpuWrites),
+				ui64Total ? hsBus.ui64Direct * 100.0 / ui64Total : 0.0,
+				ui64Total ? hsBus.ui64Std * 100.0 / ui64Total : 0.0,
+				ui64Total ? hsBus.ui64Handler * 100.0 / ui64Total : 0.0 );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bWatched ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Watchpoints: %llu hits, %llu dropped.\n",
+				static_cast<unsigned long long>(_brResults.ui64WatchHits), static_cast<unsigned long long>(_brResults.ui64WatchDropped) );
+			sRet += szBuffer;
+			if ( _brResults.ui64WatchHits ) {
+				const CWatchpoints::LSN_WATCH_HIT & whHit = _brResults.whFirstHit;
+				std::snprintf( szBuffer, sizeof( szBuffer ), "  First: %s $%04X = $%02X at PC $%04X, CPU cycle %llu (watchpoint %u).\n",
+					whHit.ui8Type == CWatchpoints::LSN_WF_READ ? "read" : "write", whHit.ui16Address, whHit.ui8Value, whHit.ui16Pc,
+					static_cast<unsigned long long>(whHit.ui64Cycle), whHit.ui32Id );
+				sRet += szBuffer;
+			}
+		}
+		if ( _brResults.bRollback ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Rollback: %s, %.3f us host frame.\n",
+				_brResults.bRollbackSynced ? "in sync" : "desynced", _brResults.dRollbackBudget );
+			sRet += szBuffer;
+			for ( size_t I = 0; I < 2; ++I ) {
+				const CRollbackSession::LSN_ROLLBACK_STATS & rsStats = _brResults.rsRollback[I];
+				std::snprintf( szBuffer, sizeof( szBuffer ),
+					"  Player %u: %llu frames, %llu stalls, %llu mispredictions, %llu rollbacks (%.2f frames average, %u max).\n"
+					"    %.3f us per rollback (%.3f us max), %.3f us per frame (%.3f us max).\n",
+					unsigned( I + 1 ), static_cast<unsigned long long>(rsStats.ui64Frames), static_cast<unsigned long long>(rsStats.ui64Stalls),
+					static_cast<unsigned long long>(rsStats.ui64Mispredictions), static_cast<unsigned long long>(rsStats.ui64Rollbacks),
+					rsStats.dAvgDepth, rsStats.ui32MaxDepth,
+					rsStats.dAvgResimMicros, rsStats.dMaxResimMicros, rsStats.dAvgFrameMicros, rsStats.dMaxFrameMicros );
+				sRet += szBuffer;
+			}
+		}
+		if ( _brResults.bMovie ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ),
+				"Movie: %llu frames, %llu keyframes, %llu bytes.\n"
+				"  Playback %s (%.8f seconds).\n",
+				static_cast<unsigned long long>(_brResults.ui64MovieFrames), static_cast<unsigned long long>(_brResults.ui64MovieKeyframes),
+				static_cast<unsigned long long>(_brResults.ui64MovieBytes),
+				_brResults.bMovieSynced ? "in sync" : "desynced", _brResults.dMovieVerifySeconds );
+			sRet += szBuffer;
+			if ( !_brResults.bMovieSynced ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), "  First bad keyframe: %llu.\n", static_cast<unsigned long long>(_brResults.ui64MovieBadFrame) );
+				sRet += szBuffer;
+			}
+		}
+		if ( _brResults.bSeeked ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), "Seek: frame %llu in %.3f us (1 restore + %llu frames).\n",
+				static_cast<unsigned long long>(_brResults.ui64SeekFrame), _brResults.dSeekMicros,
+				static_cast<unsigned long long>(_brResults.ui64SeekFramesRun) );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bRanAhead ) {
+			const CRunAhead::LSN_RUN_AHEAD_STATS & rasRunAhead = _brResults.rasRunAhead;
+			std::snprintf( szBuffer, sizeof( szBuffer ),
+				"Run-ahead: %u frames%s, %llu times.\n"
+				"  %.3f us save, %.3f us load, %.3f us run (%.3f us total, %.3f us max).\n"
+				"  %u frames fit in %.3f us.\n",
+				rasRunAhead.ui32RunAhead, rasRunAhead.bSecondInstance ? " (second instance)" : "",
+				static_cast<unsigned long long>(rasRunAhead.ui64Frames),
+				rasRunAhead.dSaveMicros, rasRunAhead.dLoadMicros, rasRunAhead.dRunMicros, rasRunAhead.dTotalMicros, rasRunAhead.dMaxMicros,
+				_brResults.ui32RunAheadBudgetFrames, _brResults.dRunAheadBudget );
+			sRet += szBuffer;
+		}
+		return sRet;
+	}
+
+	/**
+	 * Formats results as a single JSON object.
+	 *
+	 * \param _brResults The results.
+	 * \return Returns the formatted results.
+	 */
+	std::string CBenchmark::ToJson( const LSN_BENCH_RESULTS &_brResults ) {
+		std::string sName;
+		for ( char cThis : CUtilities::Utf16ToUtf8( _brResults.s16RomName.c_str() ) ) {
+			if ( cThis == '"' || cThis == '\\' ) { sName.push_back( '\\' ); }
+			if ( static_cast<unsigned char>(cThis) >= 0x20 ) { sName.push_back( cThis ); }
+		}
+		char szBuffer[1024];
+		std::snprintf( szBuffer, sizeof( szBuffer ),
+			"{\"rom\":\"%s\",\"region\":\"%s\",\"frames\":%llu,\"seconds\":%.9f,"
+			"\"master_cycles\":%llu,\"master_mhz\":%.6f,\"cpu_cycles\":%llu,\"cpu_mhz\":%.6f,"
+			"\"fps\":%.6f,\"speed\":%.6f,\"host_cycles_per_master_cycle\":%.6f,"
+			"\"ticks\":%llu,\"cycles_per_tick\":%.6f",
+			sName.c_str(), RegionName( _brResults.pmRegion ),
+			static_cast<unsigned long long>(_brResults.ui64Frames), _brResults.dWallTime,
+			static_cast<unsigned long long>(_brResults.ui64MasterCycles), _brResults.dMasterMhz,
+			static_cast<unsigned long long>(_brResults.ui64CpuCycles), _brResults.dCpuMhz,
+			_brResults.dFps, _brResults.dSpeed, _brResults.dHostCyclesPerMasterCycle,
+			static_cast<unsigned long long>(_brResults.ui64Ticks), _brResults.dCyclesPerTick );
+		std::string sRet = szBuffer;
+		std::snprintf( szBuffer, sizeof( szBuffer ), ",\"load\":{\"load_us\":%.3f,\"first_frame_us\":%.3f,\"reset_us\":%.3f}",
+			_brResults.dLoadMicros, _brResults.dFirstFrameMicros, _brResults.dResetMicros );
+		sRet += szBuffer;
+		std::snprintf( szBuffer, sizeof( szBuffer ), ",\"page_tables\":{\"enabled\":%s,\"read_pages\":%llu,\"write_pages\":%llu,\"pages\":%u}",
+			_brResults.bFastPages ? "true" : "false",
+			static_cast<unsigned long long>(_brResults.ui64FastReadPages), static_cast<unsigned long long>(_brResults.ui64FastWritePages),
+			unsigned( CCpuBus::LSN_BP_PAGES ) + unsigned( CPpuBus::LSN_BP_PAGES ) );
+		sRet += szBuffer;
+		if ( _brResults.bFastCpu ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"fast_cpu\":{\"instructions\":%llu,\"cycles\":%llu",
+				static_cast<unsigned long long>(_brResults.ui64FastCpuInstructions), static_cast<unsigned long long>(_brResults.ui64FastCpuCycles) );
+			sRet += szBuffer;
+			if ( _brResults.bBlockCpu ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), ",\"blocks\":%llu", static_cast<unsigned long long>(_brResults.ui64FastCpuBlocks) );
+				sRet += szBuffer;
+			}
+			if ( _brResults.bJitCpu ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), ",\"jit\":{\"instructions\":%llu,\"blocks\":%llu}",
+					static_cast<unsigned long long>(_brResults.ui64JitInstructions), static_cast<unsigned long long>(_brResults.ui64JitBlocks) );
+				sRet += szBuffer;
+			}
+			if ( _brResults.bIdleSkip ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), ",\"idle\":{\"skips\":%llu,\"cycles\":%llu,\"ppustatus_cycles\":%llu}",
+					static_cast<unsigned long long>(_brResults.ui64IdleSkips), static_cast<unsigned long long>(_brResults.ui64IdleCycles),
+					static_cast<unsigned long long>(_brResults.ui64IdleStatusCycles) );
+				sRet += szBuffer;
+			}
+#ifdef LSN_CPU_FAST_PATH_CHECK
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"check_failures\":%llu",
+				static_cast<unsigned long long>(_brResults.ui64FastCpuCheckFailures) );
+			sRet += szBuffer;
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+			if ( _brResults.bDecodeCache ) {
+				const CDecodeCache::LSN_DECODE_CACHE_STATS & dcsStats = _brResults.dcsDecodeCache;
+				std::snprintf( szBuffer, sizeof( szBuffer ), ",\"decode_cache\":{\"hits\":%llu,\"misses\":%llu,\"hit_rate\":%.6f,\"invalidations\":%llu,\"blocks\":%llu}",
+					static_cast<unsigned long long>(dcsStats.ui64Hits), static_cast<unsigned long long>(dcsStats.ui64Misses),
+					dcsStats.HitRate(),
+					static_cast<unsigned long long>(dcsStats.ui64Invalidations), static_cast<unsigned long long>(dcsStats.ui64Blocks) );
+				sRet += szBuffer;
+			}
+			sRet += "}";
+		}
+		std::snprintf( szBuffer, sizeof( szBuffer ), ",\"dispatch\":{\"mode\":\"%s\",\"table_bytes\":%llu,\"pointer_table_bytes\":%llu}",
+			_brResults.bSwitchDispatch ? "switch" : "pointers",
+			static_cast<unsigned long long>(_brResults.ui64DispatchTableSize), static_cast<unsigned long long>(_brResults.ui64PointerTableSize) );
+		sRet += szBuffer;
+		if ( _brResults.bCacheCounted ) {
+			sRet += ",\"cache\":{";
+			for ( size_t I = 0; I < CCacheCounters::LSN_CC_TOTAL; ++I ) {
+				if ( _brResults.ccCache.bValid[I] ) {
+					std::snprintf( szBuffer, sizeof( szBuffer ), "%s\"%s\":%llu", I ? "," : "",
+						CCacheCounters::CounterName( CCacheCounters::LSN_CACHE_COUNTER( I ) ),
+						static_cast<unsigned long long>(_brResults.ccCache.ui64Counts[I]) );
+				}
+				else {
+					std::snprintf( szBuffer, sizeof( szBuffer ), "%s\"%s\":null", I ? "," : "",
+						CCacheCounters::CounterName( CCacheCounters::LSN_CACHE_COUNTER( I ) ) );
+				}
+				sRet += szBuffer;
+			}
+			sRet += "}";
+		}
+		else if ( _brResults.bCacheUnavailable ) {
+			sRet += ",\"cache\":null";
+		}
+		if ( _brResults.ui64PacedFrames ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"paced\":{\"frames\":%llu,\"seconds\":%.9f,\"console_seconds\":%.9f,\"cpu_seconds\":%.9f,\"late\":%llu}",
+				static_cast<unsigned long long>(_brResults.ui64PacedFrames), _brResults.dPacedWallTime, _brResults.dPacedExpectedTime,
+				_brResults.dPacedCpuTime, static_cast<unsigned long long>(_brResults.ui64PacedLate) );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bProfiled ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"profile\":{\"frames\":%llu",
+				static_cast<unsigned long long>(_brResults.pfProfile.ui64Frame) );
+			sRet += szBuffer;
+			for ( size_t I = 0; I < CSystemProfiler::LSN_PC_TOTAL; ++I ) {
+				std::snprintf( szBuffer, sizeof( szBuffer ), ",\"%s\":{\"calls\":%llu,\"host_cycles\":%llu}",
+					CSystemProfiler::ComponentName( CSystemProfiler::LSN_PROFILE_COMPONENT( I ) ),
+					static_cast<unsigned long long>(_brResults.pfProfile.pcCounters[I].ui64Calls),
+					static_cast<unsigned long long>(_brResults.pfProfile.pcCounters[I].ui64HostCycles) );
+				sRet += szBuffer;
+			}
+			sRet += "}";
+		}
+		if ( _brResults.bRewound ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"rewind\":{\"frames\":%llu,\"keyframes\":%llu,\"state_size\":%llu,"
+				"\"bytes\":%llu,\"raw_bytes\":%llu,\"capture_us\":%.3f,\"encode_us\":%.3f}",
+				static_cast<unsigned long long>(_brResults.rsRewind.ui64Frames), static_cast<unsigned long long>(_brResults.rsRewind.ui64Keyframes),
+				static_cast<unsigned long long>(_brResults.rsRewind.ui64StateSize),
+				static_cast<unsigned long long>(_brResults.rsRewind.ui64Bytes), static_cast<unsigned long long>(_brResults.rsRewind.ui64RawBytes),
+				_brResults.rsRewind.dCaptureMicros, _brResults.rsRewind.dEncodeMicros );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bDirtyTracked ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"dirty_pages\":{\"total\":%llu,\"max\":%llu,\"page_size\":%u,\"pages\":%u}",
+				static_cast<unsigned long long>(_brResults.ui64DirtyPages), static_cast<unsigned long long>(_brResults.ui64MaxDirtyPages),
+				unsigned( CCpuBus::LSN_BP_PAGE_SIZE ), unsigned( CCpuBus::LSN_BP_PAGES ) + unsigned( CPpuBus::LSN_BP_PAGES ) );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bBusHistogram ) {
+			const CBusHistogram::LSN_HISTOGRAM_SUMMARY & hsBus = _brResults.hsBus;
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"bus_accesses\":{\"cpu_reads\":%llu,\"cpu_writes\":%llu,\"pattern_fetches\":%llu,"
+				"\"nametable_fetches\":%llu,\"palette_fetches\":%llu,\"ppu_writes\":%llu,\"direct\":%llu,\"std\":%llu,\"handler\":%llu}",
+				static_cast<unsigned long long>(hsBus.ui64CpuReads), static_cast<unsigned long long>(hsBus.ui64CpuWrites),
+				static_cast<unsigned long long>(hsBus.ui64PatternFetches), static_cast<unsigned long long>(hsBus.ui64NametableFetches),
+				static_cast<unsigned long long>(hsBus.ui64PaletteFetches), static_cast<unsigned long long>(hsBus.ui64PpuWrites),
+				static_cast<unsigned long long>(hsBus.ui64Direct), static_cast<unsigned long long>(hsBus.ui64Std),
+				static_cast<unsigned long long>(hsBus.ui64Handler) );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bWatched ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"watchpoints\":{\"hits\":%llu,\"dropped\":%llu",
+				static_cast<unsigned long long>(_brResults.ui64WatchHits), static_cast<unsigned long long>(_brResults.ui64WatchDropped) );
+			sRet += szBuffer;
+			if ( _brResults.ui64WatchHits ) {
+				const CWatchpoints::LSN_WATCH_HIT & whHit = _brResults.whFirstHit;
+				std::snprintf( szBuffer, sizeof( szBuffer ), ",\"first\":{\"type\":\"%s\",\"address\":%u,\"value\":%u,\"pc\":%u,\"cycle\":%llu,\"id\":%u}",
+					whHit.ui8Type == CWatchpoints::LSN_WF_READ ? "read" : "write", whHit.ui16Address, whHit.ui8Value, whHit.ui16Pc,
+					static_cast<unsigned long long>(whHit.ui64Cycle), whHit.ui32Id );
+				sRet += szBuffer;
+			}
+			sRet += "}";
+		}
+		if ( _brResults.bRollback ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"rollback\":{\"synced\":%s,\"frame_us\":%.3f,\"players\":[",
+				_brResults.bRollbackSynced ? "true" : "false", _brResults.dRollbackBudget );
+			sRet += szBuffer;
+			for ( size_t I = 0; I < 2; ++I ) {
+				const CRollbackSession::LSN_ROLLBACK_STATS & rsStats = _brResults.rsRollback[I];
+				std::snprintf( szBuffer, sizeof( szBuffer ), "%s{\"frames\":%llu,\"stalls\":%llu,\"mispredictions\":%llu,\"rollbacks\":%llu,"
+					"\"resim_frames\":%llu,\"avg_depth\":%.3f,\"max_depth\":%u,\"avg_resim_us\":%.3f,\"max_resim_us\":%.3f,"
+					"\"avg_frame_us\":%.3f,\"max_frame_us\":%.3f}",
+					I ? "," : "",
+					static_cast<unsigned long long>(rsStats.ui64Frames), static_cast<unsigned long long>(rsStats.ui64Stalls),
+					static_cast<unsigned long long>(rsStats.ui64Mispredictions), static_cast<unsigned long long>(rsStats.ui64Rollbacks),
+					static_cast<unsigned long long>(rsStats.ui64ResimFrames), rsStats.dAvgDepth, rsStats.ui32MaxDepth,
+					rsStats.dAvgResimMicros, rsStats.dMaxResimMicros, rsStats.dAvgFrameMicros, rsStats.dMaxFrameMicros );
+				sRet += szBuffer;
+			}
+			sRet += "]}";
+		}
+		if ( _brResults.bMovie ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"movie\":{\"frames\":%llu,\"keyframes\":%llu,\"bytes\":%llu,\"synced\":%s,"
+				"\"bad_frame\":%llu,\"verify_seconds\":%.9f}",
+				static_cast<unsigned long long>(_brResults.ui64MovieFrames), static_cast<unsigned long long>(_brResults.ui64MovieKeyframes),
+				static_cast<unsigned long long>(_brResults.ui64MovieBytes), _brResults.bMovieSynced ? "true" : "false",
+				static_cast<unsigned long long>(_brResults.ui64MovieBadFrame), _brResults.dMovieVerifySeconds );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bSeeked ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"seek\":{\"frame\":%llu,\"frames_run\":%llu,\"us\":%.3f}",
+				static_cast<unsigned long long>(_brResults.ui64SeekFrame), static_cast<unsigned long long>(_brResults.ui64SeekFramesRun),
+				_brResults.dSeekMicros );
+			sRet += szBuffer;
+		}
+		if ( _brResults.bRanAhead ) {
+			std::snprintf( szBuffer, sizeof( szBuffer ), ",\"run_ahead\":{\"frames\":%u,\"second_instance\":%s,\"runs\":%llu,"
+				"\"save_us\":%.3f,\"load_us\":%.3f,\"run_us\":%.3f,\"total_us\":%.3f,\"max_us\":%.3f,\"budget_us\":%.3f,\"budget_frames\":%u}",
+				_brResults.rasRunAhead.ui32RunAhead, _brResults.rasRunAhead.bSecondInstance ? "true" : "false",
+				static_cast<unsigned long long>(_brResults.rasRunAhead.ui64Frames),
+				_brResults.rasRunAhead.dSaveMicros, _brResults.rasRunAhead.dLoadMicros, _brResults.rasRunAhead.dRunMicros,
+				_brResults.rasRunAhead.dTotalMicros, _brResults.rasRunAhead.dMaxMicros,
+				_brResults.dRunAheadBudget, _brResults.ui32RunAheadBudgetFrames );
+			sRet += szBuffer;
+		}
+		sRet += "}\n";
+		return sRet;
+	}
+
+	/**
+	 * Gets the usage text.
+	 *
+	 * \return Returns the usage text.
+	 */
+	const char * CBenchmark::Usage() {
+		return "Usage: <rom.nes|rom.zip> [options]\n"
+			"  --region ntsc|pal|dendy|auto   Region to emulate (default: auto).\n"
+			"  --frames N                     Frames to run (default: 600).\n"
+			"  --input FILE                   Per-frame input, 2 bytes per frame (port 0, port 1).\n"
+			"  --unrolled                     Use the unrolled scheduler.\n"
+			"  --lazy-ppu                     Use lazy-PPU mode.\n"
+			"  --no-fast-pages                Send every bus access through its per-address function instead of the page tables.\n"
+			"  --fast-cpu                     Run instructions that only touch plain RAM/ROM in 1 call each (with --lazy-ppu only).\n"
+			"  --block-cpu                    With --fast-cpu, run eligible instructions back-to-back up to the next PPU sync point.\n"
+			"  --jit-cpu                      With --block-cpu, run back-to-back instructions through compiled x86-64 code (x86-64 Linux only).\n"
+			"  --no-decode-cache              With --fast-cpu, decode every instruction instead of caching decoded blocks.\n"
+			"  --switch-dispatch              Dispatch CPU micro-ops through a switch on 1-byte ID's instead of function pointers.\n"
+			"  --idle-skip                    With --fast-cpu, skip passes of loops that cannot change anything until the next PPU event.\n"
+			"  --cache-counters               Report host L1D and last-level cache reads and misses and branch misses over the run (Linux only).\n"
+			"  --profile                      Report the host time spent in each component (runs a profiled system).\n"
+			"  --rewind                       Capture every frame into the rewind buffer and report its memory use and capture cost.\n"
+			"  --dirty-pages                  Report the number of 256-byte bus pages written per frame (incremental snapshot size).\n"
+			"  --watch ADDR[-END][:r|w|rw][=VAL]\n"
+			"                                 Watch CPU-bus reads and/or writes (hex; default rw), optionally only of value VAL, and\n"
+			"                                 report the hits.  May be repeated.\n"
+			"  --bus-histogram FILE           Write per-page CPU/PPU bus access counts to FILE (.json for JSON, otherwise CSV).  Requires a\n"
+			"                                 build with LSN_BUS_HISTOGRAM defined.\n"
+			"  --bus-histogram-per-frame      Write the counts of each frame rather than of the whole run.\n"
+			"  --run-ahead N                  Run N frames ahead after every frame and report the cost per frame.\n"
+			"  --run-ahead-second             Run the run-ahead frames on a second system instead of restoring the first.\n"
+			"  --run-ahead-budget US          Microseconds per frame left for run-ahead (default: the console's frame period).\n"
+			"  --record-movie FILE            Record the run to a movie file, then play it back and check it bit-for-bit.\n"
+			"  --keyframe-interval N          Frames between save-state keyframes when recording (default: 300).\n"
+			"  --movie FILE                   After the run, play back a movie and check it bit-for-bit.\n"
+			"  --seek N                       After checking the movie, seek to frame N and report the time taken.\n"
+			"  --rollback                     Run 2 systems as a rollback session over a loopback link and report the rollback cost.\n"
+			"  --rollback-latency MS          One-way latency of the loopback link (default: 50).\n"
+			"  --rollback-jitter MS           Most extra random latency of the loopback link (default: 0).\n"
+			"  --rollback-delay N             Frames of local input delay (default: 0).\n"
+			"  --rollback-max N               Most frames run on predicted input before waiting (default: 8).\n"
+			"  --tick-seconds S               Also run the real-time Tick() loop for S seconds to measure cycles per Tick().\n"
+			"  --pace-frames N                Also run N frames paced to real time and report the wall and CPU time taken.\n"
+			"  --json                         Print a single JSON object.\n";
+	}
+
+	/**
+	 * Loads a file, extracting the first .NES file if it is a ZIP archive.
+	 *
+	 * \param _s16Path The path to the file.
+	 * \param _vData Holds the returned file data.
+	 * \param _s16Name Holds the returned name of the loaded file.
+	 * \param _bRom If true and the file is an archive, the first .NES file is extracted.
+	 * \return Returns true if the file was loaded.
+	 */
+	bool CBenchmark::LoadFile( const std::u16string &_s16Path, std::vector<uint8_t> &_vData, std::u16string &_s16Name, bool _bRom ) {
+		_vData.clear();
+		_s16Name = _s16Path;
+		if ( _bRom ) {
+			CZipFile zfFile;
+			if ( zfFile.Open( _s16Path.c_str() ) && zfFile.IsArchive() ) {
+				std::vector<std::u16string> vFiles;
+				zfFile.GatherArchiveFiles( vFiles );
+				for ( size_t I = 0; I < vFiles.size(); ++I ) {
+					std::u16string s16Ext = CUtilities::GetFileExtension( vFiles[I] );
+					if ( s16Ext.size() == 3 &&
+						(s16Ext[0] | 0x20) == u'n' && (s16Ext[1] | 0x20) == u'e' && (s16Ext[2] | 0x20) == u's' ) {
+						_s16Name = vFiles[I];
+						return zfFile.ExtractToMemory( vFiles[I], _vData );
+					}
+				}
+				return false;
+			}
+		}
+		CStdFile sfFile;
+		if ( !sfFile.Open( _s16Path.c_str() ) ) { return false; }
+		return sfFile.LoadToMemory( _vData );
+	}
+
+	/**
+	 * Gets the name of a region.
+	 *
+	 * \param _pmRegion The region.
+	 * \return Returns the name of the region.
+	 */
+	const char * CBenchmark::RegionName( LSN_PPU_METRICS _pmRegion ) {
+		switch ( _pmRegion ) {
+			case LSN_PM_NTSC : { return "ntsc"; }
+			case LSN_PM_PAL : { return "pal"; }
+			case LSN_PM_DENDY : { return "dendy"; }
+			default : { return "unknown"; }
+		}
+	}
+
+	/**
+	 * Parses a watchpoint of the form ADDR[-END][:r|w|rw][=VAL], with hexadecimal addresses and value.
+	 *
+	 * \param _pcSpec The watchpoint text.
+	 * \param _wWatch Holds the returned watchpoint.
+	 * \return Returns true if the text was valid.
+	 */
+	bool CBenchmark::ParseWatch( const char * _pcSpec, CWatchpoints::LSN_WATCHPOINT &_wWatch ) {
+		_wWatch = CWatchpoints::LSN_WATCHPOINT();
+		char * pcEnd = nullptr;
+		unsigned long ulStart = std::strtoul( _pcSpec, &pcEnd, 16 );
+		if ( pcEnd == _pcSpec || ulStart > 0xFFFF ) { return false; }
+		unsigned long ulEnd = ulStart;
+		if ( (*pcEnd) == '-' ) {
+			const char * pcEndAddr = pcEnd + 1;
+			ulEnd = std::strtoul( pcEndAddr, &pcEnd, 16 );
+			if ( pcEnd == pcEndAddr || ulEnd > 0xFFFF || ulEnd < ulStart ) { return false; }
+		}
+		_wWatch.ui8Flags = CWatchpoints::LSN_WF_READ | CWatchpoints::LSN_WF_WRITE;
+		if ( (*pcEnd) == ':' ) {
+			++pcEnd;
+			_wWatch.ui8Flags = 0;
+			for ( ; (*pcEnd) == 'r' || (*pcEnd) == 'w'; ++pcEnd ) {
+				_wWatch.ui8Flags |= (*pcEnd) == 'r' ? CWatchpoints::LSN_WF_READ : CWatchpoints::LSN_WF_WRITE;
+			}
+			if ( !_wWatch.ui8Flags ) { return false; }
+		}
+		if ( (*pcEnd) == '=' ) {
+			const char * pcVal = pcEnd + 1;
+			unsigned long ulVal = std::strtoul( pcVal, &pcEnd, 16 );
+			if ( pcEnd == pcVal || ulVal > 0xFF ) { return false; }
+			_wWatch.ui8Flags |= CWatchpoints::LSN_WF_VALUE;
+			_wWatch.ui8Value = uint8_t( ulVal );
+		}
+		if ( (*pcEnd) != '\0' ) { return false; }
+		_wWatch.ui16Start = uint16_t( ulStart );
+		_wWatch.ui16End = uint16_t( ulEnd );
+		return true;
+	}
+
+}	// namespace lsn
+
+#undef LSN_HOST_CYCLES
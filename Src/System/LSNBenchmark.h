@@ -0,0 +1,246 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: The headless command-line benchmark.  Loads a ROM, runs it uncapped for a number of frames, and reports the emulation speed
+ *	as text or JSON.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Bus/LSNBusHistogram.h"
+#include "../Input/LSNInputMovie.h"
+#include "../Utilities/LSNCacheCounters.h"
+#include "LSNRewindBuffer.h"
+#include "LSNRollbackSession.h"
+#include "LSNRunAhead.h"
+#include "LSNSystemBase.h"
+
+#include <string>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CBenchmark
+	 * \brief The headless command-line benchmark.
+	 *
+	 * Description: The headless command-line benchmark.  Loads a ROM, runs it uncapped for a number of frames, and reports the emulation speed
+	 *	as text or JSON.
+	 */
+	class CBenchmark {
+	public :
+		// == Types.
+		/** Benchmark options. */
+		struct LSN_BENCH_OPTIONS {
+			std::u16string								s16RomPath;							/**< The ROM (.nes or .zip). */
+			std::u16string								s16InputPath;						/**< Optional per-frame input file (see CFrameInputPoller::FromFile()). */
+			LSN_PPU_METRICS								pmRegion = LSN_PM_UNKNOWN;			/**< The region.  If LSN_PM_UNKNOWN, the ROM's region is used. */
+			uint64_t									ui64Frames = 600;					/**< The number of frames to run. */
+			double										dTickSeconds = 0.0;					/**< If not 0, the real-time Tick() loop is also run for this many seconds to measure master cycles per Tick(). */
+			uint64_t									ui64PaceFrames = 0;					/**< If not 0, this many frames are also run paced to real time by CFramePacer to measure its accuracy and CPU use. */
+			bool										bUnrolled = false;					/**< Use the unrolled scheduler. */
+			bool										bLazyPpu = false;					/**< Use lazy-PPU mode. */
+			bool										bFastPages = true;					/**< Access plain RAM/ROM bus pages directly through the page tables. */
+			bool										bFastCpu = false;					/**< Run eligible instructions in 1 call each (lazy-PPU mode only). */
+			bool										bDecodeCache = true;				/**< Look instructions run in 1 call each up in the decoded-block cache. */
+			bool										bBlockCpu = false;					/**< Run eligible instructions back-to-back up to the next sync point (with bFastCpu only). */
+			bool										bJitCpu = false;					/**< Run back-to-back instructions through compiled x86-64 code (with bBlockCpu only). */
+			bool										bSwitchDispatch = false;			/**< Dispatch the CPU's micro-ops through a switch on 1-byte ID's instead of through function pointers. */
+			bool										bIdleSkip = false;					/**< Skip passes of idle loops up to the next sync point (with bFastCpu only). */
+			bool										bCacheCounters = false;				/**< Read the host's cache-miss counters around the uncapped run. */
+			bool										bProfile = false;					/**< Run a profiled system and report the time spent in each component. */
+			bool										bRewind = false;					/**< Capture every frame into a rewind buffer and report its memory use and capture cost. */
+			uint32_t									ui32RunAhead = 0;					/**< If not 0, run this many frames ahead after every frame and report the cost. */
+			bool										bRunAheadSecondInstance = false;	/**< Run the run-ahead frames on a second system. */
+			double										dRunAheadBudget = 0.0;				/**< Microseconds per frame available for run-ahead.  If 0, the console's frame period is used. */
+			bool										bDirtyPages = false;				/**< Count the bus pages written each frame and report the size of incremental snapshots. */
+			std::vector<CWatchpoints::LSN_WATCHPOINT>	vWatches;							/**< CPU-bus watchpoints whose hits are drained every frame and reported. */
+			std::u16string								s16BusHistogramPath;				/**< If not empty, per-page bus access counts are written to this file (.json for JSON, otherwise CSV).  Requires LSN_BUS_HISTOGRAM. */
+			bool										bBusHistogramPerFrame = false;		/**< Write the bus access counts of each frame rather than of the whole run. */
+			std::u16string								s16RecordMoviePath;					/**< If not empty, the run is recorded to this movie file, which is then verified. */
+			uint32_t									ui32KeyframeInterval = CInputMovie::LSN_IM_DEFAULT_KEYFRAME_INTERVAL;	/**< Frames between movie keyframes when recording. */
+			std::u16string								s16MoviePath;						/**< If not empty, this movie is played back after the run and verified. */
+			uint64_t									ui64SeekFrame = UINT64_MAX;			/**< If not UINT64_MAX, the movie is seeked to this frame after verifying and the seek is timed. */
+			bool										bRollback = false;					/**< Run 2 systems as a rollback session over a loopback link and report the rollback cost. */
+			double										dRollbackLatency = 50.0;			/**< The one-way latency of the loopback link, in milliseconds. */
+			double										dRollbackJitter = 0.0;				/**< The most extra random latency of the loopback link, in milliseconds. */
+			uint32_t									ui32RollbackDelay = 0;				/**< Frames of local input delay. */
+			uint32_t									ui32RollbackMax = CRollbackSession::LSN_RS_DEFAULT_MAX_ROLLBACK;	/**< The most frames run on predicted input. */
+			bool										bJson = false;						/**< Print JSON instead of text. */
+		};
+
+		/** Benchmark results. */
+		struct LSN_BENCH_RESULTS {
+			std::u16string								s16RomName;							/**< The name of the ROM that was run. */
+			LSN_PPU_METRICS								pmRegion = LSN_PM_UNKNOWN;			/**< The region that was run. */
+			uint64_t									ui64Frames = 0;						/**< Frames run. */
+			uint64_t									ui64MasterCycles = 0;				/**< Master cycles run. */
+			uint64_t									ui64CpuCycles = 0;					/**< CPU cycles run. */
+			uint64_t									ui64HostCycles = 0;					/**< Host time-stamp-counter cycles spent running. */
+			double										dWallTime = 0.0;					/**< Seconds spent running. */
+			double										dMasterMhz = 0.0;					/**< Emulated master clock, in MHz. */
+			double										dCpuMhz = 0.0;						/**< Emulated CPU clock, in MHz. */
+			double										dFps = 0.0;							/**< Emulated frames per second. */
+			double										dSpeed = 0.0;						/**< Speed relative to the real console. */
+			double										dHostCyclesPerMasterCycle = 0.0;	/**< Host cycles per emulated master cycle. */
+			double										dCyclesPerTick = 0.0;				/**< Master cycles per real-time Tick() (only if LSN_BENCH_OPTIONS::dTickSeconds is not 0). */
+			uint64_t									ui64Ticks = 0;						/**< The number of real-time Tick() calls (only if LSN_BENCH_OPTIONS::dTickSeconds is not 0). */
+			uint64_t									ui64PacedFrames = 0;				/**< Frames run paced to real time (LSN_BENCH_OPTIONS::ui64PaceFrames). */
+			uint64_t									ui64PacedLate = 0;					/**< Paced frames whose deadline had already passed. */
+			double										dPacedWallTime = 0.0;				/**< Seconds of wall time taken by the paced frames. */
+			double										dPacedExpectedTime = 0.0;			/**< Seconds the paced frames take on the real console. */
+			double										dPacedCpuTime = 0.0;				/**< Seconds of process CPU time taken by the paced frames. */
+			double										dLoadMicros = 0.0;					/**< Microseconds from the ROM file in memory to a reset system ready to run. */
+			double										dFirstFrameMicros = 0.0;			/**< Microseconds from the ROM file in memory to the end of the first frame. */
+			double										dResetMicros = 0.0;					/**< Average microseconds per ResetState() once the ROM is loaded. */
+			bool										bFastPages = false;					/**< True if the page tables were used. */
+			uint64_t									ui64FastReadPages = 0;				/**< CPU-bus and PPU-bus pages read directly. */
+			uint64_t									ui64FastWritePages = 0;				/**< CPU-bus and PPU-bus pages written directly. */
+			bool										bFastCpu = false;					/**< True if eligible instructions were run in 1 call each. */
+			uint64_t									ui64FastCpuInstructions = 0;		/**< Instructions run in 1 call each. */
+			uint64_t									ui64FastCpuCycles = 0;				/**< CPU cycles inside instructions run in 1 call each. */
+			bool										bBlockCpu = false;					/**< True if eligible instructions were run back-to-back. */
+			uint64_t									ui64FastCpuBlocks = 0;				/**< Runs of back-to-back instructions. */
+			bool										bJitCpu = false;					/**< True if back-to-back instructions were run through compiled code. */
+			uint64_t									ui64JitInstructions = 0;			/**< Instructions run through compiled code (included in ui64FastCpuInstructions). */
+			uint64_t									ui64JitBlocks = 0;					/**< Blocks of instructions compiled. */
+			uint64_t									ui64FastCpuCheckFailures = 0;		/**< Instructions run in 1 call that failed the LSN_CPU_FAST_PATH_CHECK checks. */
+			bool										bIdleSkip = false;					/**< True if passes of idle loops were skipped. */
+			uint64_t									ui64IdleSkips = 0;					/**< Times passes of an idle loop were skipped. */
+			uint64_t									ui64IdleCycles = 0;					/**< CPU cycles skipped in idle loops. */
+			uint64_t									ui64IdleStatusCycles = 0;			/**< CPU cycles skipped in loops polling PPUSTATUS (included in ui64IdleCycles). */
+			bool										bDecodeCache = false;				/**< True if the decoded-block cache was used. */
+			CDecodeCache::LSN_DECODE_CACHE_STATS		dcsDecodeCache = {};				/**< Decoded-block cache statistics (only if bDecodeCache is true). */
+			bool										bSwitchDispatch = false;			/**< True if the CPU's micro-ops were dispatched through the switch. */
+			uint64_t									ui64DispatchTableSize = 0;			/**< The size in bytes of the table read by the CPU's dispatcher on each cycle. */
+			uint64_t									ui64PointerTableSize = 0;			/**< The size in bytes of the handler pointers in the instruction table. */
+			CCacheCounters::LSN_CACHE_COUNTS			ccCache = {};						/**< Host cache counters over the uncapped run (only if LSN_BENCH_OPTIONS::bCacheCounters is true). */
+			bool										bCacheCounted = false;				/**< True if ccCache is valid. */
+			bool										bCacheUnavailable = false;			/**< True if the cache counters were requested but the host provides none. */
+			CSystemProfiler::LSN_PROFILE_FRAME			pfProfile = {};						/**< Per-component totals over the uncapped run (only if LSN_BENCH_OPTIONS::bProfile is true). */
+			bool										bProfiled = false;					/**< True if pfProfile is valid. */
+			CRewindBuffer::LSN_REWIND_STATS				rsRewind = {};						/**< Rewind-buffer statistics after the uncapped run (only if LSN_BENCH_OPTIONS::bRewind is true). */
+			bool										bRewound = false;					/**< True if rsRewind is valid. */
+			CRunAhead::LSN_RUN_AHEAD_STATS				rasRunAhead = {};					/**< Run-ahead statistics (only if LSN_BENCH_OPTIONS::ui32RunAhead is not 0). */
+			double										dRunAheadBudget = 0.0;				/**< The microseconds per frame available for run-ahead. */
+			uint32_t									ui32RunAheadBudgetFrames = 0;		/**< The number of frames that can be run ahead within dRunAheadBudget. */
+			bool										bRanAhead = false;					/**< True if rasRunAhead is valid. */
+			uint64_t									ui64DirtyPages = 0;					/**< The total number of CPU-bus and PPU-bus pages written, counted per frame (only if LSN_BENCH_OPTIONS::bDirtyPages is true). */
+			uint64_t									ui64MaxDirtyPages = 0;				/**< The most pages written in 1 frame. */
+			bool										bDirtyTracked = false;				/**< True if ui64DirtyPages and ui64MaxDirtyPages are valid. */
+			uint64_t									ui64WatchHits = 0;					/**< Watchpoint hits drained from the ring buffer (only if LSN_BENCH_OPTIONS::vWatches is not empty). */
+			uint64_t									ui64WatchDropped = 0;				/**< Watchpoint hits dropped because the ring buffer was full. */
+			CWatchpoints::LSN_WATCH_HIT					whFirstHit = {};					/**< The first hit, if ui64WatchHits is not 0. */
+			bool										bWatched = false;					/**< True if the watchpoint values above are valid. */
+			CBusHistogram::LSN_HISTOGRAM_SUMMARY		hsBus = {};							/**< Bus access totals (only if LSN_BENCH_OPTIONS::s16BusHistogramPath is not empty). */
+			bool										bBusHistogram = false;				/**< True if hsBus is valid. */
+			uint64_t									ui64MovieFrames = 0;				/**< The number of frames in the movie. */
+			uint64_t									ui64MovieKeyframes = 0;				/**< The number of keyframes in the movie. */
+			uint64_t									ui64MovieBytes = 0;					/**< The size of the movie file. */
+			bool										bMovieSynced = false;				/**< True if playback matched every keyframe bit-for-bit. */
+			uint64_t									ui64MovieBadFrame = 0;				/**< The first keyframe that did not match, if bMovieSynced is false. */
+			double										dMovieVerifySeconds = 0.0;			/**< Seconds spent playing back and verifying the whole movie. */
+			bool										bMovie = false;						/**< True if the movie values above are valid. */
+			uint64_t									ui64SeekFrame = 0;					/**< The frame that was seeked to. */
+			uint64_t									ui64SeekFramesRun = 0;				/**< The frames emulated after restoring the nearest keyframe. */
+			double										dSeekMicros = 0.0;					/**< Microseconds spent seeking. */
+			bool										bSeeked = false;					/**< True if the seek values above are valid. */
+			CRollbackSession::LSN_ROLLBACK_STATS		rsRollback[2] = {};					/**< Rollback statistics for both sides (only if LSN_BENCH_OPTIONS::bRollback is true). */
+			double										dRollbackBudget = 0.0;				/**< The host frame period in microseconds, within which each frame and its rollback must fit. */
+			bool										bRollbackSynced = false;			/**< True if both systems ended in the same state. */
+			bool										bRollback = false;					/**< True if the rollback values above are valid. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Runs the benchmark from the command line: parses arguments, runs, and prints the results to stdout.
+		 *
+		 * \param _iArgC The number of arguments.
+		 * \param _ppcArgV The arguments, in UTF-8.
+		 * \return Returns the process exit code.
+		 */
+		static int										Main( int _iArgC, char * _ppcArgV[] );
+
+		/**
+		 * Parses the command line.
+		 *
+		 * \param _iArgC The number of arguments.
+		 * \param _ppcArgV The arguments, in UTF-8.
+		 * \param _boOptions Holds the returned options.
+		 * \param _sError Holds the returned error message.
+		 * \return Returns true if the command line was valid.
+		 */
+		static bool										ParseCommandLine( int _iArgC, char * _ppcArgV[], LSN_BENCH_OPTIONS &_boOptions, std::string &_sError );
+
+		/**
+		 * Runs the benchmark.
+		 *
+		 * \param _boOptions The options.
+		 * \param _brResults Holds the returned results.
+		 * \param _sError Holds the returned error message.
+		 * \return Returns true if the benchmark ran.
+		 */
+		static bool										Run( const LSN_BENCH_OPTIONS &_boOptions, LSN_BENCH_RESULTS &_brResults, std::string &_sError );
+
+		/**
+		 * Formats results as human-readable text.
+		 *
+		 * \param _brResults The results.
+		 * \return Returns the formatted results.
+		 */
+		static std::string								ToText( const LSN_BENCH_RESULTS &_brResults );
+
+		/**
+		 * Formats results as a single JSON object.
+		 *
+		 * \param _brResults The results.
+		 * \return Returns the formatted results.
+		 */
+		static std::string								ToJson( const LSN_BENCH_RESULTS &_brResults );
+
+		/**
+		 * Gets the usage text.
+		 *
+		 * \return Returns the usage text.
+		 */
+		static const char *								Usage();
+
+
+	protected :
+		// == Functions.
+		/**
+		 * Loads a file, extracting the first .NES file if it is a ZIP archive.
+		 *
+		 * \param _s16Path The path to the file.
+		 * \param _vData Holds the returned file data.
+		 * \param _s16Name Holds the returned name of the loaded file.
+		 * \param _bRom If true and the file is an archive, the first .NES file is extracted.
+		 * \return Returns true if the file was loaded.
+		 */
+		static bool										LoadFile( const std::u16string &_s16Path, std::vector<uint8_t> &_vData, std::u16string &_s16Name, bool _bRom );
+
+		/**
+		 * Gets the name of a region.
+		 *
+		 * \param _pmRegion The region.
+		 * \return Returns the name of the region.
+		 */
+		static const char *								RegionName( LSN_PPU_METRICS _pmRegion );
+
+		/**
+		 * Parses a watchpoint of the form ADDR[-END][:r|w|rw][=VAL], with hexadecimal addresses and value.
+		 *
+		 * \param _pcSpec The watchpoint text.
+		 * \param _wWatch Holds the returned watchpoint.
+		 * \return Returns true if the text was valid.
+		 */
+		static bool										ParseWatch( const char * _pcSpec, CWatchpoints::LSN_WATCHPOINT &_wWatch );
+	};
+
+}	// namespace lsn
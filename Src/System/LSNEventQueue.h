@@ -0,0 +1,183 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A queue of events keyed by absolute master-cycle timestamps.  Hardware that only needs to do something at
+ *	known points in time (the APU frame counter, mapper cycle-counter IRQ's, etc.) schedules itself here instead of being
+ *	ticked every cycle, and the system scheduler runs each event just before the components tick on that master cycle.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+
+namespace lsn {
+
+	/**
+	 * Class CEventQueue
+	 * \brief A queue of events keyed by absolute master-cycle timestamps.
+	 *
+	 * Description: A queue of events keyed by absolute master-cycle timestamps.  Hardware that only needs to do something at
+	 *	known points in time (the APU frame counter, mapper cycle-counter IRQ's, etc.) schedules itself here instead of being
+	 *	ticked every cycle, and the system scheduler runs each event just before the components tick on that master cycle.
+	 */
+	class CEventQueue {
+	public :
+		CEventQueue() :
+			m_stTotal( 0 ),
+			m_pui64Horizon( nullptr ),
+			m_ui64CpuDiv( 1 ),
+			m_ui64CpuCycleBase( 0 ) {
+		}
+
+
+		// == Enumerations.
+		/** Queue limits. */
+		enum LSN_EVENT_QUEUE {
+			LSN_EQ_MAX_EVENTS								= 16,									/**< Maximum number of events that can be pending at once.  Every source cancels its own event before scheduling the next (the APU frame counter, 1 per CMapperBase::ScheduleCpuEvent() function/parameter pair), so this only fills if a source leaks events. */
+		};
+
+
+		// == Types.
+		/** An event function.  Receives the parameter passed to Schedule() and the master cycle at which the event was scheduled. */
+		typedef void (LSN_FASTCALL *						PfEventFunc)( void * _pvParm, uint64_t _ui64Time );
+
+		/** An event. */
+		struct LSN_EVENT {
+			uint64_t										ui64Time;								/**< The master cycle at which to run the event. */
+			PfEventFunc										pfFunc;									/**< The function to call. */
+			void *											pvParm;									/**< The parameter to pass to the function. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Removes all events.
+		 */
+		inline void											Reset() {
+			m_stTotal = 0;
+		}
+
+		/**
+		 * Sets the horizon, which is the last master cycle the scheduler will run before coming back to the queue.  Scheduling an event at or
+		 *	before the horizon pulls it back so that the scheduler stops in time to run the event.
+		 *
+		 * \param _pui64Horizon A pointer to the scheduler's target master cycle.
+		 */
+		inline void											SetHorizon( uint64_t * _pui64Horizon ) {
+			m_pui64Horizon = _pui64Horizon;
+		}
+
+		/**
+		 * Sets the values used to convert CPU cycles to master cycles.
+		 *
+		 * \param _ui64CpuDiv The CPU divider.
+		 * \param _ui64CpuCycleBase The CPU cycle count at master cycle 0.
+		 */
+		inline void											SetCpuTimeBase( uint64_t _ui64CpuDiv, uint64_t _ui64CpuCycleBase ) {
+			m_ui64CpuDiv = _ui64CpuDiv;
+			m_ui64CpuCycleBase = _ui64CpuCycleBase;
+		}
+
+		/**
+		 * Converts a CPU cycle count to the master cycle on which that CPU cycle runs.  Passing CCpuBase::GetCycleCount() from inside a CPU
+		 *	cycle returns the master cycle of the CPU cycle in progress.
+		 *
+		 * \param _ui64CpuCycle The CPU cycle to convert.
+		 * \return Returns the master cycle on which the given CPU cycle runs.
+		 */
+		inline uint64_t										CpuCycleToMaster( uint64_t _ui64CpuCycle ) const {
+			return (_ui64CpuCycle - m_ui64CpuCycleBase + 1) * m_ui64CpuDiv;
+		}
+
+		/**
+		 * Schedules an event.  Events run before any component ticks on the same master cycle.  Events on the same master cycle run in
+		 *	the order in which they were scheduled.
+		 *
+		 * \param _ui64Time The master cycle at which to run the event.
+		 * \param _pfFunc The function to call.
+		 * \param _pvParm The parameter to pass to _pfFunc.
+		 * \return Returns false if the queue is full.  A full queue means an event source is leaking events; debug builds assert.
+		 */
+		bool												Schedule( uint64_t _ui64Time, PfEventFunc _pfFunc, void * _pvParm ) {
+			assert( m_stTotal < LSN_EQ_MAX_EVENTS );
+			if ( m_stTotal == LSN_EQ_MAX_EVENTS ) { return false; }
+			// Kept sorted from latest to soonest so that the next event is always at the end.
+			size_t stIdx = m_stTotal;
+			while ( stIdx && m_eEvents[stIdx-1].ui64Time <= _ui64Time ) {
+				m_eEvents[stIdx] = m_eEvents[stIdx-1];
+				--stIdx;
+			}
+			m_eEvents[stIdx].ui64Time = _ui64Time;
+			m_eEvents[stIdx].pfFunc = _pfFunc;
+			m_eEvents[stIdx].pvParm = _pvParm;
+			++m_stTotal;
+			if ( m_pui64Horizon && _ui64Time && _ui64Time - 1 < (*m_pui64Horizon) ) {
+				(*m_pui64Horizon) = _ui64Time - 1;
+			}
+			return true;
+		}
+
+		/**
+		 * Removes all events matching the given function and parameter.
+		 *
+		 * \param _pfFunc The function of the events to remove.
+		 * \param _pvParm The parameter of the events to remove.
+		 */
+		void												Cancel( PfEventFunc _pfFunc, void * _pvParm ) {
+			size_t stDst = 0;
+			for ( size_t I = 0; I < m_stTotal; ++I ) {
+				if ( m_eEvents[I].pfFunc != _pfFunc || m_eEvents[I].pvParm != _pvParm ) {
+					m_eEvents[stDst++] = m_eEvents[I];
+				}
+			}
+			m_stTotal = stDst;
+		}
+
+		/**
+		 * Gets the master cycle of the next event.
+		 *
+		 * \return Returns the master cycle of the next event, or ~0ULL if there are no events.
+		 */
+		inline uint64_t										NextTime() const {
+			return m_stTotal ? m_eEvents[m_stTotal-1].ui64Time : ~0ULL;
+		}
+
+		/**
+		 * Runs all events scheduled on or before the given master cycle, in order.  Events may schedule new events.
+		 *
+		 * \param _ui64Time The master cycle up to which to run events.
+		 */
+		void												RunUntil( uint64_t _ui64Time ) {
+			while ( m_stTotal && m_eEvents[m_stTotal-1].ui64Time <= _ui64Time ) {
+				LSN_EVENT eEvent = m_eEvents[--m_stTotal];
+				eEvent.pfFunc( eEvent.pvParm, eEvent.ui64Time );
+			}
+		}
+
+		/**
+		 * Gets the number of pending events.
+		 *
+		 * \return Returns the number of pending events.
+		 */
+		inline size_t										Total() const { return m_stTotal; }
+
+
+	protected :
+		// == Members.
+		/** The events, sorted from latest to soonest. */
+		LSN_EVENT											m_eEvents[LSN_EQ_MAX_EVENTS];
+		/** The number of events in m_eEvents. */
+		size_t												m_stTotal;
+		/** The scheduler's target master cycle, pulled back when an event is scheduled before it. */
+		uint64_t *											m_pui64Horizon;
+		/** The CPU divider, used to convert CPU cycles to master cycles. */
+		uint64_t											m_ui64CpuDiv;
+		/** The CPU cycle count at master cycle 0. */
+		uint64_t											m_ui64CpuCycleBase;
+	};
+
+}	// namespace lsn
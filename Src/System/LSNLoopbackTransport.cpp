@@ -0,0 +1,76 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: An in-process pair of rollback transports with simulated latency and jitter, so that 2 rollback sessions can be run and
+ *	measured on 1 machine.  Time only moves when Step() is called, so runs are repeatable.
+ */
+
+#include "LSNLoopbackTransport.h"
+
+
+namespace lsn {
+
+	CLoopbackLink::CLoopbackLink( uint64_t _ui64LatencyMicros, uint64_t _ui64JitterMicros, uint64_t _ui64Seed ) :
+		m_ui64Now( 0 ),
+		m_ui64Latency( _ui64LatencyMicros ),
+		m_ui64Jitter( _ui64JitterMicros ),
+		m_ui64Random( _ui64Seed ? _ui64Seed : 1 ) {
+		for ( size_t I = 0; I < 2; ++I ) {
+			m_eEnds[I].m_pllLink = this;
+			m_eEnds[I].m_peOther = &m_eEnds[I^1];
+		}
+	}
+
+	// == Functions.
+	/**
+	 * Gets the simulated time at which a message sent now arrives.
+	 *
+	 * \return Returns the arrival time.
+	 */
+	uint64_t CLoopbackLink::ArrivalTime() {
+		uint64_t ui64Time = m_ui64Now + m_ui64Latency;
+		if ( m_ui64Jitter ) {
+			// xorshift64.
+			m_ui64Random ^= m_ui64Random << 13;
+			m_ui64Random ^= m_ui64Random >> 7;
+			m_ui64Random ^= m_ui64Random << 17;
+			ui64Time += m_ui64Random % (m_ui64Jitter + 1);
+		}
+		return ui64Time;
+	}
+
+	/**
+	 * Sends 1 frame of local input to the other side.
+	 *
+	 * \param _riInput The input to send.
+	 * \return Returns true.
+	 */
+	bool CLoopbackLink::CEndpoint::Send( const LSN_ROLLBACK_INPUT &_riInput ) {
+		m_peOther->m_vInbox.push_back( { m_pllLink->ArrivalTime(), _riInput } );
+		return true;
+	}
+
+	/**
+	 * Receives the next frame of remote input that has arrived, if any.
+	 *
+	 * \param _riInput Holds the returned input.
+	 * \return Returns false if nothing has arrived.
+	 */
+	bool CLoopbackLink::CEndpoint::Receive( LSN_ROLLBACK_INPUT &_riInput ) {
+		// Messages arrive in order of arrival time, so jitter can reorder them.
+		size_t stBest = m_vInbox.size();
+		for ( size_t I = 0; I < m_vInbox.size(); ++I ) {
+			if ( m_vInbox[I].ui64Arrival <= m_pllLink->Now() &&
+				(stBest == m_vInbox.size() || m_vInbox[I].ui64Arrival < m_vInbox[stBest].ui64Arrival) ) {
+				stBest = I;
+			}
+		}
+		if ( stBest == m_vInbox.size() ) { return false; }
+		_riInput = m_vInbox[stBest].riInput;
+		m_vInbox.erase( m_vInbox.begin() + stBest );
+		return true;
+	}
+
+}	// namespace lsn
@@ -0,0 +1,118 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: An in-process pair of rollback transports with simulated latency and jitter, so that 2 rollback sessions can be run and
+ *	measured on 1 machine.  Time only moves when Step() is called, so runs are repeatable.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "LSNRollbackTransport.h"
+
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CLoopbackLink
+	 * \brief An in-process pair of rollback transports with simulated latency and jitter.
+	 *
+	 * Description: An in-process pair of rollback transports with simulated latency and jitter, so that 2 rollback sessions can be run and
+	 *	measured on 1 machine.  Time only moves when Step() is called, so runs are repeatable.
+	 */
+	class CLoopbackLink {
+	public :
+		CLoopbackLink( uint64_t _ui64LatencyMicros = 0, uint64_t _ui64JitterMicros = 0, uint64_t _ui64Seed = 1 );
+
+
+		// == Functions.
+		/**
+		 * Gets one end of the link.
+		 *
+		 * \param _stSide The side (0 or 1).  Input sent from one side is received on the other.
+		 * \return Returns the transport for the given side.
+		 */
+		CRollbackTransport &							Endpoint( size_t _stSide ) { return m_eEnds[_stSide&1]; }
+
+		/**
+		 * Moves simulated time forward.  Messages are delivered once their latency has passed.
+		 *
+		 * \param _ui64Micros The number of microseconds to move forward.
+		 */
+		void											Step( uint64_t _ui64Micros ) { m_ui64Now += _ui64Micros; }
+
+		/**
+		 * Gets the current simulated time.
+		 *
+		 * \return Returns the current simulated time in microseconds.
+		 */
+		inline uint64_t									Now() const { return m_ui64Now; }
+
+
+	protected :
+		// == Types.
+		/** A message in flight. */
+		struct LSN_MESSAGE {
+			uint64_t									ui64Arrival;						/**< The simulated time at which the message arrives. */
+			LSN_ROLLBACK_INPUT							riInput;							/**< The input. */
+		};
+
+		/** One end of the link. */
+		class CEndpoint : public CRollbackTransport {
+		public :
+			// == Functions.
+			/**
+			 * Sends 1 frame of local input to the other side.
+			 *
+			 * \param _riInput The input to send.
+			 * \return Returns true.
+			 */
+			virtual bool								Send( const LSN_ROLLBACK_INPUT &_riInput );
+
+			/**
+			 * Receives the next frame of remote input that has arrived, if any.
+			 *
+			 * \param _riInput Holds the returned input.
+			 * \return Returns false if nothing has arrived.
+			 */
+			virtual bool								Receive( LSN_ROLLBACK_INPUT &_riInput );
+
+
+			// == Members.
+			/** The link. */
+			CLoopbackLink *								m_pllLink;
+			/** Messages on their way to this end. */
+			std::vector<LSN_MESSAGE>					m_vInbox;
+			/** The other end. */
+			CEndpoint *									m_peOther;
+		};
+
+
+		// == Members.
+		/** The 2 ends. */
+		CEndpoint										m_eEnds[2];
+		/** The current simulated time in microseconds. */
+		uint64_t										m_ui64Now;
+		/** The base latency in microseconds. */
+		uint64_t										m_ui64Latency;
+		/** The maximum extra random latency in microseconds. */
+		uint64_t										m_ui64Jitter;
+		/** The random state. */
+		uint64_t										m_ui64Random;
+
+
+		// == Functions.
+		/**
+		 * Gets the simulated time at which a message sent now arrives.
+		 *
+		 * \return Returns the arrival time.
+		 */
+		uint64_t										ArrivalTime();
+	};
+
+}	// namespace lsn
@@ -0,0 +1,349 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A ring of per-frame save states for hold-to-rewind.  Each frame is stored as the XOR against the frame before it, run-length
+ *	encoded, and every Nth frame is also kept as a full miniz-compressed keyframe so that going back a long way does not have to walk every
+ *	delta.  Encoding and compression run on a background thread; the emulation thread only pays for SaveState().
+ */
+
+#include "LSNRewindBuffer.h"
+#include "../MiniZ/miniz.h"
+#include "../Utilities/LSNStream.h"
+
+#include <algorithm>
+
+#define LSN_MIN_MATCH_RUN						8									/**< Runs of unchanged bytes shorter than this are stored inside literals. */
+
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Appends an unsigned LEB128 value to a buffer.
+	 *
+	 * \param _stVal The value to write.
+	 * \param _vOut The buffer to which to append.
+	 */
+	static inline void WriteVarInt( size_t _stVal, std::vector<uint8_t> &_vOut ) {
+		while ( _stVal >= 0x80 ) {
+			_vOut.push_back( uint8_t( _stVal | 0x80 ) );
+			_stVal >>= 7;
+		}
+		_vOut.push_back( uint8_t( _stVal ) );
+	}
+
+	/**
+	 * Reads an unsigned LEB128 value from a buffer.
+	 *
+	 * \param _vIn The buffer from which to read.
+	 * \param _stPos The position from which to read, updated to point after the value.
+	 * \param _stVal Holds the returned value.
+	 * \return Returns false if the buffer ends before the value does.
+	 */
+	static inline bool ReadVarInt( const std::vector<uint8_t> &_vIn, size_t &_stPos, size_t &_stVal ) {
+		_stVal = 0;
+		for ( size_t stShift = 0; _stPos < _vIn.size() && stShift < sizeof( size_t ) * 8; stShift += 7 ) {
+			uint8_t ui8Byte = _vIn[_stPos++];
+			_stVal |= size_t( ui8Byte & 0x7F ) << stShift;
+			if ( !(ui8Byte & 0x80) ) { return true; }
+		}
+		return false;
+	}
+
+	CRewindBuffer::CRewindBuffer() :
+		m_stMaxFrames( LSN_RB_DEFAULT_FRAMES ),
+		m_stKeyframeInterval( LSN_RB_DEFAULT_KEYFRAME_INTERVAL ),
+		m_ui64Encoded( 0 ),
+		m_ui64Captures( 0 ),
+		m_ui64CaptureTicks( 0 ),
+		m_ui64EncodeTicks( 0 ),
+		m_bEncoding( false ),
+		m_bStop( false ) {
+		m_ptThread = std::make_unique<std::thread>( EncodeThread, this );
+	}
+	CRewindBuffer::~CRewindBuffer() {
+		{
+			std::lock_guard<std::mutex> lgLock( m_mMutex );
+			m_bStop = true;
+		}
+		m_cvWork.notify_all();
+		m_ptThread->join();
+	}
+
+	// == Functions.
+	/**
+	 * Sets the number of frames kept and the number of frames between keyframes.  Also calls Reset().
+	 *
+	 * \param _stMaxFrames The maximum number of frames to keep.
+	 * \param _stKeyframeInterval The number of frames between keyframes.
+	 */
+	void CRewindBuffer::SetLimits( size_t _stMaxFrames, size_t _stKeyframeInterval ) {
+		Flush();
+		{
+			std::lock_guard<std::mutex> lgLock( m_mMutex );
+			m_stMaxFrames = std::max<size_t>( _stMaxFrames, 1 );
+			m_stKeyframeInterval = _stKeyframeInterval;
+		}
+		Reset();
+	}
+
+	/**
+	 * Discards every stored frame and clears the statistics.
+	 */
+	void CRewindBuffer::Reset() {
+		Flush();
+		std::lock_guard<std::mutex> lgLock( m_mMutex );
+		m_dFrames.clear();
+		m_vHead.clear();
+		m_ui64Encoded = 0;
+		m_ui64Captures = 0;
+		m_ui64CaptureTicks = 0;
+		m_ui64EncodeTicks = 0;
+	}
+
+	/**
+	 * Captures the current state of a system as the newest frame.  Call once per emulated frame.
+	 *
+	 * \param _sbSystem The system to capture.
+	 * \return Returns false if the state could not be saved.
+	 */
+	bool CRewindBuffer::Capture( const CSystemBase &_sbSystem ) {
+		uint64_t ui64Start = m_cClock.GetRealTick();
+		std::vector<uint8_t> vState;
+		{
+			std::unique_lock<std::mutex> ulLock( m_mMutex );
+			m_cvDone.wait( ulLock, [this]{ return m_dPending.size() < LSN_RB_MAX_PENDING; } );
+			if ( m_vSpares.size() ) {
+				vState = std::move( m_vSpares.back() );
+				m_vSpares.pop_back();
+			}
+		}
+		vState.clear();
+		CStream sStream( vState );
+		if ( !_sbSystem.SaveState( sStream ) ) { return false; }
+		{
+			std::lock_guard<std::mutex> lgLock( m_mMutex );
+			m_dPending.push_back( std::move( vState ) );
+			++m_ui64Captures;
+			m_ui64CaptureTicks += m_cClock.GetRealTick() - ui64Start;
+		}
+		m_cvWork.notify_one();
+		return true;
+	}
+
+	/**
+	 * Restores the state captured the given number of frames before the newest one and discards every frame after it.
+	 *
+	 * \param _sbSystem The system into which to load the state.  Must be the system that was captured.
+	 * \param _stFrames The number of frames to go back.  Clamped to the number of stored frames.
+	 * \return Returns false if there was nothing to go back to or the state could not be loaded.
+	 */
+	bool CRewindBuffer::StepBack( CSystemBase &_sbSystem, size_t _stFrames ) {
+		Flush();
+		std::lock_guard<std::mutex> lgLock( m_mMutex );
+		if ( !m_dFrames.size() ) { return false; }
+		const size_t stLast = m_dFrames.size() - 1;
+		const size_t stTarget = stLast - std::min( _stFrames, stLast );
+
+		// Start from the nearest keyframe at or after the target, or from the head, and XOR the deltas backwards.
+		size_t stFrom = stLast;
+		for ( size_t I = stTarget; I < stLast; ++I ) {
+			if ( m_dFrames[I].vKeyframe.size() ) {
+				stFrom = I;
+				break;
+			}
+		}
+		std::vector<uint8_t> vState;
+		if ( m_vSpares.size() ) {
+			vState = std::move( m_vSpares.back() );
+			m_vSpares.pop_back();
+		}
+		if ( stFrom == stLast ) {
+			vState = m_vHead;
+		}
+		else {
+			vState.resize( m_vHead.size() );
+			mz_ulong ulLen = mz_ulong( vState.size() );
+			const std::vector<uint8_t> & vKeyframe = m_dFrames[stFrom].vKeyframe;
+			if ( mz_uncompress( vState.data(), &ulLen, vKeyframe.data(), mz_ulong( vKeyframe.size() ) ) != MZ_OK || ulLen != vState.size() ) { return false; }
+		}
+		for ( size_t I = stFrom; I > stTarget; --I ) {
+			if ( !ApplyXor( m_dFrames[I].vDelta, vState ) ) { return false; }
+		}
+
+		CStream sStream( vState );
+		if ( !_sbSystem.LoadState( sStream ) ) { return false; }
+		m_dFrames.erase( m_dFrames.begin() + (stTarget + 1), m_dFrames.end() );
+		m_vHead.swap( vState );
+		m_vSpares.push_back( std::move( vState ) );
+		return true;
+	}
+
+	/**
+	 * Waits for the background thread to finish encoding every captured frame.
+	 */
+	void CRewindBuffer::Flush() {
+		std::unique_lock<std::mutex> ulLock( m_mMutex );
+		m_cvDone.wait( ulLock, [this]{ return !m_dPending.size() && !m_bEncoding; } );
+	}
+
+	/**
+	 * Gets the memory and timing statistics.  Frames still waiting for the background thread are not included.
+	 *
+	 * \return Returns the statistics.
+	 */
+	CRewindBuffer::LSN_REWIND_STATS CRewindBuffer::Stats() const {
+		std::lock_guard<std::mutex> lgLock( m_mMutex );
+		LSN_REWIND_STATS rsStats = {};
+		rsStats.ui64Frames = m_dFrames.size();
+		rsStats.ui64StateSize = m_vHead.size();
+		rsStats.ui64Bytes = m_vHead.size();
+		for ( auto I = m_dFrames.size(); I--; ) {
+			rsStats.ui64Bytes += m_dFrames[I].vDelta.size() + m_dFrames[I].vKeyframe.size();
+			if ( m_dFrames[I].vKeyframe.size() ) { ++rsStats.ui64Keyframes; }
+		}
+		rsStats.ui64RawBytes = rsStats.ui64Frames * rsStats.ui64StateSize;
+		rsStats.ui64Captures = m_ui64Captures;
+		const double dToMicros = 1000000.0 / m_cClock.GetResolution();
+		rsStats.dCaptureMicros = m_ui64Captures ? m_ui64CaptureTicks * dToMicros / m_ui64Captures : 0.0;
+		rsStats.dEncodeMicros = m_ui64Encoded ? m_ui64EncodeTicks * dToMicros / m_ui64Encoded : 0.0;
+		return rsStats;
+	}
+
+	/**
+	 * Encodes a captured state against the head.  Called on the background thread without the lock held.
+	 *
+	 * \param _vState The captured state.
+	 * \param _fFrame Holds the returned frame.
+	 * \return Returns false if the state cannot be encoded against the head (its size changed), in which case the ring must be cleared.
+	 */
+	bool CRewindBuffer::Encode( const std::vector<uint8_t> &_vState, LSN_FRAME &_fFrame ) {
+		bool bContinues = m_vHead.size() && m_vHead.size() == _vState.size();
+		if ( bContinues ) {
+			EncodeXor( m_vHead.data(), _vState.data(), _vState.size(), _fFrame.vDelta );
+		}
+		if ( !bContinues || (m_stKeyframeInterval && (m_ui64Encoded % m_stKeyframeInterval) == 0) ) {
+			mz_ulong ulLen = mz_compressBound( mz_ulong( _vState.size() ) );
+			_fFrame.vKeyframe.resize( ulLen );
+			if ( mz_compress2( _fFrame.vKeyframe.data(), &ulLen, _vState.data(), mz_ulong( _vState.size() ), MZ_BEST_SPEED ) == MZ_OK ) {
+				_fFrame.vKeyframe.resize( ulLen );
+				_fFrame.vKeyframe.shrink_to_fit();
+			}
+			else {
+				_fFrame.vKeyframe.clear();
+			}
+		}
+		return bContinues;
+	}
+
+	/**
+	 * Run-length encodes the XOR of 2 buffers of the same size.
+	 *
+	 * \param _pui8A The first buffer.
+	 * \param _pui8B The second buffer.
+	 * \param _stSize The size of both buffers.
+	 * \param _vOut Holds the returned encoded delta.
+	 */
+	void CRewindBuffer::EncodeXor( const uint8_t * _pui8A, const uint8_t * _pui8B, size_t _stSize, std::vector<uint8_t> &_vOut ) {
+		// A series of (unchanged count, literal count, literal XOR bytes).  Trailing unchanged bytes are not stored.
+		_vOut.clear();
+		size_t I = 0;
+		while ( I < _stSize ) {
+			size_t stMatchStart = I;
+			while ( I < _stSize && _pui8A[I] == _pui8B[I] ) { ++I; }
+			if ( I == _stSize ) { break; }
+
+			size_t stLitStart = I;
+			size_t stRun = 0;
+			while ( I < _stSize ) {
+				if ( _pui8A[I] == _pui8B[I] ) {
+					if ( ++stRun == LSN_MIN_MATCH_RUN ) {
+						I -= LSN_MIN_MATCH_RUN - 1;
+						break;
+					}
+				}
+				else { stRun = 0; }
+				++I;
+			}
+			WriteVarInt( stLitStart - stMatchStart, _vOut );
+			WriteVarInt( I - stLitStart, _vOut );
+			for ( size_t J = stLitStart; J < I; ++J ) {
+				_vOut.push_back( _pui8A[J] ^ _pui8B[J] );
+			}
+		}
+		_vOut.shrink_to_fit();
+	}
+
+	/**
+	 * XORs an encoded delta into a buffer, turning one of the 2 buffers passed to EncodeXor() into the other.
+	 *
+	 * \param _vDelta The encoded delta.
+	 * \param _vState The buffer to modify.
+	 * \return Returns false if the delta is corrupt.
+	 */
+	bool CRewindBuffer::ApplyXor( const std::vector<uint8_t> &_vDelta, std::vector<uint8_t> &_vState ) {
+		size_t stPos = 0, stOff = 0;
+		while ( stPos < _vDelta.size() ) {
+			size_t stMatch, stLit;
+			if ( !ReadVarInt( _vDelta, stPos, stMatch ) || !ReadVarInt( _vDelta, stPos, stLit ) ) { return false; }
+			stOff += stMatch;
+			if ( stOff > _vState.size() || stLit > _vState.size() - stOff || stLit > _vDelta.size() - stPos ) { return false; }
+			for ( size_t I = 0; I < stLit; ++I ) {
+				_vState[stOff+I] ^= _vDelta[stPos+I];
+			}
+			stOff += stLit;
+			stPos += stLit;
+		}
+		return true;
+	}
+
+	/**
+	 * The background thread.
+	 *
+	 * \param _prbBuffer The rewind buffer.
+	 */
+	void CRewindBuffer::EncodeThread( CRewindBuffer * _prbBuffer ) {
+		while ( true ) {
+			std::vector<uint8_t> vState;
+			{
+				std::unique_lock<std::mutex> ulLock( _prbBuffer->m_mMutex );
+				_prbBuffer->m_cvWork.wait( ulLock, [_prbBuffer]{ return _prbBuffer->m_bStop || _prbBuffer->m_dPending.size(); } );
+				if ( !_prbBuffer->m_dPending.size() ) { break; }
+				vState = std::move( _prbBuffer->m_dPending.front() );
+				_prbBuffer->m_dPending.pop_front();
+				_prbBuffer->m_bEncoding = true;
+			}
+
+			uint64_t ui64Start = _prbBuffer->m_cClock.GetRealTick();
+			LSN_FRAME fFrame;
+			bool bContinues = _prbBuffer->Encode( vState, fFrame );
+			uint64_t ui64Ticks = _prbBuffer->m_cClock.GetRealTick() - ui64Start;
+
+			{
+				std::lock_guard<std::mutex> lgLock( _prbBuffer->m_mMutex );
+				std::deque<LSN_FRAME> & dFrames = _prbBuffer->m_dFrames;
+				if ( !bContinues ) { dFrames.clear(); }
+				dFrames.push_back( std::move( fFrame ) );
+				while ( dFrames.size() > _prbBuffer->m_stMaxFrames ) {
+					dFrames.pop_front();
+					// Nothing can be restored from before the oldest frame, so its delta is no longer needed.
+					dFrames.front().vDelta.clear();
+					dFrames.front().vDelta.shrink_to_fit();
+				}
+				_prbBuffer->m_vHead.swap( vState );
+				if ( _prbBuffer->m_vSpares.size() < LSN_RB_MAX_PENDING ) {
+					_prbBuffer->m_vSpares.push_back( std::move( vState ) );
+				}
+				++_prbBuffer->m_ui64Encoded;
+				_prbBuffer->m_ui64EncodeTicks += ui64Ticks;
+				_prbBuffer->m_bEncoding = false;
+			}
+			_prbBuffer->m_cvDone.notify_all();
+		}
+	}
+
+}	// namespace lsn
+
+#undef LSN_MIN_MATCH_RUN
@@ -0,0 +1,191 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A ring of per-frame save states for hold-to-rewind.  Each frame is stored as the XOR against the frame before it, run-length
+ *	encoded, and every Nth frame is also kept as a full miniz-compressed keyframe so that going back a long way does not have to walk every
+ *	delta.  Encoding and compression run on a background thread; the emulation thread only pays for SaveState().
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Time/LSNClock.h"
+#include "LSNSystemBase.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRewindBuffer
+	 * \brief A ring of per-frame save states for hold-to-rewind.
+	 *
+	 * Description: A ring of per-frame save states for hold-to-rewind.  Each frame is stored as the XOR against the frame before it, run-length
+	 *	encoded, and every Nth frame is also kept as a full miniz-compressed keyframe so that going back a long way does not have to walk every
+	 *	delta.  Encoding and compression run on a background thread; the emulation thread only pays for SaveState().
+	 */
+	class CRewindBuffer {
+	public :
+		CRewindBuffer();
+		~CRewindBuffer();
+
+
+		// == Enumerations.
+		/** Defaults and limits. */
+		enum LSN_REWIND_BUFFER {
+			LSN_RB_DEFAULT_FRAMES						= 60 * 60,							/**< The default number of frames kept (60 seconds on NTSC). */
+			LSN_RB_DEFAULT_KEYFRAME_INTERVAL			= 60,								/**< The default number of frames between keyframes. */
+			LSN_RB_MAX_PENDING							= 16,								/**< Capture() waits if the background thread falls this many frames behind. */
+		};
+
+
+		// == Types.
+		/** Memory and timing statistics. */
+		struct LSN_REWIND_STATS {
+			uint64_t									ui64Frames;							/**< The number of frames that can currently be rewound. */
+			uint64_t									ui64Keyframes;						/**< The number of stored keyframes. */
+			uint64_t									ui64StateSize;						/**< The size of 1 uncompressed save state. */
+			uint64_t									ui64Bytes;							/**< The total bytes held by deltas, keyframes, and the newest uncompressed state. */
+			uint64_t									ui64RawBytes;						/**< The bytes the same frames would take uncompressed. */
+			uint64_t									ui64Captures;						/**< The total number of frames captured since the last Reset(). */
+			double										dCaptureMicros;						/**< The average time Capture() spends on the calling thread, in microseconds. */
+			double										dEncodeMicros;						/**< The average time the background thread spends encoding a frame, in microseconds. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Sets the number of frames kept and the number of frames between keyframes.  Also calls Reset().
+		 *
+		 * \param _stMaxFrames The maximum number of frames to keep.
+		 * \param _stKeyframeInterval The number of frames between keyframes.
+		 */
+		void											SetLimits( size_t _stMaxFrames, size_t _stKeyframeInterval );
+
+		/**
+		 * Discards every stored frame and clears the statistics.
+		 */
+		void											Reset();
+
+		/**
+		 * Captures the current state of a system as the newest frame.  Call once per emulated frame.
+		 *
+		 * \param _sbSystem The system to capture.
+		 * \return Returns false if the state could not be saved.
+		 */
+		bool											Capture( const CSystemBase &_sbSystem );
+
+		/**
+		 * Restores the state captured the given number of frames before the newest one and discards every frame after it.
+		 *
+		 * \param _sbSystem The system into which to load the state.  Must be the system that was captured.
+		 * \param _stFrames The number of frames to go back.  Clamped to the number of stored frames.
+		 * \return Returns false if there was nothing to go back to or the state could not be loaded.
+		 */
+		bool											StepBack( CSystemBase &_sbSystem, size_t _stFrames = 1 );
+
+		/**
+		 * Waits for the background thread to finish encoding every captured frame.
+		 */
+		void											Flush();
+
+		/**
+		 * Gets the memory and timing statistics.  Frames still waiting for the background thread are not included.
+		 *
+		 * \return Returns the statistics.
+		 */
+		LSN_REWIND_STATS								Stats() const;
+
+
+	protected :
+		// == Types.
+		/** A stored frame. */
+		struct LSN_FRAME {
+			std::vector<uint8_t>						vDelta;								/**< The run-length-encoded XOR against the previous frame.  Empty for the oldest frame. */
+			std::vector<uint8_t>						vKeyframe;							/**< The miniz-compressed full state, for keyframes only. */
+		};
+
+
+		// == Members.
+		/** The stored frames, oldest first. */
+		std::deque<LSN_FRAME>							m_dFrames;
+		/** The uncompressed state of the newest stored frame. */
+		std::vector<uint8_t>							m_vHead;
+		/** Captured states waiting for the background thread. */
+		std::deque<std::vector<uint8_t>>				m_dPending;
+		/** Spare state buffers, to avoid allocating on every capture. */
+		std::vector<std::vector<uint8_t>>				m_vSpares;
+		/** Guards everything above and the statistics. */
+		mutable std::mutex								m_mMutex;
+		/** Signalled when a frame is captured or the thread is stopping. */
+		std::condition_variable							m_cvWork;
+		/** Signalled when the background thread finishes a frame. */
+		std::condition_variable							m_cvDone;
+		/** The background thread. */
+		std::unique_ptr<std::thread>					m_ptThread;
+		/** The clock used to time captures. */
+		CClock											m_cClock;
+		/** The maximum number of frames to keep. */
+		size_t											m_stMaxFrames;
+		/** The number of frames between keyframes. */
+		size_t											m_stKeyframeInterval;
+		/** The number of frames encoded since the last Reset(), used to place keyframes. */
+		uint64_t										m_ui64Encoded;
+		/** The total number of captures since the last Reset(). */
+		uint64_t										m_ui64Captures;
+		/** Total clock ticks spent in Capture(). */
+		uint64_t										m_ui64CaptureTicks;
+		/** Total clock ticks spent encoding. */
+		uint64_t										m_ui64EncodeTicks;
+		/** True while the background thread is encoding a frame outside of the lock. */
+		bool											m_bEncoding;
+		/** Set to stop the background thread. */
+		bool											m_bStop;
+
+
+		// == Functions.
+		/**
+		 * Encodes a captured state against the head.  Called on the background thread without the lock held.
+		 *
+		 * \param _vState The captured state.
+		 * \param _fFrame Holds the returned frame.
+		 * \return Returns false if the state cannot be encoded against the head (its size changed), in which case the ring must be cleared.
+		 */
+		bool											Encode( const std::vector<uint8_t> &_vState, LSN_FRAME &_fFrame );
+
+		/**
+		 * Run-length encodes the XOR of 2 buffers of the same size.
+		 *
+		 * \param _pui8A The first buffer.
+		 * \param _pui8B The second buffer.
+		 * \param _stSize The size of both buffers.
+		 * \param _vOut Holds the returned encoded delta.
+		 */
+		static void										EncodeXor( const uint8_t * _pui8A, const uint8_t * _pui8B, size_t _stSize, std::vector<uint8_t> &_vOut );
+
+		/**
+		 * XORs an encoded delta into a buffer, turning one of the 2 buffers passed to EncodeXor() into the other.
+		 *
+		 * \param _vDelta The encoded delta.
+		 * \param _vState The buffer to modify.
+		 * \return Returns false if the delta is corrupt.
+		 */
+		static bool										ApplyXor( const std::vector<uint8_t> &_vDelta, std::vector<uint8_t> &_vState );
+
+		/**
+		 * The background thread.
+		 *
+		 * \param _prbBuffer The rewind buffer.
+		 */
+		static void										EncodeThread( CRewindBuffer * _prbBuffer );
+	};
+
+}	// namespace lsn
@@ -0,0 +1,290 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A 2-player rollback session.  Each frame the local input is sent to the other side and the frame is run at once, with the
+ *	remote input predicted to be the same as the last one received.  When remote input arrives that does not match the prediction, the
+ *	snapshot taken before that frame is restored and every frame since is run again with the real input.
+ */
+
+#include "LSNRollbackSession.h"
+#include "../Utilities/LSNStream.h"
+
+#include <algorithm>
+
+
+namespace lsn {
+
+	CRollbackSession::CRollbackSession() :
+		m_psbSystem( nullptr ),
+		m_pipLocal( nullptr ),
+		m_prtTransport( nullptr ),
+		m_ui64Frame( 0 ),
+		m_ui64Confirmed( 0 ),
+		m_ui64SimFrame( 0 ),
+		m_ui32InputDelay( 0 ),
+		m_ui32MaxRollback( LSN_RS_DEFAULT_MAX_ROLLBACK ),
+		m_ui8LocalPort( 0 ),
+		m_ui64Frames( 0 ),
+		m_ui64Stalls( 0 ),
+		m_ui64Mispredictions( 0 ),
+		m_ui64Rollbacks( 0 ),
+		m_ui64ResimFrames( 0 ),
+		m_ui32MaxDepth( 0 ),
+		m_ui64ResimTicks( 0 ),
+		m_ui64MaxResimTicks( 0 ),
+		m_ui64FrameTicks( 0 ),
+		m_ui64MaxFrameTicks( 0 ) {
+		for ( size_t I = 0; I < LSN_RS_INPUT_RING; ++I ) {
+			m_fiInput[I] = { UINT64_MAX, 0, 0, 0, false };
+		}
+	}
+
+	// == Functions.
+	/**
+	 * Polls the given port and returns a byte containing the result of polling by combining the LSN_INPUT_BITS values.
+	 *
+	 * \param _ui8Port The port being polled (0 or 1).
+	 * \return Returns the local input or the confirmed or predicted remote input for the frame being run.
+	 */
+	uint8_t CRollbackSession::PollPort( uint8_t _ui8Port ) {
+		const LSN_FRAME_INPUT & fiInput = Input( m_ui64SimFrame );
+		return (_ui8Port == m_ui8LocalPort) ? fiInput.ui8Local : fiInput.ui8Used;
+	}
+
+	/**
+	 * Starts a session from the current state of the given system.  Both sides must start from the same state with the same settings.
+	 *	The system's input poller is set to this object.
+	 *
+	 * \param _sbSystem The system.  A ROM must be loaded.
+	 * \param _ui8LocalPort The port (0 or 1) of the local player.  The remote player uses the other port.
+	 * \param _pipLocal The poller from which local input is read.  Polled once per frame on _ui8LocalPort.
+	 * \param _prtTransport The link to the other side.
+	 * \param _ui32InputDelay The number of frames by which local input is delayed, which hides that much latency without rolling back.
+	 * \param _ui32MaxRollback The most frames that may be run on predicted input before AdvanceFrame() waits for the other side.  If 0,
+	 *	the session runs in lockstep and _ui32InputDelay must not be 0.
+	 * \return Returns false if a parameter is invalid.
+	 */
+	bool CRollbackSession::Start( CSystemBase &_sbSystem, uint8_t _ui8LocalPort, CInputPoller * _pipLocal, CRollbackTransport * _prtTransport,
+		uint32_t _ui32InputDelay, uint32_t _ui32MaxRollback ) {
+		Stop();
+		if ( !_sbSystem.IsRomLoaded() || _ui8LocalPort > 1 || !_prtTransport ) { return false; }
+		if ( uint64_t( _ui32InputDelay ) + _ui32MaxRollback > LSN_RS_MAX_WINDOW ) { return false; }
+		// Input is only sent when a frame is run, so lockstep without delay would wait forever.
+		if ( !_ui32InputDelay && !_ui32MaxRollback ) { return false; }
+
+		for ( size_t I = 0; I < LSN_RS_INPUT_RING; ++I ) {
+			m_fiInput[I] = { UINT64_MAX, 0, 0, 0, false };
+		}
+		m_vSnapshots.resize( _ui32MaxRollback + 1 );
+		for ( size_t I = 0; I < m_vSnapshots.size(); ++I ) {
+			m_vSnapshots[I].ui64Frame = UINT64_MAX;
+		}
+		// The frames hidden by the input delay have no input from either side.
+		for ( uint64_t I = 0; I < _ui32InputDelay; ++I ) {
+			LSN_FRAME_INPUT & fiInput = Input( I );
+			fiInput.bRemote = true;
+		}
+
+		m_psbSystem = &_sbSystem;
+		m_pipLocal = _pipLocal;
+		m_prtTransport = _prtTransport;
+		m_ui8LocalPort = _ui8LocalPort;
+		m_ui32InputDelay = _ui32InputDelay;
+		m_ui32MaxRollback = _ui32MaxRollback;
+		m_ui64Frame = 0;
+		m_ui64Confirmed = _ui32InputDelay;
+		m_ui64SimFrame = 0;
+
+		m_ui64Frames = 0;
+		m_ui64Stalls = 0;
+		m_ui64Mispredictions = 0;
+		m_ui64Rollbacks = 0;
+		m_ui64ResimFrames = 0;
+		m_ui32MaxDepth = 0;
+		m_ui64ResimTicks = 0;
+		m_ui64MaxResimTicks = 0;
+		m_ui64FrameTicks = 0;
+		m_ui64MaxFrameTicks = 0;
+
+		m_psbSystem->SetInputPoller( this );
+		return true;
+	}
+
+	/**
+	 * Ends the session.  The system's input poller is cleared.
+	 */
+	void CRollbackSession::Stop() {
+		if ( m_psbSystem ) {
+			m_psbSystem->SetInputPoller( nullptr );
+		}
+		m_psbSystem = nullptr;
+		m_pipLocal = nullptr;
+		m_prtTransport = nullptr;
+	}
+
+	/**
+	 * Receives remote input, rolls back if any of it was mispredicted, then reads and sends local input and runs 1 frame.  Call once per
+	 *	host frame.
+	 *
+	 * \return Returns false if no frame was run because the other side is too far behind.
+	 */
+	bool CRollbackSession::AdvanceFrame() {
+		if ( !m_psbSystem ) { return false; }
+		const uint64_t ui64Start = m_cClock.GetRealTick();
+		if ( !Synchronize() ) { return false; }
+
+		if ( m_ui64Frame >= m_ui64Confirmed + m_ui32MaxRollback ) {
+			// Too far ahead of the other side; wait for it to catch up.
+			++m_ui64Stalls;
+			return false;
+		}
+
+		const uint64_t ui64Target = m_ui64Frame + m_ui32InputDelay;
+		LSN_FRAME_INPUT & fiLocal = Input( ui64Target );
+		fiLocal.ui8Local = m_pipLocal ? m_pipLocal->PollPort( m_ui8LocalPort ) : 0;
+		m_prtTransport->Send( { ui64Target, fiLocal.ui8Local } );
+
+		if ( !RunFrame( m_ui64Frame, true ) ) { return false; }
+		++m_ui64Frame;
+		++m_ui64Frames;
+
+		const uint64_t ui64Ticks = m_cClock.GetRealTick() - ui64Start;
+		m_ui64FrameTicks += ui64Ticks;
+		m_ui64MaxFrameTicks = std::max( m_ui64MaxFrameTicks, ui64Ticks );
+		return true;
+	}
+
+	/**
+	 * Receives remote input and rolls back if any of it was mispredicted, without running a new frame.  AdvanceFrame() does this first;
+	 *	call it directly to catch up while not advancing.
+	 *
+	 * \return Returns false if a rollback failed.
+	 */
+	bool CRollbackSession::Synchronize() {
+		if ( !m_psbSystem ) { return false; }
+
+		// Take in everything that has arrived and find the earliest frame that was run with the wrong input.
+		uint64_t ui64Rollback = UINT64_MAX;
+		LSN_ROLLBACK_INPUT riInput;
+		while ( m_prtTransport->Receive( riInput ) ) {
+			if ( riInput.ui64Frame < m_ui64Confirmed || riInput.ui64Frame >= m_ui64Frame + LSN_RS_MAX_WINDOW ) { continue; }
+			LSN_FRAME_INPUT & fiInput = Input( riInput.ui64Frame );
+			if ( fiInput.bRemote ) { continue; }
+			fiInput.ui8Remote = riInput.ui8Input;
+			fiInput.bRemote = true;
+			if ( riInput.ui64Frame < m_ui64Frame && fiInput.ui8Used != riInput.ui8Input ) {
+				++m_ui64Mispredictions;
+				ui64Rollback = std::min( ui64Rollback, riInput.ui64Frame );
+			}
+		}
+		while ( m_ui64Confirmed < m_ui64Frame + LSN_RS_MAX_WINDOW && Input( m_ui64Confirmed ).bRemote ) {
+			++m_ui64Confirmed;
+		}
+
+		if ( ui64Rollback != UINT64_MAX ) {
+			// Never more than m_ui32MaxRollback frames back, so the snapshot is always still in the ring.
+			LSN_SNAPSHOT & sSnapshot = m_vSnapshots[size_t(ui64Rollback%m_vSnapshots.size())];
+			if ( sSnapshot.ui64Frame != ui64Rollback ) { return false; }
+			const uint64_t ui64ResimStart = m_cClock.GetRealTick();
+			CStream sStream( sSnapshot.vState );
+			if ( !m_psbSystem->LoadState( sStream ) ) { return false; }
+			for ( uint64_t I = ui64Rollback; I < m_ui64Frame; ++I ) {
+				if ( !RunFrame( I, I != ui64Rollback ) ) { return false; }
+			}
+			const uint64_t ui64Ticks = m_cClock.GetRealTick() - ui64ResimStart;
+			const uint32_t ui32Depth = uint32_t( m_ui64Frame - ui64Rollback );
+			++m_ui64Rollbacks;
+			m_ui64ResimFrames += ui32Depth;
+			m_ui32MaxDepth = std::max( m_ui32MaxDepth, ui32Depth );
+			m_ui64ResimTicks += ui64Ticks;
+			m_ui64MaxResimTicks = std::max( m_ui64MaxResimTicks, ui64Ticks );
+		}
+		return true;
+	}
+
+	/**
+	 * Gets the snapshot taken at the start of the given frame, if it is still held.
+	 *
+	 * \param _ui64Frame The frame.
+	 * \return Returns the snapshot or nullptr.
+	 */
+	const std::vector<uint8_t> * CRollbackSession::Snapshot( uint64_t _ui64Frame ) const {
+		if ( !m_vSnapshots.size() ) { return nullptr; }
+		const LSN_SNAPSHOT & sSnapshot = m_vSnapshots[size_t(_ui64Frame%m_vSnapshots.size())];
+		return sSnapshot.ui64Frame == _ui64Frame ? &sSnapshot.vState : nullptr;
+	}
+
+	/**
+	 * Gets the statistics.
+	 *
+	 * \return Returns the statistics.
+	 */
+	CRollbackSession::LSN_ROLLBACK_STATS CRollbackSession::Stats() const {
+		LSN_ROLLBACK_STATS rsStats = {};
+		rsStats.ui64Frames = m_ui64Frames;
+		rsStats.ui64Stalls = m_ui64Stalls;
+		rsStats.ui64Mispredictions = m_ui64Mispredictions;
+		rsStats.ui64Rollbacks = m_ui64Rollbacks;
+		rsStats.ui64ResimFrames = m_ui64ResimFrames;
+		rsStats.ui32MaxDepth = m_ui32MaxDepth;
+		const double dToMicros = 1000000.0 / m_cClock.GetResolution();
+		if ( m_ui64Rollbacks ) {
+			rsStats.dAvgDepth = double( m_ui64ResimFrames ) / m_ui64Rollbacks;
+			rsStats.dAvgResimMicros = m_ui64ResimTicks * dToMicros / m_ui64Rollbacks;
+		}
+		rsStats.dMaxResimMicros = m_ui64MaxResimTicks * dToMicros;
+		if ( m_ui64Frames ) {
+			rsStats.dAvgFrameMicros = m_ui64FrameTicks * dToMicros / m_ui64Frames;
+		}
+		rsStats.dMaxFrameMicros = m_ui64MaxFrameTicks * dToMicros;
+		return rsStats;
+	}
+
+	/**
+	 * Gets the input entry for a frame, clearing it if it last belonged to another frame.
+	 *
+	 * \param _ui64Frame The frame.
+	 * \return Returns the input entry.
+	 */
+	CRollbackSession::LSN_FRAME_INPUT & CRollbackSession::Input( uint64_t _ui64Frame ) {
+		LSN_FRAME_INPUT & fiInput = m_fiInput[_ui64Frame%LSN_RS_INPUT_RING];
+		if ( fiInput.ui64Frame != _ui64Frame ) {
+			fiInput = { _ui64Frame, 0, 0, 0, false };
+		}
+		return fiInput;
+	}
+
+	/**
+	 * Runs 1 frame with the best input known for it.
+	 *
+	 * \param _ui64Frame The frame to run.
+	 * \param _bSnapshot If true, a snapshot is taken first.
+	 * \return Returns false if the snapshot could not be taken.
+	 */
+	bool CRollbackSession::RunFrame( uint64_t _ui64Frame, bool _bSnapshot ) {
+		if ( _bSnapshot ) {
+			LSN_SNAPSHOT & sSnapshot = m_vSnapshots[size_t(_ui64Frame%m_vSnapshots.size())];
+			sSnapshot.vState.clear();
+			CStream sStream( sSnapshot.vState );
+			if ( !m_psbSystem->SaveState( sStream ) ) {
+				sSnapshot.ui64Frame = UINT64_MAX;
+				return false;
+			}
+			sSnapshot.ui64Frame = _ui64Frame;
+		}
+		// Remote input that has not arrived is predicted to be the last input that did.
+		LSN_FRAME_INPUT & fiInput = Input( _ui64Frame );
+		if ( fiInput.bRemote ) {
+			fiInput.ui8Used = fiInput.ui8Remote;
+		}
+		else {
+			fiInput.ui8Used = m_ui64Confirmed ? Input( m_ui64Confirmed - 1 ).ui8Remote : 0;
+		}
+		m_ui64SimFrame = _ui64Frame;
+		m_psbSystem->RunFrames( 1 );
+		return true;
+	}
+
+}	// namespace lsn
@@ -0,0 +1,225 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A 2-player rollback session.  Each frame the local input is sent to the other side and the frame is run at once, with the
+ *	remote input predicted to be the same as the last one received.  When remote input arrives that does not match the prediction, the
+ *	snapshot taken before that frame is restored and every frame since is run again with the real input.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Input/LSNInputPoller.h"
+#include "../Time/LSNClock.h"
+#include "LSNRollbackTransport.h"
+#include "LSNSystemBase.h"
+
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRollbackSession
+	 * \brief A 2-player rollback session.
+	 *
+	 * Description: A 2-player rollback session.  Each frame the local input is sent to the other side and the frame is run at once, with the
+	 *	remote input predicted to be the same as the last one received.  When remote input arrives that does not match the prediction, the
+	 *	snapshot taken before that frame is restored and every frame since is run again with the real input.
+	 */
+	class CRollbackSession : public CInputPoller {
+	public :
+		CRollbackSession();
+
+
+		// == Enumerations.
+		/** Defaults and limits. */
+		enum LSN_ROLLBACK_SESSION {
+			LSN_RS_DEFAULT_MAX_ROLLBACK					= 8,								/**< The default number of frames that may be run on predicted input. */
+			LSN_RS_INPUT_RING							= 256,								/**< The number of frames of input kept. */
+			LSN_RS_MAX_WINDOW							= LSN_RS_INPUT_RING / 2,			/**< The limit on the rollback window plus the input delay. */
+		};
+
+
+		// == Types.
+		/** Rollback statistics. */
+		struct LSN_ROLLBACK_STATS {
+			uint64_t									ui64Frames;							/**< The number of frames advanced. */
+			uint64_t									ui64Stalls;							/**< The number of calls to AdvanceFrame() that waited for remote input. */
+			uint64_t									ui64Mispredictions;					/**< The number of remote inputs that did not match the prediction. */
+			uint64_t									ui64Rollbacks;						/**< The number of rollbacks. */
+			uint64_t									ui64ResimFrames;					/**< The total number of frames run again. */
+			uint32_t									ui32MaxDepth;						/**< The most frames run again in 1 rollback. */
+			double										dAvgDepth;							/**< The average number of frames run again per rollback. */
+			double										dAvgResimMicros;					/**< The average time spent per rollback, in microseconds. */
+			double										dMaxResimMicros;					/**< The longest time spent in 1 rollback, in microseconds. */
+			double										dAvgFrameMicros;					/**< The average time spent per AdvanceFrame() that advanced, rollbacks included, in microseconds. */
+			double										dMaxFrameMicros;					/**< The longest time spent in 1 AdvanceFrame(), in microseconds. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Polls the given port and returns a byte containing the result of polling by combining the LSN_INPUT_BITS values.
+		 *
+		 * \param _ui8Port The port being polled (0 or 1).
+		 * \return Returns the local input or the confirmed or predicted remote input for the frame being run.
+		 */
+		virtual uint8_t									PollPort( uint8_t _ui8Port );
+
+		/**
+		 * Starts a session from the current state of the given system.  Both sides must start from the same state with the same settings.
+		 *	The system's input poller is set to this object.
+		 *
+		 * \param _sbSystem The system.  A ROM must be loaded.
+		 * \param _ui8LocalPort The port (0 or 1) of the local player.  The remote player uses the other port.
+		 * \param _pipLocal The poller from which local input is read.  Polled once per frame on _ui8LocalPort.
+		 * \param _prtTransport The link to the other side.
+		 * \param _ui32InputDelay The number of frames by which local input is delayed, which hides that much latency without rolling back.
+		 * \param _ui32MaxRollback The most frames that may be run on predicted input before AdvanceFrame() waits for the other side.  If 0,
+		 *	the session runs in lockstep and _ui32InputDelay must not be 0.
+		 * \return Returns false if a parameter is invalid.
+		 */
+		bool											Start( CSystemBase &_sbSystem, uint8_t _ui8LocalPort, CInputPoller * _pipLocal, CRollbackTransport * _prtTransport,
+			uint32_t _ui32InputDelay = 0, uint32_t _ui32MaxRollback = LSN_RS_DEFAULT_MAX_ROLLBACK );
+
+		/**
+		 * Ends the session.  The system's input poller is cleared.
+		 */
+		void											Stop();
+
+		/**
+		 * Receives remote input, rolls back if any of it was mispredicted, then reads and sends local input and runs 1 frame.  Call once per
+		 *	host frame.
+		 *
+		 * \return Returns false if no frame was run because the other side is too far behind.
+		 */
+		bool											AdvanceFrame();
+
+		/**
+		 * Receives remote input and rolls back if any of it was mispredicted, without running a new frame.  AdvanceFrame() does this first;
+		 *	call it directly to catch up while not advancing.
+		 *
+		 * \return Returns false if a rollback failed.
+		 */
+		bool											Synchronize();
+
+		/**
+		 * Gets the next frame to be run, counted from Start().
+		 *
+		 * \return Returns the next frame to be run.
+		 */
+		inline uint64_t									Frame() const { return m_ui64Frame; }
+
+		/**
+		 * Gets the first frame whose remote input has not been received.  Every frame before it has been run with real input only.
+		 *
+		 * \return Returns the first unconfirmed frame.
+		 */
+		inline uint64_t									ConfirmedFrame() const { return m_ui64Confirmed; }
+
+		/**
+		 * Gets the snapshot taken at the start of the given frame, if it is still held.
+		 *
+		 * \param _ui64Frame The frame.
+		 * \return Returns the snapshot or nullptr.
+		 */
+		const std::vector<uint8_t> *					Snapshot( uint64_t _ui64Frame ) const;
+
+		/**
+		 * Gets the statistics.
+		 *
+		 * \return Returns the statistics.
+		 */
+		LSN_ROLLBACK_STATS								Stats() const;
+
+
+	protected :
+		// == Types.
+		/** The input for 1 frame. */
+		struct LSN_FRAME_INPUT {
+			uint64_t									ui64Frame;							/**< The frame to which this entry belongs. */
+			uint8_t										ui8Local;							/**< The local input. */
+			uint8_t										ui8Remote;							/**< The remote input, if bRemote. */
+			uint8_t										ui8Used;							/**< The remote input the frame was last run with. */
+			bool										bRemote;							/**< True once the remote input has been received. */
+		};
+
+		/** A snapshot. */
+		struct LSN_SNAPSHOT {
+			uint64_t									ui64Frame;							/**< The frame at whose start the snapshot was taken. */
+			std::vector<uint8_t>						vState;								/**< The saved state. */
+		};
+
+
+		// == Members.
+		/** The input ring. */
+		LSN_FRAME_INPUT									m_fiInput[LSN_RS_INPUT_RING];
+		/** The snapshot ring. */
+		std::vector<LSN_SNAPSHOT>						m_vSnapshots;
+		/** The system. */
+		CSystemBase *									m_psbSystem;
+		/** The local input source. */
+		CInputPoller *									m_pipLocal;
+		/** The link to the other side. */
+		CRollbackTransport *							m_prtTransport;
+		/** The clock used for timing. */
+		CClock											m_cClock;
+		/** The next frame to run. */
+		uint64_t										m_ui64Frame;
+		/** The first frame without remote input. */
+		uint64_t										m_ui64Confirmed;
+		/** The frame being run. */
+		uint64_t										m_ui64SimFrame;
+		/** The local input delay. */
+		uint32_t										m_ui32InputDelay;
+		/** The most frames that may run on predicted input. */
+		uint32_t										m_ui32MaxRollback;
+		/** The local port. */
+		uint8_t											m_ui8LocalPort;
+
+		/** The number of frames advanced. */
+		uint64_t										m_ui64Frames;
+		/** The number of stalls. */
+		uint64_t										m_ui64Stalls;
+		/** The number of mispredictions. */
+		uint64_t										m_ui64Mispredictions;
+		/** The number of rollbacks. */
+		uint64_t										m_ui64Rollbacks;
+		/** The number of frames run again. */
+		uint64_t										m_ui64ResimFrames;
+		/** The deepest rollback. */
+		uint32_t										m_ui32MaxDepth;
+		/** Total clock ticks spent rolling back. */
+		uint64_t										m_ui64ResimTicks;
+		/** The most clock ticks spent in 1 rollback. */
+		uint64_t										m_ui64MaxResimTicks;
+		/** Total clock ticks spent in AdvanceFrame(). */
+		uint64_t										m_ui64FrameTicks;
+		/** The most clock ticks spent in 1 AdvanceFrame(). */
+		uint64_t										m_ui64MaxFrameTicks;
+
+
+		// == Functions.
+		/**
+		 * Gets the input entry for a frame, clearing it if it last belonged to another frame.
+		 *
+		 * \param _ui64Frame The frame.
+		 * \return Returns the input entry.
+		 */
+		LSN_FRAME_INPUT &								Input( uint64_t _ui64Frame );
+
+		/**
+		 * Runs 1 frame with the best input known for it.
+		 *
+		 * \param _ui64Frame The frame to run.
+		 * \param _bSnapshot If true, a snapshot is taken first.
+		 * \return Returns false if the snapshot could not be taken.
+		 */
+		bool											RunFrame( uint64_t _ui64Frame, bool _bSnapshot );
+	};
+
+}	// namespace lsn
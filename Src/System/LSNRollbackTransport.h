@@ -0,0 +1,54 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A base class for the link over which rollback sessions exchange input.  Messages may arrive late or out of order but
+ *	must not be lost.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+
+namespace lsn {
+
+	/** 1 frame of input from 1 player. */
+	struct LSN_ROLLBACK_INPUT {
+		uint64_t										ui64Frame;							/**< The frame to which the input applies. */
+		uint8_t											ui8Input;							/**< A combination of LSN_INPUT_BITS values. */
+	};
+
+	/**
+	 * Class CRollbackTransport
+	 * \brief A base class for the link over which rollback sessions exchange input.
+	 *
+	 * Description: A base class for the link over which rollback sessions exchange input.  Messages may arrive late or out of order but
+	 *	must not be lost.
+	 */
+	class CRollbackTransport {
+	public :
+		virtual ~CRollbackTransport() {}
+
+
+		// == Functions.
+		/**
+		 * Sends 1 frame of local input to the other side.
+		 *
+		 * \param _riInput The input to send.
+		 * \return Returns false if the input could not be queued.
+		 */
+		virtual bool									Send( const LSN_ROLLBACK_INPUT &/*_riInput*/ ) { return false; }
+
+		/**
+		 * Receives the next frame of remote input that has arrived, if any.
+		 *
+		 * \param _riInput Holds the returned input.
+		 * \return Returns false if nothing has arrived.
+		 */
+		virtual bool									Receive( LSN_ROLLBACK_INPUT &/*_riInput*/ ) { return false; }
+	};
+
+}	// namespace lsn
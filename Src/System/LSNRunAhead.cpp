@@ -0,0 +1,202 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Run-ahead input-latency reduction.  After each emulated frame the system is snapshotted, run N frames further with the
+ *	current input, the last of those frames is presented, and the snapshot is restored.  Optionally the extra frames are run on a second
+ *	system loaded from the snapshot instead, so the main system is never rolled back.
+ */
+
+#include "LSNRunAhead.h"
+#include "../Utilities/LSNStream.h"
+
+#include <algorithm>
+
+
+namespace lsn {
+
+	CRunAhead::CRunAhead() :
+		m_pmSecondRegion( LSN_PM_UNKNOWN ),
+		m_pdcPresenter( nullptr ),
+		m_ui32Frames( 0 ),
+		m_ui64Runs( 0 ),
+		m_ui64SaveTicks( 0 ),
+		m_ui64LoadTicks( 0 ),
+		m_ui64RunTicks( 0 ),
+		m_ui64MaxTicks( 0 ) {
+	}
+	CRunAhead::~CRunAhead() {
+		DestroySecondInstance();
+	}
+
+	// == Functions.
+	/**
+	 * Sets the number of frames to run ahead.  0 disables run-ahead.  Also clears the statistics.
+	 *
+	 * \param _ui32Frames The number of frames to run ahead.
+	 */
+	void CRunAhead::SetFrames( uint32_t _ui32Frames ) {
+		m_ui32Frames = _ui32Frames;
+		m_ui64Runs = 0;
+		m_ui64SaveTicks = 0;
+		m_ui64LoadTicks = 0;
+		m_ui64RunTicks = 0;
+		m_ui64MaxTicks = 0;
+	}
+
+	/**
+	 * Creates a second system with the same ROM and settings as the given system, on which the extra frames are run from then on.
+	 *
+	 * \param _sbSystem The main system.  A ROM must be loaded.
+	 * \param _pmRegion The region of the main system.
+	 * \param _pipPoller The input poller to be used by the second system.
+	 * \return Returns true if the second system was created and loaded.
+	 */
+	bool CRunAhead::CreateSecondInstance( const CSystemBase &_sbSystem, LSN_PPU_METRICS _pmRegion, CInputPoller * _pipPoller ) {
+		DestroySecondInstance();
+		if ( !_sbSystem.GetRom() ) { return false; }
+		std::unique_ptr<CSystemBase> psbSystem = m_spPool.Acquire( _pmRegion );
+		if ( !psbSystem ) { return false; }
+		LSN_ROM rRom = (*_sbSystem.GetRom());
+		if ( !psbSystem->LoadRom( rRom ) ) {
+			m_spPool.Release( _pmRegion, std::move( psbSystem ) );
+			return false;
+		}
+		psbSystem->SetInputPoller( _pipPoller );
+		psbSystem->SetUnrolledScheduler( _sbSystem.IsUnrolledScheduler() );
+		psbSystem->SetLazyPpu( _sbSystem.IsLazyPpu() );
+		psbSystem->SetFastCpu( _sbSystem.IsFastCpu() );
+		psbSystem->SetBlockCpu( _sbSystem.IsBlockCpu() );
+		psbSystem->SetJitCpu( _sbSystem.IsJitCpu() );
+		psbSystem->SetDecodeCache( _sbSystem.IsDecodeCache() );
+		psbSystem->SetSwitchDispatch( _sbSystem.IsSwitchDispatch() );
+		psbSystem->SetIdleSkip( _sbSystem.IsIdleSkip() );
+		psbSystem->ResetState( false );
+		m_psbSecond = std::move( psbSystem );
+		m_pmSecondRegion = _pmRegion;
+		return true;
+	}
+
+	/**
+	 * Destroys the second system, if any.  The extra frames are then run on the main system, which is restored afterwards.
+	 */
+	void CRunAhead::DestroySecondInstance() {
+		if ( m_psbSecond ) {
+			m_psbSecond->SetInputPoller( nullptr );
+			if ( m_psbSecond->GetDisplayClient() ) {
+				m_psbSecond->GetDisplayClient()->DetatchFromDisplayHost();
+			}
+			m_spPool.Release( m_pmSecondRegion, std::move( m_psbSecond ) );
+		}
+		m_pmSecondRegion = LSN_PM_UNKNOWN;
+	}
+
+	/**
+	 * Destroys the second system and clears the statistics.  Call when a new ROM is loaded.
+	 */
+	void CRunAhead::Reset() {
+		DestroySecondInstance();
+		SetFrames( m_ui32Frames );
+	}
+
+	/**
+	 * Runs ahead of the main system and presents the last frame run, then puts everything back.  Call once per emulated frame, after
+	 *	the frame has been run.  The display client of the main system must not have a display host while run-ahead is enabled.
+	 *
+	 * \param _sbSystem The main system.
+	 * \param _pdhHost The display host to which to present the last frame, or nullptr to present nothing.
+	 * \return Returns false if run-ahead is disabled or the main system could not be saved or restored.
+	 */
+	bool CRunAhead::Run( CSystemBase &_sbSystem, CDisplayHost * _pdhHost ) {
+		if ( !m_ui32Frames || !_sbSystem.IsRomLoaded() ) { return false; }
+		const uint64_t ui64Start = m_cClock.GetRealTick();
+		m_vState.clear();
+		CStream sSave( m_vState );
+		if ( !_sbSystem.SaveState( sSave ) ) { return false; }
+		const uint64_t ui64Saved = m_cClock.GetRealTick();
+
+		CSystemBase * psbRun = &_sbSystem;
+		if ( m_psbSecond ) {
+			CStream sLoad( m_vState );
+			if ( !m_psbSecond->LoadState( sLoad ) ) { return false; }
+			if ( m_psbSecond->Palette() && _sbSystem.Palette() ) {
+				(*m_psbSecond->Palette()) = (*_sbSystem.Palette());
+			}
+			psbRun = m_psbSecond.get();
+		}
+		const uint64_t ui64Loaded = m_cClock.GetRealTick();
+
+		// Both systems render into the same target.  The main system has already drawn the start of the frame in progress.
+		CDisplayClient * pdcClient = psbRun->GetDisplayClient();
+		if ( m_psbSecond && pdcClient && _sbSystem.GetDisplayClient() ) {
+			pdcClient->ShareRenderTarget( (*_sbSystem.GetDisplayClient()) );
+		}
+		if ( m_ui32Frames > 1 ) {
+			psbRun->RunFrames( m_ui32Frames - 1 );
+		}
+		// Only the last frame is presented.
+		if ( _pdhHost && pdcClient ) {
+			m_pdcPresenter = pdcClient;
+			pdcClient->SetDisplayHost( _pdhHost );
+		}
+		psbRun->RunFrames( 1 );
+		if ( m_pdcPresenter ) {
+			m_pdcPresenter->SetDisplayHost( nullptr );
+			m_pdcPresenter = nullptr;
+		}
+		const uint64_t ui64Ran = m_cClock.GetRealTick();
+
+		uint64_t ui64LoadTicks = ui64Loaded - ui64Saved;
+		if ( !m_psbSecond ) {
+			CStream sLoad( m_vState );
+			if ( !_sbSystem.LoadState( sLoad ) ) { return false; }
+			ui64LoadTicks = m_cClock.GetRealTick() - ui64Ran;
+		}
+
+		++m_ui64Runs;
+		m_ui64SaveTicks += ui64Saved - ui64Start;
+		m_ui64LoadTicks += ui64LoadTicks;
+		m_ui64RunTicks += ui64Ran - ui64Loaded;
+		m_ui64MaxTicks = std::max( m_ui64MaxTicks, (ui64Saved - ui64Start) + ui64LoadTicks + (ui64Ran - ui64Loaded) );
+		return true;
+	}
+
+	/**
+	 * Gets the timing statistics.
+	 *
+	 * \return Returns the timing statistics.
+	 */
+	CRunAhead::LSN_RUN_AHEAD_STATS CRunAhead::Stats() const {
+		LSN_RUN_AHEAD_STATS rasStats = {};
+		rasStats.ui64Frames = m_ui64Runs;
+		rasStats.ui32RunAhead = m_ui32Frames;
+		rasStats.bSecondInstance = HasSecondInstance();
+		const double dToMicros = 1000000.0 / m_cClock.GetResolution();
+		if ( m_ui64Runs ) {
+			rasStats.dSaveMicros = m_ui64SaveTicks * dToMicros / m_ui64Runs;
+			rasStats.dLoadMicros = m_ui64LoadTicks * dToMicros / m_ui64Runs;
+			rasStats.dRunMicros = m_ui64RunTicks * dToMicros / m_ui64Runs;
+			rasStats.dTotalMicros = rasStats.dSaveMicros + rasStats.dLoadMicros + rasStats.dRunMicros;
+		}
+		rasStats.dMaxMicros = m_ui64MaxTicks * dToMicros;
+		return rasStats;
+	}
+
+	/**
+	 * Gets the number of frames that can be run ahead within the given time, based on the measured statistics.
+	 *
+	 * \param _dMicros The time left in each host frame once filtering and presentation are done, in microseconds.
+	 * \return Returns the number of frames that fit in the given time.
+	 */
+	uint32_t CRunAhead::FramesForBudget( double _dMicros ) const {
+		LSN_RUN_AHEAD_STATS rasStats = Stats();
+		if ( !rasStats.ui64Frames || !rasStats.ui32RunAhead ) { return 0; }
+		// The snapshot costs the same however far ahead we run; the emulation cost scales with the frame count.
+		const double dPerFrame = rasStats.dRunMicros / rasStats.ui32RunAhead;
+		const double dLeft = _dMicros - rasStats.dSaveMicros - rasStats.dLoadMicros;
+		if ( dLeft <= 0.0 || dPerFrame <= 0.0 ) { return 0; }
+		return uint32_t( std::min( dLeft / dPerFrame, double( UINT32_MAX ) ) );
+	}
+
+}	// namespace lsn
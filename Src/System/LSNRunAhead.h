@@ -0,0 +1,156 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Run-ahead input-latency reduction.  After each emulated frame the system is snapshotted, run N frames further with the
+ *	current input, the last of those frames is presented, and the snapshot is restored.  Optionally the extra frames are run on a second
+ *	system loaded from the snapshot instead, so the main system is never rolled back.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Display/LSNDisplayHost.h"
+#include "../Input/LSNInputPoller.h"
+#include "../Time/LSNClock.h"
+#include "LSNSystemPool.h"
+
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRunAhead
+	 * \brief Run-ahead input-latency reduction.
+	 *
+	 * Description: Run-ahead input-latency reduction.  After each emulated frame the system is snapshotted, run N frames further with the
+	 *	current input, the last of those frames is presented, and the snapshot is restored.  Optionally the extra frames are run on a second
+	 *	system loaded from the snapshot instead, so the main system is never rolled back.
+	 */
+	class CRunAhead {
+	public :
+		CRunAhead();
+		~CRunAhead();
+
+
+		// == Types.
+		/** Per-frame timing statistics. */
+		struct LSN_RUN_AHEAD_STATS {
+			uint64_t									ui64Frames;							/**< The number of times Run() has run ahead since the last Reset(). */
+			uint32_t									ui32RunAhead;						/**< The number of frames run ahead each time. */
+			bool										bSecondInstance;					/**< True if a second system runs the extra frames. */
+			double										dSaveMicros;						/**< The average time spent saving the snapshot, in microseconds. */
+			double										dLoadMicros;						/**< The average time spent loading the snapshot back (or into the second system), in microseconds. */
+			double										dRunMicros;							/**< The average time spent emulating the extra frames, in microseconds. */
+			double										dTotalMicros;						/**< The average total time spent per call, in microseconds. */
+			double										dMaxMicros;							/**< The longest total time spent in 1 call, in microseconds. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Sets the number of frames to run ahead.  0 disables run-ahead.  Also clears the statistics.
+		 *
+		 * \param _ui32Frames The number of frames to run ahead.
+		 */
+		void											SetFrames( uint32_t _ui32Frames );
+
+		/**
+		 * Gets the number of frames to run ahead.
+		 *
+		 * \return Returns the number of frames to run ahead.  0 means run-ahead is disabled.
+		 */
+		inline uint32_t									Frames() const { return m_ui32Frames; }
+
+		/**
+		 * Creates a second system with the same ROM and settings as the given system, on which the extra frames are run from then on.
+		 *
+		 * \param _sbSystem The main system.  A ROM must be loaded.
+		 * \param _pmRegion The region of the main system.
+		 * \param _pipPoller The input poller to be used by the second system.
+		 * \return Returns true if the second system was created and loaded.
+		 */
+		bool											CreateSecondInstance( const CSystemBase &_sbSystem, LSN_PPU_METRICS _pmRegion, CInputPoller * _pipPoller );
+
+		/**
+		 * Destroys the second system, if any.  The extra frames are then run on the main system, which is restored afterwards.
+		 */
+		void											DestroySecondInstance();
+
+		/**
+		 * Determines whether the extra frames are run on a second system.
+		 *
+		 * \return Returns true if a second system has been created.
+		 */
+		inline bool										HasSecondInstance() const { return m_psbSecond.get() != nullptr; }
+
+		/**
+		 * Destroys the second system and clears the statistics.  Call when a new ROM is loaded.
+		 */
+		void											Reset();
+
+		/**
+		 * Runs ahead of the main system and presents the last frame run, then puts everything back.  Call once per emulated frame, after
+		 *	the frame has been run.  The display client of the main system must not have a display host while run-ahead is enabled.
+		 *
+		 * \param _sbSystem The main system.
+		 * \param _pdhHost The display host to which to present the last frame, or nullptr to present nothing.
+		 * \return Returns false if run-ahead is disabled or the main system could not be saved or restored.
+		 */
+		bool											Run( CSystemBase &_sbSystem, CDisplayHost * _pdhHost );
+
+		/**
+		 * Gets the display client presenting the current frame.  Only valid while Run() is presenting; nullptr otherwise.
+		 *
+		 * \return Returns the display client presenting the current frame or nullptr.
+		 */
+		inline CDisplayClient *							Presenter() const { return m_pdcPresenter; }
+
+		/**
+		 * Gets the timing statistics.
+		 *
+		 * \return Returns the timing statistics.
+		 */
+		LSN_RUN_AHEAD_STATS								Stats() const;
+
+		/**
+		 * Gets the number of frames that can be run ahead within the given time, based on the measured statistics.
+		 *
+		 * \param _dMicros The time left in each host frame once filtering and presentation are done, in microseconds.
+		 * \return Returns the number of frames that fit in the given time.
+		 */
+		uint32_t										FramesForBudget( double _dMicros ) const;
+
+
+	protected :
+		// == Members.
+		/** The snapshot. */
+		std::vector<uint8_t>							m_vState;
+		/** The pool from which the second system is taken. */
+		CSystemPool										m_spPool;
+		/** The second system, if any. */
+		std::unique_ptr<CSystemBase>					m_psbSecond;
+		/** The region of the second system. */
+		LSN_PPU_METRICS									m_pmSecondRegion;
+		/** The display client presenting the current frame. */
+		CDisplayClient *								m_pdcPresenter;
+		/** The clock used for timing. */
+		CClock											m_cClock;
+		/** The number of frames to run ahead. */
+		uint32_t										m_ui32Frames;
+		/** The number of times Run() has run ahead. */
+		uint64_t										m_ui64Runs;
+		/** Total clock ticks spent saving. */
+		uint64_t										m_ui64SaveTicks;
+		/** Total clock ticks spent loading. */
+		uint64_t										m_ui64LoadTicks;
+		/** Total clock ticks spent running. */
+		uint64_t										m_ui64RunTicks;
+		/** The most clock ticks spent in 1 call. */
+		uint64_t										m_ui64MaxTicks;
+	};
+
+}	// namespace lsn
@@ -11,6 +11,7 @@
 
 #include "../LSNLSpiroNes.h"
 #include "../Apu/LSNApu2A0X.h"
+#include "../Bus/LSNWatchpoints.h"
 #include "../Cpu/LSNCpu6502.h"
 #include "../Crc/LSNCrc.h"
 #include "../Database/LSNDatabase.h"
@@ -22,6 +23,7 @@
 
 #include <algorithm>
 #include <immintrin.h>
+#include <numeric>
 
 namespace lsn {
 
@@ -29,7 +31,8 @@ namespace lsn {
 	 * Class CSystem
 	 * \brief The "system" is all of the components glued together and run under the master clock.
 	 *
-	 * Description: The "system" is all of the components glued together and run under the master clock.
+	 * Description: The "system" is all of the components glued together and run under the master clock.  If _bProfile is true, the host
+	 *	time spent in each component is measured by a CSystemProfiler (see GetProfiler()); otherwise the profiling code is compiled out.
 	 */
 	template <unsigned _tMasterClock, unsigned _tMasterDiv,
 		unsigned _tCpuDiv,
@@ -37,13 +40,20 @@ namespace lsn {
 		unsigned _tApuDiv,
 		class _cCpu,
 		class _cPpu,
-		class _cApu>
+		class _cApu,
+		bool _bProfile = false>
 	class CSystem : public CSystemBase {
 	public :
 		CSystem() :
 			m_cCpu( &m_bBus ),
 			m_pPpu( &m_bBus, &m_cCpu ),
-			m_aApu( &m_bBus ) {
+			m_aApu( &m_bBus, &m_eqEvents, _tApuDiv ),
+			m_wWatchpoints( &m_bBus, &m_cCpu ),
+			m_ui64LazyCpuTime( 0 ),
+			m_ui64IdleStatusStable( 0 ),
+			m_pdhProfilerHost( &m_spProfiler ),
+			m_bProfileTickMapper( false ) {
+			m_eqEvents.SetHorizon( &m_ui64MasterCounter );
 			ResetState( false );
 		}
 
@@ -55,41 +65,23 @@ namespace lsn {
 		 * \param _bAnalog If true, a soft reset is performed on the CPU, otherwise the CPU is reset to a known state.
 		 */
 		void											ResetState( bool _bAnalog ) {
-			m_bBus.ApplyMap();
-			
-			m_aApu.ApplyMemoryMap();
-			m_cCpu.ApplyMemoryMap();
-			m_pPpu.ApplyMemoryMap();
-
-			if ( IsRomLoaded() ) {
-				switch ( m_rRom.riInfo.mmMirroring ) {
-					case LSN_MM_VERTICAL : {
-						m_pPpu.ApplyVerticalMirroring();
-						break;
-					}
-					case LSN_MM_HORIZONTAL : {
-						m_pPpu.ApplyHorizontalMirroring();
-						break;
-					}
-					case LSN_MM_4_SCREENS : {
-						m_pPpu.ApplyFourScreensMirroring();
-						break;
-					}
-					case LSN_MM_1_SCREEN_A : {
-						m_pPpu.ApplyOneScreenMirroring();
-						break;
-					}
-					case LSN_MM_1_SCREEN_B : {
-						m_pPpu.ApplyOneScreenMirroring_B();
-						break;
-					}
-				}
+			m_wWatchpoints.Detach();
+			if ( m_pmBaseCpuMap.get() && m_pmBasePpuMap.get() ) {
+				// Nothing below the mapper depends on anything but the ROM header, so it is copied back rather than rebuilt.
+				m_bBus.RestoreMap( (*m_pmBaseCpuMap) );
+				m_pPpu.GetBus().RestoreMap( (*m_pmBasePpuMap) );
+			}
+			else {
+				ApplyBaseMap();
+			}
 
-				if ( m_pmbMapper.get() ) {
-					m_pmbMapper->ApplyMap( &m_bBus, &m_pPpu.GetBus() );
-				}
+			if ( IsRomLoaded() && m_pmbMapper.get() ) {
+				// Mappers reset their banks while mapping, so this is always reapplied.
+				m_pmbMapper->ApplyMap( &m_bBus, &m_pPpu.GetBus() );
 			}
 
+			// The components schedule their first events while resetting.
+			m_eqEvents.Reset();
 			if ( _bAnalog ) {
 				m_cCpu.ResetAnalog();
 				m_aApu.ResetAnalog();
@@ -100,9 +92,24 @@ namespace lsn {
 				m_aApu.ResetToKnown();
 				m_pPpu.ResetToKnown();
 			}
+			m_eqEvents.SetCpuTimeBase( _tCpuDiv, m_cCpu.GetCycleCount() );
+			if constexpr ( _bProfile ) {
+				m_spProfiler.Reset( m_pPpu.GetFrameCount() );
+			}
+
+			// ApplyMap() above replaced all of the trampolines.
+			m_vPpuSyncTrampolines.clear();
+			m_vPpuSyncAddresses.clear();
+			if ( m_bLazyPpu ) {
+				ApplyPpuSyncTrampolines( true );
+			}
+			m_wWatchpoints.Install();
+			m_bBus.UpdatePageTable();
+			m_pPpu.GetBus().UpdatePageTable();
 
 			m_ui64TickCount = 0;
 			m_ui64AccumTime = 0;
+			m_ui64LazyCpuTime = 0;
 			m_ui64MasterCounter = 0;
 			m_ui64CpuCounter = 0;
 			m_ui64PpuCounter = 0;
@@ -127,62 +134,50 @@ namespace lsn {
 
 					//m_ui64MasterCounter = m_ui64AccumTime * _tMasterClock / (m_cClock.GetResolution() * _tMasterDiv);
 				}
+				RunMasterCycles<false>();
+			}
+			m_ui64LastRealTime = ui64CurRealTime;
+		}
 
+		/**
+		 * Runs exactly the given number of master cycles as fast as the host allows.  The real-time clock is not read and the time accumulator is
+		 *	not touched, so the results are fully deterministic.  Not intended to be mixed with Tick() on the same run.
+		 *
+		 * \param _ui64MasterCycles The number of master cycles to run.
+		 */
+		virtual void									RunCycles( uint64_t _ui64MasterCycles ) {
+			m_ui64MasterCounter += _ui64MasterCycles;
+			RunMasterCycles<false>();
+		}
 
-#define LSN_CPU_SLOT											0
-#define LSN_PPU_SLOT											1
-#define LSN_APU_SLOT											2
-				struct LSN_HW_SLOTS {
-					CTickable *									ptHw;
-					//CTickable::PfTickFunc						pfTick;
-					uint64_t 									ui64Counter;
-					const uint64_t								ui64Inc;
-				} hsSlots[3] = {
-					{ &m_cCpu, m_ui64CpuCounter + _tCpuDiv, _tCpuDiv },
-					{ &m_pPpu, m_ui64PpuCounter + _tPpuDiv, _tPpuDiv },
-					{ &m_aApu, m_ui64ApuCounter + _tApuDiv, _tApuDiv },
-				};
-				LSN_HW_SLOTS * phsSlot = nullptr;
-				do {
-					phsSlot = nullptr;
-					uint64_t ui64Low = ~0ULL;
-					// Looping over the 3 slots adds a small amount of overhead.  Unrolling the loop is easy.
-					if ( hsSlots[LSN_CPU_SLOT].ui64Counter <= m_ui64MasterCounter && hsSlots[LSN_CPU_SLOT].ui64Counter <= ui64Low ) {
-						phsSlot = &hsSlots[LSN_CPU_SLOT];
-						ui64Low = phsSlot->ui64Counter;
-					}
-					if ( hsSlots[LSN_PPU_SLOT].ui64Counter <= m_ui64MasterCounter && hsSlots[LSN_PPU_SLOT].ui64Counter <= ui64Low ) {
-						phsSlot = &hsSlots[LSN_PPU_SLOT];
-						ui64Low = phsSlot->ui64Counter;
-					}
-					if ( hsSlots[LSN_APU_SLOT].ui64Counter <= m_ui64MasterCounter && hsSlots[LSN_APU_SLOT].ui64Counter < ui64Low ) {
-						// If we come in here then we know that the APU will be the one to tick.
-						//	This means we can optimize away the "if ( phsSlot != nullptr )" check
-						//	as well as the pointer-access ("phsSlot").
-						// Testing showed this took the loop down from 0.71834220 cycles-per-tick to
-						//	0.68499566 cycles-per-tick.
-						// Switching to function pointers inside the CPU Tick() function brought it
-						//	down to 0.63103939.
-						hsSlots[LSN_APU_SLOT].ui64Counter += hsSlots[LSN_APU_SLOT].ui64Inc;
-						//(hsSlots[LSN_APU_SLOT].ptHw->*hsSlots[LSN_APU_SLOT].pfTick)();
-						hsSlots[LSN_APU_SLOT].ptHw->Tick();
-					}
-					else if ( phsSlot != nullptr ) {
-						phsSlot->ui64Counter += phsSlot->ui64Inc;
-						//(phsSlot->ptHw->*phsSlot->pfTick)();
-						phsSlot->ptHw->Tick();
-					}
-					else { break; }
-				} while ( true );
-				m_ui64CpuCounter = hsSlots[LSN_CPU_SLOT].ui64Counter - _tCpuDiv;
-				m_ui64PpuCounter = hsSlots[LSN_PPU_SLOT].ui64Counter - _tPpuDiv;
-				m_ui64ApuCounter = hsSlots[LSN_APU_SLOT].ui64Counter - _tApuDiv;
-
-#undef LSN_APU_SLOT
-#undef LSN_PPU_SLOT
-#undef LSN_CPU_SLOT
+		/**
+		 * Runs until the PPU has completed the given number of frames, as fast as the host allows.  The real-time clock is not read and the time
+		 *	accumulator is not touched, so the results are fully deterministic.  Not intended to be mixed with Tick() on the same run.
+		 *
+		 * \param _ui64Frames The number of frames to run.
+		 */
+		virtual void									RunFrames( uint64_t _ui64Frames ) {
+			const uint64_t ui64Target = m_pPpu.GetFrameCount() + _ui64Frames;
+			while ( m_pPpu.GetFrameCount() < ui64Target ) {
+				// Run in large slices; RunMasterCycles() stops early on each frame boundary.
+				m_ui64MasterCounter += _tPpuDiv * 0x10000ULL;
+				RunMasterCycles<true>();
 			}
-			m_ui64LastRealTime = ui64CurRealTime;
+		}
+
+		/**
+		 * Moves the real-time accumulator to the current master counter so that Tick() carries on from the current point.  Call this after
+		 *	RunCycles() or RunFrames() before going back to Tick().
+		 */
+		virtual void									SyncRealTime() {
+			// Rounded up so that the next Tick() never computes a master counter behind the current one.
+			const uint64_t ui64Div = _tMasterClock;
+			uint64_t ui64Hi;
+			uint64_t ui64Low = _umul128( m_ui64MasterCounter, m_cClock.GetResolution() * _tMasterDiv, &ui64Hi );
+			ui64Low += ui64Div - 1;
+			if ( ui64Low < ui64Div - 1 ) { ++ui64Hi; }
+			m_ui64AccumTime = _udiv128( ui64Hi, ui64Low, ui64Div, nullptr );
+			m_ui64LastRealTime = m_cClock.GetRealTick();
 		}
 
 		/**
@@ -227,6 +222,136 @@ namespace lsn {
 		 */
 		virtual uint64_t								GetPpuFrameCount() const { return m_pPpu.GetFrameCount(); }
 
+		/**
+		 * Gets the number of master cycles in a full PPU frame.
+		 *
+		 * \return Returns the number of master cycles in a full PPU frame.
+		 */
+		virtual uint64_t								GetMasterCyclesPerFrame() const { return uint64_t( m_pPpu.DotWidth() ) * m_pPpu.DotHeight() * _tPpuDiv; }
+
+		/**
+		 * Gets the PPU bus.
+		 *
+		 * \return Returns the PPU bus.
+		 */
+		virtual CPpuBus *								GetPpuBus() { return &m_pPpu.GetBus(); }
+
+		/**
+		 * Gets the memory watchpoints on the CPU bus.
+		 *
+		 * \return Returns the watchpoints.
+		 */
+		virtual CWatchpoints *							GetWatchpoints() { return &m_wWatchpoints; }
+
+		/**
+		 * Gets the per-component profiler.  Only systems built with profiling enabled have one.
+		 *
+		 * \return Returns the profiler, or nullptr if the system was built without profiling.
+		 */
+		virtual const CSystemProfiler *					GetProfiler() const {
+			if constexpr ( _bProfile ) { return &m_spProfiler; }
+			else { return nullptr; }
+		}
+
+		/**
+		 * Writes the full emulation state to a stream.  The state begins with a small header (magic, version, master clock, ROM CRC, and
+		 *	mapper) followed by the counters, the CPU bus, and each component.  A ROM must be loaded.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &_sStream ) const {
+			if ( !IsRomLoaded() || !m_pmbMapper.get() ) { return false; }
+			if ( !_sStream.WriteUi32( LSN_SAVE_STATE_MAGIC ) ) { return false; }
+			if ( !_sStream.WriteUi32( LSN_SAVE_STATE_VERSION ) ) { return false; }
+			if ( !_sStream.WriteUi64( MasterHz() ) ) { return false; }
+			if ( !_sStream.WriteUi32( _tMasterDiv ) ) { return false; }
+			if ( !_sStream.WriteUi32( _tCpuDiv ) ) { return false; }
+			if ( !_sStream.WriteUi32( _tPpuDiv ) ) { return false; }
+			if ( !_sStream.WriteUi32( _tApuDiv ) ) { return false; }
+			if ( !_sStream.WriteUi32( m_rRom.riInfo.ui32Crc ) ) { return false; }
+			if ( !_sStream.WriteUi16( m_rRom.riInfo.ui16Mapper ) ) { return false; }
+
+			if ( !_sStream.WriteUi64( m_ui64MasterCounter ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64CpuCounter ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64PpuCounter ) ) { return false; }
+			if ( !_sStream.WriteUi64( m_ui64ApuCounter ) ) { return false; }
+
+			if ( !m_bBus.SaveState( _sStream ) ) { return false; }
+			if ( !m_cCpu.SaveState( _sStream ) ) { return false; }
+			if ( !m_pPpu.SaveState( _sStream ) ) { return false; }
+			if ( !m_aApu.SaveState( _sStream ) ) { return false; }
+			if ( !m_pmbMapper->SaveState( _sStream ) ) { return false; }
+			return true;
+		}
+
+		/**
+		 * Restores the full emulation state from a stream previously written by SaveState() for the same ROM and region.  Timed events are
+		 *	not stored; the components that own them schedule them again from their restored state.  The real-time accumulator is not touched,
+		 *	so call SyncRealTime() before going back to Tick() unless the state was saved earlier in the same Tick() run.
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was restored.  If false is returned after the header was accepted, the system is reset.
+		 */
+		virtual bool									LoadState( CStream &_sStream ) {
+			if ( !IsRomLoaded() || !m_pmbMapper.get() ) { return false; }
+			uint32_t ui32Magic, ui32Version, ui32Crc, ui32Div;
+			uint64_t ui64MasterHz;
+			uint16_t ui16Mapper;
+			if ( !_sStream.ReadUi32( ui32Magic ) || ui32Magic != LSN_SAVE_STATE_MAGIC ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Version ) || ui32Version != LSN_SAVE_STATE_VERSION ) { return false; }
+			if ( !_sStream.ReadUi64( ui64MasterHz ) || ui64MasterHz != MasterHz() ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Div ) || ui32Div != _tMasterDiv ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Div ) || ui32Div != _tCpuDiv ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Div ) || ui32Div != _tPpuDiv ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Div ) || ui32Div != _tApuDiv ) { return false; }
+			if ( !_sStream.ReadUi32( ui32Crc ) || ui32Crc != m_rRom.riInfo.ui32Crc ) { return false; }
+			if ( !_sStream.ReadUi16( ui16Mapper ) || ui16Mapper != m_rRom.riInfo.ui16Mapper ) { return false; }
+
+			if ( !LoadStateBody( _sStream ) ) {
+				ResetState( false );
+				return false;
+			}
+			return true;
+		}
+
+		/**
+		 * Clears the dirty-page bitmaps of the CPU and PPU buses.  Call after taking a checkpoint.
+		 */
+		virtual void									ClearDirtyPages() {
+			m_bBus.ClearDirtyPages();
+			m_pPpu.GetBus().ClearDirtyPages();
+		}
+
+		/**
+		 * Gets the number of CPU-bus and PPU-bus pages written since the last call to ClearDirtyPages().
+		 *
+		 * \return Returns the number of dirty pages.
+		 */
+		virtual size_t									DirtyPageCount() const {
+			return m_bBus.DirtyPageCount() + m_pPpu.GetBus().DirtyPageCount();
+		}
+
+		/**
+		 * Writes only the CPU-bus and PPU-bus pages written since the last call to ClearDirtyPages().
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the pages were written.
+		 */
+		virtual bool									SaveDirtyPages( CStream &_sStream ) const {
+			return m_bBus.SaveDirtyPages( _sStream ) && m_pPpu.GetBus().SaveDirtyPages( _sStream );
+		}
+
+		/**
+		 * Reads pages previously written by SaveDirtyPages() over the current CPU-bus and PPU-bus memory.
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the pages were read.
+		 */
+		virtual bool									LoadDirtyPages( CStream &_sStream ) {
+			return m_bBus.LoadDirtyPages( _sStream ) && m_pPpu.GetBus().LoadDirtyPages( _sStream );
+		}
+
 		/**
 		 * Loads a ROM image.
 		 *
@@ -236,8 +361,13 @@ namespace lsn {
 		 */
 		bool											LoadRom( LSN_ROM &_rRom ) {
 			m_pmbMapper.reset();
+			// The base map depends on the ROM header.
+			m_pmBaseCpuMap.reset();
+			m_pmBasePpuMap.reset();
 			m_rRom = std::move( _rRom );
 
+			// Nothing from a previous cartridge may leak into this one (systems are reused by CSystemPool).
+			m_bBus.ResetToKnown();
 			m_pPpu.GetPpuBus().DGB_FillMemory( 0xFF );
 
 			uint16_t ui16Addr = 0x8000;
@@ -389,11 +519,14 @@ namespace lsn {
 				}
 				default : {
 					m_pmbMapper = std::make_unique<CMapperBase>();
+#ifdef LSN_WINDOWS
 					std::string sText = "****** Mapper not handled: " + std::to_string( m_rRom.riInfo.ui16Mapper ) + ".\r\n";
 					::OutputDebugStringA( sText.c_str() );
+#endif	// #ifdef LSN_WINDOWS
 				}
 			}
 			
+#ifdef LSN_WINDOWS
 			{
 				char szBuffer[128];
 				std::sprintf( szBuffer, "****** CRC: 0x%.8X\r\n", m_rRom.riInfo.ui32Crc );
@@ -413,8 +546,15 @@ namespace lsn {
 				sText = "****** PGM RAM Size: " + std::to_string( m_rRom.i32WorkRamSize ) + ".\r\n";
 				::OutputDebugStringA( sText.c_str() );
 			}
+#endif	// #ifdef LSN_WINDOWS
 			m_cCpu.SetMapper( m_pmbMapper.get() );
+			if constexpr ( _bProfile ) {
+				// Tick the mapper here instead of inside the CPU so that it can be timed separately.
+				m_bProfileTickMapper = m_cCpu.TicksMapper();
+				m_cCpu.SetTicksMapper( false );
+			}
 			if ( m_pmbMapper ) {
+				m_pmbMapper->SetEventQueue( &m_eqEvents );
 				m_pmbMapper->InitWithRom( m_rRom, &m_cCpu );
 			}
 
@@ -430,6 +570,160 @@ namespace lsn {
 			m_cCpu.SetInputPoller( _pipPoller );
 		}
 
+		/**
+		 * Enables or disables lazy-PPU mode, in which the PPU is only caught up to the CPU when something can observe or affect it.
+		 *
+		 * \param _bLazy If true, lazy-PPU mode is enabled.
+		 */
+		virtual void									SetLazyPpu( bool _bLazy ) {
+			if ( _bLazy != m_bLazyPpu ) {
+				m_bLazyPpu = _bLazy;
+				ApplyPpuSyncTrampolines( _bLazy );
+			}
+		}
+
+		/**
+		 * Enables or disables the CPU-bus and PPU-bus page tables, through which plain RAM/ROM pages are accessed directly instead of
+		 *	through their per-address functions.
+		 *
+		 * \param _bFast If true, the page tables are used.
+		 */
+		virtual void									SetFastPages( bool _bFast ) {
+			m_bFastPages = _bFast;
+			m_bBus.SetFastPages( _bFast );
+			m_pPpu.GetBus().SetFastPages( _bFast );
+		}
+
+		/**
+		 * Gets the number of CPU-bus and PPU-bus pages that are read directly rather than through per-address functions.
+		 *
+		 * \return Returns the number of directly read pages.
+		 */
+		virtual size_t									FastReadPageCount() const {
+			return m_bBus.FastReadPageCount() + m_pPpu.GetBus().FastReadPageCount();
+		}
+
+		/**
+		 * Gets the number of CPU-bus and PPU-bus pages that are written directly rather than through per-address functions.
+		 *
+		 * \return Returns the number of directly written pages.
+		 */
+		virtual size_t									FastWritePageCount() const {
+			return m_bBus.FastWritePageCount() + m_pPpu.GetBus().FastWritePageCount();
+		}
+
+		/**
+		 * Gets the number of instructions run in 1 call each since the last reset.
+		 *
+		 * \return Returns the number of instructions run in 1 call each.
+		 */
+		virtual uint64_t								FastCpuInstructions() const { return m_cCpu.FastInstructionCount(); }
+
+		/**
+		 * Gets the number of CPU cycles inside instructions run in 1 call each since the last reset.
+		 *
+		 * \return Returns the number of CPU cycles run an instruction at a time.
+		 */
+		virtual uint64_t								FastCpuCycles() const { return m_cCpu.FastCycleCount(); }
+
+		/**
+		 * Gets the number of runs of back-to-back instructions since the last reset.
+		 *
+		 * \return Returns the number of runs of instructions run without returning to the scheduler.
+		 */
+		virtual uint64_t								FastCpuBlocks() const { return m_cCpu.FastBlockCount(); }
+
+		/**
+		 * Enables or disables running back-to-back instructions through compiled x86-64 code.
+		 *
+		 * \param _bEnable If true, back-to-back instructions are compiled.
+		 */
+		virtual void									SetJitCpu( bool _bEnable ) {
+			m_cCpu.SetJit( _bEnable );
+			m_bJitCpu = m_cCpu.IsJit();
+		}
+
+		/**
+		 * Gets the number of instructions run through compiled code since the last reset.  Included in FastCpuInstructions().
+		 *
+		 * \return Returns the number of instructions run through compiled code.
+		 */
+		virtual uint64_t								JitInstructions() const { return m_cCpu.JitStats().ui64Instructions; }
+
+		/**
+		 * Gets the number of blocks of instructions compiled since the last reset.
+		 *
+		 * \return Returns the number of blocks compiled.
+		 */
+		virtual uint64_t								JitBlocks() const { return m_cCpu.JitStats().ui64Blocks; }
+
+		/**
+		 * Enables or disables skipping whole passes of idle loops.
+		 *
+		 * \param _bEnable If true, idle loops are skipped.
+		 */
+		virtual void									SetIdleSkip( bool _bEnable ) {
+			m_bIdleSkip = _bEnable;
+			m_cCpu.SetIdleSkip( _bEnable );
+		}
+
+		/**
+		 * Gets the number of times passes of an idle loop were skipped since the last reset.
+		 *
+		 * \return Returns the number of skips.
+		 */
+		virtual uint64_t								IdleSkips() const { return m_cCpu.IdleSkipCount(); }
+
+		/**
+		 * Gets the number of CPU cycles skipped in idle loops since the last reset.
+		 *
+		 * \return Returns the number of CPU cycles skipped.
+		 */
+		virtual uint64_t								IdleCycles() const { return m_cCpu.IdleCycleCount(); }
+
+		/**
+		 * Gets the number of CPU cycles skipped in loops polling PPUSTATUS since the last reset.  Included in IdleCycles().
+		 *
+		 * \return Returns the number of CPU cycles skipped in loops polling PPUSTATUS.
+		 */
+		virtual uint64_t								IdleStatusCycles() const { return m_cCpu.IdleIoCycleCount(); }
+
+		/**
+		 * Gets the number of instructions run in 1 call that could have behaved differently 1 cycle at a time.  Only counted in builds
+		 *	with LSN_CPU_FAST_PATH_CHECK defined, and always expected to be 0.
+		 *
+		 * \return Returns the number of failed checks.
+		 */
+		virtual uint64_t								FastCpuCheckFailures() const { return m_cCpu.FastCheckFailures(); }
+
+		/**
+		 * Enables or disables the cache of decoded instruction blocks used when running instructions in 1 call each.
+		 *
+		 * \param _bEnable If true, the decoded-block cache is used.
+		 */
+		virtual void									SetDecodeCache( bool _bEnable ) {
+			m_bDecodeCache = _bEnable;
+			m_cCpu.SetDecodeCache( _bEnable );
+		}
+
+		/**
+		 * Gets the decoded-block cache statistics since the last reset.
+		 *
+		 * \return Returns the decoded-block cache statistics.
+		 */
+		virtual CDecodeCache::LSN_DECODE_CACHE_STATS	DecodeCacheStats() const { return m_cCpu.DecodeCacheStats(); }
+
+		/**
+		 * Selects whether the CPU dispatches the cycles of its instructions through 1 switch on 1-byte micro-op ID's instead of through
+		 *	function pointers.
+		 *
+		 * \param _bSwitch If true, the switch dispatcher is used.
+		 */
+		virtual void									SetSwitchDispatch( bool _bSwitch ) {
+			m_bSwitchDispatch = _bSwitch;
+			m_cCpu.SetSwitchDispatch( _bSwitch );
+		}
+
 		/**
 		 * Gets the PPU.
 		 *
@@ -466,9 +760,561 @@ namespace lsn {
 		_cCpu											m_cCpu;								/**< The CPU. */
 		_cPpu											m_pPpu;								/**< The PPU. */
 		_cApu											m_aApu;								/**< The APU. */
+		CEventQueue										m_eqEvents;							/**< Timed events (APU frame counter, mapper IRQ's, etc.) */
+		CWatchpoints									m_wWatchpoints;						/**< Memory watchpoints on the CPU bus. */
+		std::unique_ptr<CCpuBus::LSN_MAP>				m_pmBaseCpuMap;						/**< The CPU-bus map before the mapper is applied, copied back by ResetState(). */
+		std::unique_ptr<CPpuBus::LSN_MAP>				m_pmBasePpuMap;						/**< The PPU-bus map before the mapper is applied, copied back by ResetState(). */
+		std::vector<CCpuBus::LSN_TRAMPOLINE>			m_vPpuSyncTrampolines;				/**< Trampolines that catch the PPU up in lazy-PPU mode. */
+		std::vector<uint16_t>							m_vPpuSyncAddresses;				/**< The address of each trampoline in m_vPpuSyncTrampolines. */
+		uint64_t										m_ui64LazyCpuTime;					/**< The master cycle of the CPU tick in progress in lazy-PPU mode. */
+		uint64_t										m_ui64IdleStatusStable;				/**< The master cycle until which PPUSTATUS reads change nothing, as of the CPU's last idle-loop state. */
+		CSystemProfiler									m_spProfiler;						/**< The per-component profiler.  Only used if _bProfile is true. */
+		CProfilerDisplayHost							m_pdhProfilerHost;					/**< Stands in for the display host while running so that Swap() can be timed.  Only used if _bProfile is true. */
+		bool											m_bProfileTickMapper;				/**< If true, the mapper is ticked before each CPU cycle by TickCpu() instead of by the CPU.  Only used if _bProfile is true. */
 
 
 		// == Functions.
+		/**
+		 * Runs every hardware component up to m_ui64MasterCounter.  The components are run in bursts between events, and each event is run
+		 *	on its master cycle before any component ticks on that cycle.
+		 * 
+		 * \param _bStopAtFrame If true, running stops as soon as the PPU finishes a frame, with m_ui64MasterCounter pulled back to the cycle on which that happened.
+		 */
+		template <bool _bStopAtFrame>
+		void											RunMasterCycles() {
+			if constexpr ( _bProfile ) {
+				// The display host is swapped out only while running, so the frontend never sees the stand-in.
+				CDisplayHost * pdhHost = m_pPpu.GetDisplayHost();
+				if ( pdhHost ) {
+					m_pdhProfilerHost.SetHost( pdhHost );
+					m_pPpu.SetDisplayHost( &m_pdhProfilerHost );
+				}
+				m_spProfiler.Measure<CSystemProfiler::LSN_PC_SCHEDULER>( [this]{ RunMasterCycles_Events<_bStopAtFrame>(); } );
+				if ( pdhHost ) {
+					m_pPpu.SetDisplayHost( pdhHost );
+				}
+			}
+			else {
+				RunMasterCycles_Events<_bStopAtFrame>();
+			}
+		}
+
+		/**
+		 * Runs every hardware component up to m_ui64MasterCounter, stopping at each pending event to run it.
+		 * 
+		 * \param _bStopAtFrame If true, running stops as soon as the PPU finishes a frame, with m_ui64MasterCounter pulled back to the cycle on which that happened.
+		 */
+		template <bool _bStopAtFrame>
+		void											RunMasterCycles_Events() {
+			const uint64_t ui64Target = m_ui64MasterCounter;
+			const uint64_t ui64Frame = m_pPpu.GetFrameCount();
+			while ( true ) {
+				const uint64_t ui64Next = m_eqEvents.NextTime();
+				// An event scheduled during the burst for a time before ui64Next pulls m_ui64MasterCounter back through the queue's horizon.
+				m_ui64MasterCounter = (ui64Next - 1 >= ui64Target) ? ui64Target : (ui64Next - 1);
+				RunMasterCycles_Bursts<_bStopAtFrame>();
+				if constexpr ( _bStopAtFrame ) {
+					if ( m_pPpu.GetFrameCount() != ui64Frame ) { return; }
+				}
+				if ( m_ui64MasterCounter == ui64Target ) { break; }
+				if constexpr ( _bProfile ) {
+					m_spProfiler.Measure<CSystemProfiler::LSN_PC_EVENTS>( [this]{ m_eqEvents.RunUntil( m_ui64MasterCounter + 1 ); } );
+				}
+				else {
+					m_eqEvents.RunUntil( m_ui64MasterCounter + 1 );
+				}
+			}
+		}
+
+		/**
+		 * Runs every hardware component up to m_ui64MasterCounter using the selected scheduler.
+		 * 
+		 * \param _bStopAtFrame If true, running stops as soon as the PPU finishes a frame, with m_ui64MasterCounter pulled back to the cycle on which that happened.
+		 */
+		template <bool _bStopAtFrame>
+		void											RunMasterCycles_Bursts() {
+			if ( m_bLazyPpu ) {
+				RunMasterCycles_Lazy<_bStopAtFrame>();
+			}
+			else if ( m_bUnrolledScheduler ) {
+				RunMasterCycles_Unrolled<_bStopAtFrame>();
+			}
+			else {
+				RunMasterCycles_Slots<_bStopAtFrame>();
+			}
+		}
+
+		/**
+		 * Runs every hardware component up to m_ui64MasterCounter by picking the next component to tick out of a set of slots.
+		 * 
+		 * \param _bStopAtFrame If true, running stops as soon as the PPU finishes a frame, with m_ui64MasterCounter pulled back to the cycle on which that happened.
+		 */
+		template <bool _bStopAtFrame>
+		void											RunMasterCycles_Slots() {
+#define LSN_CPU_SLOT											0
+#define LSN_PPU_SLOT											1
+#define LSN_APU_SLOT											2
+			// The slots only track when each unit is due.  The units themselves are ticked directly through their concrete types so that
+			//	the calls are not virtual and can be inlined.
+			struct LSN_HW_SLOTS {
+				uint64_t 									ui64Counter;
+				const uint64_t								ui64Inc;
+			} hsSlots[3] = {
+				{ m_ui64CpuCounter + _tCpuDiv, _tCpuDiv },
+				{ m_ui64PpuCounter + _tPpuDiv, _tPpuDiv },
+				{ m_ui64ApuCounter + _tApuDiv, _tApuDiv },
+			};
+			LSN_HW_SLOTS * phsSlot = nullptr;
+			const uint64_t ui64Frame = m_pPpu.GetFrameCount();
+			do {
+				phsSlot = nullptr;
+				uint64_t ui64Low = ~0ULL;
+				// Looping over the 3 slots adds a small amount of overhead.  Unrolling the loop is easy.
+				if ( hsSlots[LSN_CPU_SLOT].ui64Counter <= m_ui64MasterCounter && hsSlots[LSN_CPU_SLOT].ui64Counter <= ui64Low ) {
+					phsSlot = &hsSlots[LSN_CPU_SLOT];
+					ui64Low = phsSlot->ui64Counter;
+				}
+				if ( hsSlots[LSN_PPU_SLOT].ui64Counter <= m_ui64MasterCounter && hsSlots[LSN_PPU_SLOT].ui64Counter <= ui64Low ) {
+					phsSlot = &hsSlots[LSN_PPU_SLOT];
+					ui64Low = phsSlot->ui64Counter;
+				}
+				if ( hsSlots[LSN_APU_SLOT].ui64Counter <= m_ui64MasterCounter && hsSlots[LSN_APU_SLOT].ui64Counter < ui64Low ) {
+					// If we come in here then we know that the APU will be the one to tick.
+					//	This means we can optimize away the "if ( phsSlot != nullptr )" check
+					//	as well as the pointer-access ("phsSlot").
+					// Testing showed this took the loop down from 0.71834220 cycles-per-tick to
+					//	0.68499566 cycles-per-tick.
+					// Switching to function pointers inside the CPU Tick() function brought it
+					//	down to 0.63103939.
+					hsSlots[LSN_APU_SLOT].ui64Counter += hsSlots[LSN_APU_SLOT].ui64Inc;
+					TickApu();
+				}
+				else if ( phsSlot == &hsSlots[LSN_PPU_SLOT] ) {
+					phsSlot->ui64Counter += phsSlot->ui64Inc;
+					TickPpu();
+					if constexpr ( _bStopAtFrame ) {
+						if ( m_pPpu.GetFrameCount() != ui64Frame ) {
+							// Stop right on the frame boundary.  Anything else scheduled for this same master cycle runs on the next call.
+							m_ui64MasterCounter = hsSlots[LSN_PPU_SLOT].ui64Counter - _tPpuDiv;
+							break;
+						}
+					}
+				}
+				else if ( phsSlot != nullptr ) {
+					phsSlot->ui64Counter += phsSlot->ui64Inc;
+					TickCpu();
+				}
+				else { break; }
+			} while ( true );
+			m_ui64CpuCounter = hsSlots[LSN_CPU_SLOT].ui64Counter - _tCpuDiv;
+			m_ui64PpuCounter = hsSlots[LSN_PPU_SLOT].ui64Counter - _tPpuDiv;
+			m_ui64ApuCounter = hsSlots[LSN_APU_SLOT].ui64Counter - _tApuDiv;
+
+#undef LSN_APU_SLOT
+#undef LSN_PPU_SLOT
+#undef LSN_CPU_SLOT
+		}
+
+		/**
+		 * Runs every hardware component up to m_ui64MasterCounter using the unrolled schedule.  The slot-based scheduler is used to bring all
+		 *	components up to the next period boundary and to run whatever is left over at the end, and whole periods in between are run as
+		 *	straight-line code.  When _bStopAtFrame is true, running stops on the first period boundary after the PPU finishes a frame.
+		 * 
+		 * \param _bStopAtFrame If true, running stops shortly after the PPU finishes a frame.
+		 */
+		template <bool _bStopAtFrame>
+		void											RunMasterCycles_Unrolled() {
+			constexpr uint64_t ui64Period = SchedulerPeriod();
+			const uint64_t ui64Target = m_ui64MasterCounter;
+			const uint64_t ui64Frame = m_pPpu.GetFrameCount();
+			uint64_t ui64Boundary = std::max( std::max( m_ui64CpuCounter, m_ui64PpuCounter ), m_ui64ApuCounter );
+			ui64Boundary = (ui64Boundary + ui64Period - 1) / ui64Period * ui64Period;
+			if ( ui64Boundary + ui64Period <= ui64Target ) {
+				// Catch everything up to the boundary so that all counters line up.
+				m_ui64MasterCounter = ui64Boundary;
+				RunMasterCycles_Slots<_bStopAtFrame>();
+				if constexpr ( _bStopAtFrame ) {
+					if ( m_pPpu.GetFrameCount() != ui64Frame ) { return; }
+				}
+				// An event was scheduled before the boundary.
+				if ( m_ui64MasterCounter != ui64Boundary ) { return; }
+
+				// Events scheduled while catching up for a time past the boundary did not pull m_ui64MasterCounter back, so the horizon is
+				//	taken from the queue again.  An event scheduled during a period pulls it back; if it lands inside the period,
+				//	RunSchedulerPeriod() stops right after the CPU tick that scheduled it and the slot scheduler finishes up to the event exactly.
+				m_ui64MasterCounter = std::min( ui64Target, m_eqEvents.NextTime() - 1 );
+				while ( ui64Boundary + ui64Period <= m_ui64MasterCounter ) {
+					if ( !RunSchedulerPeriod<1>( ui64Boundary ) ) {
+						RunMasterCycles_Slots<_bStopAtFrame>();
+						return;
+					}
+					ui64Boundary += ui64Period;
+					if constexpr ( _bStopAtFrame ) {
+						if ( m_pPpu.GetFrameCount() != ui64Frame ) {
+							m_ui64CpuCounter = m_ui64PpuCounter = m_ui64ApuCounter = m_ui64MasterCounter = ui64Boundary;
+							return;
+						}
+					}
+				}
+				m_ui64CpuCounter = m_ui64PpuCounter = m_ui64ApuCounter = ui64Boundary;
+			}
+			RunMasterCycles_Slots<_bStopAtFrame>();
+		}
+
+		/**
+		 * Runs every hardware component up to m_ui64MasterCounter with the PPU lagging behind.  The CPU and APU run in lockstep up to (but not
+		 *	including) the next PPU tick that can change the NMI line or end the frame, and the PPU is then caught up to that point in one burst.
+		 *	Any CPU access that can observe or affect the PPU goes through a trampoline that first calls CatchUpPpu(), so the results match the
+		 *	other schedulers exactly.
+		 * 
+		 * \param _bStopAtFrame If true, running stops as soon as the PPU finishes a frame, with m_ui64MasterCounter pulled back to the cycle on which that happened.
+		 */
+		template <bool _bStopAtFrame>
+		void											RunMasterCycles_Lazy() {
+			while ( true ) {
+				const uint64_t ui64Sync = m_ui64PpuCounter + (m_pPpu.TicksToNextSyncPoint() + 1) * _tPpuDiv;
+				uint64_t ui64Limit = std::min( m_ui64MasterCounter, ui64Sync - 1 );
+				uint64_t ui64Cpu = m_ui64CpuCounter + _tCpuDiv;
+				uint64_t ui64Apu = m_ui64ApuCounter + _tApuDiv;
+				while ( true ) {
+					// On ties the CPU goes before the APU, the same as in RunMasterCycles_Slots().
+					if ( ui64Cpu <= ui64Limit && ui64Cpu <= ui64Apu ) {
+						m_ui64LazyCpuTime = ui64Cpu;
+						if constexpr ( !_bProfile ) {
+							// Nothing else runs before the sync point, so an instruction that cannot reach the PPU, APU, or mapper and that
+							//	ends before the limit can run in 1 call.  The APU then catches up below; nothing it does is visible to the CPU.
+							if ( m_bFastCpu && ui64Cpu + (_cCpu::LSN_FP_MAX_CYCLES - 1) * _tCpuDiv <= ui64Limit ) {
+#ifdef LSN_CPU_FAST_PATH_CHECK
+								const uint64_t ui64PpuCounter = m_ui64PpuCounter;
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+								// Every cycle of the run must land at or before the limit.
+								const uint32_t ui32Budget = uint32_t( (ui64Limit - ui64Cpu) / _tCpuDiv + 1 );
+								uint32_t ui32Cycles = 0;
+								if ( m_bBlockCpu ) { ui32Cycles = m_cCpu.TickBlock( ui32Budget ); }
+								else {
+									if ( m_bIdleSkip ) { ui32Cycles = m_cCpu.TickIdleLoop( ui32Budget ); }
+									if ( !ui32Cycles ) { ui32Cycles = m_cCpu.TickInstruction(); }
+								}
+								if ( ui32Cycles ) {
+									ui64Cpu += ui32Cycles * _tCpuDiv;
+#ifdef LSN_CPU_FAST_PATH_CHECK
+									// The instructions must not have caught the PPU up or scheduled an event inside themselves.
+									if ( m_ui64PpuCounter != ui64PpuCounter || m_ui64MasterCounter < ui64Cpu - _tCpuDiv ) {
+										m_cCpu.AddFastCheckFailure();
+									}
+#endif	// #ifdef LSN_CPU_FAST_PATH_CHECK
+									ui64Limit = std::min( ui64Limit, m_ui64MasterCounter );
+									continue;
+								}
+							}
+							if ( m_bFastCpu && m_bIdleSkip ) {
+								const uint32_t ui32Skipped = SkipPpuStatusLoop( ui64Cpu, ui64Limit );
+								if ( ui32Skipped ) {
+									ui64Cpu += ui32Skipped * _tCpuDiv;
+									continue;
+								}
+							}
+						}
+						ui64Cpu += _tCpuDiv;
+						TickCpu();
+						// The CPU may have scheduled an event that pulled m_ui64MasterCounter back.
+						ui64Limit = std::min( ui64Limit, m_ui64MasterCounter );
+					}
+					else if ( ui64Apu <= ui64Limit ) {
+						ui64Apu += _tApuDiv;
+						TickApu();
+					}
+					else { break; }
+				}
+				m_ui64CpuCounter = ui64Cpu - _tCpuDiv;
+				m_ui64ApuCounter = ui64Apu - _tApuDiv;
+
+				const uint64_t ui64Frame = m_pPpu.GetFrameCount();
+				m_ui64LazyCpuTime = std::min( m_ui64MasterCounter, ui64Sync );
+				CatchUpPpu();
+				if constexpr ( _bStopAtFrame ) {
+					if ( m_pPpu.GetFrameCount() != ui64Frame ) {
+						m_ui64MasterCounter = m_ui64PpuCounter;
+						return;
+					}
+				}
+				if ( ui64Sync > m_ui64MasterCounter ) { break; }
+			}
+		}
+
+		/**
+		 * Reads everything in a save state that follows the header.  On failure the system is left partially loaded and must be reset.
+		 *
+		 * \param _sStream The stream from which to read, positioned just after the header.
+		 * \return Returns true if the state was read.
+		 */
+		bool											LoadStateBody( CStream &_sStream ) {
+			uint64_t ui64Master, ui64Cpu, ui64Ppu, ui64Apu;
+			if ( !_sStream.ReadUi64( ui64Master ) ) { return false; }
+			if ( !_sStream.ReadUi64( ui64Cpu ) ) { return false; }
+			if ( !_sStream.ReadUi64( ui64Ppu ) ) { return false; }
+			if ( !_sStream.ReadUi64( ui64Apu ) ) { return false; }
+			if ( ui64Cpu > ui64Master || ui64Ppu > ui64Master || ui64Apu > ui64Master ) { return false; }
+			m_ui64MasterCounter = ui64Master;
+			m_ui64CpuCounter = ui64Cpu;
+			m_ui64PpuCounter = ui64Ppu;
+			m_ui64ApuCounter = ui64Apu;
+			m_ui64LazyCpuTime = ui64Master;
+
+			// The components schedule their pending events again while loading.
+			m_eqEvents.Reset();
+			if ( !m_bBus.LoadState( _sStream ) ) { return false; }
+			if ( !m_cCpu.LoadState( _sStream ) ) { return false; }
+			m_eqEvents.SetCpuTimeBase( _tCpuDiv, m_cCpu.GetCycleCount() - m_ui64CpuCounter / _tCpuDiv );
+			if ( !m_pPpu.LoadState( _sStream ) ) { return false; }
+			if ( !m_aApu.LoadState( _sStream ) ) { return false; }
+			if ( !m_pmbMapper->LoadState( _sStream ) ) { return false; }
+			if constexpr ( _bProfile ) {
+				m_spProfiler.Reset( m_pPpu.GetFrameCount() );
+			}
+			return true;
+		}
+
+		/**
+		 * Skips whole passes of a loop polling PPUSTATUS ($2002), such as LDA $2002 / BPL, while the PPU shows that reading it returns
+		 *	the same value and changes nothing.  Passes run normally until one leaves the CPU as it found it; then the passes that fit
+		 *	before the limit and before PPUSTATUS can change are skipped.
+		 *
+		 * \param _ui64Cpu The master cycle of the CPU's next cycle, which must be m_ui64LazyCpuTime.
+		 * \param _ui64Limit The last master cycle the CPU may reach.
+		 * \return Returns the number of CPU cycles skipped.
+		 */
+		uint32_t										SkipPpuStatusLoop( uint64_t _ui64Cpu, uint64_t _ui64Limit ) {
+			const uint32_t ui32Pass = m_cCpu.IdleLoopCycles( LSN_PPU_START + 0x02 );
+			if ( !ui32Pass ) { return 0; }
+			// Catch the PPU up as a read on this cycle would, so that it can tell how long PPUSTATUS stays as it is.
+			CatchUpPpu();
+			const size_t stTicks = m_pPpu.TicksStatusReadIsIdle();
+			if ( !m_cCpu.IdleLoopRepeats( ui32Pass ) || _ui64Cpu > m_ui64IdleStatusStable ) {
+				// The state just kept by IdleLoopRepeats() is compared after the next pass, whose reads must change nothing either.
+				m_ui64IdleStatusStable = stTicks ? m_ui64PpuCounter + stTicks * _tPpuDiv : 0;
+				return 0;
+			}
+			// The skipped passes read PPUSTATUS before m_ui64IdleStatusStable and run no cycle past the limit.
+			const uint64_t ui64Cycles = std::min( (_ui64Limit - _ui64Cpu) / _tCpuDiv + 1, (m_ui64IdleStatusStable - _ui64Cpu) / _tCpuDiv );
+			const uint64_t ui64Skip = ui64Cycles / ui32Pass * ui32Pass;
+			if ( ui64Skip ) { m_cCpu.SkipIdleCycles( ui64Skip, true ); }
+			return uint32_t( ui64Skip );
+		}
+
+		/**
+		 * Ticks the PPU until it has caught up with m_ui64LazyCpuTime.  On a tie the PPU ticks before the CPU, so a PPU tick landing on the same
+		 *	master cycle as the current CPU tick is run.  The counter is advanced before each tick so that the PPU's own reads of its registers
+		 *	(OAMDATA), which go through the same trampolines, find it already caught up instead of recursing.
+		 */
+		inline void										CatchUpPpu() {
+			while ( m_ui64PpuCounter + _tPpuDiv <= m_ui64LazyCpuTime ) {
+				m_ui64PpuCounter += _tPpuDiv;
+				TickPpu();
+			}
+		}
+
+		/**
+		 * Maps the buses as they are before the mapper is applied (the default map, then the APU, CPU, and PPU maps, then the mirroring
+		 *	from the ROM header) and keeps a copy of the result for later resets.
+		 */
+		void											ApplyBaseMap() {
+			m_bBus.ApplyMap();
+
+			m_aApu.ApplyMemoryMap();
+			m_cCpu.ApplyMemoryMap();
+			m_pPpu.ApplyMemoryMap();
+
+			if ( IsRomLoaded() ) {
+				switch ( m_rRom.riInfo.mmMirroring ) {
+					case LSN_MM_VERTICAL : {
+						m_pPpu.ApplyVerticalMirroring();
+						break;
+					}
+					case LSN_MM_HORIZONTAL : {
+						m_pPpu.ApplyHorizontalMirroring();
+						break;
+					}
+					case LSN_MM_4_SCREENS : {
+						m_pPpu.ApplyFourScreensMirroring();
+						break;
+					}
+					case LSN_MM_1_SCREEN_A : {
+						m_pPpu.ApplyOneScreenMirroring();
+						break;
+					}
+					case LSN_MM_1_SCREEN_B : {
+						m_pPpu.ApplyOneScreenMirroring_B();
+						break;
+					}
+				}
+			}
+
+			if ( !m_pmBaseCpuMap.get() ) { m_pmBaseCpuMap = std::make_unique<CCpuBus::LSN_MAP>(); }
+			if ( !m_pmBasePpuMap.get() ) { m_pmBasePpuMap = std::make_unique<CPpuBus::LSN_MAP>(); }
+			m_bBus.SaveMap( (*m_pmBaseCpuMap) );
+			m_pPpu.GetBus().SaveMap( (*m_pmBasePpuMap) );
+		}
+
+		/**
+		 * Installs or removes the trampolines that catch the PPU up before any CPU access that could observe or affect it.  These are the PPU
+		 *	registers ($2000-$3FFF), OAM DMA ($4014), and all writes to cartridge space ($4020-$FFFF), since that is where mappers switch CHR
+		 *	banks and mirroring.
+		 * 
+		 * \param _bInstall If true, the trampolines are installed, otherwise the original functions are restored.
+		 */
+		void											ApplyPpuSyncTrampolines( bool _bInstall ) {
+			// The watchpoint trampolines sit on top of these, so they come off first and go back on last.
+			bool bWatching = m_wWatchpoints.Installed();
+			m_wWatchpoints.Uninstall();
+			ApplyPpuSyncTrampolines_Inner( _bInstall );
+			if ( bWatching ) { m_wWatchpoints.Install(); }
+		}
+
+		/**
+		 * Installs or removes the trampolines that catch the PPU up, assuming no other trampolines have been inserted on top of them.
+		 * 
+		 * \param _bInstall If true, the trampolines are installed, otherwise the original functions are restored.
+		 */
+		void											ApplyPpuSyncTrampolines_Inner( bool _bInstall ) {
+			if ( !_bInstall ) {
+				for ( auto I = m_vPpuSyncTrampolines.size(); I--; ) {
+					const CCpuBus::LSN_ADDR_ACCESSOR & aaOrig = m_vPpuSyncTrampolines[I].aaOriginalFuncs;
+					if ( aaOrig.pfReader ) {
+						m_bBus.SetReadFunc( m_vPpuSyncAddresses[I], aaOrig.pfReader, aaOrig.pvReaderParm0, aaOrig.ui16ReaderParm1 );
+					}
+					m_bBus.SetWriteFunc( m_vPpuSyncAddresses[I], aaOrig.pfWriter, aaOrig.pvWriterParm0, aaOrig.ui16WriterParm1 );
+				}
+				m_vPpuSyncTrampolines.clear();
+				m_vPpuSyncAddresses.clear();
+				m_bBus.UpdatePageTable();
+				return;
+			}
+
+			m_vPpuSyncAddresses.clear();
+			for ( uint32_t I = LSN_PPU_START; I < LSN_APU_START; ++I ) {
+				m_vPpuSyncAddresses.push_back( uint16_t( I ) );
+			}
+			m_vPpuSyncAddresses.push_back( 0x4014 );
+			for ( uint32_t I = LSN_APU_IO_START + LSN_APU_IO; I < LSN_MEM_FULL_SIZE; ++I ) {
+				m_vPpuSyncAddresses.push_back( uint16_t( I ) );
+			}
+			// The bus keeps pointers into this, so it must not be resized after this point.
+			m_vPpuSyncTrampolines.clear();
+			m_vPpuSyncTrampolines.resize( m_vPpuSyncAddresses.size() );
+			for ( size_t I = 0; I < m_vPpuSyncAddresses.size(); ++I ) {
+				uint16_t ui16Addr = m_vPpuSyncAddresses[I];
+				CCpuBus::LSN_TRAMPOLINE * ptTramp = &m_vPpuSyncTrampolines[I];
+				ptTramp->aaOriginalFuncs.pfReader = nullptr;
+				if ( ui16Addr < LSN_APU_START ) {
+					m_bBus.SetTrampolineReadFunc( ui16Addr, PpuSyncRead, this, ui16Addr, ptTramp );
+				}
+				m_bBus.SetTrampolineWriteFunc( ui16Addr, PpuSyncWrite, this, ui16Addr, ptTramp );
+			}
+			m_bBus.UpdatePageTable();
+		}
+
+		/**
+		 * A read trampoline that catches the PPU up before calling the original read function.
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to read from _pui8Data.  It is not constant because sometimes reads do modify status registers etc.
+		 * \param _pui8Data The buffer from which to read.
+		 * \param _ui8Ret The read value.
+		 */
+		static void LSN_FASTCALL						PpuSyncRead( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * _pui8Data, uint8_t &_ui8Ret ) {
+			CCpuBus::LSN_TRAMPOLINE * ptTramp = reinterpret_cast<CCpuBus::LSN_TRAMPOLINE *>(_pvParm0);
+			reinterpret_cast<CSystem *>(ptTramp->pvReaderParm0)->CatchUpPpu();
+			ptTramp->aaOriginalFuncs.pfReader( ptTramp->aaOriginalFuncs.pvReaderParm0, ptTramp->aaOriginalFuncs.ui16ReaderParm1, _pui8Data, _ui8Ret );
+		}
+
+		/**
+		 * A write trampoline that catches the PPU up before calling the original write function.
+		 *
+		 * \param _pvParm0 A data value assigned to this address.
+		 * \param _ui16Parm1 A 16-bit parameter assigned to this address.  Typically this will be the address to write to _pui8Data.
+		 * \param _pui8Data The buffer to which to write.
+		 * \param _ui8Val The value to write.
+		 */
+		static void LSN_FASTCALL						PpuSyncWrite( void * _pvParm0, uint16_t /*_ui16Parm1*/, uint8_t * _pui8Data, uint8_t _ui8Val ) {
+			CCpuBus::LSN_TRAMPOLINE * ptTramp = reinterpret_cast<CCpuBus::LSN_TRAMPOLINE *>(_pvParm0);
+			reinterpret_cast<CSystem *>(ptTramp->pvWriterParm0)->CatchUpPpu();
+			ptTramp->aaOriginalFuncs.pfWriter( ptTramp->aaOriginalFuncs.pvWriterParm0, ptTramp->aaOriginalFuncs.ui16WriterParm1, _pui8Data, _ui8Val );
+		}
+
+		/**
+		 * Runs one master cycle of the unrolled schedule and recurses into the next until the end of the period.  Each component ticks on the
+		 *	master cycles that are multiples of its divider, and when several land on the same master cycle they run in the same order as in
+		 *	RunMasterCycles_Slots(): PPU, CPU, then APU.  If a CPU tick schedules an event that pulls m_ui64MasterCounter back inside the
+		 *	period, the period is abandoned right after that tick with each component's counter set to the last master cycle it ran.
+		 * 
+		 * \param _ui64Cycle The master cycle within the period, starting at 1.
+		 * \param _ui64Base The master cycle at which the period starts (all components have run up to and including it).
+		 * \return Returns true if the whole period was run, false if it was abandoned for an event.
+		 */
+		template <uint64_t _ui64Cycle>
+		__forceinline bool								RunSchedulerPeriod( uint64_t _ui64Base ) {
+			if constexpr ( _ui64Cycle % _tPpuDiv == 0 ) { TickPpu(); }
+			if constexpr ( _ui64Cycle % _tCpuDiv == 0 ) {
+				TickCpu();
+				if ( m_ui64MasterCounter < _ui64Base + SchedulerPeriod() ) [[unlikely]] {
+					m_ui64PpuCounter = _ui64Base + _ui64Cycle / _tPpuDiv * _tPpuDiv;
+					m_ui64CpuCounter = _ui64Base + _ui64Cycle;
+					m_ui64ApuCounter = _ui64Base + (_ui64Cycle - 1) / _tApuDiv * _tApuDiv;
+					return false;
+				}
+			}
+			if constexpr ( _ui64Cycle % _tApuDiv == 0 ) { TickApu(); }
+			if constexpr ( _ui64Cycle < SchedulerPeriod() ) {
+				return RunSchedulerPeriod<_ui64Cycle+1>( _ui64Base );
+			}
+			else {
+				return true;
+			}
+		}
+
+		/**
+		 * Ticks the CPU once.  When profiling, the mapper is ticked first (as the CPU itself would do) and both are timed.
+		 */
+		__forceinline void								TickCpu() {
+			if constexpr ( _bProfile ) {
+				if ( m_bProfileTickMapper ) {
+					m_spProfiler.Measure<CSystemProfiler::LSN_PC_MAPPER>( [this]{ m_pmbMapper->Tick(); } );
+				}
+				m_spProfiler.Measure<CSystemProfiler::LSN_PC_CPU>( [this]{ m_cCpu.Tick(); } );
+			}
+			else {
+				m_cCpu.Tick();
+			}
+		}
+
+		/**
+		 * Ticks the PPU once.  When profiling, the tick is timed and the profiler is moved to the next frame when the PPU finishes one.
+		 */
+		__forceinline void								TickPpu() {
+			if constexpr ( _bProfile ) {
+				m_spProfiler.Measure<CSystemProfiler::LSN_PC_PPU>( [this]{ m_pPpu.Tick(); } );
+				if ( m_pPpu.GetFrameCount() != m_spProfiler.Current().ui64Frame ) {
+					m_spProfiler.EndFrame( m_pPpu.GetFrameCount() );
+				}
+			}
+			else {
+				m_pPpu.Tick();
+			}
+		}
+
+		/**
+		 * Ticks the APU once.  When profiling, the tick is timed.
+		 */
+		__forceinline void								TickApu() {
+			if constexpr ( _bProfile ) {
+				m_spProfiler.Measure<CSystemProfiler::LSN_PC_APU>( [this]{ m_aApu.Tick(); } );
+			}
+			else {
+				m_aApu.Tick();
+			}
+		}
+
 		/**
 		 * Loads a ROM image in .NES format.
 		 *
@@ -543,6 +1389,13 @@ namespace lsn {
 		 * \return Returns the APU divider.
 		 */
 		inline constexpr uint64_t						ApuDiv() const { return _tApuDiv; }
+
+		/**
+		 * Gets the number of master cycles after which the CPU/PPU/APU ticking pattern repeats.
+		 *
+		 * \return Returns the least-common multiple of the CPU, PPU, and APU dividers.
+		 */
+		static inline constexpr uint64_t				SchedulerPeriod() { return std::lcm( std::lcm( uint64_t( _tCpuDiv ), uint64_t( _tPpuDiv ) ), uint64_t( _tApuDiv ) ); }
 	};
 	
 
@@ -593,4 +1446,25 @@ namespace lsn {
 		LSN_CS_NTSC_CPU_DIVISOR, LSN_CS_NTSC_PPU_DIVISOR, LSN_CS_NTSC_APU_DIVISOR,
 		CCpu6502, CNtscPpu, CNtscApu>														CRgb2C05System;
 
+	/**
+	 * An NTSC system with per-component profiling.
+	 */
+	typedef CSystem<LSN_CS_NTSC_MASTER, LSN_CS_NTSC_MASTER_DIVISOR,
+		LSN_CS_NTSC_CPU_DIVISOR, LSN_CS_NTSC_PPU_DIVISOR, LSN_CS_NTSC_APU_DIVISOR,
+		CCpu6502, CNtscPpu, CNtscApu, true>													CNtscProfiledSystem;
+
+	/**
+	 * A PAL system with per-component profiling.
+	 */
+	typedef CSystem<LSN_CS_PAL_MASTER, LSN_CS_PAL_MASTER_DIVISOR,
+		LSN_CS_PAL_CPU_DIVISOR, LSN_CS_PAL_PPU_DIVISOR, LSN_CS_PAL_APU_DIVISOR,
+		CCpu6502, CPalPpu, CPalApu, true>													CPalProfiledSystem;
+
+	/**
+	 * A Dendy system with per-component profiling.
+	 */
+	typedef CSystem<LSN_CS_DENDY_MASTER, LSN_CS_DENDY_MASTER_DIVISOR,
+		LSN_CS_DENDY_CPU_DIVISOR, LSN_CS_DENDY_PPU_DIVISOR, LSN_CS_DENDY_APU_DIVISOR,
+		CCpu6502, CDendyPpu, CNtscApu, true>												CDendyProfiledSystem;
+
 }	// namespace lsn
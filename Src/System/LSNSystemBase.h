@@ -11,11 +11,18 @@
 
 #include "../LSNLSpiroNes.h"
 #include "../Bus/LSNBus.h"
+#include "../Bus/LSNWatchpoints.h"
+#include "../Cpu/LSNDecodeCache.h"
 #include "../Display/LSNDisplayClient.h"
 #include "../Input/LSNInputPoller.h"
 #include "../Mappers/LSNAllMappers.h"
 #include "../Palette/LSNPalette.h"
 #include "../Time/LSNClock.h"
+#include "../Utilities/LSNStream.h"
+#include "LSNSystemProfiler.h"
+
+#define LSN_SAVE_STATE_MAGIC							0x53534E42			// "BNSS".
+#define LSN_SAVE_STATE_VERSION							2
 
 
 namespace lsn {
@@ -35,7 +42,16 @@ namespace lsn {
 			m_ui64CpuCounter( 0 ),
 			m_ui64PpuCounter( 0 ),
 			m_ui64ApuCounter( 0 ),
-			m_bPaused( false ) {
+			m_bPaused( false ),
+			m_bUnrolledScheduler( false ),
+			m_bLazyPpu( false ),
+			m_bFastPages( true ),
+			m_bFastCpu( false ),
+			m_bBlockCpu( false ),
+			m_bJitCpu( false ),
+			m_bDecodeCache( true ),
+			m_bSwitchDispatch( false ),
+			m_bIdleSkip( false ) {
 		}
 		virtual ~CSystemBase() {
 		}
@@ -47,13 +63,33 @@ namespace lsn {
 		 * 
 		 * \param _bAnalog If true, a soft reset is performed on the CPU, otherwise the CPU is reset to a known state.
 		 */
-		virtual void									ResetState( bool /*_bAnalog*/ ) = 0 { }
+		virtual void									ResetState( bool /*_bAnalog*/ ) = 0;
 
 		/**
 		 * Performs an update of the system state.  This means getting the amount of time that has passed since this was last called,
 		 *	determining how many cycles need to be run for each hardware component, and running all of them.
 		 */
-		virtual void									Tick() = 0 {}
+		virtual void									Tick() = 0;
+
+		/**
+		 * Runs exactly the given number of master cycles as fast as the host allows, without reading the real-time clock.
+		 *
+		 * \param _ui64MasterCycles The number of master cycles to run.
+		 */
+		virtual void									RunCycles( uint64_t /*_ui64MasterCycles*/ ) {}
+
+		/**
+		 * Runs until the PPU has completed the given number of frames, as fast as the host allows, without reading the real-time clock.
+		 *
+		 * \param _ui64Frames The number of frames to run.
+		 */
+		virtual void									RunFrames( uint64_t /*_ui64Frames*/ ) {}
+
+		/**
+		 * Moves the real-time accumulator to the current master counter so that Tick() carries on from the current point.  Call this after
+		 *	RunCycles() or RunFrames() before going back to Tick().
+		 */
+		virtual void									SyncRealTime() {}
 
 		/**
 		 * Loads a ROM image.
@@ -61,7 +97,7 @@ namespace lsn {
 		 * \param _rRom The ROM data to load, previously populated by a call to LoadRom().
 		 * \return Returns true if the image was loaded, false otherwise.
 		 */
-		virtual bool									LoadRom( LSN_ROM &/*_rRom*/ ) = 0 { return false; }
+		virtual bool									LoadRom( LSN_ROM &/*_rRom*/ ) = 0;
 
 		/**
 		 * Sets the input poller.
@@ -70,6 +106,227 @@ namespace lsn {
 		 */
 		virtual void									SetInputPoller( CInputPoller * /*_pipPoller*/ ) {}
 
+		/**
+		 * Selects between the slot-based scheduler and the unrolled scheduler.  The unrolled scheduler runs each repeating period of CPU/PPU/APU
+		 *	ticks as a fixed straight-line sequence.  Both produce identical results.
+		 *
+		 * \param _bUnrolled If true, the unrolled scheduler is used.
+		 */
+		inline void										SetUnrolledScheduler( bool _bUnrolled ) { m_bUnrolledScheduler = _bUnrolled; }
+
+		/**
+		 * Determines whether the unrolled scheduler is in use.
+		 *
+		 * \return Returns true if the unrolled scheduler is in use.
+		 */
+		inline bool										IsUnrolledScheduler() const { return m_bUnrolledScheduler; }
+
+		/**
+		 * Enables or disables lazy-PPU mode, in which the CPU runs ahead and the PPU is only caught up when something can observe or affect it.
+		 *	Results are identical to running in lockstep.
+		 *
+		 * \param _bLazy If true, lazy-PPU mode is enabled.
+		 */
+		virtual void									SetLazyPpu( bool _bLazy ) { m_bLazyPpu = _bLazy; }
+
+		/**
+		 * Determines whether lazy-PPU mode is enabled.
+		 *
+		 * \return Returns true if lazy-PPU mode is enabled.
+		 */
+		inline bool										IsLazyPpu() const { return m_bLazyPpu; }
+
+		/**
+		 * Enables or disables the bus page tables, through which plain RAM/ROM pages are accessed directly instead of through their
+		 *	per-address functions.  Enabled by default; results are identical either way.
+		 *
+		 * \param _bFast If true, the page tables are used.
+		 */
+		virtual void									SetFastPages( bool _bFast ) { m_bFastPages = _bFast; }
+
+		/**
+		 * Determines whether the bus page tables are used.
+		 *
+		 * \return Returns true if the bus page tables are used.
+		 */
+		inline bool										IsFastPages() const { return m_bFastPages; }
+
+		/**
+		 * Enables or disables running the CPU an instruction at a time whenever the instruction only touches plain RAM/ROM and no
+		 *	interrupt or DMA is pending.  Only used in lazy-PPU mode, where nothing else has to run between the CPU's cycles until the next
+		 *	sync point.  Results are identical either way.
+		 *
+		 * \param _bFast If true, eligible instructions are run in 1 call each.
+		 */
+		inline void										SetFastCpu( bool _bFast ) { m_bFastCpu = _bFast; }
+
+		/**
+		 * Determines whether eligible instructions are run in 1 call each.
+		 *
+		 * \return Returns true if eligible instructions are run in 1 call each.
+		 */
+		inline bool										IsFastCpu() const { return m_bFastCpu; }
+
+		/**
+		 * Enables or disables running eligible instructions back-to-back, as many as fit before the next sync point, instead of returning
+		 *	to the scheduler after each one.  Only used along with SetFastCpu( true ).  Results are identical either way.
+		 *
+		 * \param _bBlock If true, eligible instructions are run in runs.
+		 */
+		inline void										SetBlockCpu( bool _bBlock ) { m_bBlockCpu = _bBlock; }
+
+		/**
+		 * Determines whether eligible instructions are run back-to-back.
+		 *
+		 * \return Returns true if eligible instructions are run back-to-back.
+		 */
+		inline bool										IsBlockCpu() const { return m_bBlockCpu; }
+
+		/**
+		 * Gets the number of instructions run in 1 call each since the last reset.
+		 *
+		 * \return Returns the number of instructions run in 1 call each.
+		 */
+		virtual uint64_t								FastCpuInstructions() const { return 0; }
+
+		/**
+		 * Gets the number of CPU cycles inside instructions run in 1 call each since the last reset.
+		 *
+		 * \return Returns the number of CPU cycles run an instruction at a time.
+		 */
+		virtual uint64_t								FastCpuCycles() const { return 0; }
+
+		/**
+		 * Gets the number of runs of back-to-back instructions since the last reset.
+		 *
+		 * \return Returns the number of runs of instructions run without returning to the scheduler.
+		 */
+		virtual uint64_t								FastCpuBlocks() const { return 0; }
+
+		/**
+		 * Enables or disables running back-to-back instructions through compiled x86-64 code.  Only used along with SetBlockCpu( true ), and
+		 *	only available on x86-64 Linux.  Results are identical either way.
+		 *
+		 * \param _bEnable If true, back-to-back instructions are compiled.
+		 */
+		virtual void									SetJitCpu( bool _bEnable ) { m_bJitCpu = _bEnable; }
+
+		/**
+		 * Determines whether back-to-back instructions are run through compiled code.
+		 *
+		 * \return Returns true if back-to-back instructions are compiled.
+		 */
+		inline bool										IsJitCpu() const { return m_bJitCpu; }
+
+		/**
+		 * Gets the number of instructions run through compiled code since the last reset.  Included in FastCpuInstructions().
+		 *
+		 * \return Returns the number of instructions run through compiled code.
+		 */
+		virtual uint64_t								JitInstructions() const { return 0; }
+
+		/**
+		 * Gets the number of blocks of instructions compiled since the last reset.
+		 *
+		 * \return Returns the number of blocks compiled.
+		 */
+		virtual uint64_t								JitBlocks() const { return 0; }
+
+		/**
+		 * Enables or disables skipping whole passes of idle loops: short loops that write nothing and read only RAM/ROM or a PPUSTATUS
+		 *	($2002) that cannot change before the next sync point.  Only used along with SetFastCpu( true ).  Results are identical either way.
+		 *
+		 * \param _bEnable If true, idle loops are skipped.
+		 */
+		virtual void									SetIdleSkip( bool _bEnable ) { m_bIdleSkip = _bEnable; }
+
+		/**
+		 * Determines whether idle loops are skipped.
+		 *
+		 * \return Returns true if idle loops are skipped.
+		 */
+		inline bool										IsIdleSkip() const { return m_bIdleSkip; }
+
+		/**
+		 * Gets the number of times passes of an idle loop were skipped since the last reset.
+		 *
+		 * \return Returns the number of skips.
+		 */
+		virtual uint64_t								IdleSkips() const { return 0; }
+
+		/**
+		 * Gets the number of CPU cycles skipped in idle loops since the last reset.
+		 *
+		 * \return Returns the number of CPU cycles skipped.
+		 */
+		virtual uint64_t								IdleCycles() const { return 0; }
+
+		/**
+		 * Gets the number of CPU cycles skipped in loops polling PPUSTATUS since the last reset.  Included in IdleCycles().
+		 *
+		 * \return Returns the number of CPU cycles skipped in loops polling PPUSTATUS.
+		 */
+		virtual uint64_t								IdleStatusCycles() const { return 0; }
+
+		/**
+		 * Gets the number of instructions run in 1 call that could have behaved differently 1 cycle at a time.  Only counted in builds
+		 *	with LSN_CPU_FAST_PATH_CHECK defined, and always expected to be 0.
+		 *
+		 * \return Returns the number of failed checks.
+		 */
+		virtual uint64_t								FastCpuCheckFailures() const { return 0; }
+
+		/**
+		 * Enables or disables the cache of decoded instruction blocks used when running instructions in 1 call each.  Enabled by default;
+		 *	results are identical either way.
+		 *
+		 * \param _bEnable If true, the decoded-block cache is used.
+		 */
+		virtual void									SetDecodeCache( bool _bEnable ) { m_bDecodeCache = _bEnable; }
+
+		/**
+		 * Determines whether the decoded-block cache is used.
+		 *
+		 * \return Returns true if the decoded-block cache is used.
+		 */
+		inline bool										IsDecodeCache() const { return m_bDecodeCache; }
+
+		/**
+		 * Gets the decoded-block cache statistics since the last reset.
+		 *
+		 * \return Returns the decoded-block cache statistics.
+		 */
+		virtual CDecodeCache::LSN_DECODE_CACHE_STATS	DecodeCacheStats() const { return CDecodeCache::LSN_DECODE_CACHE_STATS(); }
+
+		/**
+		 * Selects whether the CPU dispatches the cycles of its instructions through 1 switch on 1-byte micro-op ID's instead of through
+		 *	function pointers.  Off by default; results are identical either way.
+		 *
+		 * \param _bSwitch If true, the switch dispatcher is used.
+		 */
+		virtual void									SetSwitchDispatch( bool _bSwitch ) { m_bSwitchDispatch = _bSwitch; }
+
+		/**
+		 * Determines whether the CPU dispatches through the switch.
+		 *
+		 * \return Returns true if the switch dispatcher is used.
+		 */
+		inline bool										IsSwitchDispatch() const { return m_bSwitchDispatch; }
+
+		/**
+		 * Gets the number of CPU-bus and PPU-bus pages that are read directly rather than through per-address functions.
+		 *
+		 * \return Returns the number of directly read pages.
+		 */
+		virtual size_t									FastReadPageCount() const { return 0; }
+
+		/**
+		 * Gets the number of CPU-bus and PPU-bus pages that are written directly rather than through per-address functions.
+		 *
+		 * \return Returns the number of directly written pages.
+		 */
+		virtual size_t									FastWritePageCount() const { return 0; }
+
 		/**
 		 * Gets the accumulated real time.
 		 *
@@ -177,6 +434,87 @@ namespace lsn {
 		 */
 		virtual uint64_t								GetPpuFrameCount() const { return 0; }
 
+		/**
+		 * Gets the number of master cycles in a full PPU frame.
+		 *
+		 * \return Returns the number of master cycles in a full PPU frame.
+		 */
+		virtual uint64_t								GetMasterCyclesPerFrame() const { return 0; }
+
+		/**
+		 * Gets the CPU bus.
+		 *
+		 * \return Returns the CPU bus.
+		 */
+		inline CCpuBus *								GetCpuBus() { return &m_bBus; }
+
+		/**
+		 * Gets the PPU bus.
+		 *
+		 * \return Returns the PPU bus, or nullptr if the system has none.
+		 */
+		virtual CPpuBus *								GetPpuBus() { return nullptr; }
+
+		/**
+		 * Gets the memory watchpoints on the CPU bus.
+		 *
+		 * \return Returns the watchpoints, or nullptr if the system has none.
+		 */
+		virtual CWatchpoints *							GetWatchpoints() { return nullptr; }
+
+		/**
+		 * Gets the per-component profiler.  Only systems built with profiling enabled have one.
+		 *
+		 * \return Returns the profiler, or nullptr if the system was built without profiling.
+		 */
+		virtual const CSystemProfiler *					GetProfiler() const { return nullptr; }
+
+		/**
+		 * Writes the full emulation state to a stream.  A ROM must be loaded.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		virtual bool									SaveState( CStream &/*_sStream*/ ) const { return false; }
+
+		/**
+		 * Restores the full emulation state from a stream previously written by SaveState() for the same ROM and region.  Call SyncRealTime()
+		 *	before going back to Tick() unless the state was saved earlier in the same Tick() run.
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was restored.  If false is returned after the header was accepted, the system is reset.
+		 */
+		virtual bool									LoadState( CStream &/*_sStream*/ ) { return false; }
+
+		/**
+		 * Clears the dirty-page bitmaps of the CPU and PPU buses.  Call after taking a checkpoint.
+		 */
+		virtual void									ClearDirtyPages() {}
+
+		/**
+		 * Gets the number of 256-byte CPU-bus and PPU-bus pages written since the last call to ClearDirtyPages().
+		 *
+		 * \return Returns the number of dirty pages.
+		 */
+		virtual size_t									DirtyPageCount() const { return 0; }
+
+		/**
+		 * Writes only the CPU-bus and PPU-bus pages written since the last call to ClearDirtyPages().  Loading the result with
+		 *	LoadDirtyPages() on top of the memory as it was at that checkpoint restores the memory as it is now.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the pages were written.
+		 */
+		virtual bool									SaveDirtyPages( CStream &/*_sStream*/ ) const { return false; }
+
+		/**
+		 * Reads pages previously written by SaveDirtyPages() over the current CPU-bus and PPU-bus memory.
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the pages were read.
+		 */
+		virtual bool									LoadDirtyPages( CStream &/*_sStream*/ ) { return false; }
+
 		/**
 		 * Gets the PPU as a display client.
 		 *
@@ -223,6 +561,15 @@ namespace lsn {
 		LSN_ROM											m_rRom;								/**< The current cartridge. */
 		std::unique_ptr<CMapperBase>					m_pmbMapper;						/**< The mapper. */
 		bool											m_bPaused;							/**< Pause flag. */
+		bool											m_bUnrolledScheduler;				/**< If true, components are ticked by the unrolled scheduler. */
+		bool											m_bLazyPpu;							/**< If true, the PPU is only caught up to the CPU when needed. */
+		bool											m_bFastPages;						/**< If true, the buses access plain RAM/ROM pages directly. */
+		bool											m_bFastCpu;							/**< If true, eligible instructions are run in 1 call each in lazy-PPU mode. */
+		bool											m_bBlockCpu;						/**< If true, eligible instructions are run back-to-back up to the next sync point. */
+		bool											m_bJitCpu;							/**< If true, back-to-back instructions are run through compiled code. */
+		bool											m_bDecodeCache;						/**< If true, instructions run in 1 call each are looked up in the decoded-block cache. */
+		bool											m_bSwitchDispatch;					/**< If true, the CPU dispatches micro-ops through a switch. */
+		bool											m_bIdleSkip;						/**< If true, passes of idle loops are skipped. */
 
 
 		// == Functions.
@@ -0,0 +1,76 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A thread-safe pool of systems.  Systems are expensive to construct (mainly their bus accessor tables), so they are
+ *	handed back to the pool when a job finishes and reused by the next job for the same region.
+ */
+
+#include "LSNSystemPool.h"
+
+
+namespace lsn {
+
+	// == Functions.
+	/**
+	 * Takes a system for the given region out of the pool, creating one if none are free.
+	 *
+	 * \param _pmRegion The region of the system (LSN_PM_NTSC, LSN_PM_PAL, or LSN_PM_DENDY).
+	 * \return Returns the system, or an empty pointer if the region is not valid.
+	 */
+	std::unique_ptr<CSystemBase> CSystemPool::Acquire( LSN_PPU_METRICS _pmRegion ) {
+		if ( uint32_t( _pmRegion ) >= LSN_PM_CONSOLE_TOTAL ) { return std::unique_ptr<CSystemBase>(); }
+		{
+			std::lock_guard<std::mutex> lgLock( m_mMutex );
+			if ( m_vFree[_pmRegion].size() ) {
+				std::unique_ptr<CSystemBase> psbRet = std::move( m_vFree[_pmRegion].back() );
+				m_vFree[_pmRegion].pop_back();
+				return psbRet;
+			}
+			++m_stCreated;
+		}
+
+		// Construct outside of the lock; this is the slow part.
+		switch ( _pmRegion ) {
+			case LSN_PM_NTSC : { return std::make_unique<CNtscSystem>(); }
+			case LSN_PM_PAL : { return std::make_unique<CPalSystem>(); }
+			case LSN_PM_DENDY : { return std::make_unique<CDendySystem>(); }
+			default : { return std::unique_ptr<CSystemBase>(); }
+		}
+	}
+
+	/**
+	 * Returns a system to the pool.
+	 *
+	 * \param _pmRegion The region that was passed to Acquire() when the system was taken.
+	 * \param _psbSystem The system to return.
+	 */
+	void CSystemPool::Release( LSN_PPU_METRICS _pmRegion, std::unique_ptr<CSystemBase> _psbSystem ) {
+		if ( !_psbSystem || uint32_t( _pmRegion ) >= LSN_PM_CONSOLE_TOTAL ) { return; }
+		_psbSystem->SetInputPoller( nullptr );
+		std::lock_guard<std::mutex> lgLock( m_mMutex );
+		m_vFree[_pmRegion].push_back( std::move( _psbSystem ) );
+	}
+
+	/**
+	 * Gets the number of systems that have been constructed.
+	 *
+	 * \return Returns the number of systems that have been constructed.
+	 */
+	size_t CSystemPool::Created() const {
+		std::lock_guard<std::mutex> lgLock( m_mMutex );
+		return m_stCreated;
+	}
+
+	/**
+	 * Destroys all free systems.
+	 */
+	void CSystemPool::Clear() {
+		std::lock_guard<std::mutex> lgLock( m_mMutex );
+		for ( size_t I = 0; I < LSN_PM_CONSOLE_TOTAL; ++I ) {
+			m_vFree[I].clear();
+		}
+	}
+
+}	// namespace lsn
@@ -0,0 +1,75 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A thread-safe pool of systems.  Systems are expensive to construct (mainly their bus accessor tables), so they are
+ *	handed back to the pool when a job finishes and reused by the next job for the same region.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "LSNSystem.h"
+
+#include <mutex>
+
+
+namespace lsn {
+
+	/**
+	 * Class CSystemPool
+	 * \brief A thread-safe pool of systems.
+	 *
+	 * Description: A thread-safe pool of systems.  Systems are expensive to construct (mainly their bus accessor tables), so they are
+	 *	handed back to the pool when a job finishes and reused by the next job for the same region.
+	 */
+	class CSystemPool {
+	public :
+		CSystemPool() :
+			m_stCreated( 0 ) {
+		}
+
+
+		// == Functions.
+		/**
+		 * Takes a system for the given region out of the pool, creating one if none are free.
+		 *
+		 * \param _pmRegion The region of the system (LSN_PM_NTSC, LSN_PM_PAL, or LSN_PM_DENDY).
+		 * \return Returns the system, or an empty pointer if the region is not valid.
+		 */
+		std::unique_ptr<CSystemBase>					Acquire( LSN_PPU_METRICS _pmRegion );
+
+		/**
+		 * Returns a system to the pool.
+		 *
+		 * \param _pmRegion The region that was passed to Acquire() when the system was taken.
+		 * \param _psbSystem The system to return.
+		 */
+		void											Release( LSN_PPU_METRICS _pmRegion, std::unique_ptr<CSystemBase> _psbSystem );
+
+		/**
+		 * Gets the number of systems that have been constructed.
+		 *
+		 * \return Returns the number of systems that have been constructed.
+		 */
+		size_t											Created() const;
+
+		/**
+		 * Destroys all free systems.
+		 */
+		void											Clear();
+
+
+	protected :
+		// == Members.
+		/** Guards the pool. */
+		mutable std::mutex								m_mMutex;
+		/** The free systems, per region. */
+		std::vector<std::unique_ptr<CSystemBase>>		m_vFree[LSN_PM_CONSOLE_TOTAL];
+		/** The number of systems that have been constructed. */
+		size_t											m_stCreated;
+	};
+
+}	// namespace lsn
@@ -0,0 +1,258 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Attributes host time and call counts to each hardware component, per frame.  Only used by systems built with profiling
+ *	enabled (see CSystem's _bProfile parameter), so regular builds pay nothing for it.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "../Display/LSNDisplayHost.h"
+
+#include <chrono>
+#include <cstring>
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#include <immintrin.h>
+#endif	// #if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+
+
+namespace lsn {
+
+	/**
+	 * Class CSystemProfiler
+	 * \brief Attributes host time and call counts to each hardware component, per frame.
+	 *
+	 * Description: Attributes host time and call counts to each hardware component, per frame.  Only used by systems built with profiling
+	 *	enabled (see CSystem's _bProfile parameter), so regular builds pay nothing for it.
+	 */
+	class CSystemProfiler {
+	public :
+		CSystemProfiler() {
+			Reset( 0 );
+		}
+
+
+		// == Enumerations.
+		/** The components. */
+		enum LSN_PROFILE_COMPONENT {
+			LSN_PC_CPU,																				/**< CCpu6502::Tick(), not including the mapper. */
+			LSN_PC_PPU,																				/**< The PPU's cycle functions, not including Swap(). */
+			LSN_PC_APU,																				/**< The APU's Tick(). */
+			LSN_PC_MAPPER,																			/**< The mapper's Tick(). */
+			LSN_PC_DISPLAY,																			/**< The display host's Swap(). */
+			LSN_PC_EVENTS,																			/**< Timed events (APU frame counter, mapper IRQ's, etc.) */
+			LSN_PC_SCHEDULER,																		/**< Everything else inside the scheduler: picking the next component, counters, and profiling overhead. */
+			LSN_PC_TOTAL
+		};
+
+		/** Limits. */
+		enum LSN_PROFILER {
+			LSN_P_HISTORY										= 64,								/**< The number of completed frames that are kept. */
+		};
+
+
+		// == Types.
+		/** The time and calls for 1 component. */
+		struct LSN_PROFILE_COUNTER {
+			uint64_t											ui64Calls;							/**< The number of calls. */
+			uint64_t											ui64HostCycles;						/**< Host cycles spent, not including nested components. */
+		};
+
+		/** The counters for every component over a frame (or over all frames). */
+		struct LSN_PROFILE_FRAME {
+			uint64_t											ui64Frame;							/**< The PPU frame number, or the number of frames for totals. */
+			LSN_PROFILE_COUNTER									pcCounters[LSN_PC_TOTAL];			/**< The counters, indexed by LSN_PROFILE_COMPONENT. */
+
+
+			// == Functions.
+			/**
+			 * Gets the host cycles spent by all components together.
+			 *
+			 * \return Returns the sum of the host cycles of every component.
+			 */
+			inline uint64_t										HostCycles() const {
+				uint64_t ui64Ret = 0;
+				for ( size_t I = 0; I < LSN_PC_TOTAL; ++I ) { ui64Ret += pcCounters[I].ui64HostCycles; }
+				return ui64Ret;
+			}
+		};
+
+
+		// == Functions.
+		/**
+		 * Clears all counters and history.
+		 *
+		 * \param _ui64Frame The current PPU frame.
+		 */
+		inline void												Reset( uint64_t _ui64Frame ) {
+			std::memset( &m_pfCurrent, 0, sizeof( m_pfCurrent ) );
+			std::memset( &m_pfTotals, 0, sizeof( m_pfTotals ) );
+			m_pfCurrent.ui64Frame = _ui64Frame;
+			m_stHistoryNext = 0;
+			m_stHistoryTotal = 0;
+			m_ui64Nested = 0;
+		}
+
+		/**
+		 * Runs a function and charges the host time it takes to the given component.  Time spent in nested calls to Measure() is charged to
+		 *	the nested components instead.
+		 *
+		 * \param _pcComponent The component to charge.
+		 * \param _fFunc The function to run.
+		 */
+		template <LSN_PROFILE_COMPONENT _pcComponent, typename _tFunc>
+		__forceinline void										Measure( _tFunc _fFunc ) {
+			const uint64_t ui64Nested = m_ui64Nested;
+			const uint64_t ui64Start = HostCycles();
+			_fFunc();
+			const uint64_t ui64Time = HostCycles() - ui64Start;
+			LSN_PROFILE_COUNTER & pcCounter = m_pfCurrent.pcCounters[_pcComponent];
+			pcCounter.ui64HostCycles += ui64Time - (m_ui64Nested - ui64Nested);
+			++pcCounter.ui64Calls;
+			// The caller, if any, is charged for everything but this.
+			m_ui64Nested = ui64Nested + ui64Time;
+		}
+
+		/**
+		 * Closes the current frame and starts a new one.
+		 *
+		 * \param _ui64Frame The number of the new frame.
+		 */
+		inline void												EndFrame( uint64_t _ui64Frame ) {
+			for ( size_t I = 0; I < LSN_PC_TOTAL; ++I ) {
+				m_pfTotals.pcCounters[I].ui64Calls += m_pfCurrent.pcCounters[I].ui64Calls;
+				m_pfTotals.pcCounters[I].ui64HostCycles += m_pfCurrent.pcCounters[I].ui64HostCycles;
+			}
+			++m_pfTotals.ui64Frame;
+			m_pfHistory[m_stHistoryNext] = m_pfCurrent;
+			m_stHistoryNext = (m_stHistoryNext + 1) % LSN_P_HISTORY;
+			if ( m_stHistoryTotal < LSN_P_HISTORY ) { ++m_stHistoryTotal; }
+
+			std::memset( &m_pfCurrent, 0, sizeof( m_pfCurrent ) );
+			m_pfCurrent.ui64Frame = _ui64Frame;
+		}
+
+		/**
+		 * Gets the frame in progress.
+		 *
+		 * \return Returns the counters for the frame in progress.
+		 */
+		inline const LSN_PROFILE_FRAME &						Current() const { return m_pfCurrent; }
+
+		/**
+		 * Gets the totals for all completed frames since the last Reset().  LSN_PROFILE_FRAME::ui64Frame holds the number of frames.
+		 *
+		 * \return Returns the totals for all completed frames.
+		 */
+		inline const LSN_PROFILE_FRAME &						Totals() const { return m_pfTotals; }
+
+		/**
+		 * Gets the number of completed frames in the history.
+		 *
+		 * \return Returns the number of frames that can be passed to History().
+		 */
+		inline size_t											HistorySize() const { return m_stHistoryTotal; }
+
+		/**
+		 * Gets a completed frame from the history.
+		 *
+		 * \param _stIdx The index of the frame, where 0 is the most recently completed frame.  Must be less than HistorySize().
+		 * \return Returns the counters for the requested frame.
+		 */
+		inline const LSN_PROFILE_FRAME &						History( size_t _stIdx ) const {
+			return m_pfHistory[(m_stHistoryNext+LSN_P_HISTORY-1-_stIdx)%LSN_P_HISTORY];
+		}
+
+		/**
+		 * Gets the name of a component.
+		 *
+		 * \param _pcComponent The component.
+		 * \return Returns the name of the component.
+		 */
+		static inline const char *								ComponentName( LSN_PROFILE_COMPONENT _pcComponent ) {
+			switch ( _pcComponent ) {
+				case LSN_PC_CPU : { return "cpu"; }
+				case LSN_PC_PPU : { return "ppu"; }
+				case LSN_PC_APU : { return "apu"; }
+				case LSN_PC_MAPPER : { return "mapper"; }
+				case LSN_PC_DISPLAY : { return "display"; }
+				case LSN_PC_EVENTS : { return "events"; }
+				case LSN_PC_SCHEDULER : { return "scheduler"; }
+				default : { return "unknown"; }
+			}
+		}
+
+		/**
+		 * Reads the host cycle counter.  This is the time-stamp counter on x86, otherwise nanoseconds.
+		 *
+		 * \return Returns the host cycle counter.
+		 */
+		static __forceinline uint64_t							HostCycles() {
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+			return __rdtsc();
+#else
+			return uint64_t( std::chrono::duration_cast<std::chrono::nanoseconds>( std::chrono::steady_clock::now().time_since_epoch() ).count() );
+#endif	// #if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+		}
+
+
+	protected :
+		// == Members.
+		/** The frame in progress. */
+		LSN_PROFILE_FRAME										m_pfCurrent;
+		/** Totals over all completed frames. */
+		LSN_PROFILE_FRAME										m_pfTotals;
+		/** The most recently completed frames. */
+		LSN_PROFILE_FRAME										m_pfHistory[LSN_P_HISTORY];
+		/** The index in m_pfHistory to which the next completed frame is written. */
+		size_t													m_stHistoryNext;
+		/** The number of valid frames in m_pfHistory. */
+		size_t													m_stHistoryTotal;
+		/** Host cycles spent in nested Measure() calls. */
+		uint64_t												m_ui64Nested;
+	};
+
+
+	/**
+	 * Class CProfilerDisplayHost
+	 * \brief Sits between the PPU and the real display host and charges the time spent in Swap() to LSN_PC_DISPLAY.
+	 *
+	 * Description: Sits between the PPU and the real display host and charges the time spent in Swap() to LSN_PC_DISPLAY.
+	 */
+	class CProfilerDisplayHost : public CDisplayHost {
+	public :
+		CProfilerDisplayHost( CSystemProfiler * _pspProfiler ) :
+			m_pspProfiler( _pspProfiler ),
+			m_pdhHost( nullptr ) {
+		}
+
+
+		// == Functions.
+		/**
+		 * Informs the host that a frame has been rendered.  This typically causes a display update and a framebuffer swap.
+		 */
+		virtual void											Swap() {
+			m_pspProfiler->Measure<CSystemProfiler::LSN_PC_DISPLAY>( [this]{ m_pdhHost->Swap(); } );
+		}
+
+		/**
+		 * Sets the real display host, to which Swap() is forwarded.
+		 *
+		 * \param _pdhHost The real display host.
+		 */
+		inline void												SetHost( CDisplayHost * _pdhHost ) { m_pdhHost = _pdhHost; }
+
+
+	protected :
+		// == Members.
+		/** The profiler. */
+		CSystemProfiler *										m_pspProfiler;
+		/** The real display host. */
+		CDisplayHost *											m_pdhHost;
+	};
+
+}	// namespace lsn
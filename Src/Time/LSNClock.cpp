@@ -9,6 +9,10 @@
 
 #include "LSNClock.h"
 
+#ifndef LSN_WINDOWS
+#include <ctime>
+#endif	// #ifndef LSN_WINDOWS
+
 namespace lsn {
 
 	// == Various constructors.
@@ -17,6 +21,9 @@ namespace lsn {
 		LARGE_INTEGER liTmp;
 		::QueryPerformanceFrequency( &liTmp );
 		m_ui64Resolution = liTmp.QuadPart;
+#else
+		// CLOCK_MONOTONIC in nanoseconds.  CFramePacer relies on this to sleep with clock_nanosleep().
+		m_ui64Resolution = 1000000000ULL;
 #endif	// #ifdef LSN_WINDOWS
 
 		SetStartingTick();
@@ -33,6 +40,10 @@ namespace lsn {
 		LARGE_INTEGER liTmp;
 		::QueryPerformanceCounter( &liTmp );
 		return liTmp.QuadPart;
+#else
+		struct timespec tsTime;
+		::clock_gettime( CLOCK_MONOTONIC, &tsTime );
+		return uint64_t( tsTime.tv_sec ) * 1000000000ULL + uint64_t( tsTime.tv_nsec );
 #endif	// #ifdef LSN_WINDOWS
 	}
 
@@ -0,0 +1,158 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Paces a real-time loop to a fixed period (a frame, an audio chunk, etc.)  The emulator runs a burst, then the pacer sleeps
+ *	until shortly before the next deadline and spins only for the final tail, so timing stays tight without pinning a core.
+ */
+
+#include "LSNFramePacer.h"
+
+#if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#include <immintrin.h>
+#define LSN_SPIN_PAUSE()						_mm_pause()
+#else
+#define LSN_SPIN_PAUSE()
+#endif	// #if defined( __x86_64__ ) || defined( _M_X64 ) || defined( __i386__ ) || defined( _M_IX86 )
+#ifdef LSN_WINDOWS
+#include <timeapi.h>
+#pragma comment( lib, "winmm.lib" )
+#else
+#include <cerrno>
+#include <ctime>
+#endif	// #ifdef LSN_WINDOWS
+
+
+namespace lsn {
+
+	CFramePacer::CFramePacer() :
+		m_ui64Deadline( 0 ),
+		m_ui64PeriodTicks( 0 ),
+		m_ui64PeriodRem( 0 ),
+		m_ui64PeriodDen( 1 ),
+		m_ui64Frac( 0 ),
+		m_ui64SpinTicks( 0 ),
+		m_ui64Periods( 0 ),
+		m_ui64LatePeriods( 0 ) {
+#ifdef LSN_WINDOWS
+		// Sleep() granularity is otherwise ~15.6 milliseconds.
+		::timeBeginPeriod( 1 );
+#endif	// #ifdef LSN_WINDOWS
+		SetSpinTime( LSN_FP_DEFAULT_SPIN_US );
+		Reset();
+	}
+	CFramePacer::~CFramePacer() {
+#ifdef LSN_WINDOWS
+		::timeEndPeriod( 1 );
+#endif	// #ifdef LSN_WINDOWS
+	}
+
+	// == Functions.
+	/**
+	 * Sets the length of a period as a fraction of a second.  For a frame this is (master cycles per frame * master divider) / master Hz.
+	 *	Also calls Reset().
+	 *
+	 * \param _ui64Num The numerator of the length of a period in seconds.
+	 * \param _ui64Den The denominator of the length of a period in seconds.
+	 */
+	void CFramePacer::SetPeriod( uint64_t _ui64Num, uint64_t _ui64Den ) {
+		if ( !_ui64Den ) {
+			m_ui64PeriodTicks = m_ui64PeriodRem = 0;
+			m_ui64PeriodDen = 1;
+		}
+		else {
+			// A frame is a few million master cycles and the clock resolution is at most 1 GHz, so this does not overflow.
+			uint64_t ui64Ticks = _ui64Num * m_cClock.GetResolution();
+			m_ui64PeriodTicks = ui64Ticks / _ui64Den;
+			m_ui64PeriodRem = ui64Ticks % _ui64Den;
+			m_ui64PeriodDen = _ui64Den;
+		}
+		Reset();
+	}
+
+	/**
+	 * Sets how long to spin before each deadline instead of sleeping.
+	 *
+	 * \param _ui64Microseconds The spin time in microseconds.
+	 */
+	void CFramePacer::SetSpinTime( uint64_t _ui64Microseconds ) {
+		m_ui64SpinTicks = _ui64Microseconds * m_cClock.GetResolution() / 1000000ULL;
+	}
+
+	/**
+	 * Sets the next deadline to 1 period from now.
+	 */
+	void CFramePacer::Reset() {
+		m_ui64Deadline = m_cClock.GetRealTick();
+		m_ui64Frac = 0;
+		Advance();
+	}
+
+	/**
+	 * Waits until the current deadline and then moves the deadline ahead by 1 period.
+	 *
+	 * \return Returns false if the deadline had already passed, in which case there was no wait.
+	 */
+	bool CFramePacer::Wait() {
+		++m_ui64Periods;
+		uint64_t ui64Now = m_cClock.GetRealTick();
+		if ( ui64Now >= m_ui64Deadline ) {
+			++m_ui64LatePeriods;
+			if ( ui64Now - m_ui64Deadline > m_ui64PeriodTicks * LSN_FP_MAX_LATE_PERIODS ) {
+				// Too far behind (a breakpoint, the window being dragged, etc.)  Start over from here.
+				m_ui64Deadline = ui64Now;
+				m_ui64Frac = 0;
+			}
+			Advance();
+			return false;
+		}
+
+		if ( m_ui64Deadline - ui64Now > m_ui64SpinTicks ) {
+			SleepUntil( m_ui64Deadline - m_ui64SpinTicks );
+		}
+		while ( m_cClock.GetRealTick() < m_ui64Deadline ) {
+			LSN_SPIN_PAUSE();
+		}
+		Advance();
+		return true;
+	}
+
+	/**
+	 * Moves the deadline ahead by 1 period.
+	 */
+	void CFramePacer::Advance() {
+		m_ui64Deadline += m_ui64PeriodTicks;
+		m_ui64Frac += m_ui64PeriodRem;
+		if ( m_ui64Frac >= m_ui64PeriodDen ) {
+			m_ui64Frac -= m_ui64PeriodDen;
+			++m_ui64Deadline;
+		}
+	}
+
+	/**
+	 * Sleeps until the given clock tick or a bit before.
+	 *
+	 * \param _ui64Time The clock tick until which to sleep.
+	 */
+	void CFramePacer::SleepUntil( uint64_t _ui64Time ) {
+#ifdef LSN_WINDOWS
+		uint64_t ui64Now = m_cClock.GetRealTick();
+		if ( _ui64Time > ui64Now ) {
+			uint64_t ui64Ms = (_ui64Time - ui64Now) * 1000ULL / m_cClock.GetResolution();
+			if ( ui64Ms ) {
+				::Sleep( DWORD( ui64Ms ) );
+			}
+		}
+#else
+		// CClock ticks are CLOCK_MONOTONIC nanoseconds, so the deadline can be slept on directly.
+		struct timespec tsTime;
+		tsTime.tv_sec = time_t( _ui64Time / 1000000000ULL );
+		tsTime.tv_nsec = long( _ui64Time % 1000000000ULL );
+		while ( ::clock_nanosleep( CLOCK_MONOTONIC, TIMER_ABSTIME, &tsTime, nullptr ) == EINTR ) {}
+#endif	// #ifdef LSN_WINDOWS
+	}
+
+}	// namespace lsn
+
+#undef LSN_SPIN_PAUSE
@@ -0,0 +1,124 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Paces a real-time loop to a fixed period (a frame, an audio chunk, etc.)  The emulator runs a burst, then the pacer sleeps
+ *	until shortly before the next deadline and spins only for the final tail, so timing stays tight without pinning a core.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include "LSNClock.h"
+
+
+namespace lsn {
+
+	/**
+	 * Class CFramePacer
+	 * \brief Paces a real-time loop to a fixed period.
+	 *
+	 * Description: Paces a real-time loop to a fixed period (a frame, an audio chunk, etc.)  The emulator runs a burst, then the pacer sleeps
+	 *	until shortly before the next deadline and spins only for the final tail, so timing stays tight without pinning a core.
+	 */
+	class CFramePacer {
+	public :
+		CFramePacer();
+		~CFramePacer();
+
+
+		// == Enumerations.
+		/** Pacer settings. */
+		enum LSN_FRAME_PACER {
+#ifdef LSN_WINDOWS
+			LSN_FP_DEFAULT_SPIN_US						= 2000,								/**< Default time to spin before each deadline, in microseconds.  Sleep() is only accurate to about 1 millisecond. */
+#else
+			LSN_FP_DEFAULT_SPIN_US						= 250,								/**< Default time to spin before each deadline, in microseconds. */
+#endif	// #ifdef LSN_WINDOWS
+			LSN_FP_MAX_LATE_PERIODS						= 4,								/**< If the loop falls this many periods behind, the deadline is moved up to the current time rather than trying to catch up. */
+		};
+
+
+		// == Functions.
+		/**
+		 * Sets the length of a period as a fraction of a second.  For a frame this is (master cycles per frame * master divider) / master Hz.
+		 *	Also calls Reset().
+		 *
+		 * \param _ui64Num The numerator of the length of a period in seconds.
+		 * \param _ui64Den The denominator of the length of a period in seconds.
+		 */
+		void											SetPeriod( uint64_t _ui64Num, uint64_t _ui64Den );
+
+		/**
+		 * Sets how long to spin before each deadline instead of sleeping.
+		 *
+		 * \param _ui64Microseconds The spin time in microseconds.
+		 */
+		void											SetSpinTime( uint64_t _ui64Microseconds );
+
+		/**
+		 * Sets the next deadline to 1 period from now.
+		 */
+		void											Reset();
+
+		/**
+		 * Waits until the current deadline and then moves the deadline ahead by 1 period.
+		 *
+		 * \return Returns false if the deadline had already passed, in which case there was no wait.
+		 */
+		bool											Wait();
+
+		/**
+		 * Gets the number of periods that have been waited.
+		 *
+		 * \return Returns the number of periods that have been waited.
+		 */
+		inline uint64_t									Periods() const { return m_ui64Periods; }
+
+		/**
+		 * Gets the number of periods whose deadline had already passed when Wait() was called.
+		 *
+		 * \return Returns the number of late periods.
+		 */
+		inline uint64_t									LatePeriods() const { return m_ui64LatePeriods; }
+
+
+	protected :
+		// == Members.
+		/** The clock. */
+		CClock											m_cClock;
+		/** The next deadline, in clock ticks. */
+		uint64_t										m_ui64Deadline;
+		/** The whole part of a period, in clock ticks. */
+		uint64_t										m_ui64PeriodTicks;
+		/** The fractional part of a period, in units of 1/m_ui64PeriodDen clock ticks. */
+		uint64_t										m_ui64PeriodRem;
+		/** The denominator of the fractional part of a period. */
+		uint64_t										m_ui64PeriodDen;
+		/** The accumulated fractional clock ticks. */
+		uint64_t										m_ui64Frac;
+		/** The time to spin before each deadline, in clock ticks. */
+		uint64_t										m_ui64SpinTicks;
+		/** The number of periods waited. */
+		uint64_t										m_ui64Periods;
+		/** The number of late periods. */
+		uint64_t										m_ui64LatePeriods;
+
+
+		// == Functions.
+		/**
+		 * Moves the deadline ahead by 1 period.
+		 */
+		void											Advance();
+
+		/**
+		 * Sleeps until the given clock tick or a bit before.
+		 *
+		 * \param _ui64Time The clock tick until which to sleep.
+		 */
+		void											SleepUntil( uint64_t _ui64Time );
+	};
+
+}	// namespace lsn
@@ -0,0 +1,136 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Reads the host CPU's cache-miss and branch-miss counters around a block of code.  Only available on Linux (perf events);
+ *	elsewhere every counter reports as unavailable.
+ */
+
+#include "LSNCacheCounters.h"
+
+#if defined( __linux__ )
+#include <cstring>
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif	// #if defined( __linux__ )
+
+
+namespace lsn {
+
+	CCacheCounters::CCacheCounters() {
+		for ( size_t I = 0; I < LSN_CC_TOTAL; ++I ) {
+			m_iFds[I] = -1;
+		}
+	}
+	CCacheCounters::~CCacheCounters() {
+		Close();
+	}
+
+	// == Functions.
+	/**
+	 * Opens and starts the counters.  Counting is per thread and excludes the kernel.
+	 *
+	 * \return Returns true if at least 1 counter could be started.
+	 */
+	bool CCacheCounters::Start() {
+		Close();
+#if defined( __linux__ )
+		static const uint32_t ui32Types[LSN_CC_TOTAL] = {
+			PERF_TYPE_HW_CACHE,
+			PERF_TYPE_HW_CACHE,
+			PERF_TYPE_HW_CACHE,
+			PERF_TYPE_HW_CACHE,
+			PERF_TYPE_HARDWARE,
+			PERF_TYPE_HARDWARE,
+		};
+		static const uint64_t ui64Configs[LSN_CC_TOTAL] = {
+			PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16),
+			PERF_COUNT_HW_CACHE_L1D | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+			PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_ACCESS << 16),
+			PERF_COUNT_HW_CACHE_LL | (PERF_COUNT_HW_CACHE_OP_READ << 8) | (PERF_COUNT_HW_CACHE_RESULT_MISS << 16),
+			PERF_COUNT_HW_BRANCH_INSTRUCTIONS,
+			PERF_COUNT_HW_BRANCH_MISSES,
+		};
+		bool bAny = false;
+		for ( size_t I = 0; I < LSN_CC_TOTAL; ++I ) {
+			perf_event_attr peaAttr;
+			std::memset( &peaAttr, 0, sizeof( peaAttr ) );
+			peaAttr.type = ui32Types[I];
+			peaAttr.size = sizeof( peaAttr );
+			peaAttr.config = ui64Configs[I];
+			peaAttr.disabled = 1;
+			peaAttr.exclude_kernel = 1;
+			peaAttr.exclude_hv = 1;
+			m_iFds[I] = int( ::syscall( __NR_perf_event_open, &peaAttr, 0, -1, -1, 0 ) );
+			if ( m_iFds[I] >= 0 ) {
+				::ioctl( m_iFds[I], PERF_EVENT_IOC_RESET, 0 );
+				bAny = true;
+			}
+		}
+		// Enable them together, after all of the opening is done.
+		for ( size_t I = 0; I < LSN_CC_TOTAL; ++I ) {
+			if ( m_iFds[I] >= 0 ) { ::ioctl( m_iFds[I], PERF_EVENT_IOC_ENABLE, 0 ); }
+		}
+		return bAny;
+#else
+		return false;
+#endif	// #if defined( __linux__ )
+	}
+
+	/**
+	 * Stops the counters and reads them.
+	 *
+	 * \return Returns the counts since Start().
+	 */
+	CCacheCounters::LSN_CACHE_COUNTS CCacheCounters::Stop() {
+		LSN_CACHE_COUNTS ccCounts;
+#if defined( __linux__ )
+		for ( size_t I = 0; I < LSN_CC_TOTAL; ++I ) {
+			if ( m_iFds[I] >= 0 ) { ::ioctl( m_iFds[I], PERF_EVENT_IOC_DISABLE, 0 ); }
+		}
+		for ( size_t I = 0; I < LSN_CC_TOTAL; ++I ) {
+			uint64_t ui64Count;
+			if ( m_iFds[I] >= 0 && ::read( m_iFds[I], &ui64Count, sizeof( ui64Count ) ) == sizeof( ui64Count ) ) {
+				ccCounts.ui64Counts[I] = ui64Count;
+				ccCounts.bValid[I] = true;
+			}
+		}
+#endif	// #if defined( __linux__ )
+		Close();
+		return ccCounts;
+	}
+
+	/**
+	 * Gets the name of a counter.
+	 *
+	 * \param _ccCounter The counter.
+	 * \return Returns the name of the counter.
+	 */
+	const char * CCacheCounters::CounterName( LSN_CACHE_COUNTER _ccCounter ) {
+		switch ( _ccCounter ) {
+			case LSN_CC_L1D_READS : { return "l1d_reads"; }
+			case LSN_CC_L1D_READ_MISSES : { return "l1d_read_misses"; }
+			case LSN_CC_LL_READS : { return "ll_reads"; }
+			case LSN_CC_LL_READ_MISSES : { return "ll_read_misses"; }
+			case LSN_CC_BRANCHES : { return "branches"; }
+			case LSN_CC_BRANCH_MISSES : { return "branch_misses"; }
+			default : { return "unknown"; }
+		}
+	}
+
+	/**
+	 * Closes all of the counters.
+	 */
+	void CCacheCounters::Close() {
+		for ( size_t I = 0; I < LSN_CC_TOTAL; ++I ) {
+#if defined( __linux__ )
+			if ( m_iFds[I] >= 0 ) { ::close( m_iFds[I] ); }
+#endif	// #if defined( __linux__ )
+			m_iFds[I] = -1;
+		}
+	}
+
+}	// namespace lsn
@@ -0,0 +1,103 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: Reads the host CPU's cache-miss and branch-miss counters around a block of code.  Only available on Linux (perf events);
+ *	elsewhere every counter reports as unavailable.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+
+namespace lsn {
+
+	/**
+	 * Class CCacheCounters
+	 * \brief Reads the host CPU's cache-miss and branch-miss counters around a block of code.
+	 *
+	 * Description: Reads the host CPU's cache-miss and branch-miss counters around a block of code.  Only available on Linux (perf events);
+	 *	elsewhere every counter reports as unavailable.
+	 */
+	class CCacheCounters {
+	public :
+		CCacheCounters();
+		~CCacheCounters();
+
+
+		// == Enumerations.
+		/** The counters. */
+		enum LSN_CACHE_COUNTER {
+			LSN_CC_L1D_READS,															/**< L1 data-cache reads. */
+			LSN_CC_L1D_READ_MISSES,														/**< L1 data-cache read misses. */
+			LSN_CC_LL_READS,															/**< Last-level-cache reads (L2 or L3, depending on the host). */
+			LSN_CC_LL_READ_MISSES,														/**< Last-level-cache read misses. */
+			LSN_CC_BRANCHES,															/**< Retired branch instructions. */
+			LSN_CC_BRANCH_MISSES,														/**< Mispredicted branch instructions. */
+
+			LSN_CC_TOTAL
+		};
+
+
+		// == Types.
+		/** Counter values. */
+		struct LSN_CACHE_COUNTS {
+			uint64_t									ui64Counts[LSN_CC_TOTAL] = {};		/**< The counts. */
+			bool										bValid[LSN_CC_TOTAL] = {};			/**< True for each counter the host could read. */
+
+
+			// == Functions.
+			/**
+			 * Gets a miss rate.
+			 *
+			 * \param _ccAccesses The access counter.
+			 * \param _ccMisses The miss counter.
+			 * \return Returns the misses divided by the accesses, or a negative number if either counter is unavailable.
+			 */
+			inline double								MissRate( LSN_CACHE_COUNTER _ccAccesses, LSN_CACHE_COUNTER _ccMisses ) const {
+				if ( !bValid[_ccAccesses] || !bValid[_ccMisses] ) { return -1.0; }
+				return ui64Counts[_ccAccesses] ? double( ui64Counts[_ccMisses] ) / ui64Counts[_ccAccesses] : 0.0;
+			}
+		};
+
+
+		// == Functions.
+		/**
+		 * Opens and starts the counters.  Counting is per thread and excludes the kernel.
+		 *
+		 * \return Returns true if at least 1 counter could be started.
+		 */
+		bool											Start();
+
+		/**
+		 * Stops the counters and reads them.
+		 *
+		 * \return Returns the counts since Start().
+		 */
+		LSN_CACHE_COUNTS								Stop();
+
+		/**
+		 * Gets the name of a counter.
+		 *
+		 * \param _ccCounter The counter.
+		 * \return Returns the name of the counter.
+		 */
+		static const char *								CounterName( LSN_CACHE_COUNTER _ccCounter );
+
+
+	protected :
+		// == Members.
+		int												m_iFds[LSN_CC_TOTAL];				/**< The perf-event file descriptors, or -1. */
+
+
+		// == Functions.
+		/**
+		 * Closes all of the counters.
+		 */
+		void											Close();
+	};
+
+}	// namespace lsn
@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include "LSNStream.h"
 #include <functional>
 
 
@@ -46,8 +47,8 @@ namespace lsn {
 		 *
 		 * \return Returns _uDelayCycles + 1.
 		 */
-		template <size_t _uDelayCycles>
-		static constexpr size_t								ArraySize() { return _uDelayCycles + 1; }
+		template <size_t _uDelay>
+		static constexpr size_t								ArraySize() { return _uDelay + 1; }
 
 		/**
 		 * Gets the actual delay.
@@ -139,6 +140,33 @@ namespace lsn {
 			return m_tBuffer[0];
 		}
 
+		/**
+		 * Writes the values in the delay chain to a stream.  The callback is not saved.
+		 *
+		 * \param _sStream The stream to which to write.
+		 * \return Returns true if the state was written.
+		 */
+		bool												SaveState( CStream &_sStream ) const {
+			return _sStream.WriteBytes( m_tBuffer, sizeof( m_tBuffer ) ) &&
+				_sStream.WriteBytes( m_bIsWrite, sizeof( m_bIsWrite ) ) &&
+				_sStream.WriteUi64( m_stDirty );
+		}
+
+		/**
+		 * Reads the values in the delay chain from a stream previously written by SaveState().  The callback is not triggered.
+		 *
+		 * \param _sStream The stream from which to read.
+		 * \return Returns true if the state was read.
+		 */
+		bool												LoadState( CStream &_sStream ) {
+			uint64_t ui64Dirty;
+			if ( !_sStream.ReadBytes( m_tBuffer, sizeof( m_tBuffer ) ) ) { return false; }
+			if ( !_sStream.ReadBytes( m_bIsWrite, sizeof( m_bIsWrite ) ) ) { return false; }
+			if ( !_sStream.ReadUi64( ui64Dirty ) ) { return false; }
+			m_stDirty = size_t( ui64Dirty );
+			return true;
+		}
+
 	protected :
 		// == Members.
 		/** A callback function called when the final value actually gets set. */
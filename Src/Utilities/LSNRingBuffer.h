@@ -0,0 +1,133 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A lock-free single-producer/single-consumer ring buffer.  One thread pushes (the emulation thread) and one other thread
+ *	pops (a debugger or tool) without either ever waiting on the other.  When the buffer is full, new items are dropped and counted.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+#include <atomic>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CRingBuffer
+	 * \brief A lock-free single-producer/single-consumer ring buffer.
+	 *
+	 * Description: A lock-free single-producer/single-consumer ring buffer.  One thread pushes (the emulation thread) and one other thread
+	 *	pops (a debugger or tool) without either ever waiting on the other.  When the buffer is full, new items are dropped and counted.
+	 */
+	template <typename _tType>
+	class CRingBuffer {
+	public :
+		CRingBuffer( size_t _stCapacity = 4096 ) :
+			m_stHead( 0 ),
+			m_stTail( 0 ),
+			m_ui64Dropped( 0 ) {
+			SetCapacity( _stCapacity );
+		}
+
+
+		// == Functions.
+		/**
+		 * Sets the capacity, rounded up to a power of 2, and empties the buffer.  Neither thread may be using the buffer during this call.
+		 *
+		 * \param _stCapacity The minimum number of items the buffer can hold.
+		 */
+		void												SetCapacity( size_t _stCapacity ) {
+			size_t stSize = 2;
+			while ( stSize < _stCapacity + 1 ) { stSize <<= 1; }
+			m_vItems.resize( stSize );
+			m_stMask = stSize - 1;
+			Reset();
+		}
+
+		/**
+		 * Gets the number of items the buffer can hold.
+		 *
+		 * \return Returns the capacity.
+		 */
+		inline size_t										Capacity() const { return m_stMask; }
+
+		/**
+		 * Empties the buffer and clears the dropped count.  Neither thread may be using the buffer during this call.
+		 */
+		void												Reset() {
+			m_stHead.store( 0, std::memory_order_relaxed );
+			m_stTail.store( 0, std::memory_order_relaxed );
+			m_ui64Dropped.store( 0, std::memory_order_relaxed );
+		}
+
+		/**
+		 * Adds an item.  Only the producer thread may call this.
+		 *
+		 * \param _tItem The item to add.
+		 * \return Returns false if the buffer was full and the item was dropped.
+		 */
+		inline bool											Push( const _tType &_tItem ) {
+			const size_t stHead = m_stHead.load( std::memory_order_relaxed );
+			const size_t stNext = (stHead + 1) & m_stMask;
+			if ( stNext == m_stTail.load( std::memory_order_acquire ) ) {
+				m_ui64Dropped.fetch_add( 1, std::memory_order_relaxed );
+				return false;
+			}
+			m_vItems[stHead] = _tItem;
+			m_stHead.store( stNext, std::memory_order_release );
+			return true;
+		}
+
+		/**
+		 * Removes the oldest item.  Only the consumer thread may call this.
+		 *
+		 * \param _tItem Holds the returned item.
+		 * \return Returns false if the buffer was empty.
+		 */
+		inline bool											Pop( _tType &_tItem ) {
+			const size_t stTail = m_stTail.load( std::memory_order_relaxed );
+			if ( stTail == m_stHead.load( std::memory_order_acquire ) ) { return false; }
+			_tItem = m_vItems[stTail];
+			m_stTail.store( (stTail + 1) & m_stMask, std::memory_order_release );
+			return true;
+		}
+
+		/**
+		 * Removes every item currently in the buffer.  Only the consumer thread may call this.
+		 *
+		 * \param _vItems The items are appended to this.
+		 * \return Returns the number of items removed.
+		 */
+		size_t												Drain( std::vector<_tType> &_vItems ) {
+			size_t stCount = 0;
+			_tType tItem;
+			while ( Pop( tItem ) ) {
+				_vItems.push_back( tItem );
+				++stCount;
+			}
+			return stCount;
+		}
+
+		/**
+		 * Gets the number of items dropped because the buffer was full.
+		 *
+		 * \return Returns the number of dropped items.
+		 */
+		inline uint64_t										Dropped() const { return m_ui64Dropped.load( std::memory_order_relaxed ); }
+
+
+	protected :
+		// == Members.
+		std::vector<_tType>									m_vItems;								/**< The items.  1 slot is always empty to tell full from empty. */
+		size_t												m_stMask;								/**< The size of m_vItems minus 1. */
+		alignas( 64 ) std::atomic<size_t>					m_stHead;								/**< The next slot to write (owned by the producer). */
+		alignas( 64 ) std::atomic<size_t>					m_stTail;								/**< The next slot to read (owned by the consumer). */
+		alignas( 64 ) std::atomic<uint64_t>					m_ui64Dropped;							/**< The number of items dropped because the buffer was full. */
+	};
+
+}	// namespace lsn
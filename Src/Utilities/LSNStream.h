@@ -10,6 +10,7 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#include <cstring>
 #include <vector>
 
 
@@ -123,6 +124,22 @@ namespace lsn {
 			return Read<bool>( _bValue );
 		}
 
+		/**
+		 * Reads a block of bytes from the stream.
+		 *
+		 * \param _pvDst The buffer to which to copy the bytes.
+		 * \param _stSize The number of bytes to read.
+		 * \return Returns true if there was enough space left in the stream to read the bytes.
+		 */
+		inline bool									ReadBytes( void * _pvDst, size_t _stSize ) {
+			if ( (m_vStream.size() - m_stPos) >= _stSize ) {
+				std::memcpy( _pvDst, &m_vStream.data()[m_stPos], _stSize );
+				m_stPos += _stSize;
+				return true;
+			}
+			return false;
+		}
+
 
 		// ========
 		// WRITING
@@ -217,6 +234,24 @@ namespace lsn {
 			return Write<bool>( _bValue );
 		}
 
+		/**
+		 * Writes a block of bytes to the stream.
+		 *
+		 * \param _pvSrc The bytes to write.
+		 * \param _stSize The number of bytes to write.
+		 * \return Returns true if there was enough space left in the stream to write the bytes.
+		 */
+		inline bool									WriteBytes( const void * _pvSrc, size_t _stSize ) {
+			if ( m_stPos + _stSize > m_vStream.size() ) {
+				m_vStream.resize( m_stPos + _stSize );
+			}
+			if ( _stSize ) {
+				std::memcpy( &m_vStream.data()[m_stPos], _pvSrc, _stSize );
+			}
+			m_stPos += _stSize;
+			return true;
+		}
+
 
 		// ========
 		// BASE
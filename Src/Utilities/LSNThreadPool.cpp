@@ -0,0 +1,142 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A work-stealing thread pool.  Each worker has its own task queue and takes its newest task first; a worker whose queue
+ *	runs dry steals the oldest task from another worker's queue.
+ */
+
+#include "LSNThreadPool.h"
+
+
+namespace lsn {
+
+	/** The index of the worker running on this thread, or ~0 if this is not a worker thread. */
+	static thread_local size_t							s_stWorkerIdx = ~size_t( 0 );
+	/** The pool owning the worker running on this thread. */
+	static thread_local CThreadPool *					s_ptpWorkerPool = nullptr;
+
+	CThreadPool::CThreadPool( size_t _stThreads ) :
+		m_aQueued( 0 ),
+		m_aPending( 0 ),
+		m_aNextQueue( 0 ),
+		m_aSteals( 0 ),
+		m_aStop( false ) {
+		if ( !_stThreads ) {
+			_stThreads = std::max<size_t>( std::thread::hardware_concurrency(), 1 );
+		}
+		m_vQueues.reserve( _stThreads );
+		for ( size_t I = 0; I < _stThreads; ++I ) {
+			m_vQueues.push_back( std::make_unique<LSN_WORKER_QUEUE>() );
+		}
+		m_vThreads.reserve( _stThreads );
+		for ( size_t I = 0; I < _stThreads; ++I ) {
+			m_vThreads.push_back( std::make_unique<std::thread>( WorkerThread, this, I ) );
+		}
+	}
+	CThreadPool::~CThreadPool() {
+		{
+			std::lock_guard<std::mutex> lgLock( m_mSleepMutex );
+			m_aStop = true;
+		}
+		m_cvWork.notify_all();
+		for ( auto I = m_vThreads.size(); I--; ) {
+			m_vThreads[I]->join();
+		}
+	}
+
+	// == Functions.
+	/**
+	 * Adds a task to the pool.  Tasks submitted from a worker thread go to that worker's own queue, others are spread over the workers.
+	 *
+	 * \param _tTask The task to add.
+	 */
+	void CThreadPool::Submit( Task _tTask ) {
+		size_t stQueue = (s_ptpWorkerPool == this) ?
+			s_stWorkerIdx :
+			(m_aNextQueue++ % m_vQueues.size());
+		++m_aPending;
+		{
+			std::lock_guard<std::mutex> lgLock( m_vQueues[stQueue]->mMutex );
+			m_vQueues[stQueue]->dTasks.push_back( std::move( _tTask ) );
+		}
+		{
+			// Taken so that a worker cannot miss the wake-up between checking m_aQueued and going to sleep.
+			std::lock_guard<std::mutex> lgLock( m_mSleepMutex );
+			++m_aQueued;
+		}
+		m_cvWork.notify_one();
+	}
+
+	/**
+	 * Waits until every submitted task has finished.  Must not be called from a worker thread.
+	 */
+	void CThreadPool::WaitAll() {
+		std::unique_lock<std::mutex> ulLock( m_mSleepMutex );
+		m_cvDone.wait( ulLock, [this]{ return m_aPending.load() == 0; } );
+	}
+
+	/**
+	 * Takes a task for the given worker, first from its own queue and then from the others.
+	 *
+	 * \param _stWorker The index of the worker.
+	 * \param _tTask Holds the returned task.
+	 * \return Returns true if a task was found.
+	 */
+	bool CThreadPool::TakeTask( size_t _stWorker, Task &_tTask ) {
+		{
+			LSN_WORKER_QUEUE & wqQueue = (*m_vQueues[_stWorker]);
+			std::lock_guard<std::mutex> lgLock( wqQueue.mMutex );
+			if ( wqQueue.dTasks.size() ) {
+				// Newest first; its data is most likely to still be in the cache.
+				_tTask = std::move( wqQueue.dTasks.back() );
+				wqQueue.dTasks.pop_back();
+				--m_aQueued;
+				return true;
+			}
+		}
+		for ( size_t I = 1; I < m_vQueues.size(); ++I ) {
+			LSN_WORKER_QUEUE & wqQueue = (*m_vQueues[(_stWorker+I)%m_vQueues.size()]);
+			std::lock_guard<std::mutex> lgLock( wqQueue.mMutex );
+			if ( wqQueue.dTasks.size() ) {
+				// Oldest first; it is the furthest from what the owner is working on.
+				_tTask = std::move( wqQueue.dTasks.front() );
+				wqQueue.dTasks.pop_front();
+				--m_aQueued;
+				++m_aSteals;
+				return true;
+			}
+		}
+		return false;
+	}
+
+	/**
+	 * The worker thread.
+	 *
+	 * \param _ptpPool The pool.
+	 * \param _stWorker The index of this worker.
+	 */
+	void CThreadPool::WorkerThread( CThreadPool * _ptpPool, size_t _stWorker ) {
+		s_stWorkerIdx = _stWorker;
+		s_ptpWorkerPool = _ptpPool;
+		Task tTask;
+		while ( true ) {
+			if ( _ptpPool->TakeTask( _stWorker, tTask ) ) {
+				tTask();
+				tTask = nullptr;
+				if ( --_ptpPool->m_aPending == 0 ) {
+					std::lock_guard<std::mutex> lgLock( _ptpPool->m_mSleepMutex );
+					_ptpPool->m_cvDone.notify_all();
+				}
+				continue;
+			}
+
+			std::unique_lock<std::mutex> ulLock( _ptpPool->m_mSleepMutex );
+			_ptpPool->m_cvWork.wait( ulLock, [_ptpPool]{ return _ptpPool->m_aStop.load() || _ptpPool->m_aQueued.load() != 0; } );
+			if ( _ptpPool->m_aStop ) { break; }
+		}
+		s_ptpWorkerPool = nullptr;
+	}
+
+}	// namespace lsn
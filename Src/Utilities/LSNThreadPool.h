@@ -0,0 +1,123 @@
+/**
+ * Copyright L. Spiro 2023
+ *
+ * Written by: Shawn (L. Spiro) Wilcoxen
+ *
+ * Description: A work-stealing thread pool.  Each worker has its own task queue and takes its newest task first; a worker whose queue
+ *	runs dry steals the oldest task from another worker's queue.
+ */
+
+
+#pragma once
+
+#include "../LSNLSpiroNes.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace lsn {
+
+	/**
+	 * Class CThreadPool
+	 * \brief A work-stealing thread pool.
+	 *
+	 * Description: A work-stealing thread pool.  Each worker has its own task queue and takes its newest task first; a worker whose queue
+	 *	runs dry steals the oldest task from another worker's queue.
+	 */
+	class CThreadPool {
+	public :
+		CThreadPool( size_t _stThreads = 0 );
+		~CThreadPool();
+
+
+		// == Types.
+		/** A task. */
+		typedef std::function<void ()>					Task;
+
+
+		// == Functions.
+		/**
+		 * Adds a task to the pool.  Tasks submitted from a worker thread go to that worker's own queue, others are spread over the workers.
+		 *
+		 * \param _tTask The task to add.
+		 */
+		void											Submit( Task _tTask );
+
+		/**
+		 * Waits until every submitted task has finished.  Must not be called from a worker thread.
+		 */
+		void											WaitAll();
+
+		/**
+		 * Gets the number of worker threads.
+		 *
+		 * \return Returns the number of worker threads.
+		 */
+		inline size_t									Threads() const { return m_vThreads.size(); }
+
+		/**
+		 * Gets the total number of tasks that were stolen from another worker's queue.
+		 *
+		 * \return Returns the number of stolen tasks.
+		 */
+		inline uint64_t									Steals() const { return m_aSteals.load(); }
+
+
+	protected :
+		// == Types.
+		/** A worker's task queue. */
+		struct LSN_WORKER_QUEUE {
+			std::mutex									mMutex;								/**< Guards dTasks. */
+			std::deque<Task>							dTasks;								/**< The tasks.  The owner takes from the back, thieves from the front. */
+		};
+
+
+		// == Members.
+		/** One queue per worker. */
+		std::vector<std::unique_ptr<LSN_WORKER_QUEUE>>	m_vQueues;
+		/** The worker threads. */
+		std::vector<std::unique_ptr<std::thread>>		m_vThreads;
+		/** Guards sleeping and waking. */
+		std::mutex										m_mSleepMutex;
+		/** Signalled when tasks are added or the pool is stopping. */
+		std::condition_variable							m_cvWork;
+		/** Signalled when the last pending task finishes. */
+		std::condition_variable							m_cvDone;
+		/** The number of tasks sitting in the queues. */
+		std::atomic<size_t>								m_aQueued;
+		/** The number of tasks that have been submitted but not finished. */
+		std::atomic<size_t>								m_aPending;
+		/** The queue that gets the next task submitted from outside the pool. */
+		std::atomic<size_t>								m_aNextQueue;
+		/** The number of tasks stolen. */
+		std::atomic<uint64_t>							m_aSteals;
+		/** Set to stop the workers. */
+		std::atomic<bool>								m_aStop;
+
+
+		// == Functions.
+		/**
+		 * Takes a task for the given worker, first from its own queue and then from the others.
+		 *
+		 * \param _stWorker The index of the worker.
+		 * \param _tTask Holds the returned task.
+		 * \return Returns true if a task was found.
+		 */
+		bool											TakeTask( size_t _stWorker, Task &_tTask );
+
+		/**
+		 * The worker thread.
+		 *
+		 * \param _ptpPool The pool.
+		 * \param _stWorker The index of this worker.
+		 */
+		static void										WorkerThread( CThreadPool * _ptpPool, size_t _stWorker );
+	};
+
+}	// namespace lsn
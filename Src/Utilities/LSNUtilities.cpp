@@ -12,6 +12,7 @@
 
 #ifndef LSN_WINDOWS
 #include <codecvt>
+#include <locale>
 #endif
 
 namespace lsn {
@@ -76,7 +77,7 @@ namespace lsn {
 		// Visual Studio reports these as deprecated since C++17.
 		if ( _pbErrored != nullptr ) { (*_pbErrored) = false; }
 		try {
-			return std::wstring_convert<std::codecvt_utf8<wchar_t>>{}.to_bytes( reinterpret_cast<const wchar_t *>(_pcString) );
+			return std::wstring_convert<std::codecvt_utf8_utf16<char16_t>, char16_t>{}.to_bytes( _pcString );
 		}
 		catch ( ... ) { 
 			if ( _pbErrored != nullptr ) { (*_pbErrored) = true; }
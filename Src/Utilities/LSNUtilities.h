@@ -10,7 +10,10 @@
 #pragma once
 
 #include "../LSNLSpiroNes.h"
+#ifdef LSN_WINDOWS
 #include <intrin.h>
+#endif	// #ifdef LSN_WINDOWS
+#include <cstring>
 #include <string>
 
 
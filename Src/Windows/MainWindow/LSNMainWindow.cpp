@@ -23,6 +23,7 @@
 #include "../../Input/LSNDirectInput8.h"
 #include "../../Utilities/LSNUtilities.h"
 #include "../../Localization/LSNLocalization.h"
+#include "../../Time/LSNFramePacer.h"
 #include "../Input/LSNInputWindowLayout.h"
 #include "../SelectRom/LSNSelectRomDialogLayout.h"
 #include "LSNMainWindowLayout.h"
@@ -36,6 +37,7 @@
 
 
 #define LSN_SCALE_RESOLUTION					30.0
+#define LSN_EMU_SLICES_PER_FRAME				4						/**< The emulation thread runs in bursts of this fraction of a frame, bounding the added input latency to a quarter of a frame. */
 
 
 namespace lsn {
@@ -1166,9 +1168,34 @@ namespace lsn {
 		::SetThreadAffinityMask( ::GetCurrentThread(), 1 );
 #endif	// #ifdef LSN_WINDOWS
 
+		// Run a burst of emulation then sleep until the next slice is due, rather than spinning Tick() on a whole core.
+		CSystemBase * psbSystem = _pmwWindow->m_bnEmulator.GetSystem();
+		CFramePacer fpPacer;
+		fpPacer.SetPeriod( psbSystem->GetMasterCyclesPerFrame() * psbSystem->GetMasterDiv(), psbSystem->GetMasterHz() * LSN_EMU_SLICES_PER_FRAME );
+		uint64_t ui64LastFrame = psbSystem->GetPpuFrameCount();
+		uint32_t ui32Slice = 0;
 		while ( _pmwWindow->m_aiThreadState != LSN_TS_STOP ) {
-			_pmwWindow->m_bnEmulator.GetSystem()->Tick();
-			//::Sleep( 1 );
+			bool bNewFrame = false;
+			if ( ::GetForegroundWindow() == _pmwWindow->Wnd() && (::GetAsyncKeyState( VK_BACK ) & 0x8000) ) {
+				// Hold Backspace to rewind, 1 frame per frame period.  Frames displayed while rewinding are not captured again.
+				if ( ++ui32Slice >= LSN_EMU_SLICES_PER_FRAME ) {
+					ui32Slice = 0;
+					bNewFrame = _pmwWindow->m_bnEmulator.RewindFrame();
+				}
+			}
+			else {
+				psbSystem->Tick();
+				if ( psbSystem->GetPpuFrameCount() != ui64LastFrame ) {
+					_pmwWindow->m_bnEmulator.Rewind().Capture( (*psbSystem) );
+					bNewFrame = true;
+				}
+			}
+			if ( bNewFrame ) {
+				_pmwWindow->m_bnEmulator.Movie().OnFrame( (*psbSystem) );
+				_pmwWindow->m_bnEmulator.RunAheadFrame();
+			}
+			ui64LastFrame = psbSystem->GetPpuFrameCount();
+			fpPacer.Wait();
 		}
 		_pmwWindow->m_aiThreadState = LSN_TS_INACTIVE;
 	}
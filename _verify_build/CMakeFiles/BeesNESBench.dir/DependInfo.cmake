@@ -0,0 +1,21 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Src/LSNLSpiroNes.cpp" "CMakeFiles/BeesNESBench.dir/Src/LSNLSpiroNes.cpp.o" "gcc" "CMakeFiles/BeesNESBench.dir/Src/LSNLSpiroNes.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_verify_build/CMakeFiles/BeesNESCore.dir/DependInfo.cmake"
+  "/root/repo/_verify_build/CMakeFiles/LSon.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,11 @@
+file(REMOVE_RECURSE
+  "BeesNESBench"
+  "BeesNESBench.pdb"
+  "CMakeFiles/BeesNESBench.dir/Src/LSNLSpiroNes.cpp.o"
+  "CMakeFiles/BeesNESBench.dir/Src/LSNLSpiroNes.cpp.o.d"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/BeesNESBench.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
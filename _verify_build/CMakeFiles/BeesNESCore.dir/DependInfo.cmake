@@ -0,0 +1,51 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Src/MiniZ/miniz.c" "CMakeFiles/BeesNESCore.dir/Src/MiniZ/miniz.c.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/MiniZ/miniz.c.o.d"
+  "/root/repo/Src/Apu/LSNPulse.cpp" "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNPulse.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNPulse.cpp.o.d"
+  "/root/repo/Src/Apu/LSNSequencer.cpp" "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNSequencer.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNSequencer.cpp.o.d"
+  "/root/repo/Src/Bus/LSNBus.cpp" "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBus.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBus.cpp.o.d"
+  "/root/repo/Src/Bus/LSNBusHistogram.cpp" "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBusHistogram.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBusHistogram.cpp.o.d"
+  "/root/repo/Src/Bus/LSNWatchpoints.cpp" "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNWatchpoints.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNWatchpoints.cpp.o.d"
+  "/root/repo/Src/Cpu/LSNCpu6502.cpp" "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNCpu6502.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNCpu6502.cpp.o.d"
+  "/root/repo/Src/Cpu/LSNJit6502.cpp" "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNJit6502.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNJit6502.cpp.o.d"
+  "/root/repo/Src/Crc/LSNCrc.cpp" "CMakeFiles/BeesNESCore.dir/Src/Crc/LSNCrc.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Crc/LSNCrc.cpp.o.d"
+  "/root/repo/Src/Database/LSNDatabase.cpp" "CMakeFiles/BeesNESCore.dir/Src/Database/LSNDatabase.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Database/LSNDatabase.cpp.o.d"
+  "/root/repo/Src/Display/LSNDisplayClient.cpp" "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayClient.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayClient.cpp.o.d"
+  "/root/repo/Src/Display/LSNDisplayHost.cpp" "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayHost.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayHost.cpp.o.d"
+  "/root/repo/Src/File/LSNFileBase.cpp" "CMakeFiles/BeesNESCore.dir/Src/File/LSNFileBase.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/File/LSNFileBase.cpp.o.d"
+  "/root/repo/Src/File/LSNStdFile.cpp" "CMakeFiles/BeesNESCore.dir/Src/File/LSNStdFile.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/File/LSNStdFile.cpp.o.d"
+  "/root/repo/Src/File/LSNZipFile.cpp" "CMakeFiles/BeesNESCore.dir/Src/File/LSNZipFile.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/File/LSNZipFile.cpp.o.d"
+  "/root/repo/Src/Input/LSNInputMovie.cpp" "CMakeFiles/BeesNESCore.dir/Src/Input/LSNInputMovie.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Input/LSNInputMovie.cpp.o.d"
+  "/root/repo/Src/Roms/LSNRom.cpp" "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRom.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRom.cpp.o.d"
+  "/root/repo/Src/Roms/LSNRomInfo.cpp" "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRomInfo.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRomInfo.cpp.o.d"
+  "/root/repo/Src/System/LSNBatchRunner.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNBatchRunner.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNBatchRunner.cpp.o.d"
+  "/root/repo/Src/System/LSNBenchmark.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNBenchmark.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNBenchmark.cpp.o.d"
+  "/root/repo/Src/System/LSNLoopbackTransport.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNLoopbackTransport.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNLoopbackTransport.cpp.o.d"
+  "/root/repo/Src/System/LSNRewindBuffer.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNRewindBuffer.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNRewindBuffer.cpp.o.d"
+  "/root/repo/Src/System/LSNRollbackSession.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNRollbackSession.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNRollbackSession.cpp.o.d"
+  "/root/repo/Src/System/LSNRunAhead.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNRunAhead.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNRunAhead.cpp.o.d"
+  "/root/repo/Src/System/LSNSystem.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystem.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystem.cpp.o.d"
+  "/root/repo/Src/System/LSNSystemBase.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemBase.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemBase.cpp.o.d"
+  "/root/repo/Src/System/LSNSystemPool.cpp" "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemPool.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemPool.cpp.o.d"
+  "/root/repo/Src/Time/LSNClock.cpp" "CMakeFiles/BeesNESCore.dir/Src/Time/LSNClock.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Time/LSNClock.cpp.o.d"
+  "/root/repo/Src/Time/LSNFramePacer.cpp" "CMakeFiles/BeesNESCore.dir/Src/Time/LSNFramePacer.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Time/LSNFramePacer.cpp.o.d"
+  "/root/repo/Src/Utilities/LSNCacheCounters.cpp" "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNCacheCounters.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNCacheCounters.cpp.o.d"
+  "/root/repo/Src/Utilities/LSNThreadPool.cpp" "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNThreadPool.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNThreadPool.cpp.o.d"
+  "/root/repo/Src/Utilities/LSNUtilities.cpp" "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNUtilities.cpp.o" "gcc" "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNUtilities.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  "/root/repo/_verify_build/CMakeFiles/LSon.dir/DependInfo.cmake"
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,73 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNPulse.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNPulse.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNSequencer.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Apu/LSNSequencer.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBus.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBus.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBusHistogram.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNBusHistogram.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNWatchpoints.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Bus/LSNWatchpoints.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNCpu6502.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNCpu6502.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNJit6502.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Cpu/LSNJit6502.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Crc/LSNCrc.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Crc/LSNCrc.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Database/LSNDatabase.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Database/LSNDatabase.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayClient.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayClient.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayHost.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Display/LSNDisplayHost.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/File/LSNFileBase.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/File/LSNFileBase.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/File/LSNStdFile.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/File/LSNStdFile.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/File/LSNZipFile.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/File/LSNZipFile.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Input/LSNInputMovie.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Input/LSNInputMovie.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/MiniZ/miniz.c.o"
+  "CMakeFiles/BeesNESCore.dir/Src/MiniZ/miniz.c.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRom.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRom.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRomInfo.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Roms/LSNRomInfo.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNBatchRunner.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNBatchRunner.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNBenchmark.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNBenchmark.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNLoopbackTransport.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNLoopbackTransport.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNRewindBuffer.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNRewindBuffer.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNRollbackSession.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNRollbackSession.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNRunAhead.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNRunAhead.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystem.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystem.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemBase.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemBase.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemPool.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/System/LSNSystemPool.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Time/LSNClock.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Time/LSNClock.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Time/LSNFramePacer.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Time/LSNFramePacer.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNCacheCounters.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNCacheCounters.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNThreadPool.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNThreadPool.cpp.o.d"
+  "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNUtilities.cpp.o"
+  "CMakeFiles/BeesNESCore.dir/Src/Utilities/LSNUtilities.cpp.o.d"
+  "libBeesNESCore.a"
+  "libBeesNESCore.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang C CXX)
+  include(CMakeFiles/BeesNESCore.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()
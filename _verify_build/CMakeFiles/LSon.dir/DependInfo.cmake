@@ -0,0 +1,22 @@
+
+# Consider dependencies only in project.
+set(CMAKE_DEPENDS_IN_PROJECT_ONLY OFF)
+
+# The set of languages for which implicit dependencies are needed:
+set(CMAKE_DEPENDS_LANGUAGES
+  )
+
+# The set of dependency files which are needed:
+set(CMAKE_DEPENDS_DEPENDENCY_FILES
+  "/root/repo/Libraries/LSon/Src/Gen/LSONJsonLexBase.cpp" "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonLexBase.cpp.o" "gcc" "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonLexBase.cpp.o.d"
+  "/root/repo/Libraries/LSon/Src/Gen/LSONJsonParser.cpp" "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonParser.cpp.o" "gcc" "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonParser.cpp.o.d"
+  "/root/repo/Libraries/LSon/Src/LSONJson.cpp" "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJson.cpp.o" "gcc" "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJson.cpp.o.d"
+  "/root/repo/Libraries/LSon/Src/LSONJsonContainer.cpp" "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJsonContainer.cpp.o" "gcc" "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJsonContainer.cpp.o.d"
+  )
+
+# Targets to which this target links.
+set(CMAKE_TARGET_LINKED_INFO_FILES
+  )
+
+# Fortran module output directory.
+set(CMAKE_Fortran_TARGET_MODULE_DIR "")
@@ -0,0 +1,17 @@
+file(REMOVE_RECURSE
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonLexBase.cpp.o"
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonLexBase.cpp.o.d"
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonParser.cpp.o"
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/Gen/LSONJsonParser.cpp.o.d"
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJson.cpp.o"
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJson.cpp.o.d"
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJsonContainer.cpp.o"
+  "CMakeFiles/LSon.dir/Libraries/LSon/Src/LSONJsonContainer.cpp.o.d"
+  "libLSon.a"
+  "libLSon.pdb"
+)
+
+# Per-language clean rules from dependency scanning.
+foreach(lang CXX)
+  include(CMakeFiles/LSon.dir/cmake_clean_${lang}.cmake OPTIONAL)
+endforeach()